@@ -1,5 +1,7 @@
 #include "EyerAVAlphaFrameUtil.hpp"
 
+#include "EyerAVScaler.hpp"
+
 namespace Eyer
 {
     EyerAVAlphaFrameUtil::EyerAVAlphaFrameUtil()
@@ -21,7 +23,9 @@ namespace Eyer
         frame422p.GetBuffer(1);
 
         EyerAVFrame frame420p;
-        frame.Scale(frame420p, EyerAVPixelFormat::EYER_YUV420P);
+        EyerAVScaler scaler;
+        scaler.SetQuality(EyerAVScaleQuality::FAST_BILINEAR);
+        scaler.Scale(frame, frame420p, EyerAVPixelFormat::EYER_YUV420P);
 
         // copy y channel
         for(int i=0;i<frame420p.GetHeight();i++){
@@ -37,8 +37,8 @@ namespace Eyer
     int EyerAVAudioFifo::PutAVFrame(EyerAVFrame & avFrame)
     {
         av_audio_fifo_write(piml->fifo,
-                            (void **)avFrame.piml->frame->data,
-                            avFrame.piml->frame->nb_samples
+                            (void **)avFrame.GetPrivate()->frame->data,
+                            avFrame.GetPrivate()->frame->nb_samples
         );
         return 0;
     }
@@ -50,14 +50,14 @@ namespace Eyer
             return -1;
         }
 
-        frame.piml->frame->channel_layout       = piml->channelLayout.GetFFmpegId();
-        frame.piml->frame->channels             = av_get_channel_layout_nb_channels(frame.piml->frame->channel_layout);
-        frame.piml->frame->sample_rate          = piml->sampleRate;
-        frame.piml->frame->format               = piml->sampleFormat.ffmpegId;
-        frame.piml->frame->nb_samples           = sampleNB;
-        av_frame_get_buffer(frame.piml->frame, 1);
+        frame.GetPrivate()->frame->channel_layout       = piml->channelLayout.GetFFmpegId();
+        frame.GetPrivate()->frame->channels             = av_get_channel_layout_nb_channels(frame.GetPrivate()->frame->channel_layout);
+        frame.GetPrivate()->frame->sample_rate          = piml->sampleRate;
+        frame.GetPrivate()->frame->format               = piml->sampleFormat.ffmpegId;
+        frame.GetPrivate()->frame->nb_samples           = sampleNB;
+        av_frame_get_buffer(frame.GetPrivate()->frame, 1);
 
-        av_audio_fifo_read(piml->fifo, (void **)frame.piml->frame->data, frame.piml->frame->nb_samples);
+        av_audio_fifo_read(piml->fifo, (void **)frame.GetPrivate()->frame->data, frame.GetPrivate()->frame->nb_samples);
 
         return 0;
     }
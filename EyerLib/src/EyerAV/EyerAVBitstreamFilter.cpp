@@ -38,6 +38,7 @@ namespace Eyer
         */
 
         avcodec_parameters_copy(piml->ctx->par_in, avStream.piml->codecpar);
+        piml->ctx->time_base_in = avStream.piml->timebase;
         av_bsf_init(piml->ctx);
     }
 
@@ -55,7 +56,7 @@ namespace Eyer
 
     int EyerAVBitstreamFilter::SendPacket(EyerAVPacket & packet)
     {
-        return av_bsf_send_packet(piml->ctx, packet.piml->packet);
+        return av_bsf_send_packet(piml->ctx, packet.GetPrivate()->packet);
     }
 
     int EyerAVBitstreamFilter::SendPacketNull()
@@ -65,6 +66,19 @@ namespace Eyer
 
     int EyerAVBitstreamFilter::RecvPacket(EyerAVPacket & packet)
     {
-        return av_bsf_receive_packet(piml->ctx, packet.piml->packet);
+        return av_bsf_receive_packet(piml->ctx, packet.GetPrivate()->packet);
+    }
+
+    int EyerAVBitstreamFilter::GetOutputStream(EyerAVStream & stream)
+    {
+        if(piml->ctx == nullptr || piml->ctx->par_out == nullptr){
+            return -1;
+        }
+        int ret = avcodec_parameters_copy(stream.piml->codecpar, piml->ctx->par_out);
+        if(ret < 0){
+            return -1;
+        }
+        stream.piml->timebase = piml->ctx->time_base_out;
+        return 0;
     }
 }
\ No newline at end of file
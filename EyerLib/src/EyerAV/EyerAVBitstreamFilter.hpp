@@ -19,6 +19,9 @@ namespace Eyer
         int SendPacketNull();
         int RecvPacket(EyerAVPacket & packet);
 
+        // 过滤后的流参数, 例如 mp4toannexb 输出的 Annex B extradata
+        int GetOutputStream(EyerAVStream & stream);
+
         static int QueryAllBitstreamFilter();
 
     private:
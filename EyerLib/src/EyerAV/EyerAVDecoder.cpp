@@ -98,17 +98,17 @@ namespace Eyer
 
     int EyerAVDecoder::SendPacket(EyerAVPacket * packet)
     {
-        return avcodec_send_packet(piml->codecContext, packet->piml->packet);
+        return avcodec_send_packet(piml->codecContext, packet->GetPrivate()->packet);
     }
 
     int EyerAVDecoder::SendPacket(EyerAVPacket & packet)
     {
-        return avcodec_send_packet(piml->codecContext, packet.piml->packet);
+        return avcodec_send_packet(piml->codecContext, packet.GetPrivate()->packet);
     }
 
     int EyerAVDecoder::SendPacket(EyerSmartPtr<EyerAVPacket> & packet)
     {
-        return avcodec_send_packet(piml->codecContext, packet->piml->packet);
+        return avcodec_send_packet(piml->codecContext, packet->GetPrivate()->packet);
     }
 
     int EyerAVDecoder::SendPacketNull()
@@ -118,11 +118,11 @@ namespace Eyer
 
     int EyerAVDecoder::RecvFrame(EyerAVFrame & frame)
     {
-        int ret = avcodec_receive_frame(piml->codecContext, frame.piml->frame);
+        int ret = avcodec_receive_frame(piml->codecContext, frame.GetPrivate()->frame);
         if(!ret){
             int64_t pts = frame.GetPTS();
-            frame.piml->secPTS = pts * (double)piml->streamTimebase.num / piml->streamTimebase.den;
-            frame.piml->angle = GetAngle();
+            frame.GetPrivate()->secPTS = pts * (double)piml->streamTimebase.num / piml->streamTimebase.den;
+            frame.GetPrivate()->angle = GetAngle();
         }
         return ret;
     }
@@ -1,9 +1,14 @@
 #include "EyerAVDecoderBox.hpp"
+#include "EyerAVSharedFrameCache.hpp"
 
 #include <math.h>
+#include <algorithm>
 
 namespace Eyer
 {
+    // 新开一条解码线 (打开文件, 初始化解码器, seek) 的开销, 折算成往后解码的秒数
+    static const double EYER_AV_DECODER_BOX_OPEN_LINE_COST = 1.0;
+
     EyerAVDecoderBox::EyerAVDecoderBox(const EyerString & _path, EyerAVReaderCustomIO * _customIO)
         : EyerAVDecoderBox(_path, EyerAVDecoderLineParams(), _customIO)
     {
@@ -15,6 +20,9 @@ namespace Eyer
         params      = _params;
         path        = _path;
         customIO    = _customIO;
+        if(params.sharedFrameCache){
+            sharedCacheKey = EyerAVSharedFrameCache::GetKey(path, customIO, params);
+        }
     }
 
     EyerAVDecoderBox::~EyerAVDecoderBox()
@@ -30,6 +38,30 @@ namespace Eyer
         return 8.4;
     }
 
+    int64_t EyerAVDecoderBox::GetMemoryUsage()
+    {
+        int64_t usage = 0;
+        for(int i=0;i<decoderLineCache.size();i++) {
+            usage += decoderLineCache[i]->GetCacheBytes();
+        }
+        return usage;
+    }
+
+    int EyerAVDecoderBox::GetLineNum()
+    {
+        return decoderLineCache.size();
+    }
+
+    int EyerAVDecoderBox::ReleaseLeastRecentLine()
+    {
+        if(decoderLineCache.size() <= 0){
+            return -1;
+        }
+        delete decoderLineCache[0];
+        decoderLineCache.erase(decoderLineCache.begin());
+        return 0;
+    }
+
     int EyerAVDecoderBox::GetFrame(EyerAVFrame & frame, double _pts)
     {
         return GetFrameInternal(frame, _pts);
@@ -37,6 +69,15 @@ namespace Eyer
 
     int EyerAVDecoderBox::GetFrameInternal(EyerAVFrame & frame, double pts)
     {
+        // 命中共享缓存时不用选解码线, 也不会新开解码线
+        if(!sharedCacheKey.IsEmpty()){
+            if(EyerAVSharedFrameCache::GetInstance().Get(sharedCacheKey, pts, frame) == 0){
+                return 0;
+            }
+        }
+
+        InitKeyframeIndex();
+
         while(decoderLineCache.size() > 2){
             EyerAVDecoderLine * d = nullptr;
             for(int i=0;i<decoderLineCache.size();i++) {
@@ -68,7 +109,18 @@ namespace Eyer
         EyerAVDecoderLine * decoderLine = findDecoderLine(pts);
         if(decoderLine == nullptr){
             // EyerLog("Create Decode Line: %f, path: %s\n", pts, path.c_str());
-            decoderLine = new EyerAVDecoderLine(path, pts, customIO, params);
+            // 直接 seek 到 pts 所在 GOP 的关键帧
+            double startTime = pts;
+            int keyframe = keyframeIndex.FindKeyframe(pts);
+            if(keyframe >= 0){
+                startTime = keyframeIndex.GetKeyframe(keyframe).pts;
+            }
+            decoderLine = new EyerAVDecoderLine(path, startTime, customIO, params);
+            decoderLineCache.push_back(decoderLine);
+        }
+        else{
+            // 挪到最后, 淘汰时从前面开始
+            decoderLineCache.erase(std::find(decoderLineCache.begin(), decoderLineCache.end(), decoderLine));
             decoderLineCache.push_back(decoderLine);
         }
 
@@ -77,31 +129,77 @@ namespace Eyer
 
     EyerAVDecoderLine * EyerAVDecoderBox::findDecoderLine(double pts)
     {
-        EyerAVDecoderLine * res = nullptr;
-        double minDist = 0.0;
-
-        for(int i=0;i<decoderLineCache.size();i++) {
-            double startTime = decoderLineCache[i]->GetStartTime();
-            if(pts >= startTime){
-                if(res == nullptr){
-                    res = decoderLineCache[i];
-                    minDist = abs(pts - startTime);
-                }
-                else{
-                    if(minDist > abs(pts - startTime)){
+        int keyframe = keyframeIndex.FindKeyframe(pts);
+        if(keyframe < 0){
+            // 没有索引, 选起始时间最近的
+            EyerAVDecoderLine * res = nullptr;
+            double minDist = 0.0;
+            for(int i=0;i<decoderLineCache.size();i++) {
+                double startTime = decoderLineCache[i]->GetStartTime();
+                if(pts >= startTime){
+                    if(res == nullptr || minDist > abs(pts - startTime)){
                         res = decoderLineCache[i];
                         minDist = abs(pts - startTime);
                     }
                 }
             }
+            return res;
         }
 
-        if(res != nullptr){
-            if(minDist >= 2.0){
-                // res = nullptr;
+        // 复用解码线的开销是从它已经解码到的位置往后解到 pts
+        EyerAVDecoderLine * res = nullptr;
+        double minCost = 0.0;
+        for(int i=0;i<decoderLineCache.size();i++) {
+            EyerAVDecoderLine * decoderLine = decoderLineCache[i];
+            if(pts < decoderLine->GetStartTime()){
+                continue;
+            }
+            double cost = pts - decoderLine->GetEndTime();
+            if(cost < 0.0){
+                cost = 0.0;
+            }
+            if(res == nullptr || minCost > cost){
+                res = decoderLine;
+                minCost = cost;
             }
         }
 
+        // 新开解码线的开销是从关键帧解到 pts
+        double openCost = pts - keyframeIndex.GetKeyframe(keyframe).pts + EYER_AV_DECODER_BOX_OPEN_LINE_COST;
+        if(res != nullptr && minCost > openCost){
+            res = nullptr;
+        }
+
         return res;
     }
+
+    int EyerAVDecoderBox::InitKeyframeIndex()
+    {
+        if(isKeyframeIndexInit){
+            return 0;
+        }
+        isKeyframeIndexInit = true;
+
+        if(!params.keyframeIndex){
+            return 0;
+        }
+
+        // 自定义 IO 的 path 不一定是文件路径, 不存旁路文件
+        bool sidecar = params.keyframeIndexSidecar && customIO == nullptr;
+        EyerString indexPath = path + ".keyindex";
+        if(sidecar){
+            if(keyframeIndex.Load(indexPath, path) == 0){
+                return 0;
+            }
+        }
+
+        int ret = keyframeIndex.Build(path, customIO);
+        if(ret){
+            return -1;
+        }
+        if(sidecar){
+            keyframeIndex.Save(indexPath);
+        }
+        return 0;
+    }
 }
\ No newline at end of file
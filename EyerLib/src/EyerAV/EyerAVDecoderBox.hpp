@@ -6,6 +6,7 @@
 #include "EyerCore/EyerCore.hpp"
 #include "EyerAVDecoderLine.hpp"
 #include "EyerAVDecoderLineParams.hpp"
+#include "EyerAVKeyframeIndex.hpp"
 
 namespace Eyer
 {
@@ -21,15 +22,29 @@ namespace Eyer
 
         double GetDuration();
 
+        // 所有解码线缓存的字节数
+        int64_t GetMemoryUsage();
+        int GetLineNum();
+        // 释放最久没用的解码线
+        int ReleaseLeastRecentLine();
+
     public:
         EyerString path;
         EyerAVDecoderLineParams params;
 
+        // 按使用顺序排列, 最近用过的在最后
         std::vector<EyerAVDecoderLine *> decoderLineCache;
 
         EyerAVDecoderLine * findDecoderLine(double pts);
 
         EyerAVReaderCustomIO * customIO = nullptr;
+
+        // 第一次取帧时建立, 建立失败时按起始时间选择解码线
+        EyerAVKeyframeIndex keyframeIndex;
+        bool isKeyframeIndexInit = false;
+        int InitKeyframeIndex();
+
+        EyerString sharedCacheKey;
     };
 }
 
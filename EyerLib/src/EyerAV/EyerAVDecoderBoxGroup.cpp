@@ -1,6 +1,7 @@
 #include "EyerAVDecoderBoxGroup.hpp"
 
 #include "EyerAVDecoderBox.hpp"
+#include "EyerAVSharedFrameCache.hpp"
 
 namespace Eyer
 {
@@ -28,9 +29,117 @@ namespace Eyer
 
         int ret = decoderBox->GetFrame(frame, pts);
 
+        useTick++;
+        decoderBoxUseTick[path] = useTick;
+        ReleaseOverBudget(path);
+
         return ret;
     }
 
+    int64_t EyerAVDecoderBoxGroup::GetMemoryUsage()
+    {
+        int64_t usage = 0;
+        std::map<EyerString, EyerAVDecoderBox *>::iterator it;
+        for(it = decoderBoxCache.begin(); it != decoderBoxCache.end(); it++) {
+            usage += it->second->GetMemoryUsage();
+        }
+        return usage;
+    }
+
+    int EyerAVDecoderBoxGroup::GetLineNum()
+    {
+        int lineNum = 0;
+        std::map<EyerString, EyerAVDecoderBox *>::iterator it;
+        for(it = decoderBoxCache.begin(); it != decoderBoxCache.end(); it++) {
+            lineNum += it->second->GetLineNum();
+        }
+        return lineNum;
+    }
+
+    int EyerAVDecoderBoxGroup::GetBoxNum()
+    {
+        return decoderBoxCache.size();
+    }
+
+    bool EyerAVDecoderBoxGroup::IsOverBudget()
+    {
+        if(params.groupMaxLines > 0 && GetLineNum() > params.groupMaxLines){
+            return true;
+        }
+        if(params.groupMaxBytes > 0 && GetMemoryUsage() + GetSharedFrameCacheBytes() > params.groupMaxBytes){
+            return true;
+        }
+        return false;
+    }
+
+    int64_t EyerAVDecoderBoxGroup::GetSharedFrameCacheBytes()
+    {
+        if(!params.sharedFrameCache){
+            return 0;
+        }
+        return EyerAVSharedFrameCache::GetInstance().GetBytes();
+    }
+
+    int EyerAVDecoderBoxGroup::ShrinkSharedFrameCache()
+    {
+        if(params.groupMaxBytes <= 0 || GetSharedFrameCacheBytes() <= 0){
+            return -1;
+        }
+        // 解码线用剩下的预算留给共享缓存
+        int64_t room = params.groupMaxBytes - GetMemoryUsage();
+        if(room < 0){
+            room = 0;
+        }
+        if(GetSharedFrameCacheBytes() <= room){
+            return -1;
+        }
+        EyerAVSharedFrameCache::GetInstance().SetMaxBytes(room);
+        return 0;
+    }
+
+    int EyerAVDecoderBoxGroup::ReleaseOverBudget(const EyerString & currentPath)
+    {
+        while(IsOverBudget()){
+            // 解码线没超出预算时, 先缩小共享缓存
+            if(params.groupMaxBytes > 0 && GetMemoryUsage() < params.groupMaxBytes){
+                if(ShrinkSharedFrameCache() == 0){
+                    continue;
+                }
+            }
+
+            // 再淘汰最久没用的 Box
+            std::map<EyerString, EyerAVDecoderBox *>::iterator lruIt = decoderBoxCache.end();
+            int64_t lruTick = 0;
+            std::map<EyerString, EyerAVDecoderBox *>::iterator it;
+            for(it = decoderBoxCache.begin(); it != decoderBoxCache.end(); it++) {
+                if(it->first == currentPath){
+                    continue;
+                }
+                int64_t tick = decoderBoxUseTick[it->first];
+                if(lruIt == decoderBoxCache.end() || tick < lruTick){
+                    lruIt = it;
+                    lruTick = tick;
+                }
+            }
+            if(lruIt != decoderBoxCache.end()){
+                decoderBoxUseTick.erase(lruIt->first);
+                delete lruIt->second;
+                decoderBoxCache.erase(lruIt);
+                continue;
+            }
+
+            // 只剩当前 Box, 保留刚用过的解码线
+            it = decoderBoxCache.find(currentPath);
+            if(it == decoderBoxCache.end() || it->second->GetLineNum() <= 1){
+                // 没有可以淘汰的解码线了, 剩下的预算都不够共享缓存用
+                ShrinkSharedFrameCache();
+                break;
+            }
+            it->second->ReleaseLeastRecentLine();
+        }
+        return 0;
+    }
+
     EyerAVDecoderBox * EyerAVDecoderBoxGroup::FindDecoderBox(const EyerString & path)
     {
         EyerAVDecoderBox * decoderBox = nullptr;
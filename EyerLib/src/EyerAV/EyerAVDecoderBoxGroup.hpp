@@ -20,10 +20,25 @@ namespace Eyer
 
         int GetFrame(EyerAVFrame & frame, const EyerString & path, double pts);
 
+        // 当前占用, 预算见 EyerAVDecoderLineParams::SetGroupBudget
+        // GetMemoryUsage 只算解码线, 打开共享缓存时 EyerAVSharedFrameCache 的字节数也计入预算
+        int64_t GetMemoryUsage();
+        int GetLineNum();
+        int GetBoxNum();
+
     private:
         EyerAVDecoderLineParams params;
         std::map<EyerString, EyerAVDecoderBox *> decoderBoxCache;
+        // 每个 Box 最后一次使用的序号, 越小越久没用
+        std::map<EyerString, int64_t> decoderBoxUseTick;
+        int64_t useTick = 0;
+
         EyerAVDecoderBox * FindDecoderBox(const EyerString & path);
+        bool IsOverBudget();
+        int64_t GetSharedFrameCacheBytes();
+        // 超出预算时调低 EyerAVSharedFrameCache::SetMaxBytes, 缩小了返回 0
+        int ShrinkSharedFrameCache();
+        int ReleaseOverBudget(const EyerString & currentPath);
     };
 }
 
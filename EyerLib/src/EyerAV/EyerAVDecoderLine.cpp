@@ -9,6 +9,11 @@ namespace Eyer
     EyerAVDecoderLine::EyerAVDecoderLine(const EyerString & _path, double _startSeekTime, EyerAVReaderCustomIO * _customIO, const EyerAVDecoderLineParams & _params)
     {
         params = _params;
+        scaler.SetQuality(params.scaleQuality);
+        frameCache.SetLimit(params.lineCacheMaxFrame, params.lineCacheMaxBytes);
+        if(params.sharedFrameCache){
+            sharedCacheKey = EyerAVSharedFrameCache::GetKey(_path, _customIO, params);
+        }
 
         startSeekTime = _startSeekTime;
 
@@ -55,6 +60,10 @@ namespace Eyer
                 ret = reader->SeekStream(startSeekTime, videoStreamIndex);
             }
         }
+
+        if(params.decodeAheadFrame > 0 || params.decodeAheadTime > 0){
+            aheadThread = new std::thread(&EyerAVDecoderLine::DecodeAheadLoop, this);
+        }
     }
     EyerAVDecoderLine::EyerAVDecoderLine(const EyerString & path, double _startSeekTime, EyerAVReaderCustomIO * _customIO)
         : EyerAVDecoderLine(path, _startSeekTime, _customIO, EyerAVDecoderLineParams())
@@ -64,6 +73,8 @@ namespace Eyer
 
     EyerAVDecoderLine::~EyerAVDecoderLine()
     {
+        StopDecodeAhead();
+
         if(reader != nullptr){
             reader->Close();
             delete reader;
@@ -73,10 +84,10 @@ namespace Eyer
             delete decoder;
             decoder = nullptr;
         }
-        for(int i=0; i<frameCache.size(); i++){
-            delete frameCache[i];
+        EyerAVFrame * cacheFrame = nullptr;
+        while(frameCache.PopFront(cacheFrame) == 0){
+            framePool.DeleteFrame(cacheFrame);
         }
-        frameCache.clear();
 
         if(lastFrame != nullptr){
             delete lastFrame;
@@ -99,23 +110,61 @@ namespace Eyer
             return EYER_AV_DECODER_LINE_PTS_ERROR;
         }
 
-        while(1){
-            int ret = SearchFrameInCache(frame, pts);
-            if(ret == EYER_AV_OK){
-                return EYER_AV_OK;
+        {
+            // 预解码线程从这个时间开始往后解码
+            std::lock_guard<std::mutex> lg(cacheMut);
+            lastRequestPTS = pts;
+        }
+        aheadCond.notify_one();
+
+        if(!sharedCacheKey.IsEmpty()){
+            // 其他解码线可能已经解过这一帧
+            {
+                std::lock_guard<std::mutex> lg(cacheMut);
+                if(SearchFrameInCache(frame, pts) == EYER_AV_OK){
+                    return EYER_AV_OK;
+                }
             }
-            else if(ret == EYER_AV_DECODER_LINE_NOT_MATCH_REGION){
-                return EYER_AV_DECODER_LINE_NOT_FIND;
+            if(EyerAVSharedFrameCache::GetInstance().Get(sharedCacheKey, pts, frame) == 0){
+                return EYER_AV_OK;
             }
-            else if(ret == EYER_AV_DECODER_LINE_NEED_MORE_DATA){
+        }
+
+        while(1){
+            int canDropFrames = 0;
+            {
+                std::lock_guard<std::mutex> lg(cacheMut);
+                int ret = SearchFrameInCache(frame, pts);
+                if(ret == EYER_AV_OK){
+                    return EYER_AV_OK;
+                }
+                else if(ret == EYER_AV_DECODER_LINE_NOT_MATCH_REGION){
+                    return EYER_AV_DECODER_LINE_NOT_FIND;
+                }
                 // 需要更多的数据，要进行解码了x
                 // 记录当前缓存有多少帧，
-                int canDropFrames = frameCache.size() - 1;
+                canDropFrames = frameCache.Size() - 1;
                 if(canDropFrames <= 0){
                     canDropFrames = 0;
                 }
+            }
+
+            int ret = EYER_AV_OK;
+            {
+                std::lock_guard<std::mutex> decodeLock(decodeMut);
+                // 预解码线程可能刚解出要找的帧, 拿到解码锁后再查一次
+                bool needDecode = true;
+                {
+                    std::lock_guard<std::mutex> lg(cacheMut);
+                    needDecode = SearchFrameInCache(frame, pts) == EYER_AV_DECODER_LINE_NEED_MORE_DATA;
+                }
+                if(needDecode){
+                    ret = DecodeFrame();
+                }
+            }
 
-                ret = DecodeFrame();
+            {
+                std::lock_guard<std::mutex> lg(cacheMut);
                 ClearCache(canDropFrames);
                 if(ret == EYER_AV_DECODER_LINE_DECODER_END_OF_FILE || ret == EYER_AV_DECODER_LINE_DECODER_ERROR){
                     // 到了文件结尾或者视频出错了。
@@ -127,8 +176,8 @@ namespace Eyer
                         return EYER_AV_DECODER_LINE_NOT_FIND;
                     }
                     else if(ret == EYER_AV_DECODER_LINE_NEED_MORE_DATA){
-                        if(frameCache.size() > 0){
-                            frame = *frameCache[frameCache.size() - 1];
+                        if(frameCache.Size() > 0){
+                            frame = *frameCache.Get(frameCache.Size() - 1);
                             return EYER_AV_OK;
                         }
                         return EYER_AV_DECODER_LINE_NOT_FIND;
@@ -138,9 +187,6 @@ namespace Eyer
                     }
                 }
             }
-            else{
-
-            }
         }
 
         return EYER_AV_DECODER_LINE_NOT_FIND;
@@ -148,148 +194,247 @@ namespace Eyer
 
     int EyerAVDecoderLine::GetCacheSize()
     {
-        return frameCache.size();
+        std::lock_guard<std::mutex> lg(cacheMut);
+        return frameCache.Size();
+    }
+
+    int64_t EyerAVDecoderLine::GetCacheBytes()
+    {
+        std::lock_guard<std::mutex> lg(cacheMut);
+        return frameCache.GetBytes();
     }
 
     double EyerAVDecoderLine::GetStartTime()
     {
-        if(frameCache.size() > 0){
-            return frameCache[0]->GetSecPTS();
+        std::lock_guard<std::mutex> lg(cacheMut);
+        if(frameCache.Size() > 0){
+            return frameCache.GetPTS(0);
         }
         return startSeekTime;
     }
 
-    int EyerAVDecoderLine::SearchFrameInCache(EyerAVFrame & frame, double pts)
+    double EyerAVDecoderLine::GetEndTime()
     {
-        for(int i=0;i<frameCache.size();i++){
-            double secPTS = frameCache[i]->GetSecPTS();
-            if(secPTS == pts){
-                frame = *frameCache[i];
-                return EYER_AV_OK;
-            }
-            else if(secPTS < pts){
-                continue;
-            }
-            else{
-                if(i <= 0){
-                    return EYER_AV_DECODER_LINE_NOT_MATCH_REGION;
-                }
-                double lastSecPTS = frameCache[i - 1]->GetSecPTS();
-                double nowSecPTS  = frameCache[i]->GetSecPTS();
+        std::lock_guard<std::mutex> lg(cacheMut);
+        if(frameCache.Size() > 0){
+            return frameCache.GetPTS(frameCache.Size() - 1);
+        }
+        return startSeekTime;
+    }
 
-                if(abs(lastSecPTS - pts) >= abs(nowSecPTS - pts)){
-                    frame = *frameCache[i];
-                    return EYER_AV_OK;
-                }
-                else{
-                    frame = *frameCache[i - 1];
-                    return EYER_AV_OK;
-                }
-            }
+    int EyerAVDecoderLine::SearchFrameInCache(EyerAVFrame & frame, double pts)
+    {
+        int index = frameCache.LowerBound(pts);
+        if(index >= frameCache.Size()){
+            return EYER_AV_DECODER_LINE_NEED_MORE_DATA;
+        }
+        if(frameCache.GetPTS(index) == pts){
+            frame = *frameCache.Get(index);
+            return EYER_AV_OK;
+        }
+        if(index <= 0){
+            return EYER_AV_DECODER_LINE_NOT_MATCH_REGION;
         }
 
-        return EYER_AV_DECODER_LINE_NEED_MORE_DATA;
+        double lastSecPTS = frameCache.GetPTS(index - 1);
+        double nowSecPTS  = frameCache.GetPTS(index);
+        if(abs(lastSecPTS - pts) >= abs(nowSecPTS - pts)){
+            frame = *frameCache.Get(index);
+        }
+        else{
+            frame = *frameCache.Get(index - 1);
+        }
+        return EYER_AV_OK;
     }
 
     int EyerAVDecoderLine::DecodeFrame()
     {
-        int lastCacheSize = frameCache.size();
+        // 需要持有 decodeMut, 解出的帧先放在这里, 最后一次性放进缓存
+        std::vector<EyerAVFrame *> decodedList;
+        int result = EYER_AV_OK;
 
+        EyerAVPacket & packet = readPacket;
         while(1) {
-            EyerAVPacket packet;
+            bool isReadEnd = false;
             int ret = reader->Read(packet);
             if (ret) {
                 // 读到了文件末尾或者是出错了
+                isReadEnd = true;
                 ret = decoder->SendPacketNull();
-                if (ret) {
-                    return EYER_AV_DECODER_LINE_DECODER_ERROR;
-                }
-                while (1) {
-                    EyerAVFrame * frame = new EyerAVFrame();
-                    ret = decoder->RecvFrame(*frame);
-                    if (ret) {
-                        delete frame;
-                        break;
-                    }
-
-                    if(params.isScale) {
-                        EyerAVFrame * outframe = new EyerAVFrame();
-                        frame->Scale(*outframe, params.pixelFormat, params.scaleWidth, params.scaleHeight);
-
-                        frameCache.push_back(outframe);
-                        delete frame;
-                    }
-                    else{
-                        frameCache.push_back(frame);
-                    }
-                }
-                return EYER_AV_DECODER_LINE_DECODER_END_OF_FILE;
             }
-
-            if (currentStreamIndex != packet.GetStreamIndex()) {
-                continue;
-            }
-
-            ret = decoder->SendPacket(packet);
-            for(int i=0;i<10;i++){
-                // printf("%d ", packet.GetDatePtr()[i]);
+            else {
+                if (currentStreamIndex != packet.GetStreamIndex()) {
+                    continue;
+                }
+                ret = decoder->SendPacket(packet);
             }
-            // printf("\n");
             if (ret) {
-                return EYER_AV_DECODER_LINE_DECODER_ERROR;
+                result = EYER_AV_DECODER_LINE_DECODER_ERROR;
+                break;
             }
 
             while(1){
-                EyerAVFrame * frame = new EyerAVFrame();
-                ret = decoder->RecvFrame(*frame);
-                if(ret){
-                    delete frame;
+                EyerAVFrame * frame = framePool.NewFrame();
+                int recvRet = decoder->RecvFrame(*frame);
+                if(recvRet){
+                    framePool.DeleteFrame(frame);
                     break;
                 }
 
-                // EyerLog("Frame.... %lld\n", frame->GetPTS());
-
                 if(params.isScale) {
-                    EyerAVFrame * outframe = new EyerAVFrame();
-                    frame->Scale(*outframe, params.pixelFormat, params.scaleWidth, params.scaleHeight);
+                    EyerAVFrame * outframe = framePool.NewFrame();
+                    if(scaler.Scale(*frame, *outframe, params.pixelFormat, params.scaleWidth, params.scaleHeight)){
+                        EyerLog("Decoder line scale fail\n");
+                        framePool.DeleteFrame(outframe);
+                        framePool.DeleteFrame(frame);
+                        continue;
+                    }
 
-                    frameCache.push_back(outframe);
-                    delete frame;
+                    decodedList.push_back(outframe);
+                    framePool.DeleteFrame(frame);
                 }
                 else{
-                    frameCache.push_back(frame);
+                    decodedList.push_back(frame);
                 }
             }
 
-            int nowCacheSize = frameCache.size();
-            if(nowCacheSize != lastCacheSize){
-                return EYER_AV_OK;
+            if(isReadEnd){
+                result = EYER_AV_DECODER_LINE_DECODER_END_OF_FILE;
+                break;
+            }
+            if(decodedList.size() > 0){
+                break;
             }
-            continue;
         }
-        return EYER_AV_OK;
+
+        if(!sharedCacheKey.IsEmpty()){
+            for(int i = 0; i < decodedList.size(); i++){
+                PutSharedFrame(*decodedList[i], false);
+            }
+            if(result == EYER_AV_DECODER_LINE_DECODER_END_OF_FILE && hasLastDecodedFrame){
+                PutSharedFrame(lastDecodedFrame, true);
+            }
+        }
+
+        std::lock_guard<std::mutex> lg(cacheMut);
+        for(int i = 0; i < decodedList.size(); i++){
+            frameCache.Push(decodedList[i]);
+        }
+        if(result != EYER_AV_OK){
+            isEOF = true;
+        }
+        return result;
     }
 
     int EyerAVDecoderLine::ClearCache(int maxDropFrames)
     {
+        // 调用方已经持有 cacheMut
         int times = 0;
-        int maxFrame = params.lineCacheMaxFrame;
-        while(1){
-            if(GetCacheSize() <= maxFrame){
-                break;
+        while(frameCache.IsOverLimit() && times < maxDropFrames){
+            EyerAVFrame * frame = nullptr;
+            frameCache.PopFront(frame);
+            framePool.DeleteFrame(frame);
+            times++;
+        }
+        return 0;
+    }
+
+    int EyerAVDecoderLine::PutSharedFrame(EyerAVFrame & frame, bool isEnd)
+    {
+        EyerAVSharedFrameCache & sharedCache = EyerAVSharedFrameCache::GetInstance();
+        if(isEnd){
+            return sharedCache.Put(sharedCacheKey, frame, EYER_AV_SHARED_FRAME_CACHE_EOF);
+        }
+        // 解码输出按显示顺序, 这一帧就是上一帧的下一帧
+        if(hasLastDecodedFrame){
+            sharedCache.Put(sharedCacheKey, lastDecodedFrame, frame.GetSecPTS());
+        }
+        sharedCache.Put(sharedCacheKey, frame, -1.0);
+        lastDecodedFrame = frame;
+        hasLastDecodedFrame = true;
+        return 0;
+    }
+
+    int EyerAVDecoderLine::StopDecodeAhead()
+    {
+        if(aheadThread == nullptr){
+            return 0;
+        }
+        {
+            std::lock_guard<std::mutex> lg(cacheMut);
+            aheadStop = true;
+        }
+        aheadCond.notify_all();
+        // 正在解码时等这一包解完
+        aheadThread->join();
+        delete aheadThread;
+        aheadThread = nullptr;
+        return 0;
+    }
+
+    bool EyerAVDecoderLine::NeedDecodeAhead()
+    {
+        if(aheadStop || isEOF || lastRequestPTS < 0.0){
+            return false;
+        }
+
+        // 缓存满了, 又没有请求时间之前的帧可以淘汰, 不再往后解
+        int cacheSize = frameCache.Size();
+        if(frameCache.IsFull()){
+            if(cacheSize < 2 || frameCache.GetPTS(1) > lastRequestPTS){
+                return false;
             }
-            if(times >= maxDropFrames){
+        }
+
+        int aheadFrameNum = cacheSize - frameCache.UpperBound(lastRequestPTS);
+        double aheadTime = 0.0;
+        if(cacheSize > 0){
+            aheadTime = (frameCache.GetPTS(cacheSize - 1) - lastRequestPTS) * 1000.0;
+        }
+
+        if(params.decodeAheadFrame > 0 && aheadFrameNum < params.decodeAheadFrame){
+            return true;
+        }
+        if(params.decodeAheadTime > 0 && aheadTime < params.decodeAheadTime){
+            return true;
+        }
+        return false;
+    }
+
+    int EyerAVDecoderLine::ClearCacheBefore(double pts)
+    {
+        // 保留 pts 之前最近的一帧, 它可能就是 pts 要取的帧
+        while(frameCache.IsOverLimit() && frameCache.Size() >= 2){
+            if(frameCache.GetPTS(1) > pts){
                 break;
             }
+            EyerAVFrame * frame = nullptr;
+            frameCache.PopFront(frame);
+            framePool.DeleteFrame(frame);
+        }
+        return 0;
+    }
 
-            std::vector<EyerAVFrame *>::iterator itr = frameCache.begin();
+    void EyerAVDecoderLine::DecodeAheadLoop()
+    {
+        while(1){
+            {
+                std::unique_lock<std::mutex> lock(cacheMut);
+                aheadCond.wait(lock, [this]{
+                    return aheadStop || NeedDecodeAhead();
+                });
+                if(aheadStop){
+                    break;
+                }
+            }
 
-            EyerAVFrame * frame = frameCache[0];
-            delete frame;
+            {
+                std::lock_guard<std::mutex> lg(decodeMut);
+                DecodeFrame();
+            }
 
-            frameCache.erase(itr);
-            times++;
+            std::lock_guard<std::mutex> lg(cacheMut);
+            ClearCacheBefore(lastRequestPTS);
         }
-        return 0;
     }
 }
\ No newline at end of file
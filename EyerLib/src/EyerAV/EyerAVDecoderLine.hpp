@@ -2,13 +2,21 @@
 #define EYERLIB_EYERAVDECODERLINE_HPP
 
 #include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 
 #include "EyerCore/EyerCore.hpp"
 
 #include "EyerAVFrame.hpp"
 #include "EyerAVDecoder.hpp"
 #include "EyerAVReader.hpp"
+#include "EyerAVPacket.hpp"
 #include "EyerAVDecoderLineParams.hpp"
+#include "EyerAVScaler.hpp"
+#include "EyerAVFramePool.hpp"
+#include "EyerAVFrameCache.hpp"
+#include "EyerAVSharedFrameCache.hpp"
 
 namespace Eyer
 {
@@ -21,14 +29,21 @@ namespace Eyer
         int GetFrame(EyerAVFrame & frame, double pts);
 
         int GetCacheSize();
+        // 缓存的帧占用的字节数
+        int64_t GetCacheBytes();
 
         double GetStartTime();
+        // 已经解码到的时间, 缓存为空时是起始 seek 的时间
+        double GetEndTime();
+
+        // 停止预解码线程, 析构时会自动调用
+        int StopDecodeAhead();
 
     public:
         EyerAVReader * reader = nullptr;
         EyerAVDecoder * decoder = nullptr;
 
-        std::vector<EyerAVFrame *> frameCache;
+        EyerAVFrameCache<EyerAVFrame *> frameCache;
 
         double startSeekTime = 0.0;
 
@@ -41,9 +56,37 @@ namespace Eyer
         int ClearCache(int maxDropFrames);
 
         EyerAVDecoderLineParams params;
+        EyerAVScaler scaler;
+        // frameCache 中的帧从这里取, 淘汰后归还, 避免每帧 new 一次
+        EyerAVFramePool framePool;
+        // 读包复用同一个对象, Read 会先释放上一个包的数据
+        EyerAVPacket readPacket;
 
         EyerAVFrame * lastFrame = nullptr;
         int PutFrame(EyerAVFrame * _lastFrame);
+
+    private:
+        // 以下需要持有 cacheMut
+        bool NeedDecodeAhead();
+        int ClearCacheBefore(double pts);
+
+        void DecodeAheadLoop();
+
+        // 需要持有 decodeMut, 解出的帧按顺序放进共享缓存
+        int PutSharedFrame(EyerAVFrame & frame, bool isEnd);
+        EyerString sharedCacheKey;
+        EyerAVFrame lastDecodedFrame;
+        bool hasLastDecodedFrame = false;
+
+        // cacheMut 保护 frameCache, isEOF 和 lastRequestPTS
+        // decodeMut 保护 reader, decoder 和 scaler, 解码时不持有 cacheMut, 命中缓存的请求不用等解码
+        // 两个锁都要时先拿 decodeMut
+        std::mutex cacheMut;
+        std::mutex decodeMut;
+        std::condition_variable aheadCond;
+        std::thread * aheadThread = nullptr;
+        bool aheadStop = false;
+        double lastRequestPTS = -1.0;
     };
 }
 
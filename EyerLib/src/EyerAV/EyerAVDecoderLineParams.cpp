@@ -9,6 +9,15 @@ namespace Eyer
         pixelFormat = EyerAVPixelFormat::EYER_RGBA;
         scaleWidth = 0;
         scaleHeight = 0;
+        scaleQuality = EyerAVScaleQuality::FAST_BILINEAR;
+        decodeAheadFrame = 0;
+        decodeAheadTime = 0;
+        lineCacheMaxBytes = 0;
+        keyframeIndex = false;
+        keyframeIndexSidecar = false;
+        groupMaxBytes = 0;
+        groupMaxLines = 0;
+        sharedFrameCache = true;
     }
 
     EyerAVDecoderLineParams::EyerAVDecoderLineParams(int _lineCacheMaxFrame)
@@ -18,6 +27,15 @@ namespace Eyer
         pixelFormat = EyerAVPixelFormat::EYER_RGBA;
         scaleWidth = 0;
         scaleHeight = 0;
+        scaleQuality = EyerAVScaleQuality::FAST_BILINEAR;
+        decodeAheadFrame = 0;
+        decodeAheadTime = 0;
+        lineCacheMaxBytes = 0;
+        keyframeIndex = false;
+        keyframeIndexSidecar = false;
+        groupMaxBytes = 0;
+        groupMaxLines = 0;
+        sharedFrameCache = true;
     }
 
     EyerAVDecoderLineParams::~EyerAVDecoderLineParams()
@@ -33,4 +51,43 @@ namespace Eyer
         scaleHeight     = _scaleHeight;
         return 0;
     }
+
+    int EyerAVDecoderLineParams::SetScaleQuality(const EyerAVScaleQuality & _scaleQuality)
+    {
+        scaleQuality    = _scaleQuality;
+        return 0;
+    }
+
+    int EyerAVDecoderLineParams::SetDecodeAhead(int _aheadFrame, int _aheadTime)
+    {
+        decodeAheadFrame    = _aheadFrame;
+        decodeAheadTime     = _aheadTime;
+        return 0;
+    }
+
+    int EyerAVDecoderLineParams::SetCacheMaxBytes(int64_t _cacheMaxBytes)
+    {
+        lineCacheMaxBytes   = _cacheMaxBytes;
+        return 0;
+    }
+
+    int EyerAVDecoderLineParams::SetKeyframeIndex(bool _enable, bool _sidecar)
+    {
+        keyframeIndex           = _enable;
+        keyframeIndexSidecar    = _sidecar;
+        return 0;
+    }
+
+    int EyerAVDecoderLineParams::SetGroupBudget(int64_t _maxBytes, int _maxLines)
+    {
+        groupMaxBytes   = _maxBytes;
+        groupMaxLines   = _maxLines;
+        return 0;
+    }
+
+    int EyerAVDecoderLineParams::SetSharedFrameCache(bool _enable)
+    {
+        sharedFrameCache = _enable;
+        return 0;
+    }
 }
\ No newline at end of file
@@ -1,7 +1,9 @@
 #ifndef EYERLIB_EYERAVDECODERLINEPARAMS_HPP
 #define EYERLIB_EYERAVDECODERLINEPARAMS_HPP
 
+#include <stdint.h>
 #include "EyerAVPixelFormat.hpp"
+#include "EyerAVScaleQuality.hpp"
 
 namespace Eyer
 {
@@ -12,12 +14,38 @@ namespace Eyer
         ~EyerAVDecoderLineParams();
 
         int SetScale(const EyerAVPixelFormat & _pixelFormat, int scaleWidth, int scaleHeight);
+        int SetScaleQuality(const EyerAVScaleQuality & _scaleQuality);
+        // 预解码: 后台线程在最近一次请求的时间之后保持 aheadFrame 帧或 aheadTime 毫秒已经解码, 都为 0 时关闭
+        // 预解码的帧也放在缓存中, 总数不超过 lineCacheMaxFrame
+        int SetDecodeAhead(int aheadFrame, int aheadTime = 0);
+        // 缓存占用的字节上限, 和 lineCacheMaxFrame 同时生效, 0 表示不限制
+        int SetCacheMaxBytes(int64_t cacheMaxBytes);
+        // EyerAVDecoderBox 第一次取帧时建立关键帧索引, 用来决定复用解码线还是重新 seek
+        // 建立索引要同步解封装整个文件, 默认关闭; Box 被 EyerAVDecoderBoxGroup 淘汰后重新打开还要再建一次
+        // sidecar 为 true 时索引存在媒体文件旁边 (path + ".keyindex"), 下次直接读取, 长文件建议打开
+        int SetKeyframeIndex(bool enable, bool sidecar = false);
+        // EyerAVDecoderBoxGroup 的总预算: 所有解码线缓存的字节数和解码线 (打开的文件和解码器) 数量
+        // 超出时按最久没用淘汰整个 Box, 只剩当前 Box 时淘汰它的解码线, 0 表示不限制
+        int SetGroupBudget(int64_t maxBytes, int maxLines);
+        // 解码前先查 EyerAVSharedFrameCache, 解出的帧也放进去, 默认打开; 自定义 IO 时不使用
+        // 共享缓存的帧计入 SetGroupBudget, 超出时 EyerAVDecoderBoxGroup 会调低 EyerAVSharedFrameCache::SetMaxBytes
+        int SetSharedFrameCache(bool enable);
 
         int lineCacheMaxFrame       = 5;
         bool isScale                = false;
         EyerAVPixelFormat pixelFormat;
         int scaleWidth              = 0;
         int scaleHeight             = 0;
+        // 预览/缩略图路径, 默认使用最快的算法
+        EyerAVScaleQuality scaleQuality = EyerAVScaleQuality::FAST_BILINEAR;
+        int decodeAheadFrame        = 0;
+        int decodeAheadTime         = 0;
+        int64_t lineCacheMaxBytes   = 0;
+        bool keyframeIndex          = false;
+        bool keyframeIndexSidecar   = false;
+        int64_t groupMaxBytes       = 0;
+        int groupMaxLines           = 0;
+        bool sharedFrameCache       = true;
     };
 }
 
@@ -9,6 +9,75 @@
 #include "EyerAVADTSUtil.hpp"
 
 namespace Eyer {
+    /**
+     * @brief 把 preset/tune、码率控制、GOP 和 B 帧参数设置到 libx264/libx265
+     * @param codecContext 编码器上下文
+     * @param dict avcodec_open2 使用的参数字典
+     * @param param 编码器参数
+     * @param isH265 true 表示 libx265，false 表示 libx264
+     * @return 0 表示成功
+     *
+     * - CRF：只设置 crf
+     * - ABR：设置 bit_rate，可选 maxrate/bufsize 限制峰值
+     * - CBR：maxrate 等于 bitrate，x264 使用 nal-hrd=cbr，x265 使用 strict-cbr
+     * - CRF 模式下同样可以设置 maxrate/bufsize（capped CRF）
+     * - 部分参数 libx265 封装不读取 AVCodecContext，通过 x265-params 传递
+     */
+    static int EyerAVEncoder_SetX26XParams(AVCodecContext * codecContext, AVDictionary ** dict, const EyerAVEncoderParam & param, bool isH265)
+    {
+        if (!param.preset.IsEmpty()) {
+            av_dict_set(dict, "preset", param.preset.c_str(), 0);
+        }
+        if (!param.tune.IsEmpty()) {
+            av_dict_set(dict, "tune", param.tune.c_str(), 0);
+        }
+
+        std::string x265Params = "";
+
+        int maxrate = param.maxrate;
+        int bufsize = param.bufsize;
+        if (param.rateControl == EyerAVRateControl::CRF) {
+            av_dict_set(dict, "crf", EyerString::Number(param.crf).c_str(), 0);
+        }
+        else {
+            codecContext->bit_rate = (int64_t)param.bitrate * 1000;
+            if (param.rateControl == EyerAVRateControl::CBR) {
+                maxrate = param.bitrate;
+                if (bufsize <= 0) {
+                    bufsize = param.bitrate;
+                }
+                codecContext->rc_min_rate = codecContext->bit_rate;
+                if (isH265) {
+                    x265Params += "strict-cbr=1:";
+                }
+                else {
+                    av_dict_set(dict, "nal-hrd", "cbr", 0);
+                }
+            }
+        }
+        if (maxrate > 0) {
+            codecContext->rc_max_rate = (int64_t)maxrate * 1000;
+        }
+        if (bufsize > 0) {
+            codecContext->rc_buffer_size = bufsize * 1000;
+        }
+
+        if (param.gop > 0) {
+            codecContext->gop_size = param.gop;
+            x265Params += std::string("keyint=") + EyerString::Number(param.gop).c_str() + ":";
+        }
+        if (param.bframes >= 0) {
+            codecContext->max_b_frames = param.bframes;
+            x265Params += std::string("bframes=") + EyerString::Number(param.bframes).c_str() + ":";
+        }
+
+        if (isH265 && !x265Params.empty()) {
+            x265Params.pop_back();
+            av_dict_set(dict, "x265-params", x265Params.c_str(), 0);
+        }
+        return 0;
+    }
+
     /**
      * @brief 构造函数 - 创建音视频编码器
      *
@@ -126,10 +195,9 @@ namespace Eyer {
             // 设置时间基准的分子
             piml->codecContext->time_base.num = param.timebase.num;
 
-            // 向字典中设置 CRF（Constant Rate Factor）参数
+            // 设置 preset/tune、码率控制（CRF/ABR/CBR）、GOP 和 B 帧
             // CRF 控制视频质量（0-51）：0 为无损，23 为默认，51 为最差质量
-            // 将整数 CRF 值转换为字符串后存入字典
-            av_dict_set( &dict, "crf", EyerString::Number(param.crf).c_str(), 0);
+            EyerAVEncoder_SetX26XParams(piml->codecContext, &dict, param, false);
         }
 
 
@@ -185,9 +253,9 @@ namespace Eyer {
             // 设置时间基准的分子
             piml->codecContext->time_base.num = param.timebase.num;
 
-            // 向字典中设置 CRF（Constant Rate Factor）参数
-            // 这会覆盖上面的 global_quality 设置，使用 CRF 模式进行质量控制
-            av_dict_set( &dict, "crf", EyerString::Number(param.crf).c_str(), 0);
+            // 设置 preset/tune、码率控制（CRF/ABR/CBR）、GOP 和 B 帧
+            // CRF 会覆盖上面的 global_quality 设置，使用 CRF 模式进行质量控制
+            EyerAVEncoder_SetX26XParams(piml->codecContext, &dict, param, true);
         }
 
 
@@ -642,6 +710,11 @@ namespace Eyer {
             piml->codecContext->time_base.den = param.timebase.den;
             // 设置时间基准的分子
             piml->codecContext->time_base.num = param.timebase.num;
+
+            // 设置 ProRes profile（0 proxy, 1 lt, 2 standard, 3 hq），不设置时使用编码器默认值
+            if (param.proresProfile >= 0) {
+                av_dict_set( &dict, "profile", EyerString::Number(param.proresProfile).c_str(), 0);
+            }
         }
 
         // ========== SRT 字幕编码器配置（SubRip 字幕格式）==========
@@ -698,6 +771,26 @@ namespace Eyer {
         return piml->codecContext->frame_size;
     }
 
+    /**
+     * @brief 最后一帧是否可以少于 frame_size
+     * @return true 表示可以直接送入不足一帧的采样
+     *
+     * 编码器声明了 AV_CODEC_CAP_SMALL_LAST_FRAME 或 AV_CODEC_CAP_VARIABLE_FRAME_SIZE,
+     * 或者 frame_size 为 0 (不限制帧大小) 时返回 true
+     * 补静音会让输出比输入长, 这类编码器应当直接送入最后的短帧
+     */
+    bool EyerAVEncoder::IsSmallLastFrameSupported()
+    {
+        if(piml->codecContext->frame_size <= 0){
+            return true;
+        }
+        const AVCodec * codec = piml->codecContext->codec;
+        if(codec == nullptr){
+            return false;
+        }
+        return (codec->capabilities & (AV_CODEC_CAP_SMALL_LAST_FRAME | AV_CODEC_CAP_VARIABLE_FRAME_SIZE)) != 0;
+    }
+
     /**
      * @brief 发送帧到编码器
      * @param frame 要编码的音视频帧
@@ -708,8 +801,8 @@ namespace Eyer {
      */
     int EyerAVEncoder::SendFrame(EyerAVFrame &frame)
     {
-        // frame.piml->frame->pict_type = AV_PICTURE_TYPE_I;
-        return avcodec_send_frame(piml->codecContext, frame.piml->frame);
+        // frame.GetPrivate()->frame->pict_type = AV_PICTURE_TYPE_I;
+        return avcodec_send_frame(piml->codecContext, frame.GetPrivate()->frame);
     }
 
     /**
@@ -734,7 +827,7 @@ namespace Eyer {
      */
     int EyerAVEncoder::RecvPacket(EyerAVPacket &packet)
     {
-        return avcodec_receive_packet(piml->codecContext, packet.piml->packet);
+        return avcodec_receive_packet(piml->codecContext, packet.GetPrivate()->packet);
     }
 
     /**
@@ -24,6 +24,8 @@ namespace Eyer
         int RecvPacket(EyerAVPacket & packet);
 
         int GetFrameSize();
+        // 最后一帧可以少于 frame_size (AV_CODEC_CAP_SMALL_LAST_FRAME, 或者不限制帧大小), 不需要补静音
+        bool IsSmallLastFrameSupported();
 
         int GetTimebase(EyerAVRational & timebase);
         EyerAVRational GetTimebase();
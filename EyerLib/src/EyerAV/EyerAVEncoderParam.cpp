@@ -30,6 +30,19 @@ namespace Eyer
         timebase    = params.timebase;
         pixelFormat = params.pixelFormat;
         threadnum   = params.threadnum;
+        crf         = params.crf;
+        channelLayout   = params.channelLayout;
+        sampleFormat    = params.sampleFormat;
+
+        preset      = params.preset;
+        tune        = params.tune;
+        rateControl = params.rateControl;
+        bitrate     = params.bitrate;
+        maxrate     = params.maxrate;
+        bufsize     = params.bufsize;
+        gop         = params.gop;
+        bframes     = params.bframes;
+        proresProfile   = params.proresProfile;
         return *this;
     }
 
@@ -294,4 +307,53 @@ namespace Eyer
         height = _height;
         return 0;
     }
+
+    bool EyerAVEncoderParam::IsPresetSupport(const EyerAVCodecID & _codecId, const EyerString & _preset)
+    {
+        if(_preset.IsEmpty()){
+            return true;
+        }
+        if(_codecId != EyerAVCodecID::CODEC_ID_H264 && _codecId != EyerAVCodecID::CODEC_ID_H265){
+            return false;
+        }
+        // x264 和 x265 的 preset 列表相同
+        const char * presetList[] = {
+                "ultrafast", "superfast", "veryfast", "faster", "fast",
+                "medium", "slow", "slower", "veryslow", "placebo"
+        };
+        for(int i = 0; i < sizeof(presetList) / sizeof(presetList[0]); i++){
+            if(_preset == presetList[i]){
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool EyerAVEncoderParam::IsTuneSupport(const EyerAVCodecID & _codecId, const EyerString & _tune)
+    {
+        if(_tune.IsEmpty()){
+            return true;
+        }
+        if(_codecId == EyerAVCodecID::CODEC_ID_H264){
+            const char * tuneList[] = {
+                    "film", "animation", "grain", "stillimage", "psnr", "ssim", "fastdecode", "zerolatency"
+            };
+            for(int i = 0; i < sizeof(tuneList) / sizeof(tuneList[0]); i++){
+                if(_tune == tuneList[i]){
+                    return true;
+                }
+            }
+        }
+        if(_codecId == EyerAVCodecID::CODEC_ID_H265){
+            const char * tuneList[] = {
+                    "psnr", "ssim", "grain", "zerolatency", "fastdecode", "animation"
+            };
+            for(int i = 0; i < sizeof(tuneList) / sizeof(tuneList[0]); i++){
+                if(_tune == tuneList[i]){
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
 }
\ No newline at end of file
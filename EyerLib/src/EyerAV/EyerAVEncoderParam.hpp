@@ -7,6 +7,7 @@
 #include "EyerAVSampleFormat.hpp"
 #include "EyerAVPixelFormat.hpp"
 #include "EyerAVCodecID.hpp"
+#include "EyerAVRateControl.hpp"
 
 namespace Eyer
 {
@@ -55,6 +56,10 @@ namespace Eyer
         int SetTimebase(const EyerAVRational & timebase);
         int SetWH(int width, int height);
 
+        // 校验 preset/tune 是否被 codecId 对应的编码器支持, 空字符串表示使用编码器默认值
+        static bool IsPresetSupport(const EyerAVCodecID & codecId, const EyerString & preset);
+        static bool IsTuneSupport(const EyerAVCodecID & codecId, const EyerString & tune);
+
     public:
         EyerAVCodecID codecId = EyerAVCodecID::CODEC_ID_UNKNOW;
         int width = 0;
@@ -63,6 +68,20 @@ namespace Eyer
         int crf = 18;
         int threadnum = 4;
 
+        // 以下参数只对 H264/H265 生效, 0/-1/空字符串表示使用编码器默认值
+        EyerString preset = "";
+        EyerString tune = "";
+        EyerAVRateControl rateControl = EyerAVRateControl::CRF;
+        // 单位 kbps
+        int bitrate = 0;
+        int maxrate = 0;
+        int bufsize = 0;
+        int gop = 0;
+        int bframes = -1;
+
+        // ProRes profile: 0 proxy, 1 lt, 2 standard, 3 hq, -1 编码器默认
+        int proresProfile = -1;
+
         int sample_rate = 44100;
         EyerAVChannelLayout channelLayout;
         EyerAVSampleFormat sampleFormat;
@@ -0,0 +1,38 @@
+#include "EyerAVFileUtil.hpp"
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#define EyerAVFileUtil_Stat _stat64
+#define EyerAVFileUtil_StatStruct struct _stat64
+#else
+#define EyerAVFileUtil_Stat stat
+#define EyerAVFileUtil_StatStruct struct stat
+#endif
+
+namespace Eyer
+{
+    int EyerAVFileUtil::GetFileInfo(const EyerString & path, int64_t & size, int64_t & mtime)
+    {
+        EyerAVFileUtil_StatStruct st;
+        if(EyerAVFileUtil_Stat(path.c_str(), &st)){
+            size = -1;
+            mtime = -1;
+            return -1;
+        }
+        size = st.st_size;
+        mtime = st.st_mtime;
+        return 0;
+    }
+
+    int64_t EyerAVFileUtil::GetFileSize(const EyerString & path)
+    {
+        int64_t size = 0;
+        int64_t mtime = 0;
+        if(GetFileInfo(path, size, mtime)){
+            return 0;
+        }
+        return size;
+    }
+}
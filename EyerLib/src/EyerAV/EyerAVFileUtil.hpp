@@ -0,0 +1,21 @@
+#ifndef EYERLIB_EYERAVFILEUTIL_HPP
+#define EYERLIB_EYERAVFILEUTIL_HPP
+
+#include <stdint.h>
+#include "EyerCore/EyerCore.hpp"
+
+namespace Eyer
+{
+    // 本地文件的大小和修改时间
+    // Windows 上 stat 的 st_size 是 32 位, 使用 _stat64, 大于 2G 的文件也能拿到正确的值
+    class EyerAVFileUtil
+    {
+    public:
+        // 文件不存在时返回 -1, mtime 单位秒
+        static int GetFileInfo(const EyerString & path, int64_t & size, int64_t & mtime);
+        // 文件不存在时返回 0
+        static int64_t GetFileSize(const EyerString & path);
+    };
+}
+
+#endif //EYERLIB_EYERAVFILEUTIL_HPP
@@ -0,0 +1,132 @@
+#include "EyerAVFileWriterCustomIO.hpp"
+
+#ifdef _WIN32
+#define EyerAVFileWriterCustomIO_Seek _fseeki64
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#define EyerAVFileWriterCustomIO_Seek fseeko
+#endif
+
+namespace Eyer
+{
+    EyerAVFileWriterCustomIO::EyerAVFileWriterCustomIO(const EyerString & _path)
+    {
+        path = _path;
+    }
+
+    EyerAVFileWriterCustomIO::~EyerAVFileWriterCustomIO()
+    {
+        Close();
+    }
+
+    int EyerAVFileWriterCustomIO::Open(int64_t preallocateSize)
+    {
+        if(fp != nullptr){
+            return -1;
+        }
+        fp = fopen(path.c_str(), "wb");
+        if(fp == nullptr){
+            EyerLog("EyerAVFileWriterCustomIO Open Fail: %s\n", path.c_str());
+            return -1;
+        }
+        setvbuf(fp, nullptr, _IONBF, 0);
+
+        pos = 0;
+        size = 0;
+        isPreallocated = false;
+
+#if defined(__linux__)
+        if(preallocateSize > 0){
+            // 预分配失败 (文件系统不支持, 空间不足) 不影响写入
+            int ret = posix_fallocate(fileno(fp), 0, preallocateSize);
+            if(ret == 0){
+                isPreallocated = true;
+            }
+            else{
+                EyerLog("EyerAVFileWriterCustomIO Preallocate Fail: %s, size: %lld\n", path.c_str(), (long long)preallocateSize);
+            }
+        }
+#endif
+        return 0;
+    }
+
+    int EyerAVFileWriterCustomIO::Close()
+    {
+        if(fp == nullptr){
+            return 0;
+        }
+        int ret = 0;
+        if(fflush(fp)){
+            ret = -1;
+        }
+#if !defined(_WIN32)
+        if(isPreallocated){
+            if(ftruncate(fileno(fp), size)){
+                ret = -1;
+            }
+        }
+#endif
+        if(fclose(fp)){
+            ret = -1;
+        }
+        fp = nullptr;
+        return ret;
+    }
+
+    int EyerAVFileWriterCustomIO::Write(const uint8_t * buf, int buf_size)
+    {
+        if(fp == nullptr || buf == nullptr || buf_size < 0){
+            return -1;
+        }
+        size_t len = fwrite(buf, 1, buf_size, fp);
+        if(len != (size_t)buf_size){
+            return -1;
+        }
+        pos += buf_size;
+        if(pos > size){
+            size = pos;
+        }
+        return buf_size;
+    }
+
+    int64_t EyerAVFileWriterCustomIO::Seek(int64_t offset, int whence)
+    {
+        if(fp == nullptr){
+            return -1;
+        }
+        whence &= ~SEEK_FORCE;
+        if(whence == SEEK_SIZE){
+            return size;
+        }
+
+        int64_t target = 0;
+        if(whence == SEEK_SET){
+            target = offset;
+        }
+        else if(whence == SEEK_CUR){
+            target = pos + offset;
+        }
+        else if(whence == SEEK_END){
+            // 预分配后文件末尾不是写入的末尾
+            target = size + offset;
+        }
+        else{
+            return -1;
+        }
+
+        if(target < 0){
+            return -1;
+        }
+        if(EyerAVFileWriterCustomIO_Seek(fp, target, SEEK_SET)){
+            return -1;
+        }
+        pos = target;
+        return pos;
+    }
+
+    int64_t EyerAVFileWriterCustomIO::GetSize() const
+    {
+        return size;
+    }
+}
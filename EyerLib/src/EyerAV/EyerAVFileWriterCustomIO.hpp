@@ -0,0 +1,42 @@
+#ifndef EYERLIB_EYERAVFILEWRITERCUSTOMIO_HPP
+#define EYERLIB_EYERAVFILEWRITERCUSTOMIO_HPP
+
+#include <stdio.h>
+
+#include "EyerCore/EyerCore.hpp"
+#include "EyerAVWriterCustomIO.hpp"
+
+namespace Eyer
+{
+    // 写到本地文件的输出, EyerAVWriter 设置了大缓冲区或预分配时内部使用
+    // 数据已经由 AVIOContext 缓冲, 这里关闭 stdio 缓冲, 避免再复制一次
+    class EyerAVFileWriterCustomIO : public EyerAVWriterCustomIO
+    {
+    public:
+        EyerAVFileWriterCustomIO(const EyerString & path);
+        virtual ~EyerAVFileWriterCustomIO();
+
+        // preallocateSize > 0 时预先分配磁盘空间, 减少写入时的扩展和碎片, 目前只在 Linux 上生效
+        int Open(int64_t preallocateSize = 0);
+        // 预分配过的文件截断到实际写入的大小
+        int Close();
+
+        virtual int Write(const uint8_t * buf, int buf_size) override;
+        virtual int64_t Seek(int64_t offset, int whence) override;
+
+        int64_t GetSize() const;
+
+    private:
+        EyerAVFileWriterCustomIO(const EyerAVFileWriterCustomIO & io) = delete;
+        EyerAVFileWriterCustomIO & operator = (const EyerAVFileWriterCustomIO & io) = delete;
+
+        EyerString path;
+        FILE * fp = nullptr;
+        int64_t pos = 0;
+        // 实际写入的最大偏移, 预分配后文件本身的大小不能代表写入的大小
+        int64_t size = 0;
+        bool isPreallocated = false;
+    };
+}
+
+#endif //EYERLIB_EYERAVFILEWRITERCUSTOMIO_HPP
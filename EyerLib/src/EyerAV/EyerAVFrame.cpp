@@ -4,19 +4,32 @@
 
 #include "EyerAVFramePrivate.hpp"
 #include "EyerAVPixelFormat.hpp"
+#include "EyerAVScaler.hpp"
 
 #include <string.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <utility>
 
 #include "EyerAVFrame_CVPixelBuffer.h"
 
 namespace Eyer
 {
+    // 复制格式参数和属性, 不涉及数据
+    static void EyerAVFrame_CopyParams(AVFrame * dst, const AVFrame * src)
+    {
+        dst->format         = src->format;
+        dst->width          = src->width;
+        dst->height         = src->height;
+        dst->channels       = src->channels;
+        dst->channel_layout = src->channel_layout;
+        dst->nb_samples     = src->nb_samples;
+        av_frame_copy_props(dst, src);
+    }
+
     EyerAVFrame::EyerAVFrame()
     {
-        piml = new EyerAVFramePrivate();
-        piml->frame = av_frame_alloc();
+        CreatePrivate();
     }
 
     EyerAVFrame::EyerAVFrame(void * _cvPixelBuffer)
@@ -33,6 +46,17 @@ namespace Eyer
         *this = frame;
     }
 
+    EyerAVFrame::EyerAVFrame(EyerAVFrame && frame) noexcept
+    {
+        // 不分配内存, 被移动的帧下次用到时再创建空的私有数据
+        piml = frame.piml;
+        frame.piml = nullptr;
+#ifdef EYER_PLATFORM_DARWIN
+        cvPixelBuffer = frame.cvPixelBuffer;
+        frame.cvPixelBuffer = nullptr;
+#endif
+    }
+
     EyerAVFrame::~EyerAVFrame()
     {
 #ifdef EYER_PLATFORM_DARWIN
@@ -42,17 +66,26 @@ namespace Eyer
         }
 #endif
 
-        av_frame_unref(piml->frame);
-        av_frame_free(&piml->frame);
-
         if(piml != nullptr){
+            av_frame_unref(piml->frame);
+            av_frame_free(&piml->frame);
+
             delete piml;
             piml = nullptr;
         }
     }
 
+    void EyerAVFrame::CreatePrivate() const
+    {
+        piml = new EyerAVFramePrivate();
+        piml->frame = av_frame_alloc();
+    }
+
     EyerAVFrame & EyerAVFrame::operator = (const EyerAVFrame & frame)
     {
+        if(this == &frame){
+            return *this;
+        }
 #ifdef EYER_PLATFORM_DARWIN
         if(cvPixelBuffer != nullptr){
             freeCVPixelBuffer(cvPixelBuffer);
@@ -62,94 +95,167 @@ namespace Eyer
             cvPixelBuffer = copyCVPixelBuffer(frame.cvPixelBuffer);
         }
 #endif
-        av_frame_unref(piml->frame);
+        av_frame_unref(GetPrivate()->frame);
 
-        piml->secPTS = frame.piml->secPTS;
-        piml->LAST_FRAME_FLAG = frame.piml->LAST_FRAME_FLAG;
-        piml->angle = frame.piml->angle;
-        av_frame_copy_props(piml->frame, frame.piml->frame);
-        av_frame_copy(piml->frame, frame.piml->frame);
-        av_frame_ref(piml->frame, frame.piml->frame);
+        GetPrivate()->secPTS = frame.GetPrivate()->secPTS;
+        GetPrivate()->LAST_FRAME_FLAG = frame.GetPrivate()->LAST_FRAME_FLAG;
+        GetPrivate()->angle = frame.GetPrivate()->angle;
 
+        AVFrame * src = frame.GetPrivate()->frame;
+        if(src->buf[0] != nullptr || src->data[0] != nullptr){
+            // 有引用计数的数据只增加引用, 没有引用计数的数据 av_frame_ref 会复制一份
+            av_frame_ref(GetPrivate()->frame, src);
+        }
+        else {
+            // 没有数据, 只复制参数
+            EyerAVFrame_CopyParams(GetPrivate()->frame, src);
+        }
+
+        return *this;
+    }
+
+    EyerAVFrame & EyerAVFrame::operator = (EyerAVFrame && frame) noexcept
+    {
+        // 交换, 原来的数据随被移动的帧一起释放
+        std::swap(piml, frame.piml);
+#ifdef EYER_PLATFORM_DARWIN
+        std::swap(cvPixelBuffer, frame.cvPixelBuffer);
+#endif
         return *this;
     }
 
+    int EyerAVFrame::DeepCopy(EyerAVFrame & dstFrame) const
+    {
+        if(this == &dstFrame){
+            return 0;
+        }
+
+#ifdef EYER_PLATFORM_DARWIN
+        if(dstFrame.cvPixelBuffer != nullptr){
+            freeCVPixelBuffer(dstFrame.cvPixelBuffer);
+            dstFrame.cvPixelBuffer = nullptr;
+        }
+        if(cvPixelBuffer != nullptr){
+            dstFrame.cvPixelBuffer = copyCVPixelBuffer(cvPixelBuffer);
+        }
+#endif
+
+        AVFrame * src = GetPrivate()->frame;
+        AVFrame * dst = dstFrame.GetPrivate()->frame;
+        av_frame_unref(dst);
+
+        dstFrame.GetPrivate()->secPTS = GetPrivate()->secPTS;
+        dstFrame.GetPrivate()->LAST_FRAME_FLAG = GetPrivate()->LAST_FRAME_FLAG;
+        dstFrame.GetPrivate()->angle = GetPrivate()->angle;
+
+        EyerAVFrame_CopyParams(dst, src);
+        if(src->data[0] == nullptr){
+            return 0;
+        }
+
+        int ret = av_frame_get_buffer(dst, 32);
+        if(ret){
+            return -1;
+        }
+        ret = av_frame_copy(dst, src);
+        if(ret){
+            return -1;
+        }
+        return 0;
+    }
+
+    bool EyerAVFrame::IsWritable() const
+    {
+        return av_frame_is_writable(GetPrivate()->frame) != 0;
+    }
+
+    int EyerAVFrame::MakeWritable()
+    {
+        if(GetPrivate()->frame->data[0] == nullptr){
+            return 0;
+        }
+        if(av_frame_make_writable(GetPrivate()->frame)){
+            return -1;
+        }
+        return 0;
+    }
+
     int EyerAVFrame::SetPTS(int64_t pts)
     {
-        piml->frame->pts = pts;
+        GetPrivate()->frame->pts = pts;
         return 0;
     }
 
     int64_t EyerAVFrame::GetPTS()
     {
-        return piml->frame->pts;
+        return GetPrivate()->frame->pts;
     }
 
     double EyerAVFrame::GetSecPTS()
     {
-        return piml->secPTS;
+        return GetPrivate()->secPTS;
     }
 
     int EyerAVFrame::SetSecPTS(double pts)
     {
-        piml->secPTS = pts;
+        GetPrivate()->secPTS = pts;
         return 0;
     }
 
     const int EyerAVFrame::GetWidth() const
     {
-        return piml->frame->width;
+        return GetPrivate()->frame->width;
     }
 
     const int EyerAVFrame::GetHeight() const
     {
-        return piml->frame->height;
+        return GetPrivate()->frame->height;
     }
 
     int EyerAVFrame::SetWidth(int width)
     {
-        piml->frame->width = width;
+        GetPrivate()->frame->width = width;
         return 0;
     }
 
     int EyerAVFrame::SetHeight(int height)
     {
-        piml->frame->height = height;
+        GetPrivate()->frame->height = height;
         return 0;
     }
 
     int EyerAVFrame::SetPixelFormat(const EyerAVPixelFormat & pixelFormat)
     {
-        piml->frame->format = pixelFormat.GetFFmpegId();
+        GetPrivate()->frame->format = pixelFormat.GetFFmpegId();
         return 0;
     }
     int EyerAVFrame::SetLinesize(int index, int linesize)
     {
-        piml->frame->linesize[index] = linesize;
+        GetPrivate()->frame->linesize[index] = linesize;
         return 0;
     }
 
     int EyerAVFrame::GetBuffer(int align)
     {
-        av_frame_get_buffer(piml->frame, align);
+        av_frame_get_buffer(GetPrivate()->frame, align);
         return 0;
     }
 
     int EyerAVFrame::SetVideoData420P(unsigned char * _y, unsigned char * _u, unsigned char * _v, int _width, int _height)
     {
-        piml->frame->format = AVPixelFormat::AV_PIX_FMT_YUV420P;
-        piml->frame->width = _width;
-        piml->frame->height = _height;
-        piml->frame->extended_data = piml->frame->data;
+        GetPrivate()->frame->format = AVPixelFormat::AV_PIX_FMT_YUV420P;
+        GetPrivate()->frame->width = _width;
+        GetPrivate()->frame->height = _height;
+        GetPrivate()->frame->extended_data = GetPrivate()->frame->data;
 
-        av_frame_get_buffer(piml->frame, 16);
+        av_frame_get_buffer(GetPrivate()->frame, 16);
         for(int i=0; i<_height; i++){
-            memcpy(piml->frame->data[0] + piml->frame->linesize[0] * i, _y + _width * i, _width);
+            memcpy(GetPrivate()->frame->data[0] + GetPrivate()->frame->linesize[0] * i, _y + _width * i, _width);
         }
 
         for(int i=0; i<_height / 2; i++){
-            memcpy(piml->frame->data[1] + piml->frame->linesize[1] * i, _u + _width / 2 * i, _width / 2);
-            memcpy(piml->frame->data[2] + piml->frame->linesize[2] * i, _v + _width / 2 * i, _width / 2);
+            memcpy(GetPrivate()->frame->data[1] + GetPrivate()->frame->linesize[1] * i, _u + _width / 2 * i, _width / 2);
+            memcpy(GetPrivate()->frame->data[2] + GetPrivate()->frame->linesize[2] * i, _v + _width / 2 * i, _width / 2);
         }
 
         return 0;
@@ -161,19 +267,19 @@ namespace Eyer
             frame = *this;
             return -1;
         }
-        frame.piml->frame->width    = piml->frame->width;
-        frame.piml->frame->height   = piml->frame->height;
-        frame.piml->frame->format   = piml->frame->format;
-        av_frame_get_buffer(frame.piml->frame, 1);
+        frame.GetPrivate()->frame->width    = GetPrivate()->frame->width;
+        frame.GetPrivate()->frame->height   = GetPrivate()->frame->height;
+        frame.GetPrivate()->frame->format   = GetPrivate()->frame->format;
+        av_frame_get_buffer(frame.GetPrivate()->frame, 1);
 
-        int height = piml->frame->height;
-        int width = piml->frame->width;
+        int height = GetPrivate()->frame->height;
+        int width = GetPrivate()->frame->width;
 
         if(type == 1){
             // 横向
             for(int i=0;i<height;i++){
-                uint8_t * dist = frame.piml->frame->data[0] + frame.piml->frame->linesize[0] * i;
-                uint8_t * src  = piml->frame->data[0] + piml->frame->linesize[0] * i;
+                uint8_t * dist = frame.GetPrivate()->frame->data[0] + frame.GetPrivate()->frame->linesize[0] * i;
+                uint8_t * src  = GetPrivate()->frame->data[0] + GetPrivate()->frame->linesize[0] * i;
 
                 for(int j=0;j<width;j++){
                     memcpy(dist + (width - j) * 4, src + j * 4, 4);
@@ -182,15 +288,15 @@ namespace Eyer
         }
         else if(type == 2){
             for(int i=0;i<height;i++){
-                uint8_t * dist = frame.piml->frame->data[0] + frame.piml->frame->linesize[0] * i;
-                uint8_t * src  = piml->frame->data[0] + piml->frame->linesize[0] * (height - 1 - i);
+                uint8_t * dist = frame.GetPrivate()->frame->data[0] + frame.GetPrivate()->frame->linesize[0] * i;
+                uint8_t * src  = GetPrivate()->frame->data[0] + GetPrivate()->frame->linesize[0] * (height - 1 - i);
                 memcpy(dist, src, width * 4);
             }
         }
         else {
             for(int i=0;i<height;i++){
-                uint8_t * dist = frame.piml->frame->data[0] + frame.piml->frame->linesize[0] * i;
-                uint8_t * src  = piml->frame->data[0] + piml->frame->linesize[0] * i;
+                uint8_t * dist = frame.GetPrivate()->frame->data[0] + frame.GetPrivate()->frame->linesize[0] * i;
+                uint8_t * src  = GetPrivate()->frame->data[0] + GetPrivate()->frame->linesize[0] * i;
                 memcpy(dist, src, width * 4);
             }
         }
@@ -199,77 +305,77 @@ namespace Eyer
 
     int EyerAVFrame::SetAudioDataFLTP(uint8_t * data, int & offset)
     {
-        piml->frame->channel_layout = AV_CH_LAYOUT_STEREO;
-        piml->frame->channels = av_get_channel_layout_nb_channels(piml->frame->channel_layout);
-        piml->frame->sample_rate = 44100;
-        piml->frame->nb_samples = 1152;
-        piml->frame->format = AVSampleFormat::AV_SAMPLE_FMT_FLTP;
+        GetPrivate()->frame->channel_layout = AV_CH_LAYOUT_STEREO;
+        GetPrivate()->frame->channels = av_get_channel_layout_nb_channels(GetPrivate()->frame->channel_layout);
+        GetPrivate()->frame->sample_rate = 44100;
+        GetPrivate()->frame->nb_samples = 1152;
+        GetPrivate()->frame->format = AVSampleFormat::AV_SAMPLE_FMT_FLTP;
 
         // int num_bytes = av_get_bytes_per_sample(AVSampleFormat::AV_SAMPLE_FMT_FLTP);
-        // EyerLog("channels: %d\n", piml->frame->channels);
+        // EyerLog("channels: %d\n", GetPrivate()->frame->channels);
 
-        av_frame_get_buffer(piml->frame, 16);
+        av_frame_get_buffer(GetPrivate()->frame, 16);
 
-        int nb_samples = piml->frame->nb_samples;
+        int nb_samples = GetPrivate()->frame->nb_samples;
         float * a = (float *)malloc(nb_samples * sizeof(float));
         for(int i=0;i<nb_samples;i++){
             a[i] = sin(i * (1.0 / nb_samples) * 2 * 3.1415926 * 8);
         }
 
-        memcpy(piml->frame->data[0], a, nb_samples * sizeof(float));
-        memcpy(piml->frame->data[1], a, nb_samples * sizeof(float));
-        // memset(piml->frame->data[0], 0, piml->frame->linesize[0]);
-        // memset(piml->frame->data[1], 0, piml->frame->linesize[0]);
+        memcpy(GetPrivate()->frame->data[0], a, nb_samples * sizeof(float));
+        memcpy(GetPrivate()->frame->data[1], a, nb_samples * sizeof(float));
+        // memset(GetPrivate()->frame->data[0], 0, GetPrivate()->frame->linesize[0]);
+        // memset(GetPrivate()->frame->data[1], 0, GetPrivate()->frame->linesize[0]);
 
         free(a);
 
-        piml->frame->pts = offset;
-        offset += piml->frame->nb_samples;
-        // EyerLog("PTS: %d\n", piml->frame->pts);
+        GetPrivate()->frame->pts = offset;
+        offset += GetPrivate()->frame->nb_samples;
+        // EyerLog("PTS: %d\n", GetPrivate()->frame->pts);
 
-        // memcpy(piml->frame->data[0], data, );
+        // memcpy(GetPrivate()->frame->data[0], data, );
 
         return 0;
     }
 
     int EyerAVFrame::SetAudioDataS16_44100_2_1024 (uint8_t * data)
     {
-        piml->frame->format         = AVSampleFormat::AV_SAMPLE_FMT_S16;
-        piml->frame->sample_rate    = 44100;
-        piml->frame->channels       = 2;
-        piml->frame->nb_samples     = 1024;
-        piml->frame->channel_layout = av_get_default_channel_layout(piml->frame->channels);
+        GetPrivate()->frame->format         = AVSampleFormat::AV_SAMPLE_FMT_S16;
+        GetPrivate()->frame->sample_rate    = 44100;
+        GetPrivate()->frame->channels       = 2;
+        GetPrivate()->frame->nb_samples     = 1024;
+        GetPrivate()->frame->channel_layout = av_get_default_channel_layout(GetPrivate()->frame->channels);
 
-        av_frame_get_buffer(piml->frame, 16);
+        av_frame_get_buffer(GetPrivate()->frame, 16);
 
-        // memset(piml->frame->data[0], 0, piml->frame->linesize[0]);
-        memcpy(piml->frame->data[0], data, 2 * 2 * 1024);
+        // memset(GetPrivate()->frame->data[0], 0, GetPrivate()->frame->linesize[0]);
+        memcpy(GetPrivate()->frame->data[0], data, 2 * 2 * 1024);
 
         return 0;
     }
 
     int EyerAVFrame::InitVideoData(EyerAVPixelFormat pixelFormat, int width, int height)
     {
-        piml->frame->format         = (AVPixelFormat)pixelFormat.GetFFmpegId();
-        piml->frame->width          = width;
-        piml->frame->height         = height;
-        av_frame_get_buffer(piml->frame, 1);
+        GetPrivate()->frame->format         = (AVPixelFormat)pixelFormat.GetFFmpegId();
+        GetPrivate()->frame->width          = width;
+        GetPrivate()->frame->height         = height;
+        av_frame_get_buffer(GetPrivate()->frame, 1);
 
         return 0;
     }
 
     int EyerAVFrame::InitAudioData(EyerAVChannelLayout channelLayout, EyerAVSampleFormat sampleFormat, int sample_rate, int nb_samples)
     {
-        piml->frame->format         = (AVSampleFormat)sampleFormat.ffmpegId;
-        piml->frame->sample_rate    = sample_rate;
-        piml->frame->channel_layout = channelLayout.GetFFmpegId();
-        piml->frame->channels       = av_get_channel_layout_nb_channels(piml->frame->channel_layout);
-        piml->frame->nb_samples     = nb_samples;
+        GetPrivate()->frame->format         = (AVSampleFormat)sampleFormat.ffmpegId;
+        GetPrivate()->frame->sample_rate    = sample_rate;
+        GetPrivate()->frame->channel_layout = channelLayout.GetFFmpegId();
+        GetPrivate()->frame->channels       = av_get_channel_layout_nb_channels(GetPrivate()->frame->channel_layout);
+        GetPrivate()->frame->nb_samples     = nb_samples;
 
-        av_frame_get_buffer(piml->frame, 16);
+        av_frame_get_buffer(GetPrivate()->frame, 16);
 
         for(int i=0;i<8;i++){
-            memset(piml->frame->data[i], 0, piml->frame->linesize[i]);
+            memset(GetPrivate()->frame->data[i], 0, GetPrivate()->frame->linesize[i]);
         }
 
         return 0;
@@ -277,24 +383,24 @@ namespace Eyer
 
     int EyerAVFrame::Resample(EyerAVFrame & dstFrame, EyerAVChannelLayout channelLayout, EyerAVSampleFormat sampleFormat, int sample_rate)
     {
-        av_frame_copy_props(dstFrame.piml->frame, piml->frame);
+        av_frame_copy_props(dstFrame.GetPrivate()->frame, GetPrivate()->frame);
 
-        dstFrame.piml->frame->channel_layout    = channelLayout.GetFFmpegId();
-        dstFrame.piml->frame->channels          = av_get_channel_layout_nb_channels(dstFrame.piml->frame->channel_layout);
-        dstFrame.piml->frame->sample_rate       = sample_rate;
-        dstFrame.piml->frame->format            = sampleFormat.ffmpegId;
+        dstFrame.GetPrivate()->frame->channel_layout    = channelLayout.GetFFmpegId();
+        dstFrame.GetPrivate()->frame->channels          = av_get_channel_layout_nb_channels(dstFrame.GetPrivate()->frame->channel_layout);
+        dstFrame.GetPrivate()->frame->sample_rate       = sample_rate;
+        dstFrame.GetPrivate()->frame->format            = sampleFormat.ffmpegId;
 
-        av_frame_get_buffer(dstFrame.piml->frame, 1);
+        av_frame_get_buffer(dstFrame.GetPrivate()->frame, 1);
 
         SwrContext * swrCtx = swr_alloc_set_opts(
                 NULL,
-                dstFrame.piml->frame->channel_layout,
-                (AVSampleFormat)dstFrame.piml->frame->format,
-                dstFrame.piml->frame->sample_rate,
+                dstFrame.GetPrivate()->frame->channel_layout,
+                (AVSampleFormat)dstFrame.GetPrivate()->frame->format,
+                dstFrame.GetPrivate()->frame->sample_rate,
 
-                piml->frame->channel_layout,
-                (AVSampleFormat)piml->frame->format,
-                piml->frame->sample_rate,
+                GetPrivate()->frame->channel_layout,
+                (AVSampleFormat)GetPrivate()->frame->format,
+                GetPrivate()->frame->sample_rate,
 
                 0,
                 NULL
@@ -302,7 +408,7 @@ namespace Eyer
 
         swr_init(swrCtx);
 
-        int ret = swr_convert_frame(swrCtx, dstFrame.piml->frame, piml->frame);
+        int ret = swr_convert_frame(swrCtx, dstFrame.GetPrivate()->frame, GetPrivate()->frame);
 
         swr_free(&swrCtx);
 
@@ -316,179 +422,103 @@ namespace Eyer
 
     int EyerAVFrame::Scale(EyerAVFrame & dstFrame, const int dstW, const int dstH) const
     {
-        AVPixelFormat distFormat = (AVPixelFormat)piml->frame->format;
-
-        av_frame_copy_props(dstFrame.piml->frame, piml->frame);
-
-        dstFrame.piml->frame->pict_type = AVPictureType::AV_PICTURE_TYPE_NONE;
-
-        dstFrame.piml->frame->format    = distFormat;
-        dstFrame.piml->frame->width     = dstW;
-        dstFrame.piml->frame->height    = dstH;
-
-        dstFrame.piml->secPTS           = piml->secPTS;
-
-        // uint8_t
-        av_frame_get_buffer(dstFrame.piml->frame, 1);
-
-        int srcW = GetWidth();
-        int srcH = GetHeight();
-        AVPixelFormat srcFormat = (AVPixelFormat)(piml->frame->format);
-
-        SwsContext * swsContext = sws_getContext(srcW, srcH, srcFormat, dstW, dstH, distFormat, SWS_SINC, NULL, NULL, NULL);
-
-        if(swsContext == nullptr){
-            return -1;
-        }
-
-        sws_scale(
-                swsContext,
-                piml->frame->data,
-                piml->frame->linesize,
-                0,
-                srcH,
-
-                dstFrame.piml->frame->data,
-                dstFrame.piml->frame->linesize
-        );
-
-        sws_freeContext(swsContext);
-
-        return 0;
+        EyerAVScaler scaler;
+        return scaler.Scale(*this, dstFrame, dstW, dstH);
     }
 
     int EyerAVFrame::Scale(EyerAVFrame & dstFrame, const EyerAVPixelFormat distformat, int dstW, int dstH) const
     {
-        EyerAVPixelFormat format = distformat;
-        if(distformat == EyerAVPixelFormat::EYER_KEEP_SAME){
-            format = GetPixelFormat();
-        }
-        if(dstW <= 0){
-            dstW = GetWidth();
-        }
-        if(dstH <= 0){
-            dstH = GetHeight();
-        }
-
-        if(format == GetPixelFormat() && dstW == GetWidth() && dstH == GetHeight()){
-            dstFrame = *this;
-            return 0;
-        }
-
-        AVPixelFormat distFormat = (AVPixelFormat)format.GetFFmpegId();
-
-        av_frame_copy_props(dstFrame.piml->frame, piml->frame);
-
-        dstFrame.piml->frame->pict_type = AVPictureType::AV_PICTURE_TYPE_NONE;
-
-        dstFrame.piml->frame->format    = distFormat;
-        dstFrame.piml->frame->width     = dstW;
-        dstFrame.piml->frame->height    = dstH;
-
-        dstFrame.piml->secPTS           = piml->secPTS;
-
-        // uint8_t
-        av_frame_get_buffer(dstFrame.piml->frame, 1);
-
-        int srcW = GetWidth();
-        int srcH = GetHeight();
-        AVPixelFormat srcFormat = (AVPixelFormat)(piml->frame->format);
-
-        SwsContext * swsContext = sws_getContext(srcW, srcH, srcFormat, dstW, dstH, distFormat, SWS_SINC, NULL, NULL, NULL);
-
-        if(swsContext == nullptr){
-            return -1;
-        }
-
-        sws_scale(
-                swsContext,
-                piml->frame->data,
-                piml->frame->linesize,
-                0,
-                srcH,
-
-                dstFrame.piml->frame->data,
-                dstFrame.piml->frame->linesize
-        );
-
-        sws_freeContext(swsContext);
-
-        return 0;
+        EyerAVScaler scaler;
+        return scaler.Scale(*this, dstFrame, distformat, dstW, dstH);
     }
 
     uint8_t * EyerAVFrame::GetData(int index) const
     {
-        return piml->frame->data[index];
+        return GetPrivate()->frame->data[index];
     }
 
     const int EyerAVFrame::GetLinesize(int index) const
     {
-        return piml->frame->linesize[index];
+        return GetPrivate()->frame->linesize[index];
+    }
+
+    int64_t EyerAVFrame::GetBufferSize() const
+    {
+        int64_t size = 0;
+        for(int i = 0; i < AV_NUM_DATA_POINTERS; i++){
+            if(GetPrivate()->frame->buf[i] != nullptr){
+                size += GetPrivate()->frame->buf[i]->size;
+            }
+        }
+        for(int i = 0; i < GetPrivate()->frame->nb_extended_buf; i++){
+            size += GetPrivate()->frame->extended_buf[i]->size;
+        }
+        return size;
     }
 
     int EyerAVFrame::GetSampleRate()
     {
-        return piml->frame->sample_rate;
+        return GetPrivate()->frame->sample_rate;
     }
 
     const EyerAVPixelFormat EyerAVFrame::GetPixelFormat() const
     {
-        return EyerAVPixelFormat::GetByFFmpegId(piml->frame->format);
+        return EyerAVPixelFormat::GetByFFmpegId(GetPrivate()->frame->format);
     }
 
     EyerAVChannelLayout EyerAVFrame::GetChannelLayout()
     {
-        return EyerAVChannelLayout::GetByFFmpegId(piml->frame->channel_layout);
+        return EyerAVChannelLayout::GetByFFmpegId(GetPrivate()->frame->channel_layout);
     }
 
     EyerAVSampleFormat EyerAVFrame::GetSampleFormat()
     {
-        return EyerAVSampleFormat::GetByFFmpegId(piml->frame->format);
+        return EyerAVSampleFormat::GetByFFmpegId(GetPrivate()->frame->format);
     }
 
     int EyerAVFrame::GetSampleNB()
     {
-        return piml->frame->nb_samples;
+        return GetPrivate()->frame->nb_samples;
     }
 
     int EyerAVFrame::SetSampleRate(int sampleRate)
     {
-        piml->frame->sample_rate = sampleRate;
+        GetPrivate()->frame->sample_rate = sampleRate;
         return 0;
     }
 
     int EyerAVFrame::SetChannelLayout(EyerAVChannelLayout channelLayout)
     {
-        piml->frame->channel_layout = channelLayout.GetFFmpegId();
-        piml->frame->channels = av_get_channel_layout_nb_channels(piml->frame->channel_layout);
+        GetPrivate()->frame->channel_layout = channelLayout.GetFFmpegId();
+        GetPrivate()->frame->channels = av_get_channel_layout_nb_channels(GetPrivate()->frame->channel_layout);
         return 0;
     }
 
     int EyerAVFrame::SetSampleFormat(EyerAVSampleFormat sampleFormat)
     {
-        piml->frame->format = sampleFormat.ffmpegId;
+        GetPrivate()->frame->format = sampleFormat.ffmpegId;
         return 0;
     }
 
     int EyerAVFrame::SetSampleNB(int sampleNB)
     {
-        piml->frame->nb_samples = sampleNB;
+        GetPrivate()->frame->nb_samples = sampleNB;
         return 0;
     }
 
     bool EyerAVFrame::GetLastFrameFlag()
     {
-        return piml->LAST_FRAME_FLAG;
+        return GetPrivate()->LAST_FRAME_FLAG;
     }
 
     int EyerAVFrame::SetLastFrameFlag(bool flag)
     {
-        piml->LAST_FRAME_FLAG = flag;
+        GetPrivate()->LAST_FRAME_FLAG = flag;
         return 0;
     }
 
     const int EyerAVFrame::GetAngle() const
     {
-        return piml->angle;
+        return GetPrivate()->angle;
     }
 }
\ No newline at end of file
@@ -10,15 +10,28 @@ namespace Eyer
 {
     class EyerAVFramePrivate;
 
+    // 拷贝和赋值是浅拷贝, 只增加数据的引用计数, 两个帧共享同一份数据
+    // 需要独立修改数据时用 DeepCopy 或 MakeWritable
     class EyerAVFrame
     {
     public:
         EyerAVFrame();
         EyerAVFrame(void * cvPixelBuffer);
         EyerAVFrame(const EyerAVFrame & frame);
+        // 不分配内存, 移动之后 frame 是空帧
+        EyerAVFrame(EyerAVFrame && frame) noexcept;
         ~EyerAVFrame();
 
         EyerAVFrame & operator = (const EyerAVFrame & frame);
+        // 和 frame 交换内容
+        EyerAVFrame & operator = (EyerAVFrame && frame) noexcept;
+
+        // 把数据复制一份到 dstFrame, 不和当前帧共享
+        int DeepCopy(EyerAVFrame & dstFrame) const;
+        // 数据没有被其他帧引用时返回 true
+        bool IsWritable() const;
+        // 数据被共享时复制一份, 之后可以直接修改
+        int MakeWritable();
 
         int SetPTS(int64_t pts);
         int64_t GetPTS();
@@ -55,6 +68,8 @@ namespace Eyer
         uint8_t * GetData(int index = 0) const;
         int SetLinesize(int index, int linesize);
         const int GetLinesize(int index = 0) const;
+        // 帧数据占用的字节数, 共享的数据也按完整大小计算
+        int64_t GetBufferSize() const;
 
         const EyerAVPixelFormat GetPixelFormat() const;
 
@@ -73,8 +88,21 @@ namespace Eyer
 
         const int GetAngle() const;
 
+        // 移动构造之后 piml 为空, 第一次用到时再创建
+        EyerAVFramePrivate * GetPrivate() const
+        {
+            if(piml == nullptr){
+                CreatePrivate();
+            }
+            return piml;
+        }
+
+    private:
+        void CreatePrivate() const;
+
     public:
-        EyerAVFramePrivate * piml = nullptr;
+        // 可能为空, 通过 GetPrivate 访问
+        mutable EyerAVFramePrivate * piml = nullptr;
 
 #ifdef EYER_PLATFORM_DARWIN
         void * cvPixelBuffer = nullptr;
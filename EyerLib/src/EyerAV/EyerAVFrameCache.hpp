@@ -0,0 +1,208 @@
+#ifndef EYERLIB_EYERAVFRAMECACHE_HPP
+#define EYERLIB_EYERAVFRAMECACHE_HPP
+
+#include <stdint.h>
+#include <vector>
+#include <utility>
+
+namespace Eyer
+{
+    // 解码线的帧缓存, 按 PTS 从小到大排列的环形缓冲区
+    // 查找是二分, 从头部淘汰是 O(1); 解码输出的 PTS 偶尔乱序时插入到正确位置
+    // 只负责排序和计数, 帧的释放由调用者处理; 不加锁, 多线程访问由调用者保护
+    // T 是 EyerAVFrame * 或者 std::shared_ptr<EyerAVFrame>
+    template<typename T>
+    class EyerAVFrameCache
+    {
+    public:
+        // maxBytes 为 0 时不限制字节数
+        EyerAVFrameCache(int _maxFrame = 5, int64_t _maxBytes = 0)
+        {
+            SetLimit(_maxFrame, _maxBytes);
+        }
+
+        ~EyerAVFrameCache()
+        {
+
+        }
+
+        int SetLimit(int _maxFrame, int64_t _maxBytes = 0)
+        {
+            maxFrame = _maxFrame;
+            if(maxFrame <= 0){
+                maxFrame = 1;
+            }
+            maxBytes = _maxBytes;
+            return 0;
+        }
+
+        int Size() const
+        {
+            return count;
+        }
+
+        int64_t GetBytes() const
+        {
+            return bytes;
+        }
+
+        // 帧数或者字节数超过上限
+        bool IsOverLimit() const
+        {
+            if(count > maxFrame){
+                return true;
+            }
+            if(maxBytes > 0 && bytes > maxBytes){
+                return true;
+            }
+            return false;
+        }
+
+        // 帧数达到上限, 再放一帧就要淘汰
+        bool IsFull() const
+        {
+            if(count >= maxFrame){
+                return true;
+            }
+            if(maxBytes > 0 && bytes >= maxBytes){
+                return true;
+            }
+            return false;
+        }
+
+        int Push(const T & frame)
+        {
+            if(count >= (int)ring.size()){
+                Grow();
+            }
+
+            double pts = (*frame).GetSecPTS();
+            int64_t frameBytes = (*frame).GetBufferSize();
+
+            // 通常按顺序到达, 直接放在尾部
+            int pos = count;
+            if(count > 0 && pts < ring[Index(count - 1)].pts){
+                pos = UpperBound(pts);
+            }
+
+            // 往短的一边挪
+            if(pos < count / 2){
+                head = (head - 1) & (int)(ring.size() - 1);
+                for(int i = 0; i < pos; i++){
+                    ring[Index(i)] = std::move(ring[Index(i + 1)]);
+                }
+            }
+            else{
+                for(int i = count; i > pos; i--){
+                    ring[Index(i)] = std::move(ring[Index(i - 1)]);
+                }
+            }
+
+            Item & item = ring[Index(pos)];
+            item.frame = frame;
+            item.pts = pts;
+            item.bytes = frameBytes;
+
+            count++;
+            bytes += frameBytes;
+            return 0;
+        }
+
+        int PopFront(T & frame)
+        {
+            if(count <= 0){
+                return -1;
+            }
+            Item & item = ring[head];
+            frame = std::move(item.frame);
+            item.frame = T();
+            bytes -= item.bytes;
+
+            head = (head + 1) & (int)(ring.size() - 1);
+            count--;
+            return 0;
+        }
+
+        T & Get(int index)
+        {
+            return ring[Index(index)].frame;
+        }
+
+        double GetPTS(int index) const
+        {
+            return ring[Index(index)].pts;
+        }
+
+        // 第一个 PTS >= pts 的位置, 都比 pts 小时返回 Size()
+        int LowerBound(double pts) const
+        {
+            int left = 0;
+            int right = count;
+            while(left < right){
+                int mid = left + (right - left) / 2;
+                if(ring[Index(mid)].pts < pts){
+                    left = mid + 1;
+                }
+                else{
+                    right = mid;
+                }
+            }
+            return left;
+        }
+
+        // 第一个 PTS > pts 的位置, 相同 PTS 的帧按到达的顺序排
+        int UpperBound(double pts) const
+        {
+            int left = 0;
+            int right = count;
+            while(left < right){
+                int mid = left + (right - left) / 2;
+                if(ring[Index(mid)].pts <= pts){
+                    left = mid + 1;
+                }
+                else{
+                    right = mid;
+                }
+            }
+            return left;
+        }
+
+    private:
+        struct Item
+        {
+            T frame = T();
+            double pts = 0.0;
+            int64_t bytes = 0;
+        };
+
+        // 容量总是 2 的幂, 下标用位与回绕
+        int Index(int index) const
+        {
+            return (head + index) & (int)(ring.size() - 1);
+        }
+
+        void Grow()
+        {
+            int capacity = ring.size() * 2;
+            if(capacity < 8){
+                capacity = 8;
+            }
+            std::vector<Item> newRing(capacity);
+            for(int i = 0; i < count; i++){
+                newRing[i] = std::move(ring[Index(i)]);
+            }
+            ring.swap(newRing);
+            head = 0;
+        }
+
+        std::vector<Item> ring;
+        int head = 0;
+        int count = 0;
+        int64_t bytes = 0;
+
+        int maxFrame = 5;
+        int64_t maxBytes = 0;
+    };
+}
+
+#endif //EYERLIB_EYERAVFRAMECACHE_HPP
@@ -0,0 +1,260 @@
+#include "EyerAVFramePool.hpp"
+
+#include "EyerAVFramePoolPrivate.hpp"
+#include "EyerAVFramePrivate.hpp"
+
+#include <string.h>
+
+#include "EyerAVFrame_CVPixelBuffer.h"
+
+namespace Eyer
+{
+    // 尺寸频繁变化时 (例如任意尺寸的缩略图), 不为每个尺寸都保留一个池
+    static const int EYER_AV_FRAME_POOL_MAX_BUFFER_POOL_NUM = 8;
+
+    static AVBufferRef * EyerAVFramePool_BufferAlloc(void * opaque, int size)
+    {
+        EyerAVFramePoolPrivate * piml = (EyerAVFramePoolPrivate *)opaque;
+        piml->bufferAllocNum++;
+        return av_buffer_alloc(size);
+    }
+
+    // 只释放数据, 保留宽高, 格式, pts 等属性
+    static void EyerAVFramePool_ReleaseData(AVFrame * frame)
+    {
+        for(int i = 0; i < AV_NUM_DATA_POINTERS; i++){
+            av_buffer_unref(&frame->buf[i]);
+        }
+        for(int i = 0; i < frame->nb_extended_buf; i++){
+            av_buffer_unref(&frame->extended_buf[i]);
+        }
+        av_freep(&frame->extended_buf);
+        frame->nb_extended_buf = 0;
+
+        if(frame->extended_data != frame->data){
+            av_freep(&frame->extended_data);
+        }
+        frame->extended_data = nullptr;
+
+        memset(frame->data, 0, sizeof(frame->data));
+        memset(frame->linesize, 0, sizeof(frame->linesize));
+    }
+
+    EyerAVFramePool::EyerAVFramePool(int align, int maxFreeFrameNum)
+    {
+        piml = new EyerAVFramePoolPrivate();
+
+        if(align <= 0 || (align & (align - 1)) != 0){
+            align = 64;
+        }
+        if(maxFreeFrameNum < 0){
+            maxFreeFrameNum = 0;
+        }
+        piml->align = align;
+        piml->maxFreeFrameNum = maxFreeFrameNum;
+    }
+
+    EyerAVFramePool::~EyerAVFramePool()
+    {
+        for(int i = 0; i < piml->freeFrameList.size(); i++){
+            delete piml->freeFrameList[i];
+        }
+        piml->freeFrameList.clear();
+
+        // 还在被帧引用的数据块, 在最后一个引用释放时才真正回收
+        std::map<int, AVBufferPool *>::iterator itr;
+        for(itr = piml->bufferPoolMap.begin(); itr != piml->bufferPoolMap.end(); itr++){
+            av_buffer_pool_uninit(&itr->second);
+        }
+        piml->bufferPoolMap.clear();
+        piml->bufferPoolUseTick.clear();
+
+        if(piml != nullptr){
+            delete piml;
+            piml = nullptr;
+        }
+    }
+
+    EyerAVFrame * EyerAVFramePool::NewFrame()
+    {
+        {
+            std::lock_guard<std::mutex> lg(piml->frameMut);
+            if(piml->freeFrameList.size() > 0){
+                EyerAVFrame * frame = piml->freeFrameList.back();
+                piml->freeFrameList.pop_back();
+                return frame;
+            }
+        }
+        return new EyerAVFrame();
+    }
+
+    int EyerAVFramePool::DeleteFrame(EyerAVFrame * frame)
+    {
+        if(frame == nullptr){
+            return -1;
+        }
+        // 先放掉数据, 数据块回到各自的池中
+        av_frame_unref(frame->GetPrivate()->frame);
+        frame->GetPrivate()->secPTS = 0.0;
+        frame->GetPrivate()->LAST_FRAME_FLAG = false;
+        frame->GetPrivate()->angle = 0;
+#ifdef EYER_PLATFORM_DARWIN
+        if(frame->cvPixelBuffer != nullptr){
+            freeCVPixelBuffer(frame->cvPixelBuffer);
+            frame->cvPixelBuffer = nullptr;
+        }
+#endif
+
+        {
+            std::lock_guard<std::mutex> lg(piml->frameMut);
+            if(piml->freeFrameList.size() < piml->maxFreeFrameNum){
+                piml->freeFrameList.push_back(frame);
+                return 0;
+            }
+        }
+
+        delete frame;
+        return 0;
+    }
+
+    int EyerAVFramePool::GetBuffer(EyerAVFrame & _frame)
+    {
+        AVFrame * frame = _frame.GetPrivate()->frame;
+        EyerAVFramePool_ReleaseData(frame);
+
+        if(frame->format < 0){
+            return -1;
+        }
+
+        int align = piml->align;
+        bool isVideo = frame->width > 0 && frame->height > 0;
+
+        int paddedHeight = 0;
+        int size = 0;
+        if(isVideo){
+            AVPixelFormat format = (AVPixelFormat)frame->format;
+            const AVPixFmtDescriptor * desc = av_pix_fmt_desc_get(format);
+            if(desc == nullptr || (desc->flags & AV_PIX_FMT_FLAG_HWACCEL)){
+                return -1;
+            }
+
+            int ret = av_image_fill_linesizes(frame->linesize, format, frame->width);
+            if(ret < 0){
+                return -1;
+            }
+            // 每一行的起始地址都对齐, SIMD 可以用对齐读写
+            for(int i = 0; i < 4; i++){
+                frame->linesize[i] = FFALIGN(frame->linesize[i], align);
+            }
+
+            // 高度和 av_frame_get_buffer 一样按 32 对齐, 给按块处理的代码留出余量
+            paddedHeight = FFALIGN(frame->height, 32);
+            size = av_image_fill_pointers(frame->data, format, paddedHeight, NULL, frame->linesize);
+            if(size < 0){
+                memset(frame->data, 0, sizeof(frame->data));
+                memset(frame->linesize, 0, sizeof(frame->linesize));
+                return -1;
+            }
+        }
+        else {
+            if(frame->nb_samples <= 0){
+                return -1;
+            }
+            if(frame->channels <= 0){
+                frame->channels = av_get_channel_layout_nb_channels(frame->channel_layout);
+            }
+            if(frame->channels <= 0){
+                return -1;
+            }
+
+            int planes = av_sample_fmt_is_planar((AVSampleFormat)frame->format) ? frame->channels : 1;
+            if(planes > AV_NUM_DATA_POINTERS){
+                // 需要 extended_buf, 这种情况很少, 交给 FFmpeg 分配
+                if(av_frame_get_buffer(frame, align)){
+                    return -1;
+                }
+                return 0;
+            }
+
+            int linesize = 0;
+            int planeSize = av_samples_get_buffer_size(&linesize, frame->channels, frame->nb_samples, (AVSampleFormat)frame->format, align);
+            if(planeSize < 0){
+                return -1;
+            }
+            size = planeSize;
+        }
+
+        // 多申请 align 字节用来对齐首地址, 再加上 FFmpeg 要求的尾部填充
+        int bufferSize = size + align + AV_INPUT_BUFFER_PADDING_SIZE;
+
+        AVBufferRef * buffer = nullptr;
+        {
+            std::lock_guard<std::mutex> lg(piml->bufferMut);
+            AVBufferPool * pool = nullptr;
+            std::map<int, AVBufferPool *>::iterator itr = piml->bufferPoolMap.find(bufferSize);
+            if(itr != piml->bufferPoolMap.end()){
+                pool = itr->second;
+            }
+            else {
+                if(piml->bufferPoolMap.size() >= EYER_AV_FRAME_POOL_MAX_BUFFER_POOL_NUM){
+                    // 只淘汰最久没用的一个池, 其他尺寸继续复用
+                    std::map<int, int64_t>::iterator lruItr = piml->bufferPoolUseTick.begin();
+                    for(std::map<int, int64_t>::iterator tickItr = piml->bufferPoolUseTick.begin(); tickItr != piml->bufferPoolUseTick.end(); tickItr++){
+                        if(tickItr->second < lruItr->second){
+                            lruItr = tickItr;
+                        }
+                    }
+                    itr = piml->bufferPoolMap.find(lruItr->first);
+                    av_buffer_pool_uninit(&itr->second);
+                    piml->bufferPoolMap.erase(itr);
+                    piml->bufferPoolUseTick.erase(lruItr);
+                }
+                pool = av_buffer_pool_init2(bufferSize, piml, EyerAVFramePool_BufferAlloc, NULL);
+                if(pool != nullptr){
+                    piml->bufferPoolMap[bufferSize] = pool;
+                }
+            }
+            if(pool != nullptr){
+                piml->useTick++;
+                piml->bufferPoolUseTick[bufferSize] = piml->useTick;
+            }
+            // uninit 之后池可能被释放, 取数据块也要在锁内
+            if(pool != nullptr){
+                buffer = av_buffer_pool_get(pool);
+            }
+        }
+        if(buffer == nullptr){
+            memset(frame->data, 0, sizeof(frame->data));
+            memset(frame->linesize, 0, sizeof(frame->linesize));
+            return -1;
+        }
+
+        uint8_t * ptr = (uint8_t *)FFALIGN((uintptr_t)buffer->data, (uintptr_t)align);
+        if(isVideo){
+            av_image_fill_pointers(frame->data, (AVPixelFormat)frame->format, paddedHeight, ptr, frame->linesize);
+        }
+        else {
+            av_samples_fill_arrays(frame->data, &frame->linesize[0], ptr, frame->channels, frame->nb_samples, (AVSampleFormat)frame->format, align);
+        }
+        frame->buf[0] = buffer;
+        frame->extended_data = frame->data;
+
+        return 0;
+    }
+
+    int EyerAVFramePool::GetAlign() const
+    {
+        return piml->align;
+    }
+
+    int EyerAVFramePool::GetFreeFrameNum()
+    {
+        std::lock_guard<std::mutex> lg(piml->frameMut);
+        return piml->freeFrameList.size();
+    }
+
+    int64_t EyerAVFramePool::GetBufferAllocNum()
+    {
+        return piml->bufferAllocNum;
+    }
+}
@@ -0,0 +1,43 @@
+#ifndef EYERLIB_EYERAVFRAMEPOOL_HPP
+#define EYERLIB_EYERAVFRAMEPOOL_HPP
+
+#include <stdint.h>
+#include "EyerAVFrame.hpp"
+
+namespace Eyer
+{
+    class EyerAVFramePoolPrivate;
+
+    // 帧复用池, 线程安全
+    // 1. NewFrame/DeleteFrame 复用 EyerAVFrame 外壳 (EyerAVFramePrivate + AVFrame), 省去每帧的 new 和 av_frame_alloc
+    // 2. GetBuffer 代替 av_frame_get_buffer, 相同大小的数据块从 AVBufferPool 中取, 最后一个引用释放后回到池中
+    class EyerAVFramePool
+    {
+    public:
+        // align 为数据首地址和 linesize 的对齐字节数, 必须是 2 的幂, 默认 64 满足 AVX-512
+        EyerAVFramePool(int align = 64, int maxFreeFrameNum = 32);
+        ~EyerAVFramePool();
+
+        EyerAVFramePool(const EyerAVFramePool & pool) = delete;
+        EyerAVFramePool & operator = (const EyerAVFramePool & pool) = delete;
+
+        EyerAVFrame * NewFrame();
+        // 可以归还任意 new 出来的 EyerAVFrame, 空闲帧超过 maxFreeFrameNum 时直接 delete
+        int DeleteFrame(EyerAVFrame * frame);
+
+        // 按 frame 上已经设置的 宽高/像素格式 或 采样格式/声道/采样数 分配数据
+        // frame 原有的数据会先释放, pts 等其他属性保留
+        int GetBuffer(EyerAVFrame & frame);
+
+        int GetAlign() const;
+        // 当前空闲的帧外壳数量
+        int GetFreeFrameNum();
+        // 实际申请数据块的次数, 从池中复用时不增加
+        int64_t GetBufferAllocNum();
+
+    private:
+        EyerAVFramePoolPrivate * piml = nullptr;
+    };
+}
+
+#endif //EYERLIB_EYERAVFRAMEPOOL_HPP
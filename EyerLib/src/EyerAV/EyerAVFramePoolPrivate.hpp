@@ -0,0 +1,35 @@
+#ifndef EYERLIB_EYERAVFRAMEPOOLPRIVATE_HPP
+#define EYERLIB_EYERAVFRAMEPOOLPRIVATE_HPP
+
+#include "EyerAVFFmpegHeader.hpp"
+#include "EyerAVFrame.hpp"
+
+#include <map>
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <stdint.h>
+
+namespace Eyer
+{
+    class EyerAVFramePoolPrivate
+    {
+    public:
+        int align = 64;
+        int maxFreeFrameNum = 32;
+
+        std::mutex frameMut;
+        std::vector<EyerAVFrame *> freeFrameList;
+
+        // 数据块大小 -> 池
+        std::mutex bufferMut;
+        std::map<int, AVBufferPool *> bufferPoolMap;
+        // 数据块大小 -> 最近一次使用的序号, 池太多时淘汰序号最小的
+        std::map<int, int64_t> bufferPoolUseTick;
+        int64_t useTick = 0;
+
+        std::atomic<int64_t> bufferAllocNum {0};
+    };
+}
+
+#endif //EYERLIB_EYERAVFRAMEPOOLPRIVATE_HPP
@@ -6,14 +6,20 @@
 #include "EyerAVDecoder.hpp"
 #include "EyerAVEncoder.hpp"
 #include "EyerAVEncoderParam.hpp"
+#include "EyerAVRateControl.hpp"
 #include "EyerAVFrame.hpp"
+#include "EyerAVFramePool.hpp"
+#include "EyerAVFrameCache.hpp"
 #include "EyerAVPacket.hpp"
+#include "EyerAVPacketPool.hpp"
 #include "EyerAVRational.hpp"
 #include "EyerAVWriter.hpp"
 #include "EyerAVBitstreamFilter.hpp"
 #include "EyerAVBitstreamFilterType.hpp"
 #include "EyerAVDecoderLine.hpp"
 #include "EyerAVDecoderBox.hpp"
+#include "EyerAVKeyframeIndex.hpp"
+#include "EyerAVSharedFrameCache.hpp"
 #include "EyerAVSampleFormat.hpp"
 #include "EyerAVImageReader.hpp"
 #include "EyerAVADTS.hpp"
@@ -37,7 +43,13 @@
 #include "EyerH264AVCC.hpp"
 #include "EyerAVAudioBox.hpp"
 #include "EyerAVReaderCustomIO.hpp"
+#include "EyerAVWriterCustomIO.hpp"
+#include "EyerAVMemoryWriterCustomIO.hpp"
+#include "EyerAVFileWriterCustomIO.hpp"
+#include "EyerAVFileUtil.hpp"
 #include "EyerAVSnapshot.hpp"
 #include "EyerAVVideoWriter.hpp"
+#include "EyerAVScaleQuality.hpp"
+#include "EyerAVScaler.hpp"
 
 #endif //EYERLIB_EYERAVHEADER_HPP
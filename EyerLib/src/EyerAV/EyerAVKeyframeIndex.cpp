@@ -0,0 +1,181 @@
+#include "EyerAVKeyframeIndex.hpp"
+
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+
+#include "EyerAVPacket.hpp"
+#include "EyerAVFileUtil.hpp"
+#include "EyerAVFFmpegHeader.hpp"
+
+#define EYER_AV_KEYFRAME_INDEX_MAGIC "EyerAVKeyframeIndex"
+// 2: 文件头增加源文件的修改时间
+#define EYER_AV_KEYFRAME_INDEX_VERSION 2
+
+namespace Eyer
+{
+    EyerAVKeyframeIndex::EyerAVKeyframeIndex()
+    {
+
+    }
+
+    EyerAVKeyframeIndex::~EyerAVKeyframeIndex()
+    {
+
+    }
+
+    int EyerAVKeyframeIndex::Build(const EyerString & path, EyerAVReaderCustomIO * customIO)
+    {
+        keyframeList.clear();
+        isValid = false;
+
+        EyerAVReader reader(path, customIO);
+        int ret = reader.Open();
+        if(ret){
+            EyerLogE("EyerAVKeyframeIndex Open Fail: %s\n", path.c_str());
+            return -1;
+        }
+
+        int videoStreamIndex = reader.GetVideoStreamIndex();
+        if(videoStreamIndex < 0){
+            reader.Close();
+            return -1;
+        }
+
+        // 只读视频流的数据包
+        for(int i = 0; i < reader.GetStreamCount(); i++){
+            if(i != videoStreamIndex){
+                reader.SetStreamDiscard(i, true);
+            }
+        }
+
+        EyerAVPacket packet;
+        while(reader.Read(packet) == 0){
+            if(packet.GetStreamIndex() != videoStreamIndex){
+                continue;
+            }
+            if(!packet.IsKeyFrame() || packet.GetPTS() == AV_NOPTS_VALUE){
+                continue;
+            }
+            EyerAVKeyframe keyframe;
+            keyframe.pts = packet.GetSecPTS();
+            keyframe.pos = packet.GetPos();
+            keyframeList.push_back(keyframe);
+        }
+        reader.Close();
+
+        std::sort(keyframeList.begin(), keyframeList.end(), [](const EyerAVKeyframe & a, const EyerAVKeyframe & b){
+            return a.pts < b.pts;
+        });
+
+        fileSize = -1;
+        fileMtime = -1;
+        if(customIO == nullptr){
+            EyerAVFileUtil::GetFileInfo(path, fileSize, fileMtime);
+        }
+        isValid = keyframeList.size() > 0;
+
+        EyerLog("EyerAVKeyframeIndex Build: %s, keyframe num: %d\n", path.c_str(), (int)keyframeList.size());
+        return isValid ? 0 : -1;
+    }
+
+    int EyerAVKeyframeIndex::Load(const EyerString & indexPath, const EyerString & path)
+    {
+        keyframeList.clear();
+        isValid = false;
+
+        FILE * file = fopen(indexPath.c_str(), "rb");
+        if(file == nullptr){
+            return -1;
+        }
+
+        char magic[64] = {0};
+        int version = 0;
+        long long savedFileSize = -1;
+        long long savedFileMtime = -1;
+        int keyframeNum = 0;
+        int ret = fscanf(file, "%63s %d %lld %lld %d", magic, &version, &savedFileSize, &savedFileMtime, &keyframeNum);
+        if(ret != 5 || strcmp(magic, EYER_AV_KEYFRAME_INDEX_MAGIC) != 0 || version != EYER_AV_KEYFRAME_INDEX_VERSION || keyframeNum <= 0){
+            fclose(file);
+            return -1;
+        }
+
+        // 源文件变了, 索引作废; 大小不变的原地修改靠修改时间发现
+        int64_t currentFileSize = -1;
+        int64_t currentFileMtime = -1;
+        EyerAVFileUtil::GetFileInfo(path, currentFileSize, currentFileMtime);
+        if(savedFileSize >= 0 && currentFileSize >= 0 && (savedFileSize != currentFileSize || savedFileMtime != currentFileMtime)){
+            EyerLog("EyerAVKeyframeIndex Stale: %s\n", indexPath.c_str());
+            fclose(file);
+            return -1;
+        }
+
+        for(int i = 0; i < keyframeNum; i++){
+            EyerAVKeyframe keyframe;
+            long long pos = -1;
+            if(fscanf(file, "%lf %lld", &keyframe.pts, &pos) != 2){
+                fclose(file);
+                keyframeList.clear();
+                return -1;
+            }
+            keyframe.pos = pos;
+            keyframeList.push_back(keyframe);
+        }
+        fclose(file);
+
+        fileSize = savedFileSize;
+        fileMtime = savedFileMtime;
+        isValid = true;
+        return 0;
+    }
+
+    int EyerAVKeyframeIndex::Save(const EyerString & indexPath)
+    {
+        if(!isValid){
+            return -1;
+        }
+
+        FILE * file = fopen(indexPath.c_str(), "wb");
+        if(file == nullptr){
+            EyerLogE("EyerAVKeyframeIndex Save Fail: %s\n", indexPath.c_str());
+            return -1;
+        }
+
+        fprintf(file, "%s %d %lld %lld %d\n", EYER_AV_KEYFRAME_INDEX_MAGIC, EYER_AV_KEYFRAME_INDEX_VERSION, (long long)fileSize, (long long)fileMtime, (int)keyframeList.size());
+        for(int i = 0; i < keyframeList.size(); i++){
+            fprintf(file, "%.17g %lld\n", keyframeList[i].pts, (long long)keyframeList[i].pos);
+        }
+        fclose(file);
+        return 0;
+    }
+
+    bool EyerAVKeyframeIndex::IsValid()
+    {
+        return isValid;
+    }
+
+    int EyerAVKeyframeIndex::GetKeyframeNum()
+    {
+        return keyframeList.size();
+    }
+
+    EyerAVKeyframe EyerAVKeyframeIndex::GetKeyframe(int index)
+    {
+        return keyframeList[index];
+    }
+
+    int EyerAVKeyframeIndex::FindKeyframe(double pts)
+    {
+        if(keyframeList.size() <= 0){
+            return -1;
+        }
+        std::vector<EyerAVKeyframe>::iterator it = std::upper_bound(keyframeList.begin(), keyframeList.end(), pts, [](double t, const EyerAVKeyframe & keyframe){
+            return t < keyframe.pts;
+        });
+        int index = (int)(it - keyframeList.begin()) - 1;
+        if(index < 0){
+            index = 0;
+        }
+        return index;
+    }
+}
@@ -0,0 +1,50 @@
+#ifndef EYERLIB_EYERAVKEYFRAMEINDEX_HPP
+#define EYERLIB_EYERAVKEYFRAMEINDEX_HPP
+
+#include <stdint.h>
+#include <vector>
+
+#include "EyerCore/EyerCore.hpp"
+#include "EyerAVReader.hpp"
+
+namespace Eyer
+{
+    class EyerAVKeyframe
+    {
+    public:
+        double pts = 0.0;
+        // 关键帧数据包在文件中的字节位置, -1 表示未知
+        int64_t pos = -1;
+    };
+
+    // 视频流的关键帧索引, 用来判断一个时间点属于哪个 GOP
+    // Build 只解封装不解码, 可以用 Save/Load 存成旁路文件, 下次打开时不用再扫一遍
+    class EyerAVKeyframeIndex
+    {
+    public:
+        EyerAVKeyframeIndex();
+        ~EyerAVKeyframeIndex();
+
+        int Build(const EyerString & path, EyerAVReaderCustomIO * customIO = nullptr);
+
+        // 索引文件记录了源文件的大小和修改时间, 源文件变了之后 Load 失败
+        int Load(const EyerString & indexPath, const EyerString & path);
+        int Save(const EyerString & indexPath);
+
+        bool IsValid();
+        int GetKeyframeNum();
+        EyerAVKeyframe GetKeyframe(int index);
+
+        // pts 所在 GOP 的关键帧下标, pts 在第一个关键帧之前时返回 0, 索引为空时返回 -1
+        int FindKeyframe(double pts);
+
+    private:
+        std::vector<EyerAVKeyframe> keyframeList;
+        // 自定义 IO 时为 -1, 不做校验
+        int64_t fileSize = -1;
+        int64_t fileMtime = -1;
+        bool isValid = false;
+    };
+}
+
+#endif //EYERLIB_EYERAVKEYFRAMEINDEX_HPP
@@ -0,0 +1,83 @@
+#include "EyerAVMemoryWriterCustomIO.hpp"
+
+#include <stdio.h>
+#include <string.h>
+
+namespace Eyer
+{
+    EyerAVMemoryWriterCustomIO::EyerAVMemoryWriterCustomIO(int reserveSize)
+    {
+        if(reserveSize > 0){
+            data.reserve(reserveSize);
+        }
+    }
+
+    EyerAVMemoryWriterCustomIO::~EyerAVMemoryWriterCustomIO()
+    {
+
+    }
+
+    int EyerAVMemoryWriterCustomIO::Write(const uint8_t * buf, int buf_size)
+    {
+        if(buf == nullptr || buf_size < 0){
+            return -1;
+        }
+        // Seek 回去改写文件头时覆盖原有数据, 写到末尾之后时扩容
+        if(pos + buf_size > (int64_t)data.size()){
+            data.resize(pos + buf_size);
+        }
+        memcpy(data.data() + pos, buf, buf_size);
+        pos += buf_size;
+        return buf_size;
+    }
+
+    int64_t EyerAVMemoryWriterCustomIO::Seek(int64_t offset, int whence)
+    {
+        whence &= ~SEEK_FORCE;
+        if(whence == SEEK_SIZE){
+            return data.size();
+        }
+
+        int64_t target = 0;
+        if(whence == SEEK_SET){
+            target = offset;
+        }
+        else if(whence == SEEK_CUR){
+            target = pos + offset;
+        }
+        else if(whence == SEEK_END){
+            target = data.size() + offset;
+        }
+        else{
+            return -1;
+        }
+
+        if(target < 0){
+            return -1;
+        }
+        pos = target;
+        return pos;
+    }
+
+    const uint8_t * EyerAVMemoryWriterCustomIO::GetData() const
+    {
+        return data.data();
+    }
+
+    int64_t EyerAVMemoryWriterCustomIO::GetSize() const
+    {
+        return data.size();
+    }
+
+    EyerBuffer EyerAVMemoryWriterCustomIO::GetBuffer() const
+    {
+        return EyerBuffer((uint8_t *)data.data(), data.size());
+    }
+
+    int EyerAVMemoryWriterCustomIO::Reset()
+    {
+        data.clear();
+        pos = 0;
+        return 0;
+    }
+}
@@ -0,0 +1,37 @@
+#ifndef EYERLIB_EYERAVMEMORYWRITERCUSTOMIO_HPP
+#define EYERLIB_EYERAVMEMORYWRITERCUSTOMIO_HPP
+
+#include <vector>
+
+#include "EyerCore/EyerCore.hpp"
+#include "EyerAVWriterCustomIO.hpp"
+
+namespace Eyer
+{
+    // 写到可增长内存中的输出, 支持 Seek, MP4/MOV 写完后回写文件头也可以使用
+    class EyerAVMemoryWriterCustomIO : public EyerAVWriterCustomIO
+    {
+    public:
+        EyerAVMemoryWriterCustomIO(int reserveSize = 0);
+        virtual ~EyerAVMemoryWriterCustomIO();
+
+        virtual int Write(const uint8_t * buf, int buf_size) override;
+        virtual int64_t Seek(int64_t offset, int whence) override;
+
+        // 写入期间指针可能因为扩容失效, 写完之后再取
+        const uint8_t * GetData() const;
+        int64_t GetSize() const;
+        EyerBuffer GetBuffer() const;
+
+        int Reset();
+
+    private:
+        EyerAVMemoryWriterCustomIO(const EyerAVMemoryWriterCustomIO & io) = delete;
+        EyerAVMemoryWriterCustomIO & operator = (const EyerAVMemoryWriterCustomIO & io) = delete;
+
+        std::vector<uint8_t> data;
+        int64_t pos = 0;
+    };
+}
+
+#endif //EYERLIB_EYERAVMEMORYWRITERCUSTOMIO_HPP
@@ -3,6 +3,8 @@
 #include "EyerAVReaderPrivate.hpp"
 #include "EyerAVPacketPrivate.hpp"
 
+#include <utility>
+
 namespace Eyer
 {
     /**
@@ -17,8 +19,7 @@ namespace Eyer
      */
     EyerAVPacket::EyerAVPacket()
     {
-        piml = new EyerAVPacketPrivate();
-        piml->packet = av_packet_alloc();  // 分配 AVPacket 结构
+        CreatePrivate();
     }
 
     /**
@@ -27,14 +28,27 @@ namespace Eyer
      *
      * 实现流程：
      * 1. 先调用默认构造函数初始化
-     * 2. 通过赋值操作符实现深拷贝
-     * 3. 会复制 AVPacket 的所有数据和元信息
+     * 2. 通过赋值操作符引用源数据包的数据
+     * 3. 会复制 AVPacket 的所有元信息
      */
     EyerAVPacket::EyerAVPacket(const EyerAVPacket & packet) : EyerAVPacket()
     {
         *this = packet;
     }
 
+    /**
+     * @brief 移动构造函数 - 接管另一个数据包
+     * @param packet 源数据包对象
+     *
+     * 直接接管私有数据结构，不分配 AVPacket，也不增加引用
+     * 源对象变成空包，下次用到时再创建空的私有数据
+     */
+    EyerAVPacket::EyerAVPacket(EyerAVPacket && packet) noexcept
+    {
+        piml = packet.piml;
+        packet.piml = nullptr;
+    }
+
     /**
      * @brief 析构函数 - 释放数据包资源
      *
@@ -47,42 +61,88 @@ namespace Eyer
      */
     EyerAVPacket::~EyerAVPacket()
     {
+        // 被移动过且没再用过的对象没有私有数据
+        if(piml == nullptr){
+            return;
+        }
+
         if (piml->packet != nullptr) {
             av_packet_free(&piml->packet);  // 释放 AVPacket 及其内部数据
             piml->packet = nullptr;
         }
 
-        if(piml != nullptr){
-            delete piml;
-            piml = nullptr;
-        }
+        delete piml;
+        piml = nullptr;
     }
 
     /**
-     * @brief 赋值操作符重载 - 深拷贝数据包内容
+     * @brief 赋值操作符重载 - 引用数据包内容
      * @param packet 源数据包对象
      * @return 当前对象的引用
      *
-     * 深拷贝流程：
-     * 1. 先释放当前 AVPacket 的内存（避免内存泄漏）
-     * 2. 使用 av_packet_clone 克隆源 AVPacket（完整拷贝数据和元信息）
+     * 赋值流程：
+     * 1. 释放当前 AVPacket 引用的数据，AVPacket 结构本身保留
+     * 2. 使用 av_packet_ref 引用源 AVPacket（数据只增加引用计数，元信息全部复制）
      * 3. 复制附加字段（如秒级 PTS）
      *
-     * av_packet_clone 会分配新内存并复制所有数据
+     * 源数据没有引用计数时，av_packet_ref 才会复制一份数据
      */
     EyerAVPacket & EyerAVPacket::operator = (const EyerAVPacket & packet)
     {
-        if (piml->packet != nullptr) {
-            av_packet_free(&piml->packet);  // 释放当前 AVPacket
-            piml->packet = nullptr;
+        if(this == &packet){
+            return *this;
         }
+        av_packet_unref(GetPrivate()->packet);
+        av_packet_ref(GetPrivate()->packet, packet.GetPrivate()->packet);  // 引用源 AVPacket
+        GetPrivate()->secPTS = packet.GetPrivate()->secPTS;  // 复制秒级时间戳
+        GetPrivate()->nullFlag = packet.GetPrivate()->nullFlag;
 
-        piml->packet = av_packet_clone(packet.piml->packet);  // 克隆源 AVPacket
-        piml->secPTS = packet.piml->secPTS;  // 复制秒级时间戳
+        return *this;
+    }
 
+    /**
+     * @brief 移动赋值操作符 - 与另一个数据包交换内容
+     * @param packet 源数据包对象
+     * @return 当前对象的引用
+     *
+     * 交换私有数据结构，原来的数据随源对象一起释放
+     */
+    EyerAVPacket & EyerAVPacket::operator = (EyerAVPacket && packet) noexcept
+    {
+        std::swap(piml, packet.piml);
         return *this;
     }
 
+    /**
+     * @brief 创建私有数据结构和空的 AVPacket
+     *
+     * 构造时调用；被移动过的对象在下次通过 GetPrivate 访问时调用
+     */
+    void EyerAVPacket::CreatePrivate() const
+    {
+        piml = new EyerAVPacketPrivate();
+        piml->packet = av_packet_alloc();  // 分配 AVPacket 结构
+    }
+
+    /**
+     * @brief 释放数据包的数据，保留 AVPacket 结构用于复用
+     * @return 0 表示成功
+     *
+     * 释放后与新创建的数据包状态一致：
+     * - 数据和附加数据被释放（引用计数减一）
+     * - 时间戳恢复为 AV_NOPTS_VALUE
+     * - 秒级 PTS 和空包标志清零
+     *
+     * 循环读包时复用同一个对象，省去每次 av_packet_alloc 的开销
+     */
+    int EyerAVPacket::Unref()
+    {
+        av_packet_unref(GetPrivate()->packet);
+        GetPrivate()->secPTS = 0.0;
+        GetPrivate()->nullFlag = false;
+        return 0;
+    }
+
     /**
      * @brief 设置显示时间戳（Presentation Timestamp）
      * @param pts 显示时间戳（时间基准单位）
@@ -94,7 +154,7 @@ namespace Eyer
      */
     int EyerAVPacket::SetPTS(int64_t pts)
     {
-        piml->packet->pts = pts;
+        GetPrivate()->packet->pts = pts;
         return 0;
     }
 
@@ -108,7 +168,7 @@ namespace Eyer
      */
     int64_t EyerAVPacket::GetPTS()
     {
-        return piml->packet->pts;
+        return GetPrivate()->packet->pts;
     }
 
     /**
@@ -125,7 +185,49 @@ namespace Eyer
      */
     int64_t EyerAVPacket::GetDTS()
     {
-        return piml->packet->dts;
+        return GetPrivate()->packet->dts;
+    }
+
+    /**
+     * @brief 设置解码时间戳（Decoding Timestamp）
+     * @param dts 解码时间戳（时间基准单位）
+     * @return 0 表示成功
+     */
+    int EyerAVPacket::SetDTS(int64_t dts)
+    {
+        GetPrivate()->packet->dts = dts;
+        return 0;
+    }
+
+    /**
+     * @brief 将 PTS 和 DTS 同时减去一个偏移量
+     * @param offset 偏移量（时间基准单位）
+     * @return 0 表示成功
+     *
+     * 无效的时间戳（AV_NOPTS_VALUE）保持不变
+     * 用于流复制时把裁剪起点对齐到 0
+     */
+    int EyerAVPacket::OffsetTs(int64_t offset)
+    {
+        if(GetPrivate()->packet->pts != AV_NOPTS_VALUE){
+            GetPrivate()->packet->pts -= offset;
+        }
+        if(GetPrivate()->packet->dts != AV_NOPTS_VALUE){
+            GetPrivate()->packet->dts -= offset;
+        }
+        return 0;
+    }
+
+    /**
+     * @brief 判断数据包是否为关键帧
+     * @return true 表示关键帧
+     *
+     * 流复制时必须从关键帧开始写入，否则解码端无法解出前面的帧
+     * 音频数据包通常每一个都是关键帧
+     */
+    bool EyerAVPacket::IsKeyFrame()
+    {
+        return (GetPrivate()->packet->flags & AV_PKT_FLAG_KEY) != 0;
     }
 
     /**
@@ -137,7 +239,7 @@ namespace Eyer
      */
     int EyerAVPacket::GetStreamIndex()
     {
-        return piml->packet->stream_index;
+        return GetPrivate()->packet->stream_index;
     }
 
     /**
@@ -150,7 +252,7 @@ namespace Eyer
      */
     int EyerAVPacket::SetStreamIndex(int streamIndex)
     {
-        piml->packet->stream_index = streamIndex;
+        GetPrivate()->packet->stream_index = streamIndex;
         return 0;
     }
 
@@ -186,7 +288,7 @@ namespace Eyer
         streamTimebase.den = _streamTimebase.den;
 
         // 调用 FFmpeg 的时间戳重缩放函数
-        av_packet_rescale_ts(piml->packet, codecTimebase, streamTimebase);
+        av_packet_rescale_ts(GetPrivate()->packet, codecTimebase, streamTimebase);
 
         return 0;
     }
@@ -200,7 +302,7 @@ namespace Eyer
      */
     int EyerAVPacket::GetSize()
     {
-        return piml->packet->size;
+        return GetPrivate()->packet->size;
     }
 
     /**
@@ -212,7 +314,7 @@ namespace Eyer
      */
     uint8_t * EyerAVPacket::GetDatePtr()
     {
-        return piml->packet->data;
+        return GetPrivate()->packet->data;
     }
 
     /**
@@ -223,7 +325,7 @@ namespace Eyer
      */
     int EyerAVPacket::GetSideSize()
     {
-        return piml->packet->side_data->size;
+        return GetPrivate()->packet->side_data->size;
     }
 
     /**
@@ -239,9 +341,9 @@ namespace Eyer
      */
     uint8_t * EyerAVPacket::GetSideDatePtr()
     {
-        if(AV_PKT_DATA_MATROSKA_BLOCKADDITIONAL == piml->packet->side_data->type)
-            EyerLog("piml->packet->side_data->type: %d\n", piml->packet->side_data->type);  // 调试日志：输出附加数据类型
-        return piml->packet->side_data->data;
+        if(AV_PKT_DATA_MATROSKA_BLOCKADDITIONAL == GetPrivate()->packet->side_data->type)
+            EyerLog("GetPrivate()->packet->side_data->type: %d\n", GetPrivate()->packet->side_data->type);  // 调试日志：输出附加数据类型
+        return GetPrivate()->packet->side_data->data;
     }
 
     /**
@@ -253,7 +355,18 @@ namespace Eyer
      */
     double EyerAVPacket::GetSecPTS()
     {
-        return piml->secPTS;
+        return GetPrivate()->secPTS;
+    }
+
+    /**
+     * @brief 获取数据包在文件中的字节位置
+     * @return 字节偏移, -1 表示未知
+     *
+     * 由解封装器设置, 关键帧索引用它记录每个 GOP 的位置
+     */
+    int64_t EyerAVPacket::GetPos()
+    {
+        return GetPrivate()->packet->pos;
     }
 
     /**
@@ -267,7 +380,7 @@ namespace Eyer
      */
     int EyerAVPacket::SetPKGNULLFlag()
     {
-        piml->nullFlag = true;
+        GetPrivate()->nullFlag = true;
         return 0;
     }
 
@@ -279,6 +392,6 @@ namespace Eyer
      */
     bool EyerAVPacket::IsNullPKG()
     {
-        return piml->nullFlag;
+        return GetPrivate()->nullFlag;
     }
 }
\ No newline at end of file
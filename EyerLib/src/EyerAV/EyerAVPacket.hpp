@@ -8,19 +8,31 @@ namespace Eyer
 {
     class EyerAVPacketPrivate;
 
+    // 拷贝和赋值只增加数据的引用计数, 不复制压缩数据
     class EyerAVPacket
     {
     public:
         EyerAVPacket();
         EyerAVPacket(const EyerAVPacket & packet);
+        // 不分配内存, 移动之后 packet 是空包
+        EyerAVPacket(EyerAVPacket && packet) noexcept;
         ~EyerAVPacket();
 
         EyerAVPacket & operator = (const EyerAVPacket & packet);
+        // 和 packet 交换内容
+        EyerAVPacket & operator = (EyerAVPacket && packet) noexcept;
+
+        // 释放数据, 恢复成刚创建时的状态, AVPacket 本身保留下来复用
+        int Unref();
 
         int SetPTS(int64_t pts);
         int64_t GetPTS();
 
         int64_t GetDTS();
+        int SetDTS(int64_t dts);
+
+        int OffsetTs(int64_t offset);
+        bool IsKeyFrame();
 
         int GetStreamIndex();
         int SetStreamIndex(int streamIndex);
@@ -35,11 +47,26 @@ namespace Eyer
 
         double GetSecPTS();
 
+        int64_t GetPos();
+
         int SetPKGNULLFlag();
         bool IsNullPKG();
 
+        // 移动构造之后 piml 为空, 第一次用到时再创建
+        EyerAVPacketPrivate * GetPrivate() const
+        {
+            if(piml == nullptr){
+                CreatePrivate();
+            }
+            return piml;
+        }
+
+    private:
+        void CreatePrivate() const;
+
     public:
-        EyerAVPacketPrivate * piml = nullptr;
+        // 可能为空, 通过 GetPrivate 访问
+        mutable EyerAVPacketPrivate * piml = nullptr;
     };
 }
 
@@ -0,0 +1,66 @@
+#include "EyerAVPacketPool.hpp"
+
+#include "EyerAVPacketPoolPrivate.hpp"
+
+namespace Eyer
+{
+    EyerAVPacketPool::EyerAVPacketPool(int maxFreePacketNum)
+    {
+        piml = new EyerAVPacketPoolPrivate();
+        if(maxFreePacketNum < 0){
+            maxFreePacketNum = 0;
+        }
+        piml->maxFreePacketNum = maxFreePacketNum;
+    }
+
+    EyerAVPacketPool::~EyerAVPacketPool()
+    {
+        for(int i = 0; i < piml->freePacketList.size(); i++){
+            delete piml->freePacketList[i];
+        }
+        piml->freePacketList.clear();
+
+        if(piml != nullptr){
+            delete piml;
+            piml = nullptr;
+        }
+    }
+
+    EyerAVPacket * EyerAVPacketPool::NewPacket()
+    {
+        {
+            std::lock_guard<std::mutex> lg(piml->mut);
+            if(piml->freePacketList.size() > 0){
+                EyerAVPacket * packet = piml->freePacketList.back();
+                piml->freePacketList.pop_back();
+                return packet;
+            }
+        }
+        return new EyerAVPacket();
+    }
+
+    int EyerAVPacketPool::DeletePacket(EyerAVPacket * packet)
+    {
+        if(packet == nullptr){
+            return -1;
+        }
+        packet->Unref();
+
+        {
+            std::lock_guard<std::mutex> lg(piml->mut);
+            if(piml->freePacketList.size() < piml->maxFreePacketNum){
+                piml->freePacketList.push_back(packet);
+                return 0;
+            }
+        }
+
+        delete packet;
+        return 0;
+    }
+
+    int EyerAVPacketPool::GetFreePacketNum()
+    {
+        std::lock_guard<std::mutex> lg(piml->mut);
+        return piml->freePacketList.size();
+    }
+}
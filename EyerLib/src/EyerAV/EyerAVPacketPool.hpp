@@ -0,0 +1,33 @@
+#ifndef EYERLIB_EYERAVPACKETPOOL_HPP
+#define EYERLIB_EYERAVPACKETPOOL_HPP
+
+#include "EyerAVPacket.hpp"
+
+namespace Eyer
+{
+    class EyerAVPacketPoolPrivate;
+
+    // EyerAVPacket 复用池, 线程安全
+    // 省去每个包的 new EyerAVPacketPrivate 和 av_packet_alloc, 包的数据仍然由 FFmpeg 管理
+    class EyerAVPacketPool
+    {
+    public:
+        EyerAVPacketPool(int maxFreePacketNum = 64);
+        ~EyerAVPacketPool();
+
+        EyerAVPacketPool(const EyerAVPacketPool & pool) = delete;
+        EyerAVPacketPool & operator = (const EyerAVPacketPool & pool) = delete;
+
+        EyerAVPacket * NewPacket();
+        // 可以归还任意 new 出来的 EyerAVPacket, 空闲包超过 maxFreePacketNum 时直接 delete
+        int DeletePacket(EyerAVPacket * packet);
+
+        // 当前空闲的包数量
+        int GetFreePacketNum();
+
+    private:
+        EyerAVPacketPoolPrivate * piml = nullptr;
+    };
+}
+
+#endif //EYERLIB_EYERAVPACKETPOOL_HPP
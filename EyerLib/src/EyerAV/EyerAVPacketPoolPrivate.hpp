@@ -0,0 +1,21 @@
+#ifndef EYERLIB_EYERAVPACKETPOOLPRIVATE_HPP
+#define EYERLIB_EYERAVPACKETPOOLPRIVATE_HPP
+
+#include "EyerAVPacket.hpp"
+
+#include <vector>
+#include <mutex>
+
+namespace Eyer
+{
+    class EyerAVPacketPoolPrivate
+    {
+    public:
+        int maxFreePacketNum = 64;
+
+        std::mutex mut;
+        std::vector<EyerAVPacket *> freePacketList;
+    };
+}
+
+#endif //EYERLIB_EYERAVPACKETPOOLPRIVATE_HPP
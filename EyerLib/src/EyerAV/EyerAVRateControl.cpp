@@ -0,0 +1,56 @@
+#include "EyerAVRateControl.hpp"
+
+namespace Eyer
+{
+    EyerAVRateControl EyerAVRateControl::CRF    (1, "CRF");
+    EyerAVRateControl EyerAVRateControl::ABR    (2, "ABR");
+    EyerAVRateControl EyerAVRateControl::CBR    (3, "CBR");
+
+    EyerAVRateControl::EyerAVRateControl()
+    {
+
+    }
+
+    EyerAVRateControl::EyerAVRateControl(int _id, const EyerString & _name)
+        : id(_id)
+        , name(_name)
+    {
+    }
+
+    EyerAVRateControl::~EyerAVRateControl()
+    {
+
+    }
+
+    EyerAVRateControl::EyerAVRateControl(const EyerAVRateControl & rateControl)
+    {
+        *this = rateControl;
+    }
+
+    EyerAVRateControl & EyerAVRateControl::operator = (const EyerAVRateControl & rateControl)
+    {
+        id = rateControl.id;
+        name = rateControl.name;
+        return *this;
+    }
+
+    bool EyerAVRateControl::operator == (const EyerAVRateControl & rateControl) const
+    {
+        return id == rateControl.id;
+    }
+
+    bool EyerAVRateControl::operator != (const EyerAVRateControl & rateControl) const
+    {
+        return id != rateControl.id;
+    }
+
+    const EyerString & EyerAVRateControl::GetName() const
+    {
+        return name;
+    }
+
+    int EyerAVRateControl::GetId() const
+    {
+        return id;
+    }
+}
@@ -0,0 +1,37 @@
+#ifndef EYERLIB_EYERAVRATECONTROL_HPP
+#define EYERLIB_EYERAVRATECONTROL_HPP
+
+#include "EyerCore/EyerCore.hpp"
+
+namespace Eyer
+{
+    class EyerAVRateControl
+    {
+    public:
+        // 恒定质量, 使用 crf
+        static EyerAVRateControl CRF;
+        // 平均码率, 使用 bitrate, 可以配合 maxrate/bufsize 限制峰值
+        static EyerAVRateControl ABR;
+        // 恒定码率, maxrate 等于 bitrate
+        static EyerAVRateControl CBR;
+
+        EyerAVRateControl();
+        EyerAVRateControl(int _id, const EyerString & _name);
+        ~EyerAVRateControl();
+
+        EyerAVRateControl(const EyerAVRateControl & rateControl);
+        EyerAVRateControl & operator = (const EyerAVRateControl & rateControl);
+
+        bool operator == (const EyerAVRateControl & rateControl) const;
+        bool operator != (const EyerAVRateControl & rateControl) const;
+
+        const EyerString & GetName() const;
+        int GetId() const;
+
+    private:
+        int id = 1;
+        EyerString name = "CRF";
+    };
+}
+
+#endif //EYERLIB_EYERAVRATECONTROL_HPP
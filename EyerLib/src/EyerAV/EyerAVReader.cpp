@@ -309,24 +309,12 @@ namespace Eyer {
      * @param packet 输出参数，存储读取的数据包
      * @return 0 表示成功，负数表示失败或文件结束
      *
-     * 读取下一帧数据包，并调整 PTS（减去起始时间）
-     * 同时计算秒级时间戳（secPTS）
+     * 和引用版本相同，PTS/DTS 都减去起始时间
+     * 会先释放 packet 原有的数据，同一个 packet 可以循环读取
      */
     int EyerAVReader::Read(EyerAVPacket * packet)
     {
-        int ret = av_read_frame(piml->formatCtx, packet->piml->packet);
-        if(!ret){
-            int streamIndex = packet->GetStreamIndex();
-
-            // 减去流的起始时间，使 PTS 从 0 开始
-            int64_t start_time = piml->formatCtx->streams[streamIndex]->start_time;
-            packet->piml->packet->pts -= start_time;
-
-            // 计算秒级时间戳
-            int64_t pts = packet->GetPTS();
-            packet->piml->secPTS = pts * av_q2d(piml->formatCtx->streams[streamIndex]->time_base);
-        }
-        return ret;
+        return Read(*packet);
     }
 
     /**
@@ -336,26 +324,34 @@ namespace Eyer {
      *
      * 读取下一帧数据包，处理 PTS 和 secPTS
      * 对 AV_NOPTS_VALUE 进行检查，避免无效值计算
+     * 会先释放 packet 原有的数据，同一个 packet 可以循环读取
      */
     int EyerAVReader::Read(EyerAVPacket & packet)
     {
-        int ret = av_read_frame(piml->formatCtx, packet.piml->packet);
+        // av_read_frame 不会释放 packet 原有的数据，复用时需要先释放
+        packet.Unref();
+        int ret = av_read_frame(piml->formatCtx, packet.GetPrivate()->packet);
         if(!ret){
             int streamIndex = packet.GetStreamIndex();
             int64_t start_time = piml->formatCtx->streams[streamIndex]->start_time;
             // 检查起始时间是否有效
             if(start_time != AV_NOPTS_VALUE){
-                packet.piml->packet->pts -= start_time;
+                if(packet.GetPrivate()->packet->pts != AV_NOPTS_VALUE){
+                    packet.GetPrivate()->packet->pts -= start_time;
+                }
+                if(packet.GetPrivate()->packet->dts != AV_NOPTS_VALUE){
+                    packet.GetPrivate()->packet->dts -= start_time;
+                }
             }
-            int64_t pts = packet.piml->packet->pts;
+            int64_t pts = packet.GetPrivate()->packet->pts;
             // 检查 PTS 是否有效
             if(pts != AV_NOPTS_VALUE){
-                packet.piml->secPTS = pts * av_q2d(piml->formatCtx->streams[streamIndex]->time_base);
+                packet.GetPrivate()->secPTS = pts * av_q2d(piml->formatCtx->streams[streamIndex]->time_base);
             }
 
             /*
-            uint8_t * buf       = (uint8_t *)packet.piml->packet->data;
-            uint8_t * sidebuf   = (uint8_t *)packet.piml->packet->side_data->data + 8;
+            uint8_t * buf       = (uint8_t *)packet.GetPrivate()->packet->data;
+            uint8_t * sidebuf   = (uint8_t *)packet.GetPrivate()->packet->side_data->data + 8;
 
             int keyframe  = !(buf[0] & 1);
             int profile   =  (buf[0]>>1) & 7;
@@ -365,7 +361,7 @@ namespace Eyer {
             int sideprofile   =  (sidebuf[0]>>1) & 7;
             int sideinvisible = !(sidebuf[0] & 0x10);
             */
-            // EyerLog("key: %2d, %5d   xxxxxxxxxxxxx  key: %2d, %5d\n", keyframe, packet.piml->packet->size, sidekeyframe, packet.piml->packet->side_data->size);
+            // EyerLog("key: %2d, %5d   xxxxxxxxxxxxx  key: %2d, %5d\n", keyframe, packet.GetPrivate()->packet->size, sidekeyframe, packet.GetPrivate()->packet->side_data->size);
         }
         return ret;
     }
@@ -415,4 +411,21 @@ namespace Eyer {
         int audioStream = av_find_best_stream(piml->formatCtx, AVMEDIA_TYPE_AUDIO, -1, -1, NULL, 0);
         return audioStream;
     }
+
+    /**
+     * @brief 设置是否丢弃指定流
+     * @param streamIndex 流索引
+     * @param discard true 表示丢弃，false 表示恢复读取
+     * @return 0 表示成功，-1 表示流索引无效
+     *
+     * 设置 AVStream::discard，解封装器跳过丢弃流的数据（MOV 按样本表直接跳过，不读取）
+     */
+    int EyerAVReader::SetStreamDiscard(int streamIndex, bool discard)
+    {
+        if(piml->formatCtx == nullptr || streamIndex < 0 || streamIndex >= piml->formatCtx->nb_streams){
+            return -1;
+        }
+        piml->formatCtx->streams[streamIndex]->discard = discard ? AVDISCARD_ALL : AVDISCARD_DEFAULT;
+        return 0;
+    }
 }
\ No newline at end of file
@@ -223,6 +223,18 @@ namespace Eyer
          */
         int GetVideoStreamIndex() const;
 
+        /**
+         * @brief 设置是否丢弃指定流
+         * @param streamIndex 流索引
+         * @param discard true 表示丢弃，false 表示恢复读取
+         * @return 0 表示成功，-1 表示流索引无效
+         *
+         * 丢弃的流在解封装时直接跳过，Read 不再返回它的数据包
+         * MP4/MOV、MKV 等格式跳过时不读取数据，只处理部分流时可以减少 IO 和解析开销
+         * 需要在 Open 之后调用
+         */
+        int SetStreamDiscard(int streamIndex, bool discard);
+
     private:
         // 禁用拷贝构造和赋值操作（避免资源管理问题）
         EyerAVReader(const EyerAVReader & reader) = delete;
@@ -3,30 +3,59 @@
 #include "EyerAVResamplePrivate.hpp"
 #include "EyerCore/EyerCore.hpp"
 #include "EyerAVFramePrivate.hpp"
-#include "EyerMath/EyerMath.hpp"
 
 namespace Eyer
 {
-    EyerAVResample::EyerAVResample()
+    // 保证转换缓冲区至少能放下 sampleNum 个输出采样
+    static int EyerAVResample_ReserveConvert(EyerAVResamplePrivate * piml, int sampleNum)
     {
-        piml = new EyerAVResamplePrivate();
+        if(sampleNum <= piml->convertCapacity){
+            return 0;
+        }
+        if(piml->convertData != nullptr){
+            av_freep(&piml->convertData[0]);
+            av_freep(&piml->convertData);
+        }
+        piml->convertCapacity = 0;
+
+        // 多留一些, 输入帧大小变化时不用反复重新分配
+        int capacity = FFMAX(sampleNum, 4096);
+        int ret = av_samples_alloc_array_and_samples(&piml->convertData, NULL, piml->outputChannels, capacity, (AVSampleFormat)piml->outputSampleFormat.ffmpegId, 0);
+        if(ret < 0){
+            piml->convertData = nullptr;
+            return -1;
+        }
+        piml->convertCapacity = capacity;
+        return 0;
     }
 
-    EyerAVResample::~EyerAVResample()
+    static int EyerAVResample_Release(EyerAVResamplePrivate * piml)
     {
-        if(piml->inputFifo != nullptr){
-            av_audio_fifo_free(piml->inputFifo);
-            piml->inputFifo = nullptr;
-        }
         if(piml->outputFifo != nullptr){
             av_audio_fifo_free(piml->outputFifo);
             piml->outputFifo = nullptr;
         }
+        if(piml->convertData != nullptr){
+            av_freep(&piml->convertData[0]);
+            av_freep(&piml->convertData);
+        }
+        piml->convertCapacity = 0;
         if(piml->swrCtx != nullptr){
             swr_free(&piml->swrCtx);
             piml->swrCtx = nullptr;
         }
+        return 0;
+    }
+
+    EyerAVResample::EyerAVResample()
+    {
+        piml = new EyerAVResamplePrivate();
+    }
+
+    EyerAVResample::~EyerAVResample()
+    {
         if(piml != nullptr){
+            EyerAVResample_Release(piml);
             delete piml;
             piml = nullptr;
         }
@@ -42,6 +71,9 @@ namespace Eyer
             int                     _inputSamplerate
     )
     {
+        EyerAVResample_Release(piml);
+        piml->totleOutputSampleNB = 0;
+
         piml->inputSamplerate = _inputSamplerate;
         piml->outputSamplerate = _outputSamplerate;
         piml->inputChannelLayout = _inputChannelLayout;
@@ -62,121 +94,98 @@ namespace Eyer
                 0,
                 NULL
         );
-        swr_init(piml->swrCtx);
-
-        int channels = av_get_channel_layout_nb_channels(piml->inputChannelLayout.GetFFmpegId());
-        piml->inputFifo = av_audio_fifo_alloc((AVSampleFormat)piml->inputSampleFormat.ffmpegId, channels, piml->inputSamplerate);
-
-        channels = av_get_channel_layout_nb_channels(piml->outputChannelLayout.GetFFmpegId());
-        piml->outputFifo = av_audio_fifo_alloc((AVSampleFormat)piml->outputSampleFormat.ffmpegId, channels, piml->outputSamplerate);
-
-        if(piml->inputSamplerate != piml->outputSamplerate){
-            int commonDivisor = Eyer::Eath::GetGreatestCommonDivisor(piml->inputSamplerate, piml->outputSamplerate);
-            piml->inputBlockSize = piml->inputSamplerate / commonDivisor;
-            piml->outputBlockSize = piml->outputSamplerate / commonDivisor;
+        if(piml->swrCtx == nullptr){
+            EyerLog("EyerAVResample swr_alloc_set_opts fail\n");
+            return -1;
         }
-        else {
-            piml->inputBlockSize = 1024;
-            piml->outputBlockSize = 1024;
+        int ret = swr_init(piml->swrCtx);
+        if(ret < 0){
+            EyerLog("EyerAVResample swr_init fail\n");
+            swr_free(&piml->swrCtx);
+            piml->swrCtx = nullptr;
+            return -1;
         }
 
-        EyerLog("Input: %d\n", piml->inputBlockSize);
-        EyerLog("Output: %d\n", piml->outputBlockSize);
+        piml->outputChannels = av_get_channel_layout_nb_channels(piml->outputChannelLayout.GetFFmpegId());
+        piml->outputFifo = av_audio_fifo_alloc((AVSampleFormat)piml->outputSampleFormat.ffmpegId, piml->outputChannels, piml->outputSamplerate);
+        if(piml->outputFifo == nullptr){
+            return -1;
+        }
 
         return 0;
     }
 
     int EyerAVResample::PutAVFrame(EyerAVFrame & frame)
     {
-        av_audio_fifo_write(piml->inputFifo,
-                            (void **)frame.piml->frame->data,
-                            frame.piml->frame->nb_samples
-                            );
-
-
-        while(1){
-            int inputSize = av_audio_fifo_size(piml->inputFifo);
-            if(inputSize < piml->inputBlockSize) {
-                break;
-            }
-            // 读取，重裁样
-            EyerAVFrame inputFrame;
-            inputFrame.piml->frame->channel_layout      = piml->inputChannelLayout.GetFFmpegId();
-            inputFrame.piml->frame->channels            = av_get_channel_layout_nb_channels(inputFrame.piml->frame->channel_layout);
-            inputFrame.piml->frame->sample_rate         = piml->inputSamplerate;
-            inputFrame.piml->frame->format              = piml->inputSampleFormat.ffmpegId;
-            inputFrame.piml->frame->nb_samples          = piml->inputBlockSize;
-            av_frame_get_buffer(inputFrame.piml->frame, 1);
-
-            av_audio_fifo_read(piml->inputFifo, (void **)inputFrame.piml->frame->data, inputFrame.piml->frame->nb_samples);
-
-            EyerAVFrame outputFrame;
-            outputFrame.piml->frame->channel_layout     = piml->outputChannelLayout.GetFFmpegId();
-            outputFrame.piml->frame->channels           = av_get_channel_layout_nb_channels(outputFrame.piml->frame->channel_layout);
-            outputFrame.piml->frame->sample_rate        = piml->outputSamplerate;
-            outputFrame.piml->frame->format             = piml->outputSampleFormat.ffmpegId;
-
-            int ret = swr_convert_frame(piml->swrCtx, outputFrame.piml->frame, inputFrame.piml->frame);
-
-            av_audio_fifo_write(piml->outputFifo, (void **)outputFrame.piml->frame->data, outputFrame.piml->frame->nb_samples);
+        if(piml->swrCtx == nullptr){
+            return -1;
+        }
+        AVFrame * inputFrame = frame.GetPrivate()->frame;
+        if(inputFrame->nb_samples <= 0){
+            return 0;
         }
 
+        // 整帧一次转换, swr 内部保留不足一个滤波窗口的采样, 不需要按采样率的公约数切块
+        int outSamples = swr_get_out_samples(piml->swrCtx, inputFrame->nb_samples);
+        if(outSamples < 0){
+            return -1;
+        }
+        if(EyerAVResample_ReserveConvert(piml, outSamples)){
+            return -1;
+        }
+        int ret = swr_convert(piml->swrCtx, piml->convertData, piml->convertCapacity, (const uint8_t **)inputFrame->extended_data, inputFrame->nb_samples);
+        if(ret < 0){
+            EyerLog("EyerAVResample swr_convert fail: %d\n", ret);
+            return -1;
+        }
+        if(ret > 0){
+            av_audio_fifo_write(piml->outputFifo, (void **)piml->convertData, ret);
+        }
         return 0;
     }
 
     int EyerAVResample::PutAVFrameNULL()
     {
-        int inputSize = av_audio_fifo_size(piml->inputFifo);
-        int length = inputSize % piml->inputBlockSize;
-        if(length > 0){
-            // 添加补齐数据
-            EyerAVFrame inputFrame;
-            inputFrame.piml->frame->channel_layout      = piml->inputChannelLayout.GetFFmpegId();
-            inputFrame.piml->frame->channels            = av_get_channel_layout_nb_channels(inputFrame.piml->frame->channel_layout);
-            inputFrame.piml->frame->sample_rate         = piml->inputSamplerate;
-            inputFrame.piml->frame->format              = piml->inputSampleFormat.ffmpegId;
-            inputFrame.piml->frame->nb_samples          = length;
-            av_frame_get_buffer(inputFrame.piml->frame, 16);
-
-            EyerLog("Fill : %d\n", inputFrame.piml->frame->nb_samples);
-            // TODO 清0
-            // Planner
-            /*
-            for(int i=0;i<inputFrame.piml->frame->channels;i++){
-                int bytes = av_get_bytes_per_sample((AVSampleFormat)inputFrame.piml->frame->format);
-                memset(inputFrame.piml->frame->data[i], 0, inputFrame.piml->frame->nb_samples * bytes);
+        if(piml->swrCtx == nullptr){
+            return -1;
+        }
+        // 取出重采样器中延迟的采样, 直到没有输出
+        while(1){
+            int outSamples = swr_get_out_samples(piml->swrCtx, 0);
+            if(outSamples <= 0){
+                break;
             }
-            */
-
-            // PutAVFrame(inputFrame);
+            if(EyerAVResample_ReserveConvert(piml, outSamples)){
+                return -1;
+            }
+            int ret = swr_convert(piml->swrCtx, piml->convertData, piml->convertCapacity, NULL, 0);
+            if(ret <= 0){
+                break;
+            }
+            av_audio_fifo_write(piml->outputFifo, (void **)piml->convertData, ret);
         }
         return 0;
     }
 
-    int EyerAVResample::GetLastFrame(EyerAVFrame & frame, int frameSize)
+    int EyerAVResample::GetLastFrame(EyerAVFrame & frame, int frameSize, bool padSilence)
     {
         int size = av_audio_fifo_size(piml->outputFifo);
+        if(size <= 0){
+            return -1;
+        }
+        if(size < frameSize && !padSilence){
+            return GetFrame(frame, size);
+        }
         if(size < frameSize){
+            // 不足一帧的部分补静音
             int length = frameSize - size;
-            EyerAVFrame fillFrame;
-            fillFrame.piml->frame->channel_layout       = piml->outputChannelLayout.GetFFmpegId();
-            fillFrame.piml->frame->channels             = av_get_channel_layout_nb_channels(fillFrame.piml->frame->channel_layout);
-            fillFrame.piml->frame->sample_rate          = piml->outputSamplerate;
-            fillFrame.piml->frame->format               = piml->outputSampleFormat.ffmpegId;
-            fillFrame.piml->frame->nb_samples           = length;
-            av_frame_get_buffer(fillFrame.piml->frame, 16);
-            /*
-            for(int i=0;i<fillFrame.piml->frame->channels;i++){
-                int bytes = av_get_bytes_per_sample((AVSampleFormat)fillFrame.piml->frame->format);
-                memset(fillFrame.piml->frame->data[i], 0, fillFrame.piml->frame->nb_samples * bytes);
+            if(EyerAVResample_ReserveConvert(piml, length)){
+                return -1;
             }
-            */
-            EyerLog("Fill : %d\n", fillFrame.piml->frame->nb_samples);
-            av_audio_fifo_write(piml->outputFifo, (void **)fillFrame.piml->frame->data, fillFrame.piml->frame->nb_samples);
-            GetFrame(frame, frameSize);
+            av_samples_set_silence(piml->convertData, 0, length, piml->outputChannels, (AVSampleFormat)piml->outputSampleFormat.ffmpegId);
+            av_audio_fifo_write(piml->outputFifo, (void **)piml->convertData, length);
         }
-
-        return 0;
+        return GetFrame(frame, frameSize);
     }
 
     int EyerAVResample::GetFrame(EyerAVFrame & frame, int frameSize)
@@ -186,20 +195,30 @@ namespace Eyer
             return -1;
         }
 
-        frame.piml->frame->channel_layout       = piml->outputChannelLayout.GetFFmpegId();
-        frame.piml->frame->channels             = av_get_channel_layout_nb_channels(frame.piml->frame->channel_layout);
-        frame.piml->frame->sample_rate          = piml->outputSamplerate;
-        frame.piml->frame->format               = piml->outputSampleFormat.ffmpegId;
-        frame.piml->frame->nb_samples           = frameSize;
-        av_frame_get_buffer(frame.piml->frame, 1);
+        frame.GetPrivate()->frame->channel_layout       = piml->outputChannelLayout.GetFFmpegId();
+        frame.GetPrivate()->frame->channels             = piml->outputChannels;
+        frame.GetPrivate()->frame->sample_rate          = piml->outputSamplerate;
+        frame.GetPrivate()->frame->format               = piml->outputSampleFormat.ffmpegId;
+        frame.GetPrivate()->frame->nb_samples           = frameSize;
+        if(piml->framePool.GetBuffer(frame)){
+            return -1;
+        }
 
-        av_audio_fifo_read(piml->outputFifo, (void **)frame.piml->frame->data, frame.piml->frame->nb_samples);
-        piml->totleOutputSampleNB += frame.piml->frame->nb_samples;
+        av_audio_fifo_read(piml->outputFifo, (void **)frame.GetPrivate()->frame->data, frame.GetPrivate()->frame->nb_samples);
+        piml->totleOutputSampleNB += frame.GetPrivate()->frame->nb_samples;
         return 0;
     }
 
+    int EyerAVResample::GetBufferSampleNB()
+    {
+        if(piml->outputFifo == nullptr){
+            return 0;
+        }
+        return av_audio_fifo_size(piml->outputFifo);
+    }
+
     int64_t EyerAVResample::GetTotleOutputSampleNB()
     {
         return piml->totleOutputSampleNB;
     }
-}
\ No newline at end of file
+}
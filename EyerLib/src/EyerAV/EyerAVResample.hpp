@@ -24,11 +24,18 @@ namespace Eyer
                 int                     inputSamplerate
                 );
 
+        // 整帧转换后放入输出缓冲, 输入帧的参数需要和 Init 的输入参数一致
         int PutAVFrame(EyerAVFrame & frame);
+        // 输入结束, 取出重采样器中延迟的采样, 之后用 GetFrame/GetLastFrame 取完
         int PutAVFrameNULL();
+        // 输出缓冲中不足 frameSize 时返回 -1
         int GetFrame(EyerAVFrame & frame, int frameSize);
-        int GetLastFrame(EyerAVFrame & frame, int frameSize);
+        // 取最后一帧, 输出缓冲为空时返回 -1
+        // padSilence 为 true 时不足 frameSize 的部分补静音, 否则输出剩余的采样, 编码器支持短的最后一帧时使用
+        int GetLastFrame(EyerAVFrame & frame, int frameSize, bool padSilence = true);
 
+        // 输出缓冲中剩余的采样数
+        int GetBufferSampleNB();
         int64_t GetTotleOutputSampleNB();
 
         EyerAVResamplePrivate * piml = nullptr;
@@ -2,6 +2,7 @@
 #define EYERLIB_EYERAVRESAMPLEPRIVATE_HPP
 
 #include "EyerAVFFmpegHeader.hpp"
+#include "EyerAVFramePool.hpp"
 
 namespace Eyer
 {
@@ -17,13 +18,19 @@ namespace Eyer
         int outputSamplerate;
         int inputSamplerate;
 
-        AVAudioFifo * inputFifo = nullptr;
+        int outputChannels = 0;
+
+        // 整帧直接转换到 convertData, 再写入 outputFifo, GetFrame 从 outputFifo 按编码器帧大小读取
         AVAudioFifo * outputFifo = nullptr;
 
-        int inputBlockSize = 0;
-        int outputBlockSize = 0;
+        // 转换缓冲区只在需要更大时重新分配, 之后一直复用
+        uint8_t ** convertData = nullptr;
+        int convertCapacity = 0;
 
         int64_t totleOutputSampleNB = 0;
+
+        // 输出帧大小固定, 数据块可以一直复用
+        EyerAVFramePool framePool;
     };
 }
 
@@ -0,0 +1,82 @@
+#include "EyerAVScaleQuality.hpp"
+
+#include "EyerAVFFmpegHeader.hpp"
+
+namespace Eyer
+{
+    EyerAVScaleQuality EyerAVScaleQuality::FAST_BILINEAR    (1, SWS_FAST_BILINEAR,  "FAST_BILINEAR");
+    EyerAVScaleQuality EyerAVScaleQuality::BICUBIC          (2, SWS_BICUBIC,        "BICUBIC");
+    EyerAVScaleQuality EyerAVScaleQuality::LANCZOS          (3, SWS_LANCZOS,        "LANCZOS");
+    EyerAVScaleQuality EyerAVScaleQuality::SINC             (4, SWS_SINC,           "SINC");
+
+    EyerAVScaleQuality EyerAVScaleQuality::GetById(int id)
+    {
+        if(id == FAST_BILINEAR.GetId()){
+            return FAST_BILINEAR;
+        }
+        else if(id == BICUBIC.GetId()){
+            return BICUBIC;
+        }
+        else if(id == LANCZOS.GetId()){
+            return LANCZOS;
+        }
+        return SINC;
+    }
+
+    EyerAVScaleQuality::EyerAVScaleQuality()
+    {
+        id = 4;
+        ffmpegFlags = SWS_SINC;
+        name = "SINC";
+    }
+
+    EyerAVScaleQuality::EyerAVScaleQuality(int _id, int _ffmpegFlags, const EyerString & _name)
+    {
+        id = _id;
+        ffmpegFlags = _ffmpegFlags;
+        name = _name;
+    }
+
+    EyerAVScaleQuality::EyerAVScaleQuality(const EyerAVScaleQuality & quality)
+    {
+        *this = quality;
+    }
+
+    EyerAVScaleQuality::~EyerAVScaleQuality()
+    {
+
+    }
+
+    EyerAVScaleQuality & EyerAVScaleQuality::operator = (const EyerAVScaleQuality & quality)
+    {
+        id = quality.id;
+        ffmpegFlags = quality.ffmpegFlags;
+        name = quality.name;
+        return *this;
+    }
+
+    bool EyerAVScaleQuality::operator == (const EyerAVScaleQuality & quality) const
+    {
+        return id == quality.id;
+    }
+
+    bool EyerAVScaleQuality::operator != (const EyerAVScaleQuality & quality) const
+    {
+        return id != quality.id;
+    }
+
+    const int EyerAVScaleQuality::GetId() const
+    {
+        return id;
+    }
+
+    const int EyerAVScaleQuality::GetFFmpegFlags() const
+    {
+        return ffmpegFlags;
+    }
+
+    const EyerString EyerAVScaleQuality::GetName() const
+    {
+        return name;
+    }
+}
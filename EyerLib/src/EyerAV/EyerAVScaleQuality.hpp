@@ -0,0 +1,40 @@
+#ifndef EYERLIB_EYERAVSCALEQUALITY_HPP
+#define EYERLIB_EYERAVSCALEQUALITY_HPP
+
+#include "EyerCore/EyerCore.hpp"
+
+namespace Eyer
+{
+    // swscale 插值算法预设, 从快到慢: FAST_BILINEAR < BICUBIC < LANCZOS < SINC
+    class EyerAVScaleQuality
+    {
+    public:
+        static EyerAVScaleQuality FAST_BILINEAR;
+        static EyerAVScaleQuality BICUBIC;
+        static EyerAVScaleQuality LANCZOS;
+        static EyerAVScaleQuality SINC;
+
+        static EyerAVScaleQuality GetById(int id);
+
+        EyerAVScaleQuality();
+        EyerAVScaleQuality(int id, int ffmpegFlags, const EyerString & name);
+        EyerAVScaleQuality(const EyerAVScaleQuality & quality);
+        ~EyerAVScaleQuality();
+
+        EyerAVScaleQuality & operator = (const EyerAVScaleQuality & quality);
+
+        bool operator == (const EyerAVScaleQuality & quality) const;
+        bool operator != (const EyerAVScaleQuality & quality) const;
+
+        const int GetId() const;
+        const int GetFFmpegFlags() const;
+        const EyerString GetName() const;
+
+    private:
+        int id = 0;
+        int ffmpegFlags = 0;
+        EyerString name = "";
+    };
+}
+
+#endif //EYERLIB_EYERAVSCALEQUALITY_HPP
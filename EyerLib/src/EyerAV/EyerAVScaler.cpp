@@ -0,0 +1,128 @@
+#include "EyerAVScaler.hpp"
+
+#include "EyerAVScalerPrivate.hpp"
+#include "EyerAVFramePrivate.hpp"
+
+namespace Eyer
+{
+    EyerAVScaler::EyerAVScaler()
+    {
+        piml = new EyerAVScalerPrivate();
+    }
+
+    EyerAVScaler::~EyerAVScaler()
+    {
+        Reset();
+        if(piml != nullptr){
+            delete piml;
+            piml = nullptr;
+        }
+    }
+
+    int EyerAVScaler::Reset()
+    {
+        if(piml->swsContext != nullptr){
+            sws_freeContext(piml->swsContext);
+            piml->swsContext = nullptr;
+        }
+        return 0;
+    }
+
+    int EyerAVScaler::SetQuality(const EyerAVScaleQuality & quality)
+    {
+        piml->quality = quality;
+        return 0;
+    }
+
+    const EyerAVScaleQuality EyerAVScaler::GetQuality() const
+    {
+        return piml->quality;
+    }
+
+    int EyerAVScaler::Scale(const EyerAVFrame & srcFrame, EyerAVFrame & dstFrame, const EyerAVPixelFormat format)
+    {
+        return Scale(srcFrame, dstFrame, format, srcFrame.GetWidth(), srcFrame.GetHeight());
+    }
+
+    int EyerAVScaler::Scale(const EyerAVFrame & srcFrame, EyerAVFrame & dstFrame, const int dstW, const int dstH)
+    {
+        return Scale(srcFrame, dstFrame, EyerAVPixelFormat::EYER_KEEP_SAME, dstW, dstH);
+    }
+
+    int EyerAVScaler::Scale(const EyerAVFrame & srcFrame, EyerAVFrame & dstFrame, const EyerAVPixelFormat distformat, int dstW, int dstH)
+    {
+        AVFrame * src = srcFrame.GetPrivate()->frame;
+        AVFrame * dst = dstFrame.GetPrivate()->frame;
+
+        int srcW = src->width;
+        int srcH = src->height;
+        int srcFormat = src->format;
+
+        int dstFormat = srcFormat;
+        if(distformat != EyerAVPixelFormat::EYER_KEEP_SAME){
+            dstFormat = distformat.GetFFmpegId();
+        }
+        if(dstW <= 0){
+            dstW = srcW;
+        }
+        if(dstH <= 0){
+            dstH = srcH;
+        }
+
+        if(dstFormat == srcFormat && dstW == srcW && dstH == srcH){
+            dstFrame = srcFrame;
+            return 0;
+        }
+
+        // 参数变化时才重建 SwsContext
+        int flags = piml->quality.GetFFmpegFlags();
+        if(piml->swsContext == nullptr || piml->flags != flags ||
+           piml->srcW != srcW || piml->srcH != srcH || piml->srcFormat != srcFormat ||
+           piml->dstW != dstW || piml->dstH != dstH || piml->dstFormat != dstFormat){
+            Reset();
+            piml->swsContext = sws_getContext(srcW, srcH, (AVPixelFormat)srcFormat, dstW, dstH, (AVPixelFormat)dstFormat, flags, NULL, NULL, NULL);
+            if(piml->swsContext == nullptr){
+                return -1;
+            }
+            piml->flags = flags;
+            piml->srcW = srcW;
+            piml->srcH = srcH;
+            piml->srcFormat = srcFormat;
+            piml->dstW = dstW;
+            piml->dstH = dstH;
+            piml->dstFormat = dstFormat;
+        }
+
+        av_frame_copy_props(dst, src);
+
+        dst->pict_type = AVPictureType::AV_PICTURE_TYPE_NONE;
+
+        dst->format    = dstFormat;
+        dst->width     = dstW;
+        dst->height    = dstH;
+
+        dstFrame.GetPrivate()->secPTS = srcFrame.GetPrivate()->secPTS;
+
+        if(piml->framePool.GetBuffer(dstFrame)){
+            return -1;
+        }
+
+        int ret = sws_scale(
+                piml->swsContext,
+                src->data,
+                src->linesize,
+                0,
+                srcH,
+
+                dst->data,
+                dst->linesize
+        );
+        // 失败时不把没写过的缓冲区交给调用者
+        if(ret <= 0){
+            av_frame_unref(dst);
+            return -1;
+        }
+
+        return 0;
+    }
+}
@@ -0,0 +1,39 @@
+#ifndef EYERLIB_EYERAVSCALER_HPP
+#define EYERLIB_EYERAVSCALER_HPP
+
+#include "EyerAVFrame.hpp"
+#include "EyerAVPixelFormat.hpp"
+#include "EyerAVScaleQuality.hpp"
+
+namespace Eyer
+{
+    class EyerAVScalerPrivate;
+
+    // 缓存 SwsContext, 源/目标的宽高、像素格式和算法不变时复用, 避免每帧重建滤波表
+    // 输出帧的数据从内部的 EyerAVFramePool 中取, linesize 按 64 字节对齐
+    // 非线程安全, 每个流(每个线程)持有一个
+    class EyerAVScaler
+    {
+    public:
+        EyerAVScaler();
+        ~EyerAVScaler();
+
+        EyerAVScaler(const EyerAVScaler & scaler) = delete;
+        EyerAVScaler & operator = (const EyerAVScaler & scaler) = delete;
+
+        int Scale(const EyerAVFrame & srcFrame, EyerAVFrame & dstFrame, const EyerAVPixelFormat format, int dstW, int dstH);
+        int Scale(const EyerAVFrame & srcFrame, EyerAVFrame & dstFrame, const EyerAVPixelFormat format);
+        int Scale(const EyerAVFrame & srcFrame, EyerAVFrame & dstFrame, const int dstW, const int dstH);
+
+        // 修改算法后, 下一次 Scale 会重建 SwsContext
+        int SetQuality(const EyerAVScaleQuality & quality);
+        const EyerAVScaleQuality GetQuality() const;
+
+        int Reset();
+
+    private:
+        EyerAVScalerPrivate * piml = nullptr;
+    };
+}
+
+#endif //EYERLIB_EYERAVSCALER_HPP
@@ -0,0 +1,32 @@
+#ifndef EYERLIB_EYERAVSCALERPRIVATE_HPP
+#define EYERLIB_EYERAVSCALERPRIVATE_HPP
+
+#include "EyerAVFFmpegHeader.hpp"
+#include "EyerAVScaleQuality.hpp"
+#include "EyerAVFramePool.hpp"
+
+namespace Eyer
+{
+    class EyerAVScalerPrivate
+    {
+    public:
+        SwsContext * swsContext = nullptr;
+
+        int srcW = 0;
+        int srcH = 0;
+        int srcFormat = AV_PIX_FMT_NONE;
+
+        int dstW = 0;
+        int dstH = 0;
+        int dstFormat = AV_PIX_FMT_NONE;
+
+        // 当前 swsContext 创建时使用的算法
+        int flags = SWS_SINC;
+        EyerAVScaleQuality quality = EyerAVScaleQuality::SINC;
+
+        // 输出帧的数据块, 尺寸不变时循环复用
+        EyerAVFramePool framePool;
+    };
+}
+
+#endif //EYERLIB_EYERAVSCALERPRIVATE_HPP
@@ -0,0 +1,197 @@
+#include "EyerAVSharedFrameCache.hpp"
+
+#include <math.h>
+
+#include "EyerAVFileUtil.hpp"
+
+namespace Eyer
+{
+    EyerAVSharedFrameCache & EyerAVSharedFrameCache::GetInstance()
+    {
+        static EyerAVSharedFrameCache instance;
+        return instance;
+    }
+
+    EyerString EyerAVSharedFrameCache::GetKey(const EyerString & path, EyerAVReaderCustomIO * customIO, const EyerAVDecoderLineParams & params)
+    {
+        // 自定义 IO 的 path 不能代表数据, IO 对象的地址也可能被复用, 不缓存
+        if(customIO != nullptr){
+            return "";
+        }
+        int64_t fileSize = 0;
+        int64_t fileMtime = 0;
+        if(EyerAVFileUtil::GetFileInfo(path, fileSize, fileMtime)){
+            return "";
+        }
+        EyerString key = EyerString::Sprintf("%s|%lld|%lld", path.c_str(), (long long)fileSize, (long long)fileMtime);
+        if(params.isScale){
+            key = key + EyerString::Sprintf("|%d|%dx%d|%d", params.pixelFormat.GetId(), params.scaleWidth, params.scaleHeight, params.scaleQuality.GetId());
+        }
+        return key;
+    }
+
+    EyerAVSharedFrameCache::EyerAVSharedFrameCache()
+    {
+
+    }
+
+    EyerAVSharedFrameCache::~EyerAVSharedFrameCache()
+    {
+
+    }
+
+    int EyerAVSharedFrameCache::SetMaxBytes(int64_t _maxBytes)
+    {
+        std::lock_guard<std::mutex> lg(mut);
+        maxBytes = _maxBytes;
+        ReleaseOverBudget();
+        return 0;
+    }
+
+    int64_t EyerAVSharedFrameCache::GetMaxBytes()
+    {
+        std::lock_guard<std::mutex> lg(mut);
+        return maxBytes;
+    }
+
+    int EyerAVSharedFrameCache::Put(const EyerString & key, EyerAVFrame & frame, double nextPTS)
+    {
+        std::lock_guard<std::mutex> lg(mut);
+        if(maxBytes <= 0 || key.IsEmpty()){
+            return -1;
+        }
+
+        double pts = frame.GetSecPTS();
+        std::map<double, Item> & frameMap = fileMap[key];
+        std::map<double, Item>::iterator it = frameMap.find(pts);
+        if(it != frameMap.end()){
+            // 已经有了, 补上下一帧的位置
+            if(nextPTS >= 0.0){
+                it->second.nextPTS = nextPTS;
+            }
+            Touch(key, pts, it->second);
+            return 0;
+        }
+
+        Item & item = frameMap[pts];
+        item.frame = frame;
+        item.nextPTS = nextPTS;
+        item.bytes = frame.GetBufferSize();
+        Touch(key, pts, item);
+
+        bytes += item.bytes;
+        frameNum++;
+        ReleaseOverBudget();
+        return 0;
+    }
+
+    int EyerAVSharedFrameCache::Get(const EyerString & key, double pts, EyerAVFrame & frame)
+    {
+        std::lock_guard<std::mutex> lg(mut);
+        std::map<EyerString, std::map<double, Item>>::iterator fileIt = fileMap.find(key);
+        if(fileIt == fileMap.end()){
+            missNum++;
+            return -1;
+        }
+        std::map<double, Item> & frameMap = fileIt->second;
+
+        // pts 之前最近的一帧
+        std::map<double, Item>::iterator it = frameMap.upper_bound(pts);
+        if(it == frameMap.begin()){
+            missNum++;
+            return -1;
+        }
+        it--;
+
+        double lastPTS = it->first;
+        Item * res = &it->second;
+        if(lastPTS != pts){
+            double nextPTS = it->second.nextPTS;
+            if(nextPTS < 0.0 || nextPTS <= pts){
+                // 不知道后面还有没有帧
+                missNum++;
+                return -1;
+            }
+            // 和 EyerAVDecoderLine::SearchFrameInCache 一样, 距离相同时取后一帧
+            if(fabs(lastPTS - pts) >= fabs(nextPTS - pts)){
+                std::map<double, Item>::iterator nextIt = frameMap.find(nextPTS);
+                if(nextIt == frameMap.end()){
+                    missNum++;
+                    return -1;
+                }
+                res = &nextIt->second;
+            }
+        }
+
+        frame = res->frame;
+        Touch(key, frame.GetSecPTS(), *res);
+        hitNum++;
+        return 0;
+    }
+
+    int EyerAVSharedFrameCache::Clear()
+    {
+        std::lock_guard<std::mutex> lg(mut);
+        fileMap.clear();
+        lruMap.clear();
+        bytes = 0;
+        frameNum = 0;
+        return 0;
+    }
+
+    int64_t EyerAVSharedFrameCache::GetBytes()
+    {
+        std::lock_guard<std::mutex> lg(mut);
+        return bytes;
+    }
+
+    int EyerAVSharedFrameCache::GetFrameNum()
+    {
+        std::lock_guard<std::mutex> lg(mut);
+        return frameNum;
+    }
+
+    int64_t EyerAVSharedFrameCache::GetHitNum()
+    {
+        std::lock_guard<std::mutex> lg(mut);
+        return hitNum;
+    }
+
+    int64_t EyerAVSharedFrameCache::GetMissNum()
+    {
+        std::lock_guard<std::mutex> lg(mut);
+        return missNum;
+    }
+
+    int EyerAVSharedFrameCache::Touch(const EyerString & key, double pts, Item & item)
+    {
+        if(item.useTick > 0){
+            lruMap.erase(item.useTick);
+        }
+        useTick++;
+        item.useTick = useTick;
+        lruMap[useTick] = std::pair<EyerString, double>(key, pts);
+        return 0;
+    }
+
+    int EyerAVSharedFrameCache::ReleaseOverBudget()
+    {
+        while(bytes > maxBytes && lruMap.size() > 0){
+            std::map<int64_t, std::pair<EyerString, double>>::iterator lruIt = lruMap.begin();
+            std::map<EyerString, std::map<double, Item>>::iterator fileIt = fileMap.find(lruIt->second.first);
+            if(fileIt != fileMap.end()){
+                std::map<double, Item>::iterator it = fileIt->second.find(lruIt->second.second);
+                if(it != fileIt->second.end()){
+                    bytes -= it->second.bytes;
+                    frameNum--;
+                    fileIt->second.erase(it);
+                }
+                if(fileIt->second.size() <= 0){
+                    fileMap.erase(fileIt);
+                }
+            }
+            lruMap.erase(lruIt);
+        }
+        return 0;
+    }
+}
@@ -0,0 +1,77 @@
+#ifndef EYERLIB_EYERAVSHAREDFRAMECACHE_HPP
+#define EYERLIB_EYERAVSHAREDFRAMECACHE_HPP
+
+#include <stdint.h>
+#include <map>
+#include <mutex>
+
+#include "EyerCore/EyerCore.hpp"
+#include "EyerAVFrame.hpp"
+#include "EyerAVReaderCustomIO.hpp"
+#include "EyerAVDecoderLineParams.hpp"
+
+// 最后一帧的 nextPTS
+#define EYER_AV_SHARED_FRAME_CACHE_EOF 1e300
+
+namespace Eyer
+{
+    // 进程内共享的解码帧缓存, 同一个文件的不同解码线, Box 和 Snapshot 互相复用解出的帧
+    // 按 (文件, 缩放参数) 和 PTS 查找; 每帧记录下一帧的 PTS, 知道两帧之间没有别的帧时才能按最近的一帧返回
+    // 帧是浅拷贝, 和解码线的缓存共享数据; 超出字节预算时淘汰最久没用的帧
+    class EyerAVSharedFrameCache
+    {
+    public:
+        static EyerAVSharedFrameCache & GetInstance();
+
+        // 文件路径, 大小和修改时间, 加上 isScale 时的缩放参数
+        // 自定义 IO 或者文件不存在时返回空字符串, 表示不使用共享缓存
+        static EyerString GetKey(const EyerString & path, EyerAVReaderCustomIO * customIO, const EyerAVDecoderLineParams & params);
+
+        // 0 表示不缓存
+        int SetMaxBytes(int64_t maxBytes);
+        int64_t GetMaxBytes();
+
+        // nextPTS: 下一帧的 PTS, 小于 0 表示还不知道, EYER_AV_SHARED_FRAME_CACHE_EOF 表示这是最后一帧
+        int Put(const EyerString & key, EyerAVFrame & frame, double nextPTS);
+        // 和 EyerAVDecoderLine 一样返回离 pts 最近的帧, 不确定时返回 -1
+        int Get(const EyerString & key, double pts, EyerAVFrame & frame);
+
+        int Clear();
+
+        int64_t GetBytes();
+        int GetFrameNum();
+        int64_t GetHitNum();
+        int64_t GetMissNum();
+
+    private:
+        EyerAVSharedFrameCache();
+        ~EyerAVSharedFrameCache();
+
+        class Item
+        {
+        public:
+            EyerAVFrame frame;
+            double nextPTS = -1.0;
+            int64_t bytes = 0;
+            int64_t useTick = 0;
+        };
+
+        // 调用前持有 mut
+        int Touch(const EyerString & key, double pts, Item & item);
+        int ReleaseOverBudget();
+
+        std::mutex mut;
+        std::map<EyerString, std::map<double, Item>> fileMap;
+        // 使用序号 -> (key, pts), 从小的开始淘汰
+        std::map<int64_t, std::pair<EyerString, double>> lruMap;
+        int64_t useTick = 0;
+
+        int64_t maxBytes = 256 * 1024 * 1024;
+        int64_t bytes = 0;
+        int frameNum = 0;
+        int64_t hitNum = 0;
+        int64_t missNum = 0;
+    };
+}
+
+#endif //EYERLIB_EYERAVSHAREDFRAMECACHE_HPP
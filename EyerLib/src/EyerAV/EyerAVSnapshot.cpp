@@ -1,6 +1,7 @@
 #include "EyerAVSnapshot.hpp"
 
 #include "EyerAVReader.hpp"
+#include "EyerAVSharedFrameCache.hpp"
 
 namespace Eyer
 {
@@ -8,7 +9,7 @@ namespace Eyer
         : mPath(_path)
         , mCustomIO(_customIO)
     {
-
+        SetSharedFrameCache(true);
     }
 
     EyerAVSnapshot::~EyerAVSnapshot()
@@ -40,8 +41,25 @@ namespace Eyer
         return 0;
     }
 
+    int EyerAVSnapshot::SetSharedFrameCache(bool enable)
+    {
+        mSharedCacheKey = "";
+        if(enable){
+            // 不缩放
+            mSharedCacheKey = EyerAVSharedFrameCache::GetKey(mPath, mCustomIO, EyerAVDecoderLineParams());
+        }
+        return 0;
+    }
+
     std::shared_ptr<EyerAVFrame> EyerAVSnapshot::GetFrame(double pts)
     {
+        if(!mSharedCacheKey.IsEmpty()){
+            std::shared_ptr<EyerAVFrame> sharedFrame = std::make_shared<EyerAVFrame>();
+            if(EyerAVSharedFrameCache::GetInstance().Get(mSharedCacheKey, pts, *sharedFrame) == 0){
+                return sharedFrame;
+            }
+        }
+
         while(mDecoderLineCache.size() > 2){
             std::shared_ptr<EyerAVSnapshotLine> d = nullptr;
             for(int i=0;i<mDecoderLineCache.size();i++) {
@@ -68,7 +86,7 @@ namespace Eyer
 
         std::shared_ptr<EyerAVSnapshotLine> decoderLine = FindSnapshotLine(pts);
         if(decoderLine == nullptr){
-            decoderLine = std::make_shared<EyerAVSnapshotLine>(mPath, mVideoStream, mVideoStreamIndex, pts, mCustomIO);
+            decoderLine = std::make_shared<EyerAVSnapshotLine>(mPath, mVideoStream, mVideoStreamIndex, pts, mCustomIO, mSharedCacheKey);
             mDecoderLineCache.push_back(decoderLine);
         }
 
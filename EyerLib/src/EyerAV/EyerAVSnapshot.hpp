@@ -17,6 +17,9 @@ namespace Eyer
 
         int Init();
 
+        // 默认打开, 和不缩放的 EyerAVDecoderLine 共用 EyerAVSharedFrameCache, 自定义 IO 时不使用
+        int SetSharedFrameCache(bool enable);
+
         std::shared_ptr<EyerAVFrame> GetFrame(double pts);
 
     private:
@@ -30,6 +33,9 @@ namespace Eyer
         int mVideoStreamIndex = -1;
 
         std::vector<std::shared_ptr<EyerAVSnapshotLine>> mDecoderLineCache;
+
+        // 为空时不使用共享缓存
+        EyerString mSharedCacheKey = "";
     };
 }
 
@@ -1,15 +1,17 @@
 #include "EyerAVSnapshotLine.hpp"
 
 #include "EyerAVErrorCode.hpp"
+#include "EyerAVSharedFrameCache.hpp"
 
 namespace Eyer
 {
-    EyerAVSnapshotLine::EyerAVSnapshotLine(const EyerString & _path, const EyerAVStream & _videoStream, int _videoStreamIndex, double _pts, EyerAVReaderCustomIO * _customIO)
+    EyerAVSnapshotLine::EyerAVSnapshotLine(const EyerString & _path, const EyerAVStream & _videoStream, int _videoStreamIndex, double _pts, EyerAVReaderCustomIO * _customIO, const EyerString & _sharedCacheKey)
         : mPath(_path)
         , mCustomIO(_customIO)
         , mVideoStream(_videoStream)
         , mVideoStreamIndex(_videoStreamIndex)
         , startSeekTime(_pts)
+        , sharedCacheKey(_sharedCacheKey)
     {
         reader = std::make_shared<EyerAVReader>(mPath, mCustomIO);
         reader->OpenInput();
@@ -52,12 +54,12 @@ namespace Eyer
             else if(ret == EYER_AV_DECODER_LINE_NEED_MORE_DATA){
                 // 需要更多的数据，要进行解码了x
                 // 记录当前缓存有多少帧，
-                int canDropFrames = frameCache.size() - 1;
+                int canDropFrames = frameCache.Size() - 1;
                 if(canDropFrames <= 0){
                     canDropFrames = 0;
                 }
 
-                int s = frameCache.size();
+                int s = frameCache.Size();
                 ret = DecodeFrame();
                 // EyerLog("Decode: %d\n",frameCache.size() -s );
                 ClearCache(canDropFrames);
@@ -71,8 +73,8 @@ namespace Eyer
                         return EYER_AV_DECODER_LINE_NOT_FIND;
                     }
                     else if(ret == EYER_AV_DECODER_LINE_NEED_MORE_DATA){
-                        if(frameCache.size() > 0){
-                            frame = frameCache[frameCache.size() - 1];
+                        if(frameCache.Size() > 0){
+                            frame = frameCache.Get(frameCache.Size() - 1);
                             return EYER_AV_OK;
                         }
                         return EYER_AV_DECODER_LINE_NOT_FIND;
@@ -92,42 +94,35 @@ namespace Eyer
 
     double EyerAVSnapshotLine::GetStartTime()
     {
-        if(frameCache.size() > 0){
-            return frameCache[0]->GetSecPTS();
+        if(frameCache.Size() > 0){
+            return frameCache.GetPTS(0);
         }
         return startSeekTime;
     }
 
     int EyerAVSnapshotLine::SearchFrameInCache(std::shared_ptr<EyerAVFrame> & frame, double pts)
     {
-        for(int i=0;i<frameCache.size();i++){
-            double secPTS = frameCache[i]->GetSecPTS();
-            if(secPTS == pts){
-                frame = frameCache[i];
-                return EYER_AV_OK;
-            }
-            else if(secPTS < pts){
-                continue;
-            }
-            else{
-                if(i <= 0){
-                    return EYER_AV_DECODER_LINE_NOT_MATCH_REGION;
-                }
-                double lastSecPTS = frameCache[i - 1]->GetSecPTS();
-                double nowSecPTS  = frameCache[i]->GetSecPTS();
-
-                if(abs(lastSecPTS - pts) >= abs(nowSecPTS - pts)){
-                    frame = frameCache[i];
-                    return EYER_AV_OK;
-                }
-                else{
-                    frame = frameCache[i - 1];
-                    return EYER_AV_OK;
-                }
-            }
+        int index = frameCache.LowerBound(pts);
+        if(index >= frameCache.Size()){
+            return EYER_AV_DECODER_LINE_NEED_MORE_DATA;
+        }
+        if(frameCache.GetPTS(index) == pts){
+            frame = frameCache.Get(index);
+            return EYER_AV_OK;
+        }
+        if(index <= 0){
+            return EYER_AV_DECODER_LINE_NOT_MATCH_REGION;
         }
 
-        return EYER_AV_DECODER_LINE_NEED_MORE_DATA;
+        double lastSecPTS = frameCache.GetPTS(index - 1);
+        double nowSecPTS  = frameCache.GetPTS(index);
+        if(abs(lastSecPTS - pts) >= abs(nowSecPTS - pts)){
+            frame = frameCache.Get(index);
+        }
+        else{
+            frame = frameCache.Get(index - 1);
+        }
+        return EYER_AV_OK;
     }
 
 
@@ -137,10 +132,10 @@ namespace Eyer
             if (tempFrameCache.size() > 0) {
                 std::shared_ptr<EyerAVFrame> f = tempFrameCache.front();
                 tempFrameCache.pop();
-                frameCache.push_back(f);
+                frameCache.Push(f);
                 return EYER_AV_OK;
             } else {
-                EyerAVPacket packet;
+                EyerAVPacket & packet = readPacket;
                 int ret = reader->Read(packet);
                 if (ret) {
                     ret = decoder->SendPacketNull();
@@ -148,14 +143,16 @@ namespace Eyer
                         return EYER_AV_DECODER_LINE_DECODER_ERROR;
                     }
                     while (1) {
-                        std::shared_ptr<EyerAVFrame> frame = std::make_shared<EyerAVFrame>();
+                        std::shared_ptr<EyerAVFrame> frame = NewFrame();
                         ret = decoder->RecvFrame(*(frame.get()));
                         if (ret) {
                             break;
                         }
 
+                        PutSharedFrame(frame, false);
                         tempFrameCache.push(frame);
                     }
+                    PutSharedFrame(lastDecodedFrame, true);
                     return EYER_AV_DECODER_LINE_DECODER_END_OF_FILE;
                 }
 
@@ -169,11 +166,12 @@ namespace Eyer
                 }
 
                 while (1) {
-                    std::shared_ptr<EyerAVFrame> frame = std::make_shared<EyerAVFrame>();
+                    std::shared_ptr<EyerAVFrame> frame = NewFrame();
                     ret = decoder->RecvFrame(*(frame.get()));
                     if (ret) {
                         break;
                     }
+                    PutSharedFrame(frame, false);
                     tempFrameCache.push(frame);
                 }
             }
@@ -181,20 +179,38 @@ namespace Eyer
         return EYER_AV_OK;
     }
 
+    std::shared_ptr<EyerAVFrame> EyerAVSnapshotLine::NewFrame()
+    {
+        // 帧可能被调用者持有到 EyerAVSnapshotLine 析构之后, 所以删除器里持有池的引用
+        std::shared_ptr<EyerAVFramePool> pool = framePool;
+        return std::shared_ptr<EyerAVFrame>(pool->NewFrame(), [pool](EyerAVFrame * frame){
+            pool->DeleteFrame(frame);
+        });
+    }
+
+    int EyerAVSnapshotLine::PutSharedFrame(const std::shared_ptr<EyerAVFrame> & frame, bool isEnd)
+    {
+        if(sharedCacheKey == "" || frame == nullptr){
+            return -1;
+        }
+        EyerAVSharedFrameCache & sharedCache = EyerAVSharedFrameCache::GetInstance();
+        if(isEnd){
+            return sharedCache.Put(sharedCacheKey, *frame, EYER_AV_SHARED_FRAME_CACHE_EOF);
+        }
+        if(lastDecodedFrame != nullptr){
+            sharedCache.Put(sharedCacheKey, *lastDecodedFrame, frame->GetSecPTS());
+        }
+        sharedCache.Put(sharedCacheKey, *frame, -1.0);
+        lastDecodedFrame = frame;
+        return 0;
+    }
+
     int EyerAVSnapshotLine::ClearCache(int maxDropFrames)
     {
         int times = 0;
-        int maxFrame = 5;
-        while(1){
-            if(frameCache.size() <= maxFrame){
-                break;
-            }
-            if(times >= maxDropFrames){
-                break;
-            }
-
-            std::vector<std::shared_ptr<EyerAVFrame>>::iterator itr = frameCache.begin();
-            frameCache.erase(itr);
+        while(frameCache.IsOverLimit() && times < maxDropFrames){
+            std::shared_ptr<EyerAVFrame> frame = nullptr;
+            frameCache.PopFront(frame);
             times++;
         }
         return 0;
@@ -2,15 +2,19 @@
 #define EYERLIB_EYERAVSNAPSHOTLINE_HPP
 
 #include "EyerAVReader.hpp"
+#include "EyerAVPacket.hpp"
 #include "EyerAVFrame.hpp"
 #include "EyerAVDecoder.hpp"
+#include "EyerAVFramePool.hpp"
+#include "EyerAVFrameCache.hpp"
 
 namespace Eyer
 {
     class EyerAVSnapshotLine
     {
     public:
-        EyerAVSnapshotLine(const EyerString & _path, const EyerAVStream & _videoStream, int _videoStreamIndex, double _pts, EyerAVReaderCustomIO * _customIO);
+        // sharedCacheKey 不为空时, 解出的帧放进 EyerAVSharedFrameCache
+        EyerAVSnapshotLine(const EyerString & _path, const EyerAVStream & _videoStream, int _videoStreamIndex, double _pts, EyerAVReaderCustomIO * _customIO, const EyerString & _sharedCacheKey = "");
         ~EyerAVSnapshotLine();
 
         int GetFrame(std::shared_ptr<EyerAVFrame> & frame, double pts);
@@ -21,6 +25,8 @@ namespace Eyer
         int SearchFrameInCache(std::shared_ptr<EyerAVFrame> & frame, double pts);
         int DecodeFrame();
         int ClearCache(int maxDropFrames);
+        std::shared_ptr<EyerAVFrame> NewFrame();
+        int PutSharedFrame(const std::shared_ptr<EyerAVFrame> & frame, bool isEnd);
 
     private:
         EyerString mPath = "";
@@ -32,11 +38,19 @@ namespace Eyer
         std::shared_ptr<EyerAVReader> reader = nullptr;
         std::shared_ptr<EyerAVDecoder> decoder = nullptr;
 
-        std::vector<std::shared_ptr<EyerAVFrame>> frameCache;
+        // 最多缓存 5 帧
+        EyerAVFrameCache<std::shared_ptr<EyerAVFrame>> frameCache;
 
         std::queue<std::shared_ptr<EyerAVFrame>> tempFrameCache;
 
+        std::shared_ptr<EyerAVFramePool> framePool = std::make_shared<EyerAVFramePool>();
+        // 读包复用同一个对象, Read 会先释放上一个包的数据
+        EyerAVPacket readPacket;
+
         double startSeekTime = 0.0;
+
+        EyerString sharedCacheKey;
+        std::shared_ptr<EyerAVFrame> lastDecodedFrame = nullptr;
     };
 }
 
@@ -98,6 +98,15 @@ namespace Eyer
         else if(piml->codecpar->codec_id == AV_CODEC_ID_MJPEG){
             return EyerAVCodecID::CODEC_ID_MJPEG;
         }
+        else if(piml->codecpar->codec_id == AV_CODEC_ID_PRORES){
+            return EyerAVCodecID::CODEC_ID_PRORES;
+        }
+        else if(piml->codecpar->codec_id == AV_CODEC_ID_PCM_S16LE){
+            return EyerAVCodecID::CODEC_ID_PCM_S16LE;
+        }
+        else if(piml->codecpar->codec_id == AV_CODEC_ID_PCM_S32LE){
+            return EyerAVCodecID::CODEC_ID_PCM_S32LE;
+        }
 
         return EyerAVCodecID::CODEC_ID_UNKNOW;
     }
@@ -37,7 +37,7 @@ namespace Eyer
     int EyerAVVideoWriter::PutFrame(const EyerAVFrame & frame, int64_t frameIndex)
     {
         Eyer::EyerAVFrame yuvframe;
-        frame.Scale(yuvframe, Eyer::EyerAVPixelFormat::EYER_YUV420P);
+        scaler.Scale(frame, yuvframe, Eyer::EyerAVPixelFormat::EYER_YUV420P);
 
         EyerLog("%d, %d\n", yuvframe.GetWidth(), yuvframe.GetHeight());
         yuvframe.SetPTS(frameIndex);
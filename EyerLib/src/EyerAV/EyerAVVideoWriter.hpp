@@ -5,6 +5,7 @@
 #include "EyerAVFrame.hpp"
 #include "EyerAVEncoder.hpp"
 #include "EyerAVWriter.hpp"
+#include "EyerAVScaler.hpp"
 
 namespace Eyer
 {
@@ -22,6 +23,8 @@ namespace Eyer
 
         EyerAVWriter writer;
         int videoStreamIndex = -1;
+
+        EyerAVScaler scaler;
     };
 }
 
@@ -4,25 +4,50 @@
 #include "EyerAVEncoder.hpp"
 
 #include "EyerAVEncoderPrivate.hpp"
+#include "EyerAVStreamPrivate.hpp"
 #include "EyerAVWriterPrivate.hpp"
 #include "EyerAVPacketPrivate.hpp"
 
 namespace Eyer
 {
-    EyerAVWriter::EyerAVWriter(const EyerString & _path)
+    static int EyerAVWriter_Write_Packet(void * opaque, uint8_t * buf, int buf_size)
+    {
+        EyerAVWriterCustomIO * customIO = (EyerAVWriterCustomIO *)opaque;
+        return customIO->Write(buf, buf_size);
+    }
+
+    static int64_t EyerAVWriter_Seek(void * opaque, int64_t offset, int whence)
+    {
+        EyerAVWriterCustomIO * customIO = (EyerAVWriterCustomIO *)opaque;
+        return customIO->Seek(offset, whence);
+    }
+
+    EyerAVWriter::EyerAVWriter(const EyerString & _path, EyerAVWriterCustomIO * _customIO)
     {
         piml = new EyerAVWriterPrivate();
         piml->path = _path;
+        piml->customIO = _customIO;
 
         /// av_register_all();
         avformat_network_init();
 
         avformat_alloc_output_context2(&piml->formatCtx, NULL, NULL, piml->path.c_str());
+
+        // image2 按文件名自己打开文件, 写到自定义 IO 时改用 image2pipe
+        if(piml->customIO != nullptr && piml->formatCtx != NULL && (piml->formatCtx->oformat->flags & AVFMT_NOFILE)){
+            avformat_free_context(piml->formatCtx);
+            piml->formatCtx = NULL;
+            avformat_alloc_output_context2(&piml->formatCtx, NULL, "image2pipe", piml->path.c_str());
+        }
     }
 
     EyerAVWriter::~EyerAVWriter()
     {
+        piml->StopMuxThread(true);
         if(piml->formatCtx != NULL){
+            if(piml->customIO != nullptr || piml->fileIO != nullptr){
+                Close();
+            }
             avformat_free_context(piml->formatCtx);
             piml->formatCtx = NULL;
         }
@@ -32,14 +57,126 @@ namespace Eyer
         }
     }
 
+    int EyerAVWriter::SetIOBufferSize(int size)
+    {
+        if(size < 0){
+            return -1;
+        }
+        piml->ioBufferSize = size;
+        return 0;
+    }
+
+    int EyerAVWriter::SetPreallocateSize(int64_t size)
+    {
+        if(size < 0){
+            return -1;
+        }
+        piml->preallocateSize = size;
+        return 0;
+    }
+
+    int EyerAVWriter::SetAsync(bool async, int maxQueueSize)
+    {
+        if(maxQueueSize <= 0){
+            return -1;
+        }
+        piml->isAsync = async;
+        piml->maxQueueSize = maxQueueSize;
+        return 0;
+    }
+
+    int EyerAVWriter::SetFastStart(bool faststart)
+    {
+        if(faststart && piml->customIO != nullptr){
+            EyerLog("EyerAVWriter FastStart Not Support CustomIO\n");
+            return -1;
+        }
+        piml->isFastStart = faststart;
+        if(faststart){
+            piml->isFragment = false;
+        }
+        return 0;
+    }
+
+    int EyerAVWriter::SetFragment(bool fragment, int fragmentDuration)
+    {
+        if(fragmentDuration <= 0){
+            return -1;
+        }
+        piml->isFragment = fragment;
+        piml->fragmentDuration = fragmentDuration;
+        if(fragment){
+            piml->isFastStart = false;
+        }
+        return 0;
+    }
+
     int EyerAVWriter::Open()
     {
+        if(piml->formatCtx == NULL){
+            return -1;
+        }
+
+        EyerAVWriterCustomIO * io = piml->customIO;
+        // 本地文件需要大缓冲区或者预分配时, 用内部的 fileIO 代替 avio_open
+        // image2 这类自己打开文件的格式不走这里
+        bool useFileIO = io == nullptr && (piml->ioBufferSize > 0 || piml->preallocateSize > 0) && !(piml->formatCtx->oformat->flags & AVFMT_NOFILE);
+        if(useFileIO){
+            piml->fileIO = new EyerAVFileWriterCustomIO(piml->path);
+            if(piml->fileIO->Open(piml->preallocateSize)){
+                delete piml->fileIO;
+                piml->fileIO = nullptr;
+                return -1;
+            }
+            io = piml->fileIO;
+        }
+
+        if(io != nullptr){
+            // 缓冲区由 AVIOContext 持有, 在 Close 中释放
+            int bufferSize = 64 * 1024;
+            if(piml->ioBufferSize > 0){
+                bufferSize = piml->ioBufferSize;
+            }
+            unsigned char * buffer = (unsigned char *)av_malloc(bufferSize);
+            if(buffer == NULL){
+                return -1;
+            }
+            piml->formatCtx->pb = avio_alloc_context(buffer, bufferSize, 1, io, NULL, EyerAVWriter_Write_Packet, EyerAVWriter_Seek);
+            if(piml->formatCtx->pb == NULL){
+                av_free(buffer);
+                return -1;
+            }
+            piml->formatCtx->flags |= AVFMT_FLAG_CUSTOM_IO;
+            return 0;
+        }
         int ret = avio_open(&piml->formatCtx->pb, piml->path.c_str(), AVIO_FLAG_WRITE);
         return ret;
     }
 
     int EyerAVWriter::Close()
     {
+        // 没有写文件尾就关闭时, 丢弃队列中还没写入的 packet
+        piml->StopMuxThread(true);
+
+        if(piml->customIO != nullptr || piml->fileIO != nullptr){
+            int ret = 0;
+            if(piml->formatCtx->pb != NULL){
+                avio_flush(piml->formatCtx->pb);
+                if(piml->formatCtx->pb->error < 0){
+                    ret = piml->formatCtx->pb->error;
+                }
+                av_freep(&piml->formatCtx->pb->buffer);
+                avio_context_free(&piml->formatCtx->pb);
+            }
+            if(piml->fileIO != nullptr){
+                if(piml->fileIO->Close()){
+                    ret = -1;
+                }
+                delete piml->fileIO;
+                piml->fileIO = nullptr;
+            }
+            return ret;
+        }
         return avio_close(piml->formatCtx->pb);
     }
 
@@ -56,6 +193,53 @@ namespace Eyer
         return avStream->index;
     }
 
+    int EyerAVWriter::AddStream(const EyerAVStream & stream)
+    {
+        AVStream * avStream = avformat_new_stream(piml->formatCtx, NULL);
+        if(avStream == NULL){
+            return -1;
+        }
+
+        int ret = avcodec_parameters_copy(avStream->codecpar, stream.piml->codecpar);
+        if(ret < 0){
+            return -1;
+        }
+        avStream->time_base = stream.piml->timebase;
+        avStream->codecpar->codec_tag = 0;
+        if(avStream->codecpar->codec_id == AV_CODEC_ID_HEVC){
+            avStream->codecpar->codec_tag = MKTAG('h', 'v', 'c', '1');
+        }
+
+        return avStream->index;
+    }
+
+    int EyerAVWriter::SetInBandParameterSets(int streamIndex)
+    {
+        if(streamIndex < 0 || streamIndex >= (int)piml->formatCtx->nb_streams){
+            return -1;
+        }
+        AVCodecParameters * codecpar = piml->formatCtx->streams[streamIndex]->codecpar;
+        if(codecpar->codec_id == AV_CODEC_ID_H264){
+            codecpar->codec_tag = MKTAG('a', 'v', 'c', '3');
+            return 0;
+        }
+        if(codecpar->codec_id == AV_CODEC_ID_HEVC){
+            codecpar->codec_tag = MKTAG('h', 'e', 'v', '1');
+            return 0;
+        }
+        return -1;
+    }
+
+    bool EyerAVWriter::IsStreamSupported(const EyerAVStream & stream)
+    {
+        if(piml->formatCtx == NULL){
+            return false;
+        }
+        // 返回 1 支持, 0 不支持, 格式没有提供查询时返回负数, 当作不支持
+        int ret = avformat_query_codec(piml->formatCtx->oformat, stream.piml->codecpar->codec_id, FF_COMPLIANCE_NORMAL);
+        return ret == 1;
+    }
+
     int EyerAVWriter::GetTimebase(EyerAVRational & timebase, int streamIndex)
     {
         timebase.num = piml->formatCtx->streams[streamIndex]->time_base.num;
@@ -73,7 +257,15 @@ namespace Eyer
     int EyerAVWriter::WriteHand()
     {
         AVDictionary *dict = NULL;
-        // av_dict_set( &dict, "movflags", "faststart", 0 );
+        // 不是 MP4/MOV 的 muxer 不认识这些选项, 会留在 dict 中被忽略
+        if(piml->isFastStart){
+            av_dict_set( &dict, "movflags", "faststart", 0 );
+        }
+        else if(piml->isFragment){
+            // 空 moov 开头, 分片只在关键帧处切分, 每个分片自包含, 可以边写边读
+            av_dict_set( &dict, "movflags", "frag_keyframe+empty_moov+default_base_moof", 0 );
+            av_dict_set_int( &dict, "min_frag_duration", (int64_t)piml->fragmentDuration * 1000, 0 );
+        }
         // av_dict_set( &dict, "vtag", "hvc1", 0 );
         int ret = avformat_write_header(piml->formatCtx, &dict);
         av_dict_free(&dict);
@@ -82,13 +274,114 @@ namespace Eyer
 
     int EyerAVWriter::WriteTrailer()
     {
+        // 先等封装线程写完队列中的 packet
+        piml->StopMuxThread(false);
         int ret = av_write_trailer(piml->formatCtx);
+        if(piml->muxError < 0){
+            return piml->muxError;
+        }
         return ret;
     }
 
     int EyerAVWriter::WritePacket(EyerAVPacket & packet)
     {
-        int ret = av_interleaved_write_frame(piml->formatCtx, packet.piml->packet);
+        if(piml->isAsync){
+            return piml->PushPacket(packet.GetPrivate()->packet);
+        }
+        int ret = av_interleaved_write_frame(piml->formatCtx, packet.GetPrivate()->packet);
         return ret;
     }
+
+    int64_t EyerAVWriter::GetAsyncWriteTime()
+    {
+        return piml->muxWriteTime;
+    }
+
+    int EyerAVWriterPrivate::PushPacket(AVPacket * packet)
+    {
+        if(muxError < 0){
+            return muxError;
+        }
+        if(muxThread == nullptr){
+            finishFlag = false;
+            abortFlag = false;
+            muxThread = new std::thread(&EyerAVWriterPrivate::MuxLoop, this);
+        }
+
+        // 和同步写入一样, 写入之后调用者的 packet 被清空
+        AVPacket * queuePacket = av_packet_alloc();
+        if(queuePacket == NULL){
+            return -1;
+        }
+        int ret = av_packet_ref(queuePacket, packet);
+        av_packet_unref(packet);
+        if(ret < 0){
+            av_packet_free(&queuePacket);
+            return ret;
+        }
+
+        std::unique_lock<std::mutex> lock(queueMut);
+        notFullCV.wait(lock, [this]{ return (int)packetQueue.size() < maxQueueSize || abortFlag; });
+        if(abortFlag){
+            av_packet_free(&queuePacket);
+            return -1;
+        }
+        packetQueue.push_back(queuePacket);
+        notEmptyCV.notify_one();
+        return 0;
+    }
+
+    int EyerAVWriterPrivate::StopMuxThread(bool abort)
+    {
+        if(muxThread == nullptr){
+            return 0;
+        }
+        {
+            std::lock_guard<std::mutex> lock(queueMut);
+            if(abort){
+                abortFlag = true;
+            }
+            finishFlag = true;
+            notEmptyCV.notify_all();
+            notFullCV.notify_all();
+        }
+        muxThread->join();
+        delete muxThread;
+        muxThread = nullptr;
+
+        for(int i = 0; i < packetQueue.size(); i++){
+            av_packet_free(&packetQueue[i]);
+        }
+        packetQueue.clear();
+        return 0;
+    }
+
+    void EyerAVWriterPrivate::MuxLoop()
+    {
+        while(1){
+            AVPacket * packet = nullptr;
+            {
+                std::unique_lock<std::mutex> lock(queueMut);
+                notEmptyCV.wait(lock, [this]{ return packetQueue.size() > 0 || finishFlag || abortFlag; });
+                if(abortFlag || packetQueue.size() <= 0){
+                    break;
+                }
+                packet = packetQueue.front();
+                packetQueue.pop_front();
+                notFullCV.notify_one();
+            }
+
+            // 出错之后继续取出并丢弃, 避免调用者阻塞在满队列上
+            if(muxError >= 0){
+                int64_t startTime = EyerTime::GetTimeNano();
+                int ret = av_interleaved_write_frame(formatCtx, packet);
+                muxWriteTime += EyerTime::GetTimeNano() - startTime;
+                if(ret < 0){
+                    EyerLog("EyerAVWriter Mux Thread Write Fail: %d\n", ret);
+                    muxError = ret;
+                }
+            }
+            av_packet_free(&packet);
+        }
+    }
 }
\ No newline at end of file
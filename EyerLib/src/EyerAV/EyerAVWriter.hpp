@@ -4,6 +4,8 @@
 #include "EyerCore/EyerCore.hpp"
 #include "EyerAVPacket.hpp"
 #include "EyerAVEncoder.hpp"
+#include "EyerAVStream.hpp"
+#include "EyerAVWriterCustomIO.hpp"
 
 namespace Eyer
 {
@@ -11,13 +13,35 @@ namespace Eyer
 
     class EyerAVWriter {
     public:
-        EyerAVWriter(const EyerString & _path);
+        // 设置了 customIO 时数据写到 customIO, path 只用来根据后缀确定封装格式
+        EyerAVWriter(const EyerString & _path, EyerAVWriterCustomIO * _customIO = nullptr);
         ~EyerAVWriter();
 
+        // 以下设置需要在 Open 之前调用
+        // 输出缓冲区大小, 默认 64K, 网络存储上调大可以减少写入次数
+        int SetIOBufferSize(int size);
+        // 按预估的输出大小预先分配文件空间, Close 时截断到实际大小, 只对本地文件有效
+        int SetPreallocateSize(int64_t size);
+        // 异步写入: WritePacket 只把 packet 放进队列, 写文件在单独的封装线程中进行, 写入卡顿时不阻塞编码
+        // 队列中最多 maxQueueSize 个 packet, 队列满时 WritePacket 阻塞; 封装出错后 WritePacket 返回错误
+        int SetAsync(bool async, int maxQueueSize = 64);
+
+        // 以下设置需要在 WriteHand 之前调用, 只对 MP4/MOV 生效
+        // 写文件尾时把 moov 移到文件开头, muxer 需要按路径重新打开文件读取, 写到 customIO 时不支持
+        int SetFastStart(bool faststart);
+        // 分片 MP4, 每个分片至少 fragmentDuration 毫秒, 在之后的第一个关键帧处切分, 分片写完后立即刷到输出
+        int SetFragment(bool fragment, int fragmentDuration = 1000);
+
         int Open();
         int Close();
 
         int AddStream(EyerAVEncoder & encoder);
+        int AddStream(const EyerAVStream & stream);
+        // H.264 写成 avc3, H.265 写成 hev1, 码流中可以带和文件头不同的 SPS/PPS, 只对 MP4/MOV 生效
+        // 多个编码器的输出拼成一条流时使用, 默认的 avc1/hvc1 要求参数集和 avcC/hvcC 一致, 需要在 WriteHand 之前调用
+        int SetInBandParameterSets(int streamIndex);
+        // 输出格式能否直接封装这路流的编码数据, 用来判断能否流复制
+        bool IsStreamSupported(const EyerAVStream & stream);
 
         int GetTimebase(EyerAVRational & timebase, int streamIndex);
         EyerAVRational GetTimebase(int streamIndex);
@@ -26,6 +50,9 @@ namespace Eyer
         int WriteTrailer();
 
         int WritePacket(EyerAVPacket & packet);
+
+        // 异步写入时封装线程的累计写入耗时, 单位纳秒
+        int64_t GetAsyncWriteTime();
     public:
         EyerAVWriterPrivate * piml = nullptr;
     };
@@ -0,0 +1 @@
+#include "EyerAVWriterCustomIO.hpp"
@@ -0,0 +1,24 @@
+#ifndef EYERAVWRITERCUSTOMIO_HPP
+#define EYERAVWRITERCUSTOMIO_HPP
+
+#include <stdint.h>
+
+namespace Eyer
+{
+    class EyerAVWriterCustomIO
+    {
+    public:
+        // 和 FFmpeg 的 AVSEEK_SIZE/AVSEEK_FORCE 取值相同
+        // whence 为 SEEK_SIZE 时返回已经写入的总大小, 不支持返回 -1
+        static const int SEEK_SIZE = 0x10000;
+        static const int SEEK_FORCE = 0x20000;
+
+        virtual ~EyerAVWriterCustomIO(){}
+        // 返回写入的字节数, 小于 0 表示失败
+        virtual int Write(const uint8_t * buf, int buf_size) = 0;
+        // 管道等不能 Seek 的输出返回 -1, 这时 MP4/MOV 需要使用不回写文件头的封装方式
+        virtual int64_t Seek(int64_t offset, int whence) = 0;
+    };
+}
+
+#endif //EYERAVWRITERCUSTOMIO_HPP
@@ -1,16 +1,55 @@
 #ifndef EYERLIB_EYERAVWRITERPRIVATE_HPP
 #define EYERLIB_EYERAVWRITERPRIVATE_HPP
 
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <condition_variable>
+
 #include "EyerAVFFmpegHeader.hpp"
 #include "EyerCore/EyerCore.hpp"
+#include "EyerAVWriterCustomIO.hpp"
+#include "EyerAVFileWriterCustomIO.hpp"
 
 namespace Eyer
 {
     class EyerAVWriterPrivate
     {
     public:
+        // 异步写入: 调用线程只把 packet 放进队列, 由封装线程调用 av_interleaved_write_frame
+        int PushPacket(AVPacket * packet);
+        // abort 为 false 时写完队列中剩余的 packet 再退出, 为 true 时直接丢弃
+        int StopMuxThread(bool abort);
+        void MuxLoop();
+
         AVFormatContext * formatCtx = nullptr;
         EyerString path;
+        EyerAVWriterCustomIO * customIO = nullptr;
+
+        // 设置了大缓冲区或者预分配时, 本地文件通过内部的 fileIO 写入
+        EyerAVFileWriterCustomIO * fileIO = nullptr;
+        int ioBufferSize = 0;
+        int64_t preallocateSize = 0;
+
+        bool isFastStart = false;
+        bool isFragment = false;
+        // 单位毫秒
+        int fragmentDuration = 1000;
+
+        bool isAsync = false;
+        int maxQueueSize = 64;
+        std::thread * muxThread = nullptr;
+        std::mutex queueMut;
+        std::condition_variable notEmptyCV;
+        std::condition_variable notFullCV;
+        std::deque<AVPacket *> packetQueue;
+        bool finishFlag = false;
+        bool abortFlag = false;
+        // 封装线程中第一次出错的返回值, 之后的 WritePacket 返回该值
+        std::atomic_int muxError {0};
+        // 封装线程写入的累计耗时, 单位纳秒
+        std::atomic<int64_t> muxWriteTime {0};
     };
 }
 
@@ -2,14 +2,31 @@
 
 #include "EyerAVEncoder.hpp"
 #include "EyerAVWriter.hpp"
+#include "EyerAVScaler.hpp"
 
 namespace Eyer
 {
     int EyerImageUtil::WriteFrame(EyerAVFrame & frame, const EyerString & path)
     {
-        // Frame 格式转换
+        return WriteFrame(frame, path, nullptr);
+    }
+
+    int EyerImageUtil::WriteFrame(EyerAVFrame & frame, EyerAVWriterCustomIO * customIO)
+    {
+        if(customIO == nullptr){
+            return -1;
+        }
+        // 路径只用来确定封装格式
+        return WriteFrame(frame, "image.jpg", customIO);
+    }
+
+    int EyerImageUtil::WriteFrame(EyerAVFrame & frame, const EyerString & path, EyerAVWriterCustomIO * customIO)
+    {
+        // Frame 格式转换, 只转格式不缩放, 用最快的算法
         EyerAVFrame frameYUV420P;
-        int ret = frame.Scale(frameYUV420P, EyerAVPixelFormat::EYER_YUV420P);
+        EyerAVScaler scaler;
+        scaler.SetQuality(EyerAVScaleQuality::FAST_BILINEAR);
+        int ret = scaler.Scale(frame, frameYUV420P, EyerAVPixelFormat::EYER_YUV420P);
         if(ret){
             EyerLog("Image Scale Fail\n");
             return -1;
@@ -25,8 +42,12 @@ namespace Eyer
             return -2;
         }
 
-        EyerAVWriter writer(path);
-        writer.Open();
+        EyerAVWriter writer(path, customIO);
+        ret = writer.Open();
+        if(ret){
+            EyerLog("Image Writer Open Fail\n");
+            return -3;
+        }
         int streamId = writer.AddStream(imageEncode);
         writer.WriteHand();
 
@@ -2,6 +2,7 @@
 #define EYERLIB_EYERIMAGEUTIL_HPP
 
 #include "EyerAVFrame.hpp"
+#include "EyerAVWriterCustomIO.hpp"
 #include "EyerCore/EyerCore.hpp"
 
 namespace Eyer
@@ -9,6 +10,11 @@ namespace Eyer
     class EyerImageUtil {
     public:
         int WriteFrame(EyerAVFrame & frame, const EyerString & path);
+        // JPEG 写到 customIO, 例如 EyerAVMemoryWriterCustomIO, 不经过临时文件
+        int WriteFrame(EyerAVFrame & frame, EyerAVWriterCustomIO * customIO);
+
+    private:
+        int WriteFrame(EyerAVFrame & frame, const EyerString & path, EyerAVWriterCustomIO * customIO);
     };
 }
 
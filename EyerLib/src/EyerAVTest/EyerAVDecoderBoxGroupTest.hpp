@@ -43,4 +43,89 @@ TEST(EyerAV, EyerAVDecoderBoxGroupTest)
     }
 }
 
+TEST(EyerAV, EyerAVDecoderBoxGroupTest_Budget)
+{
+    // 路径不同就是不同的 Box
+    Eyer::EyerString pathList[] = {"./demo.mp4", "././demo.mp4", "./././demo.mp4", "././././demo.mp4"};
+
+    Eyer::EyerAVFrame firstFrame;
+    {
+        Eyer::EyerAVDecoderBox decoderBox("./demo.mp4");
+        ASSERT_EQ(decoderBox.GetFrame(firstFrame, 0.0), 0);
+    }
+    int64_t frameBytes = firstFrame.GetBufferSize();
+    ASSERT_GT(frameBytes, 0);
+
+    // 解码线数量
+    {
+        Eyer::EyerAVDecoderLineParams params;
+        params.SetGroupBudget(0, 2);
+        params.SetSharedFrameCache(false);
+        Eyer::EyerAVDecoderBoxGroup decoderBoxGroup(params);
+        for(int i = 0; i < 20; i++){
+            Eyer::EyerAVFrame frame;
+            ASSERT_EQ(decoderBoxGroup.GetFrame(frame, pathList[i % 4], i * 0.3), 0);
+            ASSERT_LE(decoderBoxGroup.GetLineNum(), 2);
+            ASSERT_LE(decoderBoxGroup.GetBoxNum(), 2);
+        }
+    }
+
+    // 缓存字节数, 只剩一条解码线时不再淘汰
+    {
+        int64_t maxBytes = frameBytes * 8;
+        Eyer::EyerAVDecoderLineParams params;
+        params.SetGroupBudget(maxBytes, 0);
+        params.SetSharedFrameCache(false);
+        Eyer::EyerAVDecoderBoxGroup decoderBoxGroup(params);
+        for(int i = 0; i < 20; i++){
+            Eyer::EyerAVFrame frame;
+            ASSERT_EQ(decoderBoxGroup.GetFrame(frame, pathList[i % 4], i * 0.3), 0);
+            ASSERT_GT(decoderBoxGroup.GetMemoryUsage(), 0);
+            if(decoderBoxGroup.GetLineNum() > 1){
+                ASSERT_LE(decoderBoxGroup.GetMemoryUsage(), maxBytes);
+            }
+        }
+    }
+
+    // 共享缓存默认打开, 字节数也计入预算, 超出时调低共享缓存的上限
+    {
+        Eyer::EyerAVSharedFrameCache & cache = Eyer::EyerAVSharedFrameCache::GetInstance();
+        int64_t oldMaxBytes = cache.GetMaxBytes();
+        cache.Clear();
+
+        int64_t maxBytes = frameBytes * 8;
+        Eyer::EyerAVDecoderLineParams params;
+        params.SetGroupBudget(maxBytes, 0);
+        Eyer::EyerAVDecoderBoxGroup decoderBoxGroup(params);
+        for(int i = 0; i < 20; i++){
+            Eyer::EyerAVFrame frame;
+            ASSERT_EQ(decoderBoxGroup.GetFrame(frame, pathList[i % 4], i * 0.3), 0);
+            if(decoderBoxGroup.GetLineNum() > 1){
+                ASSERT_LE(decoderBoxGroup.GetMemoryUsage() + cache.GetBytes(), maxBytes);
+            }
+            // 解码线已经用完预算时共享缓存是空的
+            if(decoderBoxGroup.GetMemoryUsage() >= maxBytes){
+                ASSERT_EQ(cache.GetBytes(), 0);
+            }
+        }
+        ASSERT_LE(cache.GetMaxBytes(), maxBytes);
+
+        cache.SetMaxBytes(oldMaxBytes);
+        cache.Clear();
+    }
+
+    // 不限制时每个路径都留着
+    {
+        Eyer::EyerAVDecoderLineParams params;
+        params.SetSharedFrameCache(false);
+        Eyer::EyerAVDecoderBoxGroup decoderBoxGroup(params);
+        for(int i = 0; i < 4; i++){
+            Eyer::EyerAVFrame frame;
+            ASSERT_EQ(decoderBoxGroup.GetFrame(frame, pathList[i], 1.0), 0);
+        }
+        ASSERT_EQ(decoderBoxGroup.GetBoxNum(), 4);
+        ASSERT_EQ(decoderBoxGroup.GetLineNum(), 4);
+    }
+}
+
 #endif //EYERLIB_EYERAVDECODERBOXGROUPTEST_HPP
@@ -3,6 +3,8 @@
 
 #include "EyerAV/EyerAV.hpp"
 #include <math.h>
+#include <thread>
+#include <chrono>
 
 
 TEST(EyerAV, EyerAVDecoderLineTest)
@@ -90,4 +92,42 @@ TEST(EyerAV, EyerAVDecoderBoxTest_Sequence)
     }
 }
 
+TEST(EyerAV, EyerAVDecoderLineTest_DecodeAhead)
+{
+    Eyer::EyerAVDecoderLineParams params(16);
+    params.SetDecodeAhead(10);
+    Eyer::EyerAVDecoderLine aheadLine("./demo.mp4", 0, nullptr, params);
+    Eyer::EyerAVDecoderLine line("./demo.mp4", 0, nullptr, Eyer::EyerAVDecoderLineParams(16));
+
+    Eyer::EyerAVFrame frame;
+    ASSERT_EQ(aheadLine.GetFrame(frame, 0.0), 0);
+
+    // 后台线程在请求之后继续解码, 不超过缓存上限
+    int cacheSize = 0;
+    for(int i=0;i<200;i++){
+        cacheSize = aheadLine.GetCacheSize();
+        if(cacheSize > 10){
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ASSERT_GT(cacheSize, 10);
+    ASSERT_LE(cacheSize, 16);
+
+    // 结果与不预解码一致
+    for(double pts=0.0;pts<5.0;pts+=0.04){
+        Eyer::EyerAVFrame aheadFrame;
+        Eyer::EyerAVFrame lineFrame;
+        int aheadRet = aheadLine.GetFrame(aheadFrame, pts);
+        int lineRet = line.GetFrame(lineFrame, pts);
+        ASSERT_EQ(aheadRet, lineRet);
+        if(lineRet){
+            continue;
+        }
+        ASSERT_DOUBLE_EQ(aheadFrame.GetSecPTS(), lineFrame.GetSecPTS());
+    }
+
+    ASSERT_EQ(aheadLine.StopDecodeAhead(), 0);
+}
+
 #endif //EYERLIB_EYERAVDECODERLINETEST_HPP
@@ -0,0 +1,83 @@
+#ifndef EYERLIB_EYERAVFRAMECACHETEST_HPP
+#define EYERLIB_EYERAVFRAMECACHETEST_HPP
+
+#include <memory>
+#include <gtest/gtest.h>
+#include "EyerAV/EyerAV.hpp"
+
+static std::shared_ptr<Eyer::EyerAVFrame> EyerAVFrameCacheTest_NewFrame(double pts)
+{
+    std::shared_ptr<Eyer::EyerAVFrame> frame = std::make_shared<Eyer::EyerAVFrame>();
+    frame->InitVideoData(Eyer::EyerAVPixelFormat::EYER_YUV420P, 64, 64);
+    frame->SetSecPTS(pts);
+    return frame;
+}
+
+TEST(EyerAV, EyerAVFrameCacheTest_Order)
+{
+    Eyer::EyerAVFrameCache<std::shared_ptr<Eyer::EyerAVFrame>> cache(100);
+
+    // 解码顺序的 PTS 有少量乱序, 插入后仍然有序, 并且跨过环形缓冲区的扩容和回绕
+    double ptsList[] = {0.0, 0.12, 0.04, 0.08, 0.24, 0.16, 0.20, 0.36, 0.28, 0.32};
+    int64_t frameBytes = 0;
+    for(int round = 0; round < 5; round++){
+        for(int i = 0; i < sizeof(ptsList) / sizeof(ptsList[0]); i++){
+            std::shared_ptr<Eyer::EyerAVFrame> frame = EyerAVFrameCacheTest_NewFrame(round * 0.4 + ptsList[i]);
+            frameBytes = frame->GetBufferSize();
+            cache.Push(frame);
+        }
+        // 从头部淘汰, 让头部位置往后移
+        std::shared_ptr<Eyer::EyerAVFrame> frame = nullptr;
+        ASSERT_EQ(cache.PopFront(frame), 0);
+        ASSERT_NEAR(frame->GetSecPTS(), cache.GetPTS(0) - 0.04, 1e-9);
+    }
+    // 插到靠近头部的位置
+    cache.Push(EyerAVFrameCacheTest_NewFrame(cache.GetPTS(0) + 0.01));
+    ASSERT_NEAR(cache.GetPTS(1), cache.GetPTS(0) + 0.01, 1e-9);
+
+    ASSERT_EQ(cache.Size(), 46);
+    ASSERT_GT(frameBytes, 0);
+    ASSERT_EQ(cache.GetBytes(), frameBytes * 46);
+
+    for(int i = 1; i < cache.Size(); i++){
+        ASSERT_LT(cache.GetPTS(i - 1), cache.GetPTS(i));
+        ASSERT_DOUBLE_EQ(cache.Get(i)->GetSecPTS(), cache.GetPTS(i));
+    }
+
+    ASSERT_EQ(cache.LowerBound(0.0), 0);
+    ASSERT_EQ(cache.LowerBound(cache.GetPTS(10)), 10);
+    ASSERT_EQ(cache.UpperBound(cache.GetPTS(10)), 11);
+    ASSERT_EQ(cache.LowerBound(100.0), cache.Size());
+}
+
+TEST(EyerAV, EyerAVFrameCacheTest_Limit)
+{
+    std::shared_ptr<Eyer::EyerAVFrame> frame = EyerAVFrameCacheTest_NewFrame(0.0);
+    int64_t frameBytes = frame->GetBufferSize();
+
+    // 字节数先到上限
+    Eyer::EyerAVFrameCache<std::shared_ptr<Eyer::EyerAVFrame>> cache(10, frameBytes * 3);
+    for(int i = 0; i < 3; i++){
+        ASSERT_FALSE(cache.IsFull());
+        cache.Push(EyerAVFrameCacheTest_NewFrame(i * 0.04));
+    }
+    ASSERT_TRUE(cache.IsFull());
+    ASSERT_FALSE(cache.IsOverLimit());
+    cache.Push(EyerAVFrameCacheTest_NewFrame(3 * 0.04));
+    ASSERT_TRUE(cache.IsOverLimit());
+
+    // 只限制帧数
+    cache.SetLimit(4);
+    ASSERT_FALSE(cache.IsOverLimit());
+    cache.Push(EyerAVFrameCacheTest_NewFrame(4 * 0.04));
+    ASSERT_TRUE(cache.IsOverLimit());
+
+    while(cache.IsOverLimit()){
+        ASSERT_EQ(cache.PopFront(frame), 0);
+    }
+    ASSERT_EQ(cache.Size(), 4);
+    ASSERT_EQ(cache.GetBytes(), frameBytes * 4);
+    ASSERT_DOUBLE_EQ(cache.GetPTS(0), 0.04);
+}
+
+#endif //EYERLIB_EYERAVFRAMECACHETEST_HPP
@@ -0,0 +1,123 @@
+#ifndef EYERLIB_EYERAVFRAMEPOOLTEST_HPP
+#define EYERLIB_EYERAVFRAMEPOOLTEST_HPP
+
+#include <stdint.h>
+#include <string.h>
+#include <gtest/gtest.h>
+#include "EyerAV/EyerAV.hpp"
+
+TEST(EyerAV, EyerAVFramePoolTest_Video)
+{
+    Eyer::EyerAVFramePool pool;
+
+    for(int i = 0; i < 100; i++){
+        Eyer::EyerAVFrame * frame = pool.NewFrame();
+        frame->SetPixelFormat(Eyer::EyerAVPixelFormat::EYER_YUV420P);
+        // 宽度故意不是 64 的倍数
+        frame->SetWidth(1000);
+        frame->SetHeight(562);
+        ASSERT_EQ(pool.GetBuffer(*frame), 0);
+
+        for(int plane = 0; plane < 3; plane++){
+            ASSERT_NE(frame->GetData(plane), nullptr);
+            ASSERT_EQ((uintptr_t)frame->GetData(plane) % pool.GetAlign(), 0);
+            ASSERT_EQ(frame->GetLinesize(plane) % pool.GetAlign(), 0);
+        }
+        ASSERT_GE(frame->GetLinesize(0), 1000);
+        ASSERT_GE(frame->GetLinesize(1), 500);
+
+        // 写满最后一行, 检查数据块大小
+        memset(frame->GetData(0) + frame->GetLinesize(0) * 561, 1, 1000);
+        memset(frame->GetData(2) + frame->GetLinesize(2) * 280, 1, 500);
+
+        pool.DeleteFrame(frame);
+    }
+
+    // 同一时刻只用了一帧, 外壳和数据块都只申请过一次
+    ASSERT_EQ(pool.GetFreeFrameNum(), 1);
+    ASSERT_EQ(pool.GetBufferAllocNum(), 1);
+}
+
+TEST(EyerAV, EyerAVFramePoolTest_Reuse)
+{
+    Eyer::EyerAVFramePool pool;
+
+    Eyer::EyerAVFrame frame;
+    frame.SetPixelFormat(Eyer::EyerAVPixelFormat::EYER_RGBA);
+    frame.SetWidth(1280);
+    frame.SetHeight(720);
+    frame.SetPTS(1234);
+    ASSERT_EQ(pool.GetBuffer(frame), 0);
+
+    // 被其他帧引用的数据块不能被复用
+    Eyer::EyerAVFrame * refFrame = new Eyer::EyerAVFrame(frame);
+    ASSERT_EQ(pool.GetBuffer(frame), 0);
+    ASSERT_NE(frame.GetData(0), refFrame->GetData(0));
+    ASSERT_EQ(pool.GetBufferAllocNum(), 2);
+
+    // 重新分配保留 pts 和尺寸
+    ASSERT_EQ(frame.GetPTS(), 1234);
+    ASSERT_EQ(frame.GetWidth(), 1280);
+    ASSERT_EQ(frame.GetHeight(), 720);
+
+    // 引用释放后回到池中, 之后不再申请新的数据块
+    delete refFrame;
+    for(int i = 0; i < 10; i++){
+        ASSERT_EQ(pool.GetBuffer(frame), 0);
+    }
+    ASSERT_EQ(pool.GetBufferAllocNum(), 2);
+}
+
+TEST(EyerAV, EyerAVFramePoolTest_Evict)
+{
+    Eyer::EyerAVFramePool pool;
+
+    Eyer::EyerAVFrame frame;
+    frame.SetPixelFormat(Eyer::EyerAVPixelFormat::EYER_RGBA);
+    frame.SetHeight(64);
+
+    // 8 种尺寸各占一个池
+    for(int i = 0; i < 8; i++){
+        frame.SetWidth(64 * (i + 1));
+        ASSERT_EQ(pool.GetBuffer(frame), 0);
+    }
+    ASSERT_EQ(pool.GetBufferAllocNum(), 8);
+
+    // 第一种尺寸刚用过, 第 9 种尺寸只淘汰最久没用的第二种
+    frame.SetWidth(64);
+    ASSERT_EQ(pool.GetBuffer(frame), 0);
+    frame.SetWidth(64 * 9);
+    ASSERT_EQ(pool.GetBuffer(frame), 0);
+    ASSERT_EQ(pool.GetBufferAllocNum(), 9);
+
+    frame.SetWidth(64);
+    ASSERT_EQ(pool.GetBuffer(frame), 0);
+    frame.SetWidth(64 * 3);
+    ASSERT_EQ(pool.GetBuffer(frame), 0);
+    ASSERT_EQ(pool.GetBufferAllocNum(), 9);
+
+    frame.SetWidth(64 * 2);
+    ASSERT_EQ(pool.GetBuffer(frame), 0);
+    ASSERT_EQ(pool.GetBufferAllocNum(), 10);
+}
+
+TEST(EyerAV, EyerAVFramePoolTest_Audio)
+{
+    Eyer::EyerAVFramePool pool;
+
+    for(int i = 0; i < 10; i++){
+        Eyer::EyerAVFrame frame;
+        frame.SetSampleFormat(Eyer::EyerAVSampleFormat::SAMPLE_FMT_FLTP);
+        frame.SetChannelLayout(Eyer::EyerAVChannelLayout::EYER_AV_CH_LAYOUT_STEREO);
+        frame.SetSampleRate(44100);
+        frame.SetSampleNB(1024);
+        ASSERT_EQ(pool.GetBuffer(frame), 0);
+
+        ASSERT_EQ((uintptr_t)frame.GetData(0) % pool.GetAlign(), 0);
+        ASSERT_EQ((uintptr_t)frame.GetData(1) % pool.GetAlign(), 0);
+        memset(frame.GetData(1), 0, 1024 * sizeof(float));
+    }
+    ASSERT_EQ(pool.GetBufferAllocNum(), 1);
+}
+
+#endif //EYERLIB_EYERAVFRAMEPOOLTEST_HPP
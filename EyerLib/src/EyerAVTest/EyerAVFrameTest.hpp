@@ -1,6 +1,9 @@
 #ifndef EYERLIB_EYERAVFRAMETEST_HPP
 #define EYERLIB_EYERAVFRAMETEST_HPP
 
+#include <string.h>
+#include <utility>
+#include <type_traits>
 #include <gtest/gtest.h>
 #include "EyerAV/EyerAV.hpp"
 
@@ -12,4 +15,118 @@ TEST(EyerAV, EyerAVFrameTest)
     }
 }
 
+static int EyerAVFrameTest_FillFrame(Eyer::EyerAVFrame & frame)
+{
+    frame.InitVideoData(Eyer::EyerAVPixelFormat::EYER_YUV420P, 320, 240);
+    frame.SetPTS(100);
+    frame.SetSecPTS(1.5);
+    for(int plane = 0; plane < 3; plane++){
+        int planeHeight = plane == 0 ? 240 : 120;
+        memset(frame.GetData(plane), plane + 1, frame.GetLinesize(plane) * planeHeight);
+    }
+    return 0;
+}
+
+TEST(EyerAV, EyerAVFrameTest_ShallowCopy)
+{
+    Eyer::EyerAVFrame frame;
+    EyerAVFrameTest_FillFrame(frame);
+    ASSERT_TRUE(frame.IsWritable());
+
+    {
+        // 拷贝只增加引用, 数据是同一份
+        Eyer::EyerAVFrame copyFrame(frame);
+        ASSERT_EQ(copyFrame.GetData(0), frame.GetData(0));
+        ASSERT_EQ(copyFrame.GetData(1), frame.GetData(1));
+        ASSERT_EQ(copyFrame.GetData(2), frame.GetData(2));
+        ASSERT_EQ(copyFrame.GetPTS(), 100);
+        ASSERT_EQ(copyFrame.GetSecPTS(), 1.5);
+        ASSERT_FALSE(frame.IsWritable());
+        ASSERT_FALSE(copyFrame.IsWritable());
+
+        Eyer::EyerAVFrame assignFrame;
+        assignFrame = frame;
+        ASSERT_EQ(assignFrame.GetData(0), frame.GetData(0));
+
+        assignFrame = assignFrame;
+        ASSERT_EQ(assignFrame.GetData(0), frame.GetData(0));
+    }
+
+    // 其他引用都释放之后, 又可以直接修改
+    ASSERT_TRUE(frame.IsWritable());
+
+    // 没有数据的帧只复制参数
+    Eyer::EyerAVFrame emptyFrame;
+    emptyFrame.SetPixelFormat(Eyer::EyerAVPixelFormat::EYER_RGBA);
+    emptyFrame.SetWidth(64);
+    emptyFrame.SetHeight(32);
+    Eyer::EyerAVFrame emptyCopy(emptyFrame);
+    ASSERT_EQ(emptyCopy.GetData(0), nullptr);
+    ASSERT_EQ(emptyCopy.GetWidth(), 64);
+    ASSERT_EQ(emptyCopy.GetHeight(), 32);
+    ASSERT_EQ(emptyCopy.GetPixelFormat(), Eyer::EyerAVPixelFormat::EYER_RGBA);
+}
+
+TEST(EyerAV, EyerAVFrameTest_DeepCopy)
+{
+    Eyer::EyerAVFrame frame;
+    EyerAVFrameTest_FillFrame(frame);
+
+    Eyer::EyerAVFrame deepFrame;
+    ASSERT_EQ(frame.DeepCopy(deepFrame), 0);
+    ASSERT_NE(deepFrame.GetData(0), frame.GetData(0));
+    ASSERT_TRUE(frame.IsWritable());
+    ASSERT_TRUE(deepFrame.IsWritable());
+    ASSERT_EQ(deepFrame.GetWidth(), 320);
+    ASSERT_EQ(deepFrame.GetHeight(), 240);
+    ASSERT_EQ(deepFrame.GetPTS(), 100);
+    ASSERT_EQ(deepFrame.GetSecPTS(), 1.5);
+    for(int plane = 0; plane < 3; plane++){
+        int planeWidth = plane == 0 ? 320 : 160;
+        int planeHeight = plane == 0 ? 240 : 120;
+        for(int y = 0; y < planeHeight; y++){
+            ASSERT_EQ(memcmp(deepFrame.GetData(plane) + y * deepFrame.GetLinesize(plane), frame.GetData(plane) + y * frame.GetLinesize(plane), planeWidth), 0);
+        }
+    }
+
+    // 写时复制
+    Eyer::EyerAVFrame copyFrame = frame;
+    ASSERT_EQ(copyFrame.MakeWritable(), 0);
+    ASSERT_NE(copyFrame.GetData(0), frame.GetData(0));
+    memset(copyFrame.GetData(0), 0xFF, copyFrame.GetLinesize(0));
+    ASSERT_EQ(frame.GetData(0)[0], 1);
+}
+
+TEST(EyerAV, EyerAVFrameTest_Move)
+{
+    ASSERT_TRUE(std::is_nothrow_move_constructible<Eyer::EyerAVFrame>::value);
+    ASSERT_TRUE(std::is_nothrow_move_assignable<Eyer::EyerAVFrame>::value);
+
+    Eyer::EyerAVFrame frame;
+    EyerAVFrameTest_FillFrame(frame);
+    uint8_t * data = frame.GetData(0);
+
+    Eyer::EyerAVFrame moveFrame(std::move(frame));
+    ASSERT_EQ(moveFrame.GetData(0), data);
+    ASSERT_TRUE(moveFrame.IsWritable());
+    // 被移动过的帧是空帧
+    ASSERT_EQ(frame.GetData(0), nullptr);
+    ASSERT_EQ(frame.GetWidth(), 0);
+
+    // 移动赋值是交换, 原来的数据到了被移动的帧里
+    Eyer::EyerAVFrame assignFrame;
+    EyerAVFrameTest_FillFrame(assignFrame);
+    uint8_t * assignData = assignFrame.GetData(0);
+    assignFrame = std::move(moveFrame);
+    ASSERT_EQ(assignFrame.GetData(0), data);
+    ASSERT_TRUE(assignFrame.IsWritable());
+    ASSERT_EQ(moveFrame.GetData(0), assignData);
+    ASSERT_TRUE(moveFrame.IsWritable());
+
+    // 被移动过的帧可以重新赋值
+    frame = assignFrame;
+    ASSERT_EQ(frame.GetData(0), data);
+    ASSERT_EQ(frame.GetWidth(), 320);
+}
+
 #endif //EYERLIB_EYERAVFRAMETEST_HPP
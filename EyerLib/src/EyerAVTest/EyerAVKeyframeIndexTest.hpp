@@ -0,0 +1,96 @@
+#ifndef EYERLIB_EYERAVKEYFRAMEINDEXTEST_HPP
+#define EYERLIB_EYERAVKEYFRAMEINDEXTEST_HPP
+
+#include <stdio.h>
+#include <math.h>
+#include <gtest/gtest.h>
+#include "EyerAV/EyerAV.hpp"
+
+TEST(EyerAV, EyerAVKeyframeIndexTest)
+{
+    Eyer::EyerAVKeyframeIndex index;
+    ASSERT_EQ(index.Build("./demo.mp4"), 0);
+    ASSERT_TRUE(index.IsValid());
+    ASSERT_GT(index.GetKeyframeNum(), 0);
+
+    for(int i = 1; i < index.GetKeyframeNum(); i++){
+        ASSERT_LT(index.GetKeyframe(i - 1).pts, index.GetKeyframe(i).pts);
+        ASSERT_LT(index.GetKeyframe(i - 1).pos, index.GetKeyframe(i).pos);
+    }
+
+    // 每个时间点都落在它前面最近的关键帧上
+    for(int i = 0; i < index.GetKeyframeNum(); i++){
+        Eyer::EyerAVKeyframe keyframe = index.GetKeyframe(i);
+        ASSERT_EQ(index.FindKeyframe(keyframe.pts), i);
+        ASSERT_EQ(index.FindKeyframe(keyframe.pts + 0.001), i);
+    }
+    ASSERT_EQ(index.FindKeyframe(-1.0), 0);
+
+    // 存成旁路文件再读回来
+    remove("./demo.mp4.keyindex");
+    ASSERT_EQ(index.Save("./demo.mp4.keyindex"), 0);
+    Eyer::EyerAVKeyframeIndex loadIndex;
+    ASSERT_EQ(loadIndex.Load("./demo.mp4.keyindex", "./demo.mp4"), 0);
+    ASSERT_EQ(loadIndex.GetKeyframeNum(), index.GetKeyframeNum());
+    for(int i = 0; i < index.GetKeyframeNum(); i++){
+        ASSERT_EQ(loadIndex.GetKeyframe(i).pts, index.GetKeyframe(i).pts);
+        ASSERT_EQ(loadIndex.GetKeyframe(i).pos, index.GetKeyframe(i).pos);
+    }
+
+    // 源文件大小对不上时作废
+    FILE * otherFile = fopen("./keyframe_index_other.bin", "wb");
+    ASSERT_NE(otherFile, nullptr);
+    fputs("other", otherFile);
+    fclose(otherFile);
+    Eyer::EyerAVKeyframeIndex staleIndex;
+    ASSERT_NE(staleIndex.Load("./demo.mp4.keyindex", "./keyframe_index_other.bin"), 0);
+    ASSERT_FALSE(staleIndex.IsValid());
+    remove("./keyframe_index_other.bin");
+
+    // 大小相同, 修改时间对不上时也作废
+    int64_t fileSize = 0;
+    int64_t fileMtime = 0;
+    ASSERT_EQ(Eyer::EyerAVFileUtil::GetFileInfo("./demo.mp4", fileSize, fileMtime), 0);
+    for(int i = 0; i < 2; i++){
+        FILE * indexFile = fopen("./demo.mp4.keyindex", "wb");
+        ASSERT_NE(indexFile, nullptr);
+        fprintf(indexFile, "EyerAVKeyframeIndex 2 %lld %lld 1\n0 0\n", (long long)fileSize, (long long)(fileMtime + i));
+        fclose(indexFile);
+        Eyer::EyerAVKeyframeIndex mtimeIndex;
+        if(i == 0){
+            ASSERT_EQ(mtimeIndex.Load("./demo.mp4.keyindex", "./demo.mp4"), 0);
+        }
+        else{
+            ASSERT_NE(mtimeIndex.Load("./demo.mp4.keyindex", "./demo.mp4"), 0);
+        }
+    }
+    remove("./demo.mp4.keyindex");
+}
+
+TEST(EyerAV, EyerAVKeyframeIndexTest_DecoderBox)
+{
+    Eyer::EyerAVDecoderLineParams params;
+    params.SetKeyframeIndex(true, true);
+    remove("./demo.mp4.keyindex");
+
+    // 第一个 Box 建立索引并存下来, 第二个直接读取
+    for(int round = 0; round < 2; round++){
+        Eyer::EyerAVDecoderBox decoderBox("./demo.mp4", params);
+        for(int i = 0; i < 100; i++){
+            double pts = Eyer::EyerRand::Rand(8000) * 1.0 / 1000;
+            Eyer::EyerAVFrame frame;
+            int ret = decoderBox.GetFrame(frame, pts);
+            ASSERT_EQ(ret, 0);
+            ASSERT_LE(fabs(frame.GetSecPTS() - pts), 0.05);
+        }
+        ASSERT_TRUE(decoderBox.keyframeIndex.IsValid());
+        ASSERT_LE(decoderBox.decoderLineCache.size(), 3);
+
+        FILE * file = fopen("./demo.mp4.keyindex", "rb");
+        ASSERT_NE(file, nullptr);
+        fclose(file);
+    }
+    remove("./demo.mp4.keyindex");
+}
+
+#endif //EYERLIB_EYERAVKEYFRAMEINDEXTEST_HPP
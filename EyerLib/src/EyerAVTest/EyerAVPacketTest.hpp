@@ -1,6 +1,8 @@
 #ifndef EYERLIB_EYERAVPACKETTEST_HPP
 #define EYERLIB_EYERAVPACKETTEST_HPP
 
+#include <utility>
+#include <type_traits>
 #include <gtest/gtest.h>
 #include "EyerAV/EyerAV.hpp"
 
@@ -12,4 +14,108 @@ TEST(EyerAV, EyerAVPacketTest)
     }
 }
 
+TEST(EyerAV, EyerAVPacketTest_CopyMove)
+{
+    ASSERT_TRUE(std::is_nothrow_move_constructible<Eyer::EyerAVPacket>::value);
+    ASSERT_TRUE(std::is_nothrow_move_assignable<Eyer::EyerAVPacket>::value);
+
+    Eyer::EyerAVReader reader("./demo.mp4");
+    ASSERT_EQ(reader.Open(), 0);
+
+    Eyer::EyerAVPacket packet;
+    ASSERT_EQ(reader.Read(packet), 0);
+    ASSERT_GT(packet.GetSize(), 0);
+
+    // 拷贝只增加引用, 数据是同一份
+    Eyer::EyerAVPacket copyPacket(packet);
+    ASSERT_EQ(copyPacket.GetDatePtr(), packet.GetDatePtr());
+    ASSERT_EQ(copyPacket.GetSize(), packet.GetSize());
+    ASSERT_EQ(copyPacket.GetPTS(), packet.GetPTS());
+    ASSERT_EQ(copyPacket.GetSecPTS(), packet.GetSecPTS());
+
+    copyPacket = copyPacket;
+    ASSERT_EQ(copyPacket.GetDatePtr(), packet.GetDatePtr());
+
+    // 移动不分配也不复制
+    uint8_t * data = packet.GetDatePtr();
+    Eyer::EyerAVPacket movePacket(std::move(packet));
+    ASSERT_EQ(movePacket.GetDatePtr(), data);
+
+    // 被移动过的包是空包, 可以继续使用
+    ASSERT_EQ(packet.GetSize(), 0);
+    ASSERT_EQ(packet.GetDatePtr(), nullptr);
+
+    // 移动赋值是交换, 原来的空包到了被移动的包里
+    Eyer::EyerAVPacket assignPacket;
+    assignPacket = std::move(movePacket);
+    ASSERT_EQ(assignPacket.GetDatePtr(), data);
+    ASSERT_EQ(movePacket.GetSize(), 0);
+
+    // 被移动过的包可以重新赋值
+    packet = assignPacket;
+    ASSERT_EQ(packet.GetDatePtr(), data);
+
+    // 被移动过的包可以直接读取, 也可以放回池子复用
+    Eyer::EyerAVPacketPool pool(1);
+    Eyer::EyerAVPacket * poolPacket = pool.NewPacket();
+    Eyer::EyerAVPacket keepPacket(std::move(*poolPacket));
+    ASSERT_EQ(reader.Read(*poolPacket), 0);
+    ASSERT_GT(poolPacket->GetSize(), 0);
+    pool.DeletePacket(poolPacket);
+    ASSERT_EQ(pool.GetFreePacketNum(), 1);
+    ASSERT_EQ(pool.NewPacket(), poolPacket);
+    ASSERT_EQ(poolPacket->GetSize(), 0);
+    pool.DeletePacket(poolPacket);
+
+    // 同一个包循环读取, 原来的数据先释放
+    ASSERT_EQ(reader.Read(packet), 0);
+    ASSERT_NE(packet.GetDatePtr(), data);
+    ASSERT_EQ(copyPacket.GetDatePtr(), data);
+
+    packet.Unref();
+    ASSERT_EQ(packet.GetSize(), 0);
+    ASSERT_EQ(packet.GetDatePtr(), nullptr);
+    ASSERT_EQ(packet.GetSecPTS(), 0.0);
+
+    reader.Close();
+}
+
+TEST(EyerAV, EyerAVPacketTest_Pool)
+{
+    Eyer::EyerAVPacketPool pool(4);
+
+    Eyer::EyerAVReader reader("./demo.mp4");
+    ASSERT_EQ(reader.Open(), 0);
+
+    Eyer::EyerAVPacket * first = nullptr;
+    for(int i = 0; i < 100; i++){
+        Eyer::EyerAVPacket * packet = pool.NewPacket();
+        if(first == nullptr){
+            first = packet;
+        }
+        // 一次只用一个包, 拿到的一直是同一个对象
+        ASSERT_EQ(packet, first);
+        ASSERT_EQ(packet->GetSize(), 0);
+
+        if(reader.Read(*packet)){
+            pool.DeletePacket(packet);
+            break;
+        }
+        pool.DeletePacket(packet);
+    }
+    ASSERT_EQ(pool.GetFreePacketNum(), 1);
+
+    // 超过上限的包直接释放
+    Eyer::EyerAVPacket * packetList[8];
+    for(int i = 0; i < 8; i++){
+        packetList[i] = pool.NewPacket();
+    }
+    for(int i = 0; i < 8; i++){
+        pool.DeletePacket(packetList[i]);
+    }
+    ASSERT_EQ(pool.GetFreePacketNum(), 4);
+
+    reader.Close();
+}
+
 #endif //EYERLIB_EYERAVPACKETTEST_HPP
@@ -0,0 +1,140 @@
+#ifndef EYERLIB_EYERAVRESAMPLETEST_HPP
+#define EYERLIB_EYERAVRESAMPLETEST_HPP
+
+#include <stdlib.h>
+#include <gtest/gtest.h>
+#include "EyerAV/EyerAV.hpp"
+
+// 按 frameSize 一帧一帧送入 inputSampleNB 个采样, 刷新后取完, 返回输出的采样数
+static int64_t EyerAVResampleTest_Run(Eyer::EyerAVResample & resample,
+                                      const Eyer::EyerAVChannelLayout & inputLayout, const Eyer::EyerAVSampleFormat & inputFormat, int inputSamplerate,
+                                      int64_t inputSampleNB, int frameSize, int outputFrameSize)
+{
+    Eyer::EyerAVFrame inputFrame;
+    inputFrame.InitAudioData(inputLayout, inputFormat, inputSamplerate, frameSize);
+
+    int64_t outputSampleNB = 0;
+    Eyer::EyerAVFrame outputFrame;
+    for(int64_t putSampleNB = 0; putSampleNB < inputSampleNB; putSampleNB += frameSize){
+        if(resample.PutAVFrame(inputFrame)){
+            return -1;
+        }
+        while(resample.GetFrame(outputFrame, outputFrameSize) == 0){
+            outputSampleNB += outputFrame.GetSampleNB();
+        }
+    }
+
+    resample.PutAVFrameNULL();
+    while(resample.GetFrame(outputFrame, outputFrameSize) == 0){
+        outputSampleNB += outputFrame.GetSampleNB();
+    }
+    // 最后一帧补静音, 只统计有效的采样
+    int remainSampleNB = resample.GetBufferSampleNB();
+    if(resample.GetLastFrame(outputFrame, outputFrameSize) == 0){
+        outputSampleNB += remainSampleNB;
+    }
+    return outputSampleNB;
+}
+
+TEST(EyerAV, EyerAVResampleTest)
+{
+    // 44.1k -> 48k, 刷新之后输出的采样数与按采样率换算的一致
+    Eyer::EyerAVResample resample;
+    int ret = resample.Init(
+            Eyer::EyerAVChannelLayout::EYER_AV_CH_LAYOUT_STEREO, Eyer::EyerAVSampleFormat::SAMPLE_FMT_FLTP, 48000,
+            Eyer::EyerAVChannelLayout::EYER_AV_CH_LAYOUT_STEREO, Eyer::EyerAVSampleFormat::SAMPLE_FMT_S16, 44100
+    );
+    ASSERT_EQ(ret, 0);
+
+    int64_t outputSampleNB = EyerAVResampleTest_Run(resample,
+                                                    Eyer::EyerAVChannelLayout::EYER_AV_CH_LAYOUT_STEREO, Eyer::EyerAVSampleFormat::SAMPLE_FMT_S16, 44100,
+                                                    44100 * 2, 1024, 1024);
+    int64_t inputSampleNB = (44100 * 2 + 1023) / 1024 * 1024;
+    int64_t expectSampleNB = inputSampleNB * 48000 / 44100;
+    ASSERT_LE(llabs(outputSampleNB - expectSampleNB), 4);
+
+    // 输出缓冲已经取完
+    Eyer::EyerAVFrame frame;
+    ASSERT_NE(resample.GetLastFrame(frame, 1024), 0);
+    ASSERT_EQ(resample.GetBufferSampleNB(), 0);
+}
+
+TEST(EyerAV, EyerAVResampleTest_SmallLastFrame)
+{
+    Eyer::EyerAVResample resample;
+    int ret = resample.Init(
+            Eyer::EyerAVChannelLayout::EYER_AV_CH_LAYOUT_STEREO, Eyer::EyerAVSampleFormat::SAMPLE_FMT_FLTP, 48000,
+            Eyer::EyerAVChannelLayout::EYER_AV_CH_LAYOUT_STEREO, Eyer::EyerAVSampleFormat::SAMPLE_FMT_FLTP, 48000
+    );
+    ASSERT_EQ(ret, 0);
+
+    Eyer::EyerAVFrame inputFrame;
+    inputFrame.InitAudioData(Eyer::EyerAVChannelLayout::EYER_AV_CH_LAYOUT_STEREO, Eyer::EyerAVSampleFormat::SAMPLE_FMT_FLTP, 48000, 1500);
+    ASSERT_EQ(resample.PutAVFrame(inputFrame), 0);
+    resample.PutAVFrameNULL();
+
+    Eyer::EyerAVFrame frame;
+    ASSERT_EQ(resample.GetFrame(frame, 1024), 0);
+    ASSERT_NE(resample.GetFrame(frame, 1024), 0);
+
+    // 不补静音时最后一帧只有剩余的采样
+    int remainSampleNB = resample.GetBufferSampleNB();
+    ASSERT_GT(remainSampleNB, 0);
+    ASSERT_EQ(resample.GetLastFrame(frame, 1024, false), 0);
+    ASSERT_EQ(frame.GetSampleNB(), remainSampleNB);
+    ASSERT_NE(resample.GetLastFrame(frame, 1024, false), 0);
+}
+
+// 常见采样率和声道转换的吞吐量, 只输出日志, 不做断言
+// 耗时较长, 默认不跑, 用 --gtest_also_run_disabled_tests 运行
+TEST(EyerAV, DISABLED_EyerAVResampleTest_Benchmark)
+{
+    struct EyerAVResampleTestCase
+    {
+        const char * name;
+        Eyer::EyerAVChannelLayout inputLayout;
+        Eyer::EyerAVSampleFormat inputFormat;
+        int inputSamplerate;
+        Eyer::EyerAVChannelLayout outputLayout;
+        Eyer::EyerAVSampleFormat outputFormat;
+        int outputSamplerate;
+    };
+    EyerAVResampleTestCase caseList[] = {
+            {"44100 s16 stereo -> 48000 fltp stereo",
+                    Eyer::EyerAVChannelLayout::EYER_AV_CH_LAYOUT_STEREO, Eyer::EyerAVSampleFormat::SAMPLE_FMT_S16, 44100,
+                    Eyer::EyerAVChannelLayout::EYER_AV_CH_LAYOUT_STEREO, Eyer::EyerAVSampleFormat::SAMPLE_FMT_FLTP, 48000},
+            {"48000 fltp stereo -> 44100 s16 stereo",
+                    Eyer::EyerAVChannelLayout::EYER_AV_CH_LAYOUT_STEREO, Eyer::EyerAVSampleFormat::SAMPLE_FMT_FLTP, 48000,
+                    Eyer::EyerAVChannelLayout::EYER_AV_CH_LAYOUT_STEREO, Eyer::EyerAVSampleFormat::SAMPLE_FMT_S16, 44100},
+            {"48000 s16 stereo -> 48000 fltp stereo",
+                    Eyer::EyerAVChannelLayout::EYER_AV_CH_LAYOUT_STEREO, Eyer::EyerAVSampleFormat::SAMPLE_FMT_S16, 48000,
+                    Eyer::EyerAVChannelLayout::EYER_AV_CH_LAYOUT_STEREO, Eyer::EyerAVSampleFormat::SAMPLE_FMT_FLTP, 48000},
+            {"48000 fltp 5.1 -> 48000 fltp stereo",
+                    Eyer::EyerAVChannelLayout::EYER_AV_CH_LAYOUT_5POINT1, Eyer::EyerAVSampleFormat::SAMPLE_FMT_FLTP, 48000,
+                    Eyer::EyerAVChannelLayout::EYER_AV_CH_LAYOUT_STEREO, Eyer::EyerAVSampleFormat::SAMPLE_FMT_FLTP, 48000},
+            {"22050 s16 mono -> 44100 fltp stereo",
+                    Eyer::EyerAVChannelLayout::EYER_AV_CH_LAYOUT_MONO, Eyer::EyerAVSampleFormat::SAMPLE_FMT_S16, 22050,
+                    Eyer::EyerAVChannelLayout::EYER_AV_CH_LAYOUT_STEREO, Eyer::EyerAVSampleFormat::SAMPLE_FMT_FLTP, 44100}
+    };
+
+    for(int i = 0; i < sizeof(caseList) / sizeof(caseList[0]); i++){
+        EyerAVResampleTestCase & c = caseList[i];
+
+        Eyer::EyerAVResample resample;
+        ASSERT_EQ(resample.Init(c.outputLayout, c.outputFormat, c.outputSamplerate, c.inputLayout, c.inputFormat, c.inputSamplerate), 0);
+
+        // 60 秒输入
+        int64_t inputSampleNB = (int64_t)c.inputSamplerate * 60;
+        long long startTime = Eyer::EyerTime::GetTime();
+        int64_t outputSampleNB = EyerAVResampleTest_Run(resample, c.inputLayout, c.inputFormat, c.inputSamplerate, inputSampleNB, 1024, 1024);
+        long long costTime = Eyer::EyerTime::GetTime() - startTime;
+        if(costTime <= 0){
+            costTime = 1;
+        }
+        ASSERT_GT(outputSampleNB, 0);
+
+        EyerLog("Resample Benchmark %s: %lld ms, %f samples/s\n", c.name, costTime, inputSampleNB * 1000.0 / costTime);
+    }
+}
+
+#endif //EYERLIB_EYERAVRESAMPLETEST_HPP
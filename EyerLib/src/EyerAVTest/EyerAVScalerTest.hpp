@@ -0,0 +1,126 @@
+#ifndef EYERLIB_EYERAVSCALERTEST_HPP
+#define EYERLIB_EYERAVSCALERTEST_HPP
+
+#include <string.h>
+#include <gtest/gtest.h>
+#include "EyerAV/EyerAV.hpp"
+
+static int EyerAVScalerTest_FillFrame(Eyer::EyerAVFrame & frame, int width, int height, int seed)
+{
+    frame.InitVideoData(Eyer::EyerAVPixelFormat::EYER_YUV420P, width, height);
+    for(int plane = 0; plane < 3; plane++){
+        int planeHeight = plane == 0 ? height : height / 2;
+        for(int y = 0; y < planeHeight; y++){
+            uint8_t * line = frame.GetData(plane) + y * frame.GetLinesize(plane);
+            for(int x = 0; x < frame.GetLinesize(plane); x++){
+                line[x] = (uint8_t)(x + y * 3 + seed + plane * 50);
+            }
+        }
+    }
+    return 0;
+}
+
+TEST(EyerAV, EyerAVScalerTest)
+{
+    Eyer::EyerAVScaler scaler;
+
+    for(int i = 0; i < 10; i++){
+        Eyer::EyerAVFrame frame;
+        EyerAVScalerTest_FillFrame(frame, 1920, 1080, i);
+
+        Eyer::EyerAVFrame cachedFrame;
+        int ret = scaler.Scale(frame, cachedFrame, Eyer::EyerAVPixelFormat::EYER_RGBA, 1280, 720);
+        ASSERT_EQ(ret, 0);
+
+        Eyer::EyerAVFrame onceFrame;
+        ret = frame.Scale(onceFrame, Eyer::EyerAVPixelFormat::EYER_RGBA, 1280, 720);
+        ASSERT_EQ(ret, 0);
+
+        // 复用的 SwsContext 和每次新建的结果必须一致
+        ASSERT_EQ(cachedFrame.GetWidth(), 1280);
+        ASSERT_EQ(cachedFrame.GetHeight(), 720);
+        ASSERT_EQ(cachedFrame.GetLinesize(0), onceFrame.GetLinesize(0));
+        ASSERT_EQ(memcmp(cachedFrame.GetData(0), onceFrame.GetData(0), cachedFrame.GetLinesize(0) * 720), 0);
+    }
+
+    // 参数变化后重建 SwsContext
+    Eyer::EyerAVFrame frame;
+    EyerAVScalerTest_FillFrame(frame, 1280, 720, 0);
+    Eyer::EyerAVFrame smallFrame;
+    ASSERT_EQ(scaler.Scale(frame, smallFrame, Eyer::EyerAVPixelFormat::EYER_YUV420P, 640, 360), 0);
+    ASSERT_EQ(smallFrame.GetWidth(), 640);
+    ASSERT_EQ(smallFrame.GetHeight(), 360);
+    ASSERT_EQ(smallFrame.GetPixelFormat(), Eyer::EyerAVPixelFormat::EYER_YUV420P);
+}
+
+TEST(EyerAV, EyerAVScalerTest_Quality)
+{
+    Eyer::EyerAVFrame frame;
+    EyerAVScalerTest_FillFrame(frame, 1920, 1080, 0);
+
+    Eyer::EyerAVScaler scaler;
+    ASSERT_EQ(scaler.GetQuality(), Eyer::EyerAVScaleQuality::SINC);
+
+    Eyer::EyerAVFrame sincFrame;
+    ASSERT_EQ(scaler.Scale(frame, sincFrame, Eyer::EyerAVPixelFormat::EYER_YUV420P, 1280, 720), 0);
+
+    // 切换算法后必须重建 SwsContext, 结果与新建的 FAST_BILINEAR scaler 一致
+    scaler.SetQuality(Eyer::EyerAVScaleQuality::FAST_BILINEAR);
+    Eyer::EyerAVFrame switchFrame;
+    ASSERT_EQ(scaler.Scale(frame, switchFrame, Eyer::EyerAVPixelFormat::EYER_YUV420P, 1280, 720), 0);
+
+    Eyer::EyerAVScaler fastScaler;
+    fastScaler.SetQuality(Eyer::EyerAVScaleQuality::FAST_BILINEAR);
+    Eyer::EyerAVFrame fastFrame;
+    ASSERT_EQ(fastScaler.Scale(frame, fastFrame, Eyer::EyerAVPixelFormat::EYER_YUV420P, 1280, 720), 0);
+
+    ASSERT_EQ(switchFrame.GetLinesize(0), fastFrame.GetLinesize(0));
+    ASSERT_EQ(memcmp(switchFrame.GetData(0), fastFrame.GetData(0), fastFrame.GetLinesize(0) * 720), 0);
+
+    ASSERT_EQ(Eyer::EyerAVScaleQuality::GetById(Eyer::EyerAVScaleQuality::LANCZOS.GetId()), Eyer::EyerAVScaleQuality::LANCZOS);
+}
+
+// 各算法预设在 1080p / 4K 输入下的吞吐量, 只输出日志, 不做断言
+// 耗时较长, 默认不跑, 用 --gtest_also_run_disabled_tests 运行
+TEST(EyerAV, DISABLED_EyerAVScalerTest_Benchmark)
+{
+    Eyer::EyerAVScaleQuality qualityList[] = {
+            Eyer::EyerAVScaleQuality::FAST_BILINEAR,
+            Eyer::EyerAVScaleQuality::BICUBIC,
+            Eyer::EyerAVScaleQuality::LANCZOS,
+            Eyer::EyerAVScaleQuality::SINC
+    };
+    int sizeList[][2] = {
+            {1920, 1080},
+            {3840, 2160}
+    };
+    int frameCount = 30;
+
+    for(int s = 0; s < 2; s++){
+        int width = sizeList[s][0];
+        int height = sizeList[s][1];
+
+        Eyer::EyerAVFrame frame;
+        EyerAVScalerTest_FillFrame(frame, width, height, s);
+
+        for(int q = 0; q < 4; q++){
+            Eyer::EyerAVScaler scaler;
+            scaler.SetQuality(qualityList[q]);
+
+            long long startTime = Eyer::EyerTime::GetTime();
+            for(int i = 0; i < frameCount; i++){
+                Eyer::EyerAVFrame outFrame;
+                ASSERT_EQ(scaler.Scale(frame, outFrame, Eyer::EyerAVPixelFormat::EYER_YUV420P, 1280, 720), 0);
+            }
+            long long costTime = Eyer::EyerTime::GetTime() - startTime;
+            if(costTime <= 0){
+                costTime = 1;
+            }
+
+            EyerLog("Scaler Benchmark %dx%d -> 1280x720, %s: %lld ms, %f fps\n",
+                    width, height, qualityList[q].GetName().c_str(), costTime, frameCount * 1000.0 / costTime);
+        }
+    }
+}
+
+#endif //EYERLIB_EYERAVSCALERTEST_HPP
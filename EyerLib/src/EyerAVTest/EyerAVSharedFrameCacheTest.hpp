@@ -0,0 +1,143 @@
+#ifndef EYERLIB_EYERAVSHAREDFRAMECACHETEST_HPP
+#define EYERLIB_EYERAVSHAREDFRAMECACHETEST_HPP
+
+#include <gtest/gtest.h>
+#include "EyerAV/EyerAV.hpp"
+
+TEST(EyerAV, EyerAVSharedFrameCacheTest)
+{
+    Eyer::EyerAVSharedFrameCache & cache = Eyer::EyerAVSharedFrameCache::GetInstance();
+    int64_t oldMaxBytes = cache.GetMaxBytes();
+    cache.Clear();
+    cache.SetMaxBytes(256 * 1024 * 1024);
+
+    Eyer::EyerString key = "shared_frame_cache_test";
+    double ptsList[4] = {0.0, 0.04, 0.08, 0.12};
+    Eyer::EyerAVFrame frameList[4];
+    for(int i = 0; i < 4; i++){
+        frameList[i].InitVideoData(Eyer::EyerAVPixelFormat::EYER_YUV420P, 64, 64);
+        frameList[i].SetSecPTS(ptsList[i]);
+    }
+
+    // 0.00 -> 0.04 连续, 0.08 的下一帧还不知道
+    cache.Put(key, frameList[0], 0.04);
+    cache.Put(key, frameList[1], -1.0);
+    cache.Put(key, frameList[2], -1.0);
+    ASSERT_EQ(cache.GetFrameNum(), 3);
+
+    Eyer::EyerAVFrame frame;
+    ASSERT_EQ(cache.Get(key, 0.0, frame), 0);
+    ASSERT_DOUBLE_EQ(frame.GetSecPTS(), 0.0);
+    ASSERT_EQ(cache.Get(key, 0.015, frame), 0);
+    ASSERT_DOUBLE_EQ(frame.GetSecPTS(), 0.0);
+    ASSERT_EQ(cache.Get(key, 0.03, frame), 0);
+    ASSERT_DOUBLE_EQ(frame.GetSecPTS(), 0.04);
+    ASSERT_EQ(cache.Get(key, 0.08, frame), 0);
+    ASSERT_DOUBLE_EQ(frame.GetSecPTS(), 0.08);
+
+    // 0.04 和 0.08 之间是否还有帧不确定
+    ASSERT_NE(cache.Get(key, 0.05, frame), 0);
+    ASSERT_NE(cache.Get(key, 0.09, frame), 0);
+    ASSERT_NE(cache.Get(key, -1.0, frame), 0);
+    ASSERT_NE(cache.Get("other_key", 0.0, frame), 0);
+
+    // 空 key 表示不缓存
+    ASSERT_NE(cache.Put("", frameList[0], 0.04), 0);
+    ASSERT_NE(cache.Get("", 0.0, frame), 0);
+
+    // 补上之后可以查到, 最后一帧之后都返回最后一帧
+    cache.Put(key, frameList[1], 0.08);
+    cache.Put(key, frameList[2], 0.12);
+    cache.Put(key, frameList[3], EYER_AV_SHARED_FRAME_CACHE_EOF);
+    ASSERT_EQ(cache.Get(key, 0.05, frame), 0);
+    ASSERT_DOUBLE_EQ(frame.GetSecPTS(), 0.04);
+    ASSERT_EQ(cache.Get(key, 100.0, frame), 0);
+    ASSERT_DOUBLE_EQ(frame.GetSecPTS(), 0.12);
+    ASSERT_EQ(cache.GetFrameNum(), 4);
+    ASSERT_EQ(cache.GetBytes(), frameList[0].GetBufferSize() * 4);
+
+    // 超出预算时淘汰最久没用的, 0.12 刚用过
+    cache.SetMaxBytes(frameList[0].GetBufferSize() * 2);
+    ASSERT_EQ(cache.GetFrameNum(), 2);
+    ASSERT_EQ(cache.Get(key, 0.12, frame), 0);
+    ASSERT_NE(cache.Get(key, 0.0, frame), 0);
+
+    cache.Clear();
+    ASSERT_EQ(cache.GetFrameNum(), 0);
+    ASSERT_EQ(cache.GetBytes(), 0);
+    cache.SetMaxBytes(oldMaxBytes);
+}
+
+class EyerAVSharedFrameCacheTestIO : public Eyer::EyerAVReaderCustomIO
+{
+public:
+    virtual int Read(uint8_t *buf, int buf_size)
+    {
+        return -1;
+    }
+    virtual int64_t Seek(int64_t offset, int whence)
+    {
+        return -1;
+    }
+};
+
+TEST(EyerAV, EyerAVSharedFrameCacheTest_Key)
+{
+    Eyer::EyerAVDecoderLineParams params;
+    Eyer::EyerAVDecoderLineParams scaleParams;
+    scaleParams.SetScale(Eyer::EyerAVPixelFormat::EYER_RGBA, 320, 180);
+
+    Eyer::EyerString key = Eyer::EyerAVSharedFrameCache::GetKey("./demo.mp4", nullptr, params);
+    ASSERT_TRUE(key == Eyer::EyerAVSharedFrameCache::GetKey("./demo.mp4", nullptr, params));
+    ASSERT_FALSE(key == Eyer::EyerAVSharedFrameCache::GetKey("./demo.mp4", nullptr, scaleParams));
+    ASSERT_FALSE(key == Eyer::EyerAVSharedFrameCache::GetKey("./2.jpg", nullptr, params));
+    ASSERT_FALSE(key.IsEmpty());
+
+    // 自定义 IO 和不存在的文件不缓存
+    EyerAVSharedFrameCacheTestIO customIO;
+    ASSERT_TRUE(Eyer::EyerAVSharedFrameCache::GetKey("./demo.mp4", &customIO, params).IsEmpty());
+    ASSERT_TRUE(Eyer::EyerAVSharedFrameCache::GetKey("./not_exist.mp4", nullptr, params).IsEmpty());
+}
+
+TEST(EyerAV, EyerAVSharedFrameCacheTest_DecoderLine)
+{
+    Eyer::EyerAVSharedFrameCache & cache = Eyer::EyerAVSharedFrameCache::GetInstance();
+    cache.Clear();
+
+    // 第二条解码线和 Box 不用再解码
+    Eyer::EyerAVDecoderLineParams params(16);
+    params.SetSharedFrameCache(true);
+    Eyer::EyerAVDecoderLine line("./demo.mp4", 0, nullptr, params);
+    Eyer::EyerAVDecoderLine otherLine("./demo.mp4", 0, nullptr, params);
+    Eyer::EyerAVDecoderBox decoderBox("./demo.mp4", params);
+
+    for(double pts = 0.0; pts < 2.0; pts += 0.04){
+        Eyer::EyerAVFrame frame;
+        ASSERT_EQ(line.GetFrame(frame, pts), 0);
+
+        int64_t hitNum = cache.GetHitNum();
+        Eyer::EyerAVFrame otherFrame;
+        ASSERT_EQ(otherLine.GetFrame(otherFrame, pts), 0);
+        ASSERT_DOUBLE_EQ(otherFrame.GetSecPTS(), frame.GetSecPTS());
+
+        Eyer::EyerAVFrame boxFrame;
+        ASSERT_EQ(decoderBox.GetFrame(boxFrame, pts), 0);
+        ASSERT_DOUBLE_EQ(boxFrame.GetSecPTS(), frame.GetSecPTS());
+        ASSERT_EQ(cache.GetHitNum(), hitNum + 2);
+    }
+    ASSERT_EQ(otherLine.GetCacheSize(), 0);
+    ASSERT_EQ(decoderBox.decoderLineCache.size(), 0);
+
+    // 默认打开, 关闭后自己解码
+    Eyer::EyerAVDecoderLineParams noSharedParams(16);
+    ASSERT_TRUE(noSharedParams.sharedFrameCache);
+    noSharedParams.SetSharedFrameCache(false);
+    Eyer::EyerAVDecoderLine noSharedLine("./demo.mp4", 0, nullptr, noSharedParams);
+    Eyer::EyerAVFrame frame;
+    ASSERT_EQ(noSharedLine.GetFrame(frame, 1.0), 0);
+    ASSERT_GT(noSharedLine.GetCacheSize(), 0);
+
+    cache.Clear();
+}
+
+#endif //EYERLIB_EYERAVSHAREDFRAMECACHETEST_HPP
@@ -0,0 +1,139 @@
+#ifndef EYERLIB_EYERAVWRITERCUSTOMIOTEST_HPP
+#define EYERLIB_EYERAVWRITERCUSTOMIOTEST_HPP
+
+#include <stdio.h>
+#include <gtest/gtest.h>
+#include "EyerAV/EyerAV.hpp"
+
+TEST(EyerAV, EyerAVWriterCustomIOTest_Memory)
+{
+    Eyer::EyerAVMemoryWriterCustomIO io;
+
+    uint8_t head[4] = {1, 2, 3, 4};
+    uint8_t body[8] = {5, 6, 7, 8, 9, 10, 11, 12};
+    ASSERT_EQ(io.Write(head, 4), 4);
+    ASSERT_EQ(io.Write(body, 8), 8);
+    ASSERT_EQ(io.GetSize(), 12);
+    ASSERT_EQ(io.Seek(0, Eyer::EyerAVWriterCustomIO::SEEK_SIZE), 12);
+
+    // 回到开头改写文件头, 大小不变
+    uint8_t newHead[2] = {0xAA, 0xBB};
+    ASSERT_EQ(io.Seek(1, SEEK_SET), 1);
+    ASSERT_EQ(io.Write(newHead, 2), 2);
+    ASSERT_EQ(io.GetSize(), 12);
+    ASSERT_EQ(io.GetData()[0], 1);
+    ASSERT_EQ(io.GetData()[1], 0xAA);
+    ASSERT_EQ(io.GetData()[2], 0xBB);
+    ASSERT_EQ(io.GetData()[3], 4);
+
+    ASSERT_EQ(io.Seek(0, SEEK_END), 12);
+    ASSERT_EQ(io.Write(head, 4), 4);
+    ASSERT_EQ(io.GetSize(), 16);
+    ASSERT_EQ(io.Seek(-20, SEEK_CUR), -1);
+
+    Eyer::EyerBuffer buffer = io.GetBuffer();
+    ASSERT_EQ(buffer.GetLen(), 16);
+    ASSERT_EQ(buffer.GetPtr()[15], 4);
+}
+
+TEST(EyerAV, EyerAVWriterCustomIOTest_Jpeg)
+{
+    Eyer::EyerAVDecoderLineParams params;
+    Eyer::EyerAVDecoderBoxGroup decoderBoxGroup(params);
+
+    Eyer::EyerAVFrame frame;
+    ASSERT_EQ(decoderBoxGroup.GetFrame(frame, "./demo.mp4", 1.0), 0);
+
+    Eyer::EyerAVMemoryWriterCustomIO io;
+    Eyer::EyerImageUtil imageUtil;
+    ASSERT_EQ(imageUtil.WriteFrame(frame, &io), 0);
+
+    // JPEG 以 SOI 开始, EOI 结束
+    ASSERT_GT(io.GetSize(), 4);
+    const uint8_t * data = io.GetData();
+    ASSERT_EQ(data[0], 0xFF);
+    ASSERT_EQ(data[1], 0xD8);
+    ASSERT_EQ(data[io.GetSize() - 2], 0xFF);
+    ASSERT_EQ(data[io.GetSize() - 1], 0xD9);
+}
+
+TEST(EyerAV, EyerAVWriterCustomIOTest_File)
+{
+    Eyer::EyerAVFileWriterCustomIO io("./EyerAVWriterCustomIOTest_File.bin");
+    // 预分配 1M, 关闭时截断到实际写入的大小
+    ASSERT_EQ(io.Open(1024 * 1024), 0);
+
+    uint8_t head[4] = {1, 2, 3, 4};
+    uint8_t body[8] = {5, 6, 7, 8, 9, 10, 11, 12};
+    ASSERT_EQ(io.Write(head, 4), 4);
+    ASSERT_EQ(io.Write(body, 8), 8);
+    ASSERT_EQ(io.Seek(0, Eyer::EyerAVWriterCustomIO::SEEK_SIZE), 12);
+    ASSERT_EQ(io.Seek(0, SEEK_END), 12);
+
+    uint8_t newHead[2] = {0xAA, 0xBB};
+    ASSERT_EQ(io.Seek(1, SEEK_SET), 1);
+    ASSERT_EQ(io.Write(newHead, 2), 2);
+    ASSERT_EQ(io.GetSize(), 12);
+    ASSERT_EQ(io.Close(), 0);
+
+    FILE * f = fopen("./EyerAVWriterCustomIOTest_File.bin", "rb");
+    ASSERT_NE(f, nullptr);
+    uint8_t data[32];
+    int len = fread(data, 1, sizeof(data), f);
+    fclose(f);
+    ASSERT_EQ(len, 12);
+    ASSERT_EQ(data[0], 1);
+    ASSERT_EQ(data[1], 0xAA);
+    ASSERT_EQ(data[2], 0xBB);
+    ASSERT_EQ(data[11], 12);
+}
+
+TEST(EyerAV, EyerAVWriterCustomIOTest_AsyncRemux)
+{
+    Eyer::EyerAVReader reader("./demo.mp4");
+    ASSERT_EQ(reader.Open(), 0);
+
+    Eyer::EyerAVWriter writer("./EyerAVWriterCustomIOTest_AsyncRemux.mp4");
+    ASSERT_EQ(writer.SetIOBufferSize(1024 * 1024), 0);
+    ASSERT_EQ(writer.SetPreallocateSize(64 * 1024 * 1024), 0);
+    ASSERT_EQ(writer.SetAsync(true, 4), 0);
+    ASSERT_EQ(writer.Open(), 0);
+
+    int streamCount = reader.GetStreamCount();
+    for(int i = 0; i < streamCount; i++){
+        ASSERT_EQ(writer.AddStream(reader.GetStream(i)), i);
+    }
+    ASSERT_EQ(writer.WriteHand(), 0);
+
+    int packetCount = 0;
+    while(1){
+        Eyer::EyerAVPacket packet;
+        if(reader.Read(packet)){
+            break;
+        }
+        Eyer::EyerAVRational readTimebase = reader.GetStream(packet.GetStreamIndex()).GetTimebase();
+        packet.RescaleTs(readTimebase, writer.GetTimebase(packet.GetStreamIndex()));
+        ASSERT_EQ(writer.WritePacket(packet), 0);
+        packetCount++;
+    }
+    ASSERT_EQ(writer.WriteTrailer(), 0);
+    ASSERT_EQ(writer.Close(), 0);
+    reader.Close();
+    ASSERT_GT(writer.GetAsyncWriteTime(), 0);
+
+    // 预分配的空间已经截断, 读回的包数和写入的一致
+    Eyer::EyerAVReader checkReader("./EyerAVWriterCustomIOTest_AsyncRemux.mp4");
+    ASSERT_EQ(checkReader.Open(), 0);
+    int checkCount = 0;
+    while(1){
+        Eyer::EyerAVPacket packet;
+        if(checkReader.Read(packet)){
+            break;
+        }
+        checkCount++;
+    }
+    checkReader.Close();
+    ASSERT_EQ(checkCount, packetCount);
+}
+
+#endif //EYERLIB_EYERAVWRITERCUSTOMIOTEST_HPP
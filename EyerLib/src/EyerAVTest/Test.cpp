@@ -52,6 +52,17 @@
 
 #include "EyerAVReaderGetInfoTest.hpp"
 
+#include "EyerAVScalerTest.hpp"
+#include "EyerAVResampleTest.hpp"
+
+#include "EyerAVFrameTest.hpp"
+#include "EyerAVPacketTest.hpp"
+#include "EyerAVFramePoolTest.hpp"
+#include "EyerAVFrameCacheTest.hpp"
+#include "EyerAVKeyframeIndexTest.hpp"
+#include "EyerAVSharedFrameCacheTest.hpp"
+#include "EyerAVWriterCustomIOTest.hpp"
+
 int main(int argc,char **argv){
     testing::InitGoogleTest(&argc, argv);
     int ret = RUN_ALL_TESTS();
@@ -0,0 +1,174 @@
+#include "EyerAVTranscodeProfile.hpp"
+
+#include <stdio.h>
+
+namespace Eyer
+{
+    static EyerString EyerAVTranscodeProfile_Sec(int64_t nanoTime)
+    {
+        char str[64];
+        snprintf(str, sizeof(str), "%.6f", nanoTime * 1.0 / 1000000000);
+        return str;
+    }
+
+    int EyerAVTranscodeStageTimer::Start()
+    {
+        startWallTime = EyerTime::GetTimeNano();
+        startCPUTime = EyerTime::GetThreadCPUTimeNano();
+        return 0;
+    }
+
+    int EyerAVTranscodeStageTimer::Stop()
+    {
+        wallTime += EyerTime::GetTimeNano() - startWallTime;
+        cpuTime += EyerTime::GetThreadCPUTimeNano() - startCPUTime;
+        return 0;
+    }
+
+    EyerString EyerAVTranscodeStreamProfile::ToJson() const
+    {
+        EyerString json = "{";
+        json += EyerString("\"streamId\": ") + EyerString::Number(streamId) + ", ";
+        json += EyerString("\"writeStreamId\": ") + EyerString::Number(writeStreamId) + ", ";
+        json += EyerString("\"mediaType\": \"") + mediaType + "\", ";
+        json += EyerString("\"isCopy\": ") + (isCopy ? "true" : "false") + ", ";
+        json += EyerString("\"packetIn\": ") + EyerString::Number(stageTime[STAGE_DEMUX].count) + ", ";
+        json += EyerString("\"frameDecoded\": ") + EyerString::Number(stageTime[STAGE_DECODE].count) + ", ";
+        json += EyerString("\"frameEncoded\": ") + EyerString::Number(stageTime[STAGE_SCALE].count + stageTime[STAGE_RESAMPLE].count) + ", ";
+        json += EyerString("\"packetOut\": ") + EyerString::Number(stageTime[STAGE_MUX].count) + ", ";
+        json += EyerString("\"bytesIn\": ") + EyerString::Number(bytesIn) + ", ";
+        json += EyerString("\"bytesOut\": ") + EyerString::Number(bytesOut) + ", ";
+        json += "\"stages\": {";
+        for(int i = 0; i < STAGE_NUM; i++){
+            const EyerAVTranscodeStageTime & t = stageTime[i];
+            if(i > 0){
+                json += ", ";
+            }
+            json += EyerString("\"") + EyerAVTranscodeProfile::GetStageName((EyerAVTranscodeStage)i) + "\": {";
+            json += EyerString("\"wallTime\": ") + EyerAVTranscodeProfile_Sec(t.wallTime) + ", ";
+            json += EyerString("\"cpuTime\": ") + EyerAVTranscodeProfile_Sec(t.cpuTime) + ", ";
+            json += EyerString("\"count\": ") + EyerString::Number(t.count);
+            json += "}";
+        }
+        json += "}}";
+        return json;
+    }
+
+    int EyerAVTranscodeProfile::Reset(int streamNum)
+    {
+        totalTime = 0;
+        trailerTime = 0;
+        asyncWriteTime = 0;
+        streamList.clear();
+        for(int i = 0; i < streamNum; i++){
+            EyerAVTranscodeStreamProfile streamProfile;
+            streamProfile.streamId = i;
+            streamList.push_back(streamProfile);
+        }
+        return 0;
+    }
+
+    int EyerAVTranscodeProfile::AddStage(int streamId, EyerAVTranscodeStage stage, const EyerAVTranscodeStageTimer & timer, int64_t count, int64_t bytes)
+    {
+        if(streamId < 0 || streamId >= streamList.size()){
+            return -1;
+        }
+        EyerAVTranscodeStreamProfile & streamProfile = streamList[streamId];
+        EyerAVTranscodeStageTime & t = streamProfile.stageTime[stage];
+        t.wallTime += timer.wallTime;
+        t.cpuTime += timer.cpuTime;
+        t.count += count;
+        if(stage == STAGE_DEMUX){
+            streamProfile.bytesIn += bytes;
+        }
+        if(stage == STAGE_MUX){
+            streamProfile.bytesOut += bytes;
+        }
+        return 0;
+    }
+
+    int EyerAVTranscodeProfile::Merge(const EyerAVTranscodeProfile & profile)
+    {
+        for(int i = 0; i < profile.streamList.size(); i++){
+            const EyerAVTranscodeStreamProfile & src = profile.streamList[i];
+            if(src.streamId < 0){
+                continue;
+            }
+            while(streamList.size() <= src.streamId){
+                EyerAVTranscodeStreamProfile streamProfile;
+                streamProfile.streamId = streamList.size();
+                streamList.push_back(streamProfile);
+            }
+            EyerAVTranscodeStreamProfile & dst = streamList[src.streamId];
+            // 分段转码时, 每一段只处理一路流, 以实际处理过的那一段为准
+            if(dst.mediaType == "unknow" || src.stageTime[STAGE_DEMUX].count > 0){
+                dst.mediaType = src.mediaType;
+                dst.isCopy = src.isCopy;
+            }
+            for(int j = 0; j < STAGE_NUM; j++){
+                dst.stageTime[j].wallTime += src.stageTime[j].wallTime;
+                dst.stageTime[j].cpuTime += src.stageTime[j].cpuTime;
+                dst.stageTime[j].count += src.stageTime[j].count;
+            }
+            dst.bytesIn += src.bytesIn;
+            dst.bytesOut += src.bytesOut;
+        }
+        trailerTime += profile.trailerTime;
+        asyncWriteTime += profile.asyncWriteTime;
+        return 0;
+    }
+
+    int EyerAVTranscodeProfile::FindStreamByWriteId(int writeStreamId) const
+    {
+        if(writeStreamId < 0){
+            return -1;
+        }
+        for(int i = 0; i < streamList.size(); i++){
+            if(streamList[i].writeStreamId == writeStreamId){
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    EyerAVTranscodeStageTime EyerAVTranscodeProfile::GetStageTotal(EyerAVTranscodeStage stage) const
+    {
+        EyerAVTranscodeStageTime total;
+        for(int i = 0; i < streamList.size(); i++){
+            total.wallTime += streamList[i].stageTime[stage].wallTime;
+            total.cpuTime += streamList[i].stageTime[stage].cpuTime;
+            total.count += streamList[i].stageTime[stage].count;
+        }
+        return total;
+    }
+
+    const char * EyerAVTranscodeProfile::GetStageName(EyerAVTranscodeStage stage)
+    {
+        switch(stage){
+            case STAGE_DEMUX: return "demux";
+            case STAGE_DECODE: return "decode";
+            case STAGE_SCALE: return "scale";
+            case STAGE_RESAMPLE: return "resample";
+            case STAGE_ENCODE: return "encode";
+            case STAGE_MUX: return "mux";
+            default: return "unknow";
+        }
+    }
+
+    EyerString EyerAVTranscodeProfile::ToJson() const
+    {
+        EyerString json = "{";
+        json += EyerString("\"totalTime\": ") + EyerAVTranscodeProfile_Sec(totalTime) + ", ";
+        json += EyerString("\"trailerTime\": ") + EyerAVTranscodeProfile_Sec(trailerTime) + ", ";
+        json += EyerString("\"asyncWriteTime\": ") + EyerAVTranscodeProfile_Sec(asyncWriteTime) + ", ";
+        json += "\"streams\": [";
+        for(int i = 0; i < streamList.size(); i++){
+            if(i > 0){
+                json += ", ";
+            }
+            json += streamList[i].ToJson();
+        }
+        json += "]}";
+        return json;
+    }
+}
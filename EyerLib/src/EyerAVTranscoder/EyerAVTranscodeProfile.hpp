@@ -0,0 +1,96 @@
+#ifndef EYERLIB_EYERAVTRANSCODEPROFILE_HPP
+#define EYERLIB_EYERAVTRANSCODEPROFILE_HPP
+
+#include <vector>
+#include <stdint.h>
+
+#include "EyerCore/EyerCore.hpp"
+
+namespace Eyer
+{
+    enum EyerAVTranscodeStage
+    {
+        STAGE_DEMUX = 0,
+        STAGE_DECODE,
+        STAGE_SCALE,
+        STAGE_RESAMPLE,
+        STAGE_ENCODE,
+        STAGE_MUX,
+        STAGE_NUM
+    };
+
+    // 计时器, 可以多次 Start/Stop 累加, 用于统计一个阶段的墙钟时间和当前线程的 CPU 时间
+    class EyerAVTranscodeStageTimer
+    {
+    public:
+        int Start();
+        int Stop();
+
+        // 单位纳秒
+        int64_t wallTime = 0;
+        int64_t cpuTime = 0;
+
+    private:
+        int64_t startWallTime = 0;
+        int64_t startCPUTime = 0;
+    };
+
+    class EyerAVTranscodeStageTime
+    {
+    public:
+        // 单位纳秒
+        int64_t wallTime = 0;
+        int64_t cpuTime = 0;
+        // demux: 读取的包, decode: 解出的帧, scale/resample: 送入编码器的帧, encode: 编出的包, mux: 写入的包
+        int64_t count = 0;
+    };
+
+    class EyerAVTranscodeStreamProfile
+    {
+    public:
+        // 输入文件中的流序号
+        int streamId = -1;
+        int writeStreamId = -1;
+        EyerString mediaType = "unknow";
+        bool isCopy = false;
+
+        EyerAVTranscodeStageTime stageTime[STAGE_NUM];
+
+        int64_t bytesIn = 0;
+        int64_t bytesOut = 0;
+
+        EyerString ToJson() const;
+    };
+
+    // 一次转码的分阶段耗时统计, 墙钟时间减去 CPU 时间就是该阶段等待 (IO, 队列, 锁) 的时间
+    // 流水线模式下各阶段并行执行, 各阶段墙钟时间之和会大于 totalTime
+    class EyerAVTranscodeProfile
+    {
+    public:
+        int Reset(int streamNum);
+
+        int AddStage(int streamId, EyerAVTranscodeStage stage, const EyerAVTranscodeStageTimer & timer, int64_t count, int64_t bytes = 0);
+        // 按流序号累加另一份统计, 用于汇总分段转码中各段的统计
+        int Merge(const EyerAVTranscodeProfile & profile);
+
+        int FindStreamByWriteId(int writeStreamId) const;
+
+        // 所有流某个阶段的总和
+        EyerAVTranscodeStageTime GetStageTotal(EyerAVTranscodeStage stage) const;
+
+        static const char * GetStageName(EyerAVTranscodeStage stage);
+
+        EyerString ToJson() const;
+
+        // 单位纳秒
+        int64_t totalTime = 0;
+        // 写文件尾, 不属于某一路流
+        int64_t trailerTime = 0;
+        // 异步写入时封装线程的写入耗时, 不阻塞编码, 不计入 mux 阶段
+        int64_t asyncWriteTime = 0;
+
+        std::vector<EyerAVTranscodeStreamProfile> streamList;
+    };
+}
+
+#endif //EYERLIB_EYERAVTRANSCODEPROFILE_HPP
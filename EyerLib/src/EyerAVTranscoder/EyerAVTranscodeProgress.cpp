@@ -0,0 +1,18 @@
+#include "EyerAVTranscodeProgress.hpp"
+
+namespace Eyer
+{
+    EyerString EyerAVTranscodeProgress::ToString() const
+    {
+        EyerString str = "";
+        str += EyerString("progress: ") + EyerString::Number(progress) + "\n";
+        str += EyerString("frameNum: ") + EyerString::Number(frameNum) + "\n";
+        str += EyerString("fps: ") + EyerString::Number(fps) + "\n";
+        str += EyerString("speed: ") + EyerString::Number(speed) + "\n";
+        str += EyerString("bytesWritten: ") + EyerString::Number(bytesWritten) + "\n";
+        str += EyerString("mediaTime: ") + EyerString::Number(mediaTime) + "\n";
+        str += EyerString("elapsedTime: ") + EyerString::Number(elapsedTime) + "\n";
+        str += EyerString("eta: ") + EyerString::Number(eta) + "\n";
+        return str;
+    }
+}
@@ -0,0 +1,34 @@
+#ifndef EYERLIB_EYERAVTRANSCODEPROGRESS_HPP
+#define EYERLIB_EYERAVTRANSCODEPROGRESS_HPP
+
+#include <stdint.h>
+
+#include "EyerCore/EyerCore.hpp"
+
+namespace Eyer
+{
+    class EyerAVTranscodeProgress
+    {
+    public:
+        float progress = 0.0;
+
+        // 已经送入编码器 (或者流复制写入) 的视频帧数
+        int64_t frameNum = 0;
+        // 最近一个回调间隔内的处理帧率
+        double fps = 0.0;
+        // 处理的媒体时长 / 墙钟时长, 大于 1 表示比实时快
+        double speed = 0.0;
+        // 已经写入输出文件的字节数
+        int64_t bytesWritten = 0;
+
+        // 单位秒
+        double mediaTime = 0.0;
+        double elapsedTime = 0.0;
+        // 预计剩余时间, 小于 0 表示还无法估计
+        double eta = -1.0;
+
+        EyerString ToString() const;
+    };
+}
+
+#endif //EYERLIB_EYERAVTRANSCODEPROGRESS_HPP
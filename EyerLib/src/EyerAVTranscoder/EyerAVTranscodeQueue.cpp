@@ -0,0 +1,393 @@
+#include "EyerAVTranscodeQueue.hpp"
+
+#include <thread>
+
+namespace Eyer
+{
+    EyerAVTranscodeJob::EyerAVTranscodeJob(EyerAVTranscodeQueue * _queue, int _id, const EyerString & _inputPath, const EyerString & _outputPath, const EyerAVTranscoderParams & _params)
+    {
+        queue = _queue;
+        id = _id;
+        inputPath = _inputPath;
+        outputPath = _outputPath;
+        params = _params;
+    }
+
+    EyerAVTranscodeJob::~EyerAVTranscodeJob()
+    {
+
+    }
+
+    void EyerAVTranscodeJob::Run()
+    {
+        EyerAVTranscoder transcoder(inputPath);
+        transcoder.SetOutputPath(outputPath);
+        transcoder.SetParams(params);
+        transcoder.SetListener(this);
+        transcoder.Transcode(this);
+
+        bool isSucc = transcoder.GetStatus() == EyerAVTranscoderStatus::SUCC;
+        queue->OnJobFinish(this, isSucc, lastError, transcoder.GetErrorDesc());
+    }
+
+    int EyerAVTranscodeJob::OnProgress(float _progress)
+    {
+        return queue->OnJobProgress(this, _progress);
+    }
+
+    int EyerAVTranscodeJob::OnFail(EyerAVTranscoderError & error)
+    {
+        lastError = error;
+        return 0;
+    }
+
+    int EyerAVTranscodeJob::OnSuccess()
+    {
+        return 0;
+    }
+
+    bool EyerAVTranscodeJob::interrupt()
+    {
+        return cancelFlag || stopFlag;
+    }
+
+    int EyerAVTranscodeJob::Cancel()
+    {
+        cancelFlag = true;
+        return 0;
+    }
+
+    EyerAVTranscodeQueue::EyerAVTranscodeQueue(int _maxJobNum, int _threadBudget)
+    {
+        SetMaxJobNum(_maxJobNum);
+        SetThreadBudget(_threadBudget);
+    }
+
+    EyerAVTranscodeQueue::~EyerAVTranscodeQueue()
+    {
+        Stop();
+        for(int i = 0; i < jobList.size(); i++){
+            delete jobList[i];
+        }
+        jobList.clear();
+    }
+
+    int EyerAVTranscodeQueue::SetMaxJobNum(int _maxJobNum)
+    {
+        if(_maxJobNum <= 0){
+            return -1;
+        }
+        std::lock_guard<std::mutex> lg(mut);
+        maxJobNum = _maxJobNum;
+        if(isStarted){
+            Schedule();
+        }
+        return 0;
+    }
+
+    int EyerAVTranscodeQueue::GetMaxJobNum()
+    {
+        std::lock_guard<std::mutex> lg(mut);
+        return maxJobNum;
+    }
+
+    int EyerAVTranscodeQueue::SetThreadBudget(int _threadBudget)
+    {
+        std::lock_guard<std::mutex> lg(mut);
+        threadBudget = _threadBudget;
+        if(threadBudget <= 0){
+            threadBudget = std::thread::hardware_concurrency();
+        }
+        if(threadBudget <= 0){
+            threadBudget = 4;
+        }
+        return 0;
+    }
+
+    int EyerAVTranscodeQueue::GetThreadBudget()
+    {
+        std::lock_guard<std::mutex> lg(mut);
+        return threadBudget;
+    }
+
+    int EyerAVTranscodeQueue::SetListener(EyerAVTranscodeQueueListener * _listener)
+    {
+        std::lock_guard<std::mutex> lg(mut);
+        listener = _listener;
+        return 0;
+    }
+
+    int EyerAVTranscodeQueue::AddJob(const EyerString & inputPath, const EyerString & outputPath, const EyerAVTranscoderParams & params)
+    {
+        std::lock_guard<std::mutex> lg(mut);
+        int jobId = nextJobId;
+        nextJobId++;
+
+        EyerAVTranscodeJob * job = new EyerAVTranscodeJob(this, jobId, inputPath, outputPath, params);
+        jobList.push_back(job);
+
+        if(isStarted){
+            Schedule();
+        }
+        return jobId;
+    }
+
+    int EyerAVTranscodeQueue::CancelJob(int jobId)
+    {
+        std::lock_guard<std::mutex> lg(mut);
+        EyerAVTranscodeJob * job = FindJob(jobId);
+        if(job == nullptr){
+            return -1;
+        }
+        if(job->status == EyerAVTranscoderStatus::PREPARE){
+            job->status = EyerAVTranscoderStatus::FAIL;
+            job->errorDesc = "被取消";
+            finishCV.notify_all();
+            return 0;
+        }
+        if(job->status == EyerAVTranscoderStatus::ING){
+            job->Cancel();
+            return 0;
+        }
+        return -1;
+    }
+
+    int EyerAVTranscodeQueue::Start()
+    {
+        std::lock_guard<std::mutex> lg(mut);
+        isStarted = true;
+        Schedule();
+        return 0;
+    }
+
+    int EyerAVTranscodeQueue::Wait()
+    {
+        std::vector<EyerAVTranscodeJob *> joinList;
+        {
+            std::unique_lock<std::mutex> lock(mut);
+            finishCV.wait(lock, [this]{
+                if(runningJobNum > 0){
+                    return false;
+                }
+                if(!isStarted){
+                    return true;
+                }
+                for(int i = 0; i < jobList.size(); i++){
+                    if(jobList[i]->status == EyerAVTranscoderStatus::PREPARE){
+                        return false;
+                    }
+                }
+                return true;
+            });
+
+            for(int i = 0; i < jobList.size(); i++){
+                EyerAVTranscodeJob * job = jobList[i];
+                if(job->isStarted && !job->isJoined){
+                    job->isJoined = true;
+                    joinList.push_back(job);
+                }
+            }
+        }
+
+        // 任务已经结束, 这里只回收线程
+        for(int i = 0; i < joinList.size(); i++){
+            joinList[i]->Stop();
+        }
+        return 0;
+    }
+
+    int EyerAVTranscodeQueue::Stop()
+    {
+        {
+            std::lock_guard<std::mutex> lg(mut);
+            for(int i = 0; i < jobList.size(); i++){
+                EyerAVTranscodeJob * job = jobList[i];
+                if(job->status == EyerAVTranscoderStatus::PREPARE){
+                    job->status = EyerAVTranscoderStatus::FAIL;
+                    job->errorDesc = "被取消";
+                }
+                else if(job->status == EyerAVTranscoderStatus::ING){
+                    job->Cancel();
+                }
+            }
+        }
+        return Wait();
+    }
+
+    int EyerAVTranscodeQueue::GetJobCount()
+    {
+        std::lock_guard<std::mutex> lg(mut);
+        return jobList.size();
+    }
+
+    EyerAVTranscoderStatus EyerAVTranscodeQueue::GetJobStatus(int jobId)
+    {
+        std::lock_guard<std::mutex> lg(mut);
+        EyerAVTranscodeJob * job = FindJob(jobId);
+        if(job == nullptr){
+            return EyerAVTranscoderStatus::FAIL;
+        }
+        return job->status;
+    }
+
+    float EyerAVTranscodeQueue::GetJobProgress(int jobId)
+    {
+        std::lock_guard<std::mutex> lg(mut);
+        EyerAVTranscodeJob * job = FindJob(jobId);
+        if(job == nullptr){
+            return 0.0;
+        }
+        return job->progress;
+    }
+
+    EyerString EyerAVTranscodeQueue::GetJobErrorDesc(int jobId)
+    {
+        std::lock_guard<std::mutex> lg(mut);
+        EyerAVTranscodeJob * job = FindJob(jobId);
+        if(job == nullptr){
+            return "";
+        }
+        return job->errorDesc;
+    }
+
+    float EyerAVTranscodeQueue::GetProgress()
+    {
+        std::lock_guard<std::mutex> lg(mut);
+        return CalcProgress();
+    }
+
+    int EyerAVTranscodeQueue::SplitThreadBudget(EyerAVTranscoderParams & params, int threadBudget, int jobNum)
+    {
+        if(threadBudget <= 0){
+            threadBudget = std::thread::hardware_concurrency();
+        }
+        if(threadBudget <= 0){
+            threadBudget = 4;
+        }
+        if(jobNum <= 0){
+            jobNum = 1;
+        }
+
+        int jobThreadNum = threadBudget / jobNum;
+        if(jobThreadNum < 2){
+            jobThreadNum = 2;
+        }
+
+        // 编码比解码慢得多, 解码分 1/4
+        int decodeThreadNum = jobThreadNum / 4;
+        if(decodeThreadNum < 1){
+            decodeThreadNum = 1;
+        }
+        int encodeThreadNum = jobThreadNum - decodeThreadNum;
+
+        params.SetDecodeThreadNum(decodeThreadNum);
+        params.SetEncodeThreadNum(encodeThreadNum);
+        return 0;
+    }
+
+    int EyerAVTranscodeQueue::OnJobProgress(EyerAVTranscodeJob * job, float progress)
+    {
+        EyerAVTranscodeQueueListener * tempListener = nullptr;
+        float totalProgress = 0.0;
+        {
+            std::lock_guard<std::mutex> lg(mut);
+            job->progress = progress;
+            totalProgress = CalcProgress();
+            tempListener = listener;
+        }
+
+        // 回调不持锁, 允许在回调中查询队列
+        if(tempListener != nullptr){
+            tempListener->OnJobProgress(job->id, progress);
+            tempListener->OnProgress(totalProgress);
+        }
+        return 0;
+    }
+
+    int EyerAVTranscodeQueue::OnJobFinish(EyerAVTranscodeJob * job, bool isSucc, EyerAVTranscoderError & error, const EyerString & errorDesc)
+    {
+        EyerAVTranscodeQueueListener * tempListener = nullptr;
+        float totalProgress = 0.0;
+        {
+            std::lock_guard<std::mutex> lg(mut);
+            job->errorDesc = errorDesc;
+            if(isSucc){
+                job->status = EyerAVTranscoderStatus::SUCC;
+                job->progress = 1.0;
+            }
+            else{
+                job->status = EyerAVTranscoderStatus::FAIL;
+            }
+            totalProgress = CalcProgress();
+            tempListener = listener;
+        }
+
+        if(tempListener != nullptr){
+            if(isSucc){
+                tempListener->OnJobSuccess(job->id);
+            }
+            else{
+                tempListener->OnJobFail(job->id, error);
+            }
+            tempListener->OnProgress(totalProgress);
+        }
+
+        {
+            std::lock_guard<std::mutex> lg(mut);
+            runningJobNum--;
+            Schedule();
+            finishCV.notify_all();
+        }
+        return 0;
+    }
+
+    int EyerAVTranscodeQueue::Schedule()
+    {
+        for(int i = 0; i < jobList.size(); i++){
+            if(runningJobNum >= maxJobNum){
+                break;
+            }
+            EyerAVTranscodeJob * job = jobList[i];
+            if(job->status != EyerAVTranscoderStatus::PREPARE){
+                continue;
+            }
+
+            SplitThreadBudget(job->params, threadBudget, maxJobNum);
+            EyerLog("TranscodeQueue start job %d, decodeThreadNum: %d, encodeThreadNum: %d\n", job->id, job->params.GetDecodeThreadNum(), job->params.GetEncodeThreadNum());
+
+            job->status = EyerAVTranscoderStatus::ING;
+            job->isStarted = true;
+            runningJobNum++;
+            job->Start();
+        }
+        return 0;
+    }
+
+    float EyerAVTranscodeQueue::CalcProgress()
+    {
+        if(jobList.size() <= 0){
+            return 0.0;
+        }
+        float totalProgress = 0.0;
+        for(int i = 0; i < jobList.size(); i++){
+            EyerAVTranscodeJob * job = jobList[i];
+            if(job->status == EyerAVTranscoderStatus::SUCC || job->status == EyerAVTranscoderStatus::FAIL){
+                totalProgress += 1.0;
+            }
+            else{
+                totalProgress += job->progress;
+            }
+        }
+        return totalProgress / jobList.size();
+    }
+
+    EyerAVTranscodeJob * EyerAVTranscodeQueue::FindJob(int jobId)
+    {
+        for(int i = 0; i < jobList.size(); i++){
+            if(jobList[i]->id == jobId){
+                return jobList[i];
+            }
+        }
+        return nullptr;
+    }
+}
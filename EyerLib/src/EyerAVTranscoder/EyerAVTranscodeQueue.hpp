@@ -0,0 +1,122 @@
+#ifndef EYERLIB_EYERAVTRANSCODEQUEUE_HPP
+#define EYERLIB_EYERAVTRANSCODEQUEUE_HPP
+
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+
+#include "EyerCore/EyerCore.hpp"
+#include "EyerThread/EyerThreadHeader.hpp"
+#include "EyerAVTranscoder.hpp"
+
+namespace Eyer
+{
+    class EyerAVTranscodeQueue;
+
+    // 回调在转码线程中调用
+    class EyerAVTranscodeQueueListener
+    {
+    public:
+        virtual int OnJobProgress(int jobId, float progress) = 0;
+        virtual int OnJobFail(int jobId, EyerAVTranscoderError & error) = 0;
+        virtual int OnJobSuccess(int jobId) = 0;
+        // 所有任务的总进度
+        virtual int OnProgress(float progress) = 0;
+    };
+
+    class EyerAVTranscodeJob : public EyerThread, public EyerAVTranscoderListener, public EyerAVTranscoderInterrupt
+    {
+    public:
+        EyerAVTranscodeJob(EyerAVTranscodeQueue * queue, int id, const EyerString & inputPath, const EyerString & outputPath, const EyerAVTranscoderParams & params);
+        ~EyerAVTranscodeJob();
+
+        virtual void Run() override;
+
+        virtual int OnProgress(float progress) override;
+        virtual int OnFail(EyerAVTranscoderError & error) override;
+        virtual int OnSuccess() override;
+
+        virtual bool interrupt() override;
+
+        int Cancel();
+
+        // 以下状态由 EyerAVTranscodeQueue 持锁读写
+        int id = 0;
+        EyerString inputPath;
+        EyerString outputPath;
+        EyerAVTranscoderParams params;
+
+        EyerAVTranscoderStatus status = EyerAVTranscoderStatus::PREPARE;
+        EyerString errorDesc = "";
+        float progress = 0.0;
+        bool isStarted = false;
+        bool isJoined = false;
+
+    private:
+        EyerAVTranscodeQueue * queue = nullptr;
+        std::atomic_bool cancelFlag {false};
+        EyerAVTranscoderError lastError = EyerAVTranscoderError::INTERRUPT_FAIL;
+    };
+
+    // 多任务转码队列: 同时最多运行 maxJobNum 个任务, 总线程预算平分给每个任务的解码和编码线程
+    // 几个小分辨率任务并行, 比单个任务开很多编码线程更能占满 CPU
+    class EyerAVTranscodeQueue
+    {
+    public:
+        // threadBudget <= 0 时使用 CPU 核数
+        EyerAVTranscodeQueue(int maxJobNum = 2, int threadBudget = 0);
+        ~EyerAVTranscodeQueue();
+
+        int SetMaxJobNum(int maxJobNum);
+        int GetMaxJobNum();
+
+        int SetThreadBudget(int threadBudget);
+        int GetThreadBudget();
+
+        int SetListener(EyerAVTranscodeQueueListener * listener);
+
+        // 返回任务 id, 可以在 Start 之后继续添加
+        int AddJob(const EyerString & inputPath, const EyerString & outputPath, const EyerAVTranscoderParams & params);
+        int CancelJob(int jobId);
+
+        int Start();
+        // 阻塞直到所有任务结束
+        int Wait();
+        // 取消所有任务并等待结束
+        int Stop();
+
+        int GetJobCount();
+        EyerAVTranscoderStatus GetJobStatus(int jobId);
+        float GetJobProgress(int jobId);
+        EyerString GetJobErrorDesc(int jobId);
+        float GetProgress();
+
+        // 把线程预算按并发任务数分给 params 的解码/编码线程, 编码占大头
+        static int SplitThreadBudget(EyerAVTranscoderParams & params, int threadBudget, int jobNum);
+
+        int OnJobProgress(EyerAVTranscodeJob * job, float progress);
+        int OnJobFinish(EyerAVTranscodeJob * job, bool isSucc, EyerAVTranscoderError & error, const EyerString & errorDesc);
+
+    private:
+        // 需持有 mut
+        int Schedule();
+        float CalcProgress();
+        EyerAVTranscodeJob * FindJob(int jobId);
+
+        std::mutex mut;
+        std::condition_variable finishCV;
+
+        std::vector<EyerAVTranscodeJob *> jobList;
+        int nextJobId = 0;
+        int runningJobNum = 0;
+        bool isStarted = false;
+
+        int maxJobNum = 2;
+        int threadBudget = 0;
+
+        EyerAVTranscodeQueueListener * listener = nullptr;
+    };
+}
+
+#endif //EYERLIB_EYERAVTRANSCODEQUEUE_HPP
@@ -13,11 +13,18 @@ namespace Eyer
         EyerAVDecoder * decoder = nullptr;
         EyerAVEncoder * encoder = nullptr;
         EyerAVResample * resample = nullptr;
+        EyerAVScaler scaler;
         int readStreamId = -1;
         int writeStreamId = -1;
         int64_t audioPts = 0;
         int encoderVideoFrameIndex = 0;
         int isRangeEnd = 0;
+
+        // 流复制: 不解码不编码, 直接把数据包写入输出文件
+        int isCopy = 0;
+        int isCopyStarted = 0;
+        EyerAVMediaType mediaType;
+        EyerAVRational readTimebase;
     };
 }
 
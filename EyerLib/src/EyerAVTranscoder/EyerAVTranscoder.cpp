@@ -4,6 +4,10 @@
 
 #include "EyerAVTranscodeStream.hpp"
 #include "EyerAVTranscoderSupport.hpp"
+#include "EyerAVTranscoderPipeline.hpp"
+#include "EyerAVTranscoderSegment.hpp"
+#include "EyerAVTranscoderSmartCut.hpp"
+#include "EyerAVTranscoderLadder.hpp"
 
 namespace Eyer
 {
@@ -30,6 +34,25 @@ namespace Eyer
         return 0;
     }
 
+    int EyerAVTranscoder::AddRendition(const EyerString & outputPath, const EyerAVTranscoderParams & renditionParams)
+    {
+        renditionPathList.push_back(outputPath);
+        renditionParamsList.push_back(renditionParams);
+        return 0;
+    }
+
+    int EyerAVTranscoder::ClearRendition()
+    {
+        renditionPathList.clear();
+        renditionParamsList.clear();
+        return 0;
+    }
+
+    int EyerAVTranscoder::GetRenditionNum()
+    {
+        return renditionPathList.size();
+    }
+
     int EyerAVTranscoder::Transcode_(EyerAVTranscoderInterrupt * interrupt)
     {
         Eyer::EyerAVReader reader(inputPath);
@@ -47,11 +70,147 @@ namespace Eyer
         return 0;
     }
 
-    int EyerAVTranscoder::Transcode(EyerAVTranscoderInterrupt * interrupt, EyerAVReaderCustomIO * customIO)
+    int EyerAVTranscoder::Transcode(EyerAVTranscoderInterrupt * interrupt, EyerAVReaderCustomIO * customIO, EyerAVWriterCustomIO * outputCustomIO)
+    {
+        {
+            std::lock_guard<std::mutex> lg(profileMut);
+            profile.Reset(0);
+            profileStartTime = Eyer::EyerTime::GetTimeNano();
+            isProfileRunning = true;
+        }
+
+        int ret = TranscodeInternal(interrupt, customIO, outputCustomIO);
+
+        {
+            std::lock_guard<std::mutex> lg(profileMut);
+            profile.totalTime = Eyer::EyerTime::GetTimeNano() - profileStartTime;
+            isProfileRunning = false;
+        }
+        return ret;
+    }
+
+    int EyerAVTranscoder::TranscodeInternal(EyerAVTranscoderInterrupt * interrupt, EyerAVReaderCustomIO * customIO, EyerAVWriterCustomIO * outputCustomIO)
     {
         long long startTime = Eyer::EyerTime::GetTimeNano();
 
+        progressStartTime = Eyer::EyerTime::GetTime();
+        lastProgressTime = progressStartTime;
+        lastProgressFrameNum = 0;
+
         status = EyerAVTranscoderStatus::ING;
+        isWriteFail = false;
+
+        // 多码率输出, 每一路写到自己的文件
+        if(renditionPathList.size() > 0){
+            if(outputCustomIO != nullptr){
+                EyerLog("Ladder not support output custom io\n");
+                status = EyerAVTranscoderStatus::FAIL;
+                errorDesc = "多码率输出不支持自定义 IO 输出";
+                if(listener != nullptr){
+                    listener->OnFail(EyerAVTranscoderError::OPEN_OUTPUT_FAIL);
+                }
+                return -1;
+            }
+
+            EyerAVTranscoderLadder ladder(this, interrupt, customIO);
+            int ladderRet = ladder.Run();
+            if(ladderRet){
+                EyerLog("Ladder transcode fail\n");
+                status = EyerAVTranscoderStatus::FAIL;
+                if(listener != nullptr){
+                    listener->OnFail(EyerAVTranscoderError::LADDER_FAIL);
+                }
+                return -1;
+            }
+
+            if(ladder.IsInterrupt()){
+                status = EyerAVTranscoderStatus::FAIL;
+                if(listener != nullptr){
+                    errorDesc = "被取消";
+                    listener->OnFail(EyerAVTranscoderError::INTERRUPT_FAIL);
+                }
+            }
+            else{
+                status = EyerAVTranscoderStatus::SUCC;
+                if(listener != nullptr){
+                    listener->OnSuccess();
+                }
+            }
+
+            long long totleTime = Eyer::EyerTime::GetTimeNano() - startTime;
+            EyerLog("Ladder Transcode Totle time: %f s, rendition num: %d\n", totleTime * 1.0 / 1000000000, (int)renditionPathList.size());
+            return 0;
+        }
+
+        // 智能裁剪, 自定义 IO 不能多次打开输入, 也没有地方写临时文件, 不支持智能裁剪
+        if(params.GetSmartCut() && !params.GetAudioExtract() && customIO == nullptr && outputCustomIO == nullptr){
+            EyerAVTranscoderSmartCut smartCut(this, interrupt);
+            int smartCutRet = smartCut.Run();
+            if(smartCutRet < 0){
+                EyerLog("Smart cut fail\n");
+                status = EyerAVTranscoderStatus::FAIL;
+                if(listener != nullptr){
+                    listener->OnFail(isWriteFail ? EyerAVTranscoderError::WRITE_FAIL : EyerAVTranscoderError::SMART_CUT_FAIL);
+                }
+                return -1;
+            }
+            if(smartCutRet == 0){
+                if(smartCut.IsInterrupt()){
+                    status = EyerAVTranscoderStatus::FAIL;
+                    if(listener != nullptr){
+                        errorDesc = "被取消";
+                        listener->OnFail(EyerAVTranscoderError::INTERRUPT_FAIL);
+                    }
+                }
+                else{
+                    status = EyerAVTranscoderStatus::SUCC;
+                    if(listener != nullptr){
+                        listener->OnSuccess();
+                    }
+                }
+
+                long long totleTime = Eyer::EyerTime::GetTimeNano() - startTime;
+                EyerLog("Smart Cut Totle time: %f s\n", totleTime * 1.0 / 1000000000);
+                return 0;
+            }
+            EyerLog("Smart cut not supported, use normal transcode\n");
+        }
+
+        // 分段并行转码, 断点续转也按分段写临时文件, 自定义 IO 不能多次打开输入, 也没有地方写临时文件, 不支持分段
+        // 提取音频受 IO 限制, 分段并行没有收益, 不分段
+        if((params.GetSegmentNum() > 1 || params.GetResumable()) && !params.GetAudioExtract() && customIO == nullptr && outputCustomIO == nullptr){
+            EyerAVTranscoderSegment segment(this, interrupt);
+            int segmentRet = segment.Run();
+            if(segmentRet < 0){
+                EyerLog("Segment transcode fail\n");
+                status = EyerAVTranscoderStatus::FAIL;
+                if(listener != nullptr){
+                    listener->OnFail(isWriteFail ? EyerAVTranscoderError::WRITE_FAIL : EyerAVTranscoderError::SEGMENT_FAIL);
+                }
+                return -1;
+            }
+            if(segmentRet == 0){
+                if(segment.IsInterrupt()){
+                    status = EyerAVTranscoderStatus::FAIL;
+                    if(listener != nullptr){
+                        errorDesc = "被取消";
+                        listener->OnFail(EyerAVTranscoderError::INTERRUPT_FAIL);
+                    }
+                }
+                else{
+                    status = EyerAVTranscoderStatus::SUCC;
+                    if(listener != nullptr){
+                        listener->OnSuccess();
+                    }
+                }
+
+                long long totleTime = Eyer::EyerTime::GetTimeNano() - startTime;
+                EyerLog("Segment Transcode Totle time: %f s\n", totleTime * 1.0 / 1000000000);
+                return 0;
+            }
+            EyerLog("Segment transcode not supported, use normal transcode\n");
+        }
+
         Eyer::EyerAVReader reader(inputPath, customIO);
         int ret = reader.Open();
         if(ret){
@@ -66,7 +225,22 @@ namespace Eyer
 
         duration = reader.GetDuration();
 
-        Eyer::EyerAVWriter write(outputPath);
+        Eyer::EyerAVWriter write(outputPath, outputCustomIO);
+        {
+            double rangeEnd = duration;
+            if(params.GetEndTime() != 0.0 && params.GetEndTime() < duration){
+                rangeEnd = params.GetEndTime();
+            }
+            ret = InitWriter(&write, EstimateOutputSize(rangeEnd - params.GetStartTime()));
+            if(ret){
+                EyerLog("Init Output file fail\n");
+                status = EyerAVTranscoderStatus::FAIL;
+                if(listener != nullptr){
+                    listener->OnFail(EyerAVTranscoderError::OPEN_OUTPUT_FAIL);
+                }
+                return -1;
+            }
+        }
         ret = write.Open();
         if(ret){
             EyerLog("Open Output file fail\n");
@@ -81,13 +255,18 @@ namespace Eyer
         // Init Decoder and Encoder
         int streamCount = reader.GetStreamCount();
         std::vector<EyerAVTranscodeStream *> transcodeStream;
+        {
+            std::lock_guard<std::mutex> lg(profileMut);
+            profile.Reset(streamCount);
+        }
 
         for(int i=0;i<streamCount;i++){
             EyerAVStream stream = reader.GetStream(i);
 
             //转码视频还是音频
             if((stream.GetType() == EyerAVMediaType::MEDIA_TYPE_AUDIO && !params.GetCareAudio()) ||
-               (stream.GetType() == EyerAVMediaType::MEDIA_TYPE_VIDEO && !params.GetCareVideo())){
+               (stream.GetType() == EyerAVMediaType::MEDIA_TYPE_VIDEO && !params.GetCareVideo()) ||
+               (stream.GetType() != EyerAVMediaType::MEDIA_TYPE_AUDIO && params.GetAudioExtract())){
                 EyerAVTranscodeStream * ts = new EyerAVTranscodeStream();
                 transcodeStream.push_back(ts);
                 continue;
@@ -98,6 +277,20 @@ namespace Eyer
             transcodeStream.push_back(ts);
             ts->readStreamId = stream.GetStreamId();
 
+            // 流复制
+            if(IsStreamCopy(stream, &write)){
+                ts->writeStreamId = write.AddStream(stream);
+                if(ts->writeStreamId < 0){
+                    EyerLog("Add copy stream error, stream id: %d\n", stream.GetStreamId());
+                    continue;
+                }
+                ts->isCopy = 1;
+                ts->mediaType = stream.GetType();
+                ts->readTimebase = stream.GetTimebase();
+                EyerLog("Copy stream, stream id: %d, outputStreamId: %d\n", stream.GetStreamId(), ts->writeStreamId);
+                continue;
+            }
+
             // 初始化解码器
             EyerAVDecoder * decoder = new EyerAVDecoder();
             ret = decoder->Init(stream, params.GetDecodeThreadNum());
@@ -110,6 +303,7 @@ namespace Eyer
                 continue;
             }
             ts->decoder = decoder;
+            ts->scaler.SetQuality(params.GetScaleQuality());
 
             // 初始化编码器
             EyerAVEncoder * encoder = new EyerAVEncoder();
@@ -118,6 +312,11 @@ namespace Eyer
                 EyerLog("Init encoder error, stream id: %d\n", stream.GetStreamId());
                 delete encoder;
                 ts->encoder = nullptr;
+                // 还没有写文件头, 只关闭不写文件尾
+                FreeTranscodeStream(transcodeStream);
+                write.Close();
+                reader.Close();
+                status = EyerAVTranscoderStatus::FAIL;
                 if(listener != nullptr){
                     listener->OnFail(EyerAVTranscoderError::INIT_ENCODER_FAIL);
                 }
@@ -128,34 +327,43 @@ namespace Eyer
             ts->writeStreamId = write.AddStream(*encoder);
             EyerLog("outputStreamId: %d\n", ts->writeStreamId);
 
-            if(stream.GetType() == EyerAVMediaType::MEDIA_TYPE_AUDIO){
-                EyerAVResample * resample = new EyerAVResample();
-
-                EyerAVChannelLayout inputChannelLayout = stream.GetChannelLayout();
-                if(inputChannelLayout == EyerAVChannelLayout::UNKNOW){
-                    inputChannelLayout = EyerAVChannelLayout::GetDefaultChannelLayout(stream.GetChannels());
+            ret = InitResample(ts, stream);
+            if(ret){
+                EyerLog("Init resample error, stream id: %d\n", stream.GetStreamId());
+                FreeTranscodeStream(transcodeStream);
+                write.Close();
+                reader.Close();
+                status = EyerAVTranscoderStatus::FAIL;
+                if(listener != nullptr){
+                    listener->OnFail(EyerAVTranscoderError::INIT_ENCODER_FAIL);
                 }
+                return -1;
+            }
+        }
 
-                EyerLog("ChannelLayout: %s\n", inputChannelLayout.GetName().c_str());
-
-                resample->Init(
-                        encoder->GetChannelLayout(),
-                        encoder->GetSampleFormat(),
-                        encoder->GetSampleRate(),
-
-                        inputChannelLayout,
-                        stream.GetSampleFormat(),
-                        stream.GetSampleRate()
-                );
-                ts->resample = resample;
+        // 不处理的流在解封装时丢弃, 不再读取和解析它的数据包
+        for(int i = 0; i < transcodeStream.size(); i++){
+            EyerAVTranscodeStream * ts = transcodeStream[i];
+            if(ts->encoder == nullptr && !ts->isCopy){
+                reader.SetStreamDiscard(i, true);
             }
-            else {
-                ts->resample = nullptr;
+        }
+
+        {
+            std::lock_guard<std::mutex> lg(profileMut);
+            for(int i = 0; i < transcodeStream.size(); i++){
+                EyerAVTranscodeStream * ts = transcodeStream[i];
+                profile.streamList[i].mediaType = reader.GetStream(i).GetType().GetName();
+                profile.streamList[i].writeStreamId = ts->writeStreamId;
+                profile.streamList[i].isCopy = ts->isCopy;
             }
         }
 
         ret = write.WriteHand();
         if(ret){
+            FreeTranscodeStream(transcodeStream);
+            write.Close();
+            reader.Close();
             status = EyerAVTranscoderStatus::FAIL;
             errorDesc = "写入视频头失败";
             if(listener != nullptr){
@@ -170,158 +378,199 @@ namespace Eyer
         }
         bool isInterrupt = false;
         bool isRangeEnd = false;
+        bool isFail = false;
         double time = 0;
-        while(1){
-            EyerAVPacket packet;
-
-
-            long long startTime = Eyer::EyerTime::GetTimeNano();
-            int ret = reader.Read(packet);
-            long long endTime = Eyer::EyerTime::GetTimeNano();
-            ioReadTime += (endTime - startTime);
-
-            if(ret){
-                break;
+        if(params.GetPipeline()){
+            EyerAVTranscoderPipeline pipeline(this, &reader, &write, transcodeStream, interrupt);
+            if(pipeline.Run()){
+                EyerLog("Pipeline transcode fail\n");
+                isFail = true;
             }
-
-            int streamIndex = packet.GetStreamIndex();
-
-            EyerAVTranscodeStream * ts = transcodeStream[streamIndex];
-            EyerAVDecoder * decoder = ts->decoder;
-            if(decoder == nullptr){
-                continue;
-            }
-
-            EyerAVEncoder * encoder = ts->encoder;
-            if(encoder == nullptr){
-                continue;
-            }
-
-            decoder->SendPacket(packet);
+            isInterrupt = pipeline.IsInterrupt();
+        }
+        else {
+            // 解码帧和数据包在循环外只创建一次, RecvFrame 和 Read 会先释放上一次的数据
+            EyerAVFrame frame;
+            EyerAVPacket packet;
             while(1){
-                EyerAVFrame frame;
-                ret = decoder->RecvFrame(frame);
+                EyerAVTranscodeStageTimer demuxTimer;
+                demuxTimer.Start();
+                int ret = reader.Read(packet);
+                demuxTimer.Stop();
+
                 if(ret){
                     break;
                 }
-                //  EyerLog("Frame PTS: %f, Stream ID: %d\n", frame.GetSecPTS(), streamIndex);
 
-                //range处理
-                if((params.GetStartTime() != 0.0) && (frame.GetSecPTS() < params.GetStartTime())){
-                    continue;
-                }
-                if((params.GetEndTime() != 0.0) && (frame.GetSecPTS() > params.GetEndTime())){
-                    int packetStreamId = packet.GetStreamIndex();
-                    int usefulTsNum = 0;
-                    int rangeEndNum = 0;
-                    for(int i=0; i<transcodeStream.size(); i++){
-                        EyerAVTranscodeStream * ts = transcodeStream[i];
-                        if(ts->encoder != nullptr){
-                            usefulTsNum++;
-
-                            if(ts->isRangeEnd == 1){
-                                rangeEndNum++;
-                            }
-                            if(ts->isRangeEnd == 0 && ts->readStreamId == packetStreamId ){
-                                ts->isRangeEnd = 1;
-                                rangeEndNum++;
-                            }
+                int streamIndex = packet.GetStreamIndex();
+                AddProfile(streamIndex, STAGE_DEMUX, demuxTimer, 1, packet.GetSize());
+
+                EyerAVTranscodeStream * ts = transcodeStream[streamIndex];
+                if(ts->isCopy){
+                    ret = PrepareCopyPacket(&write, ts, packet);
+                    if(ret == 0){
+                        if(WritePacket(&write, streamIndex, packet)){
+                            break;
+                        }
+
+                        UpdateProgress(packet.GetSecPTS());
+                    }
+                    else if(ret > 0){
+                        if(MarkRangeEnd(transcodeStream, ts)){
+                            break;
                         }
                     }
 
-                    if(usefulTsNum == rangeEndNum){
-                        isRangeEnd = true;
-                        break;
+                    if(interrupt != nullptr){
+                        if(interrupt->interrupt()){
+                            isInterrupt = true;
+                            break;
+                        }
                     }
                     continue;
                 }
-                time = frame.GetSecPTS();
-                // EyerLog("Frame PTS: %f, Stream ID: %d\n", frame.GetSecPTS(), streamIndex);
-                EncodeFrame(&write, ts, frame);
-            }
 
-            if(isRangeEnd){
-                break;
-            }
-
-            if(interrupt != nullptr){
-                if(interrupt->interrupt()){
-                    isInterrupt = true;
-                    break;
+                EyerAVDecoder * decoder = ts->decoder;
+                if(decoder == nullptr){
+                    continue;
                 }
-            }
 
-            // EyerLog("time: %f\n", time);
-        }
+                EyerAVEncoder * encoder = ts->encoder;
+                if(encoder == nullptr){
+                    continue;
+                }
 
-        // Clear Decoder
-        for(int i = 0; i < transcodeStream.size(); i++){
-            EyerAVTranscodeStream * ts = transcodeStream[i];
-            EyerAVDecoder *decoder = ts->decoder;
-            if (decoder != nullptr) {
-                decoder->SendPacketNull();
+                EyerAVTranscodeStageTimer decodeTimer;
+                int decodeFrameNum = 0;
+                decodeTimer.Start();
+                decoder->SendPacket(packet);
+                decodeTimer.Stop();
                 while(1){
-                    EyerAVFrame frame;
+                    decodeTimer.Start();
                     ret = decoder->RecvFrame(frame);
+                    decodeTimer.Stop();
                     if(ret){
                         break;
                     }
+                    decodeFrameNum++;
+                    //  EyerLog("Frame PTS: %f, Stream ID: %d\n", frame.GetSecPTS(), streamIndex);
+
+                    //range处理
+                    if((params.GetStartTime() != 0.0) && (frame.GetSecPTS() < params.GetStartTime())){
+                        continue;
+                    }
                     if((params.GetEndTime() != 0.0) && (frame.GetSecPTS() > params.GetEndTime())){
-                        break;
+                        if(MarkRangeEnd(transcodeStream, ts)){
+                            isRangeEnd = true;
+                            break;
+                        }
+                        continue;
                     }
-                    //  EyerLog("Flush Frame PTS: %f , Stream ID: %d\n", frame.GetSecPTS(), ts->readStreamId);
+                    time = frame.GetSecPTS();
+                    // EyerLog("Frame PTS: %f, Stream ID: %d\n", frame.GetSecPTS(), streamIndex);
                     EncodeFrame(&write, ts, frame);
+                    if(isWriteFail){
+                        break;
+                    }
+                }
+                AddProfile(streamIndex, STAGE_DECODE, decodeTimer, decodeFrameNum);
+
+                if(isRangeEnd || isWriteFail){
+                    break;
                 }
-            }
-        }
 
-        if(!isInterrupt) {
-            // Clear Encode
-            for(int i = 0; i < transcodeStream.size(); i++) {
-                EyerAVTranscodeStream *ts = transcodeStream[i];
-                ClearFrame(&write, ts);
+                if(interrupt != nullptr){
+                    if(interrupt->interrupt()){
+                        isInterrupt = true;
+                        break;
+                    }
+                }
+
+                // EyerLog("time: %f\n", time);
             }
-        }
 
-        // Free Decoder and Encoder
-        for(int i = 0; i < transcodeStream.size(); i++){
-            EyerAVTranscodeStream * ts = transcodeStream[i];
-            EyerAVDecoder * decoder = ts->decoder;
-            if(decoder != nullptr){
-                delete decoder;
-                decoder = nullptr;
+            // Clear Decoder, 写入失败之后不再刷新
+            for(int i = 0; i < transcodeStream.size() && !isWriteFail; i++){
+                EyerAVTranscodeStream * ts = transcodeStream[i];
+                EyerAVDecoder *decoder = ts->decoder;
+                if (decoder != nullptr) {
+                    EyerAVTranscodeStageTimer decodeTimer;
+                    int decodeFrameNum = 0;
+                    decodeTimer.Start();
+                    decoder->SendPacketNull();
+                    decodeTimer.Stop();
+                    while(1){
+                        decodeTimer.Start();
+                        ret = decoder->RecvFrame(frame);
+                        decodeTimer.Stop();
+                        if(ret){
+                            break;
+                        }
+                        decodeFrameNum++;
+                        if((params.GetEndTime() != 0.0) && (frame.GetSecPTS() > params.GetEndTime())){
+                            break;
+                        }
+                        //  EyerLog("Flush Frame PTS: %f , Stream ID: %d\n", frame.GetSecPTS(), ts->readStreamId);
+                        EncodeFrame(&write, ts, frame);
+                        if(isWriteFail){
+                            break;
+                        }
+                    }
+                    AddProfile(ts->readStreamId, STAGE_DECODE, decodeTimer, decodeFrameNum);
+                }
             }
 
-            EyerAVEncoder * encoder = ts->encoder;
-            if(encoder != nullptr){
-                delete encoder;
-                encoder = nullptr;
+            if(!isInterrupt && !isWriteFail) {
+                // Clear Encode
+                for(int i = 0; i < transcodeStream.size(); i++) {
+                    EyerAVTranscodeStream *ts = transcodeStream[i];
+                    if(ClearFrame(&write, ts) && isWriteFail){
+                        break;
+                    }
+                }
             }
 
-            EyerAVResample * resample = ts->resample;
-            if(resample != nullptr){
-                delete resample;
-                resample = nullptr;
+            if(isWriteFail){
+                errorDesc = "写入数据包失败";
             }
         }
 
-        for(int i = 0; i < transcodeStream.size(); i++){
-            EyerAVTranscodeStream * ts = transcodeStream[i];
-            delete ts;
-        }
-        transcodeStream.clear();
+        // Free Decoder and Encoder
+        FreeTranscodeStream(transcodeStream);
 
         {
             long long startTime = Eyer::EyerTime::GetTimeNano();
-            write.WriteTrailer();
+            // 异步写入时封装线程中的错误也由 WriteTrailer 返回
+            ret = write.WriteTrailer();
             write.Close();
             long long endTime = Eyer::EyerTime::GetTimeNano();
-            ioWriteTime += (endTime - startTime);
+            std::lock_guard<std::mutex> lg(profileMut);
+            profile.trailerTime += (endTime - startTime);
+            profile.asyncWriteTime += write.GetAsyncWriteTime();
+        }
+        if(ret && !isWriteFail){
+            EyerLog("Write trailer fail\n");
+            isWriteFail = true;
+            if(!isFail){
+                errorDesc = "写入文件尾失败";
+            }
         }
 
         reader.Close();
 
-        if(isInterrupt){
+        if(isWriteFail){
+            status = EyerAVTranscoderStatus::FAIL;
+            if(listener != nullptr){
+                listener->OnFail(EyerAVTranscoderError::WRITE_FAIL);
+            }
+        }
+        else if(isFail){
+            status = EyerAVTranscoderStatus::FAIL;
+            if(listener != nullptr){
+                listener->OnFail(EyerAVTranscoderError::TRANSCODE_FAIL);
+            }
+        }
+        else if(isInterrupt){
             status = EyerAVTranscoderStatus::FAIL;
             if(listener != nullptr){
                 errorDesc = "被取消";
@@ -337,7 +586,19 @@ namespace Eyer
 
         long long endTime = Eyer::EyerTime::GetTimeNano();
 
-        totleTime = endTime - startTime;
+        long long totleTime = endTime - startTime;
+        long long ioReadTime = 0;
+        long long ioWriteTime = 0;
+        long long asyncWriteTime = 0;
+        EyerString profileJson;
+        {
+            std::lock_guard<std::mutex> lg(profileMut);
+            profile.totalTime = totleTime;
+            ioReadTime = profile.GetStageTotal(STAGE_DEMUX).wallTime;
+            ioWriteTime = profile.GetStageTotal(STAGE_MUX).wallTime + profile.trailerTime;
+            asyncWriteTime = profile.asyncWriteTime;
+            profileJson = profile.ToJson();
+        }
 
         EyerLog("==================Transcoder Finish Start==================\n");
         EyerLog("inputPath: %s\n", inputPath.c_str());
@@ -345,8 +606,42 @@ namespace Eyer
         EyerLog("Transcode Totle time: %f s\n", totleTime * 1.0 / 1000000000);
         EyerLog("Transcode IO Read Time: %f s\n", ioReadTime * 1.0 / 1000000000);
         EyerLog("Transcode IO Write Time: %f s\n", ioWriteTime * 1.0 / 1000000000);
+        if(params.GetAsyncWrite()){
+            EyerLog("Transcode Async Write Time: %f s\n", asyncWriteTime * 1.0 / 1000000000);
+        }
+        EyerLog("Transcode Profile: %s\n", profileJson.c_str());
         EyerLog("==================Transcoder Finish End==================\n");
 
+        if(isFail || isWriteFail){
+            return -1;
+        }
+        return 0;
+    }
+
+    int EyerAVTranscoder::SetEncoderRateParams(EyerAVEncoderParam & encoderParam)
+    {
+        // SetPreset/SetTune 之后可能又修改了编码器, 这里按最终的编码器再校验一次
+        if(!EyerAVEncoderParam::IsPresetSupport(encoderParam.codecId, params.GetPreset())){
+            errorDesc = "编码器不支持该 preset";
+            return -1;
+        }
+        if(!EyerAVEncoderParam::IsTuneSupport(encoderParam.codecId, params.GetTune())){
+            errorDesc = "编码器不支持该 tune";
+            return -1;
+        }
+        if(params.GetRateControl() != EyerAVRateControl::CRF && params.GetBitrate() <= 0){
+            errorDesc = "ABR/CBR 需要设置码率";
+            return -1;
+        }
+
+        encoderParam.preset = params.GetPreset();
+        encoderParam.tune = params.GetTune();
+        encoderParam.rateControl = params.GetRateControl();
+        encoderParam.bitrate = params.GetBitrate();
+        encoderParam.maxrate = params.GetMaxrate();
+        encoderParam.bufsize = params.GetBufsize();
+        encoderParam.gop = params.GetGOP();
+        encoderParam.bframes = params.GetBFrames();
         return 0;
     }
 
@@ -394,6 +689,9 @@ namespace Eyer
                         params.GetCRF()
                         );
                 encoderParam.threadnum = params.GetEncodeThreadNum();
+                if(SetEncoderRateParams(encoderParam)){
+                    return -2;
+                }
                 return encoder->Init(encoderParam);
             }
             else if(params.GetVideoCodecId() == EyerAVCodecID::CODEC_ID_H265){
@@ -430,6 +728,9 @@ namespace Eyer
                         params.GetCRF()
                 );
                 encoderParam.threadnum = params.GetEncodeThreadNum();
+                if(SetEncoderRateParams(encoderParam)){
+                    return -2;
+                }
                 return encoder->Init(encoderParam);
             }
             else if(params.GetVideoCodecId() == EyerAVCodecID::CODEC_ID_PRORES){
@@ -465,6 +766,8 @@ namespace Eyer
                 EyerAVEncoderParam encoderParam;
                 encoderParam.InitProres(distWidth, distHeight, encoderTimebase, distPixelFormat);
                 encoderParam.threadnum = params.GetEncodeThreadNum();
+                // ProRes 没有 preset 和码率控制, 只转发 profile
+                encoderParam.proresProfile = params.GetProresProfile();
                 return encoder->Init(encoderParam);
             }
             return -1;
@@ -599,7 +902,7 @@ namespace Eyer
         return -1;
     }
 
-    int EyerAVTranscoder::EncodeFrame(Eyer::EyerAVWriter * write, EyerAVTranscodeStream * ts, EyerAVFrame & frame)
+    int EyerAVTranscoder::EncodeFrame(Eyer::EyerAVWriter * write, EyerAVTranscodeStream * ts, EyerAVFrame & frame, EyerAVFrame * scaledFrame)
     {
         EyerAVEncoder * encoder = ts->encoder;
         EyerAVResample * resample = ts->resample;
@@ -625,37 +928,52 @@ namespace Eyer
 
             currentSecPTS = frame.GetSecPTS();
 
+            EyerAVTranscodeStageTimer resampleTimer;
+            EyerAVTranscodeStageTimer encodeTimer;
+            int resampleFrameNum = 0;
+            int encodePacketNum = 0;
+            // RecvPacket 会先释放上一个包的数据
+            EyerAVPacket packet;
+
             // EyerLog("frame: %s\n", frame.GetSampleFormat().GetName().c_str());
+            resampleTimer.Start();
             resample->PutAVFrame(frame);
+            resampleTimer.Stop();
             while(1){
                 EyerAVFrame encodeFrame;
-                int framesize = encoder->GetFrameSize();
-                if(framesize <= 0){
-                    framesize = 1024;
-                }
+                int framesize = GetAudioFrameSize(encoder);
+                resampleTimer.Start();
                 int ret = resample->GetFrame(encodeFrame, framesize);
+                resampleTimer.Stop();
                 if(ret){
                     break;
                 }
+                resampleFrameNum++;
                 encodeFrame.SetPTS(ts->audioPts);
                 ts->audioPts += encodeFrame.GetSampleNB();
 
+                encodeTimer.Start();
                 ret = encoder->SendFrame(encodeFrame);
+                encodeTimer.Stop();
                 while(1){
-                    EyerAVPacket packet;
+                    encodeTimer.Start();
                     int ret = encoder->RecvPacket(packet);
+                    encodeTimer.Stop();
                     if(ret){
                         break;
                     }
+                    encodePacketNum++;
                     packet.SetStreamIndex(ts->writeStreamId);
                     packet.RescaleTs(encodeTimebase, write->GetTimebase(ts->writeStreamId));
 
-                    long long startTime = Eyer::EyerTime::GetTimeNano();
-                    write->WritePacket(packet);
-                    long long endTime = Eyer::EyerTime::GetTimeNano();
-                    ioWriteTime += (endTime - startTime);
+                    if(WritePacket(write, ts->readStreamId, packet)){
+                        return -1;
+                    }
                 }
             }
+
+            AddProfile(ts->readStreamId, STAGE_RESAMPLE, resampleTimer, resampleFrameNum);
+            AddProfile(ts->readStreamId, STAGE_ENCODE, encodeTimer, encodePacketNum);
         }
         else if(mediaType == EyerAVMediaType::MEDIA_TYPE_VIDEO && params.GetCareVideo()){
             currentSecPTS = frame.GetSecPTS();
@@ -673,18 +991,37 @@ namespace Eyer
             int distWidth = params.GetWidth();
             int distHeight = params.GetHeight();
 
+            EyerAVTranscodeStageTimer scaleTimer;
             EyerAVFrame distFrame;
-            frame.Scale(distFrame, distPixelformat, distWidth, distHeight);
+            scaleTimer.Start();
+            int ret = ts->scaler.Scale(frame, distFrame, distPixelformat, distWidth, distHeight);
+            scaleTimer.Stop();
+            AddProfile(ts->readStreamId, STAGE_SCALE, scaleTimer, 1);
+            // 空帧送进编码器会被当成结束
+            if(ret){
+                EyerLog("Scale fail\n");
+                return -1;
+            }
+            if(scaledFrame != nullptr){
+                *scaledFrame = distFrame;
+            }
 
             // EyerLog("distPixelformat: %s\n", frame.GetPixelFormat().GetDescName().c_str());
 
+            EyerAVTranscodeStageTimer encodeTimer;
+            int encodePacketNum = 0;
+            encodeTimer.Start();
             encoder->SendFrame(distFrame);
+            encodeTimer.Stop();
+            EyerAVPacket packet;
             while(1){
-                EyerAVPacket packet;
+                encodeTimer.Start();
                 int ret = encoder->RecvPacket(packet);
+                encodeTimer.Stop();
                 if(ret){
                     break;
                 }
+                encodePacketNum++;
                 // EyerLog("PTS: %lld, DTS: %lld\n", packet.GetPTS(), packet.GetDTS());
                 packet.SetStreamIndex(ts->writeStreamId);
                 packet.RescaleTs(encodeTimebase, write->GetTimebase(ts->writeStreamId));
@@ -694,44 +1031,263 @@ namespace Eyer
                 }
                 // EyerLog("PTS: %lld, DTS: %lld\n", packet.GetPTS(), packet.GetDTS());
 
-                long long startTime = Eyer::EyerTime::GetTimeNano();
-                write->WritePacket(packet);
-                long long endTime = Eyer::EyerTime::GetTimeNano();
-                ioWriteTime += (endTime - startTime);
+                if(WritePacket(write, ts->readStreamId, packet)){
+                    return -1;
+                }
             }
+            AddProfile(ts->readStreamId, STAGE_ENCODE, encodeTimer, encodePacketNum);
         }
 
         // EyerLog("p: %f\n", currentSecPTS);
 
-        if(currentSecPTS - lastUpdateTime >= 0.5){
-            if(listener != nullptr){
-                double tempCurrentSecPTS = 0;
-                tempCurrentSecPTS = currentSecPTS - params.GetStartTime();
-                if(params.GetStartTime() != 0.0 || params.GetEndTime() != 0.0){
-                    if(params.GetEndTime() != 0.0){
-                        duration = params.GetEndTime() - params.GetStartTime();
-                    } else{
-                        duration = duration - params.GetStartTime();
+        UpdateProgress(currentSecPTS);
+
+        return 0;
+    }
+
+    int EyerAVTranscoder::UpdateProgress(double currentSecPTS)
+    {
+        if(listener == nullptr){
+            return 0;
+        }
+        if(!IsProgressDue()){
+            return 0;
+        }
+
+        double rangeDuration = duration - params.GetStartTime();
+        if(params.GetEndTime() != 0.0){
+            rangeDuration = params.GetEndTime() - params.GetStartTime();
+        }
+
+        double mediaTime = currentSecPTS - params.GetStartTime();
+        if(mediaTime < 0.0){
+            mediaTime = 0.0;
+        }
+
+        float progress = mediaTime / rangeDuration;
+        if(progress >= 1.0){
+            progress = 1.0;
+        }
+        if(rangeDuration <= 0){
+            progress = 0;
+        }
+
+        // 帧数和字节数从统计中汇总, 流复制的视频按写入的包计数
+        int64_t frameNum = 0;
+        int64_t bytesWritten = 0;
+        {
+            std::lock_guard<std::mutex> lg(profileMut);
+            for(int i = 0; i < profile.streamList.size(); i++){
+                const EyerAVTranscodeStreamProfile & streamProfile = profile.streamList[i];
+                bytesWritten += streamProfile.bytesOut;
+                if(streamProfile.mediaType == EyerAVMediaType::MEDIA_TYPE_VIDEO.GetName()){
+                    if(streamProfile.isCopy){
+                        frameNum += streamProfile.stageTime[STAGE_MUX].count;
+                    }
+                    else{
+                        frameNum += streamProfile.stageTime[STAGE_SCALE].count;
                     }
                 }
+            }
+        }
 
-                float progress = tempCurrentSecPTS / duration;
-                if(progress >= 1.0){
-                    progress = 1.0;
-                }
-                if(duration <= 0){
-                    progress = 0;
-                }
+        // EyerLog("p: %f\n", progress);
+        return NotifyProgress(progress, mediaTime, frameNum, bytesWritten);
+    }
+
+    bool EyerAVTranscoder::IsProgressDue()
+    {
+        return Eyer::EyerTime::GetTime() - lastProgressTime >= params.GetProgressInterval();
+    }
+
+    int EyerAVTranscoder::NotifyProgress(float progress, double mediaTime, int64_t frameNum, int64_t bytesWritten)
+    {
+        if(listener == nullptr){
+            return 0;
+        }
+
+        long long now = Eyer::EyerTime::GetTime();
 
-                // EyerLog("p: %f\n", progress);
-                listener->OnProgress(progress);
+        EyerAVTranscodeProgress info;
+        info.progress = progress;
+        info.frameNum = frameNum;
+        info.bytesWritten = bytesWritten;
+        info.mediaTime = mediaTime;
+        info.elapsedTime = (now - progressStartTime) / 1000.0;
+
+        double intervalTime = (now - lastProgressTime) / 1000.0;
+        if(intervalTime > 0.0){
+            info.fps = (frameNum - lastProgressFrameNum) / intervalTime;
+        }
+        if(info.elapsedTime > 0.0){
+            info.speed = mediaTime / info.elapsedTime;
+        }
+        if(progress >= 1.0){
+            info.eta = 0.0;
+        }
+        else if(progress > 0.0){
+            info.eta = info.elapsedTime * (1.0 - progress) / progress;
+        }
+
+        lastProgressTime = now;
+        lastProgressFrameNum = frameNum;
+
+        listener->OnProgress(progress);
+        listener->OnProgressInfo(info);
+        return 0;
+    }
+
+    int EyerAVTranscoder::InitResample(EyerAVTranscodeStream * ts, EyerAVStream & stream)
+    {
+        if(stream.GetType() != EyerAVMediaType::MEDIA_TYPE_AUDIO){
+            ts->resample = nullptr;
+            return 0;
+        }
+
+        EyerAVEncoder * encoder = ts->encoder;
+        EyerAVResample * resample = new EyerAVResample();
+
+        EyerAVChannelLayout inputChannelLayout = stream.GetChannelLayout();
+        if(inputChannelLayout == EyerAVChannelLayout::UNKNOW){
+            inputChannelLayout = EyerAVChannelLayout::GetDefaultChannelLayout(stream.GetChannels());
+        }
+
+        EyerLog("ChannelLayout: %s\n", inputChannelLayout.GetName().c_str());
+
+        int ret = resample->Init(
+                encoder->GetChannelLayout(),
+                encoder->GetSampleFormat(),
+                encoder->GetSampleRate(),
+
+                inputChannelLayout,
+                stream.GetSampleFormat(),
+                stream.GetSampleRate()
+        );
+        if(ret){
+            delete resample;
+            ts->resample = nullptr;
+            errorDesc = "初始化重采样失败";
+            return -1;
+        }
+        ts->resample = resample;
+        return 0;
+    }
+
+    bool EyerAVTranscoder::IsStreamCopy(EyerAVStream & stream, Eyer::EyerAVWriter * write)
+    {
+        if(stream.GetType() == EyerAVMediaType::MEDIA_TYPE_VIDEO){
+            if(params.GetVideoCopyMode() == EyerAVTranscoderCopyMode::COPY){
+                return true;
+            }
+            if(params.GetVideoCopyMode() == EyerAVTranscoderCopyMode::ENCODE){
+                return false;
+            }
+            if(stream.GetCodecID() != params.GetVideoCodecId()){
+                return false;
+            }
+            if(params.GetWidth() > 0 && params.GetWidth() != stream.GetWidth()){
+                return false;
+            }
+            if(params.GetHeight() > 0 && params.GetHeight() != stream.GetHeight()){
+                return false;
+            }
+            if(params.GetVideoPixelFormat() != EyerAVPixelFormat::EYER_KEEP_SAME && params.GetVideoPixelFormat() != stream.GetPixelFormat()){
+                return false;
+            }
+            return true;
+        }
+        else if(stream.GetType() == EyerAVMediaType::MEDIA_TYPE_AUDIO){
+            if(params.GetAudioCopyMode() == EyerAVTranscoderCopyMode::COPY){
+                return true;
+            }
+            if(params.GetAudioCopyMode() == EyerAVTranscoderCopyMode::ENCODE){
+                return false;
+            }
+            if(params.GetAudioChannelLayout() != EyerAVChannelLayout::EYER_KEEP_SAME && params.GetAudioChannelLayout() != stream.GetChannelLayout()){
+                return false;
+            }
+            if(params.GetSampleRate() != SAMPLE_RATE_KEEP_SAME && params.GetSampleRate() != stream.GetSampleRate()){
+                return false;
             }
-            lastUpdateTime = currentSecPTS;
+            // 提取音频时输出格式能封装就复制, 不要求和音频编码参数一致
+            if(params.GetAudioExtract() && write != nullptr){
+                return write->IsStreamSupported(stream);
+            }
+            if(stream.GetCodecID() != params.GetAudioCodecId()){
+                return false;
+            }
+            return true;
+        }
+        return false;
+    }
+
+    int EyerAVTranscoder::GetAudioFrameSize(EyerAVEncoder * encoder)
+    {
+        int framesize = encoder->GetFrameSize();
+        if(framesize > 0){
+            return framesize;
+        }
+        // PCM 等编码器不限制帧大小, 提取音频时一次送入更多采样, 减少重采样和编码的调用次数
+        if(params.GetAudioExtract()){
+            return 16384;
+        }
+        return 1024;
+    }
+
+    int EyerAVTranscoder::PrepareCopyPacket(Eyer::EyerAVWriter * write, EyerAVTranscodeStream * ts, EyerAVPacket & packet)
+    {
+        if(ts->isRangeEnd){
+            return 1;
+        }
+        if((params.GetEndTime() != 0.0) && (packet.GetSecPTS() > params.GetEndTime())){
+            return 1;
         }
 
+        // 必须从关键帧开始复制, 视频从 Seek 到的关键帧开始, 音频丢掉起始时间之前的包
+        if(!ts->isCopyStarted){
+            if(!packet.IsKeyFrame()){
+                return -1;
+            }
+            if(ts->mediaType != EyerAVMediaType::MEDIA_TYPE_VIDEO){
+                if((params.GetStartTime() != 0.0) && (packet.GetSecPTS() < params.GetStartTime())){
+                    return -1;
+                }
+            }
+            ts->isCopyStarted = 1;
+        }
+
+        if(params.GetStartTime() != 0.0){
+            int64_t offset = EyerAVRational::RescaleQ((int64_t)(params.GetStartTime() * 1000000), EyerAVRational(1, 1000000), ts->readTimebase);
+            packet.OffsetTs(offset);
+        }
+
+        packet.SetStreamIndex(ts->writeStreamId);
+        packet.RescaleTs(ts->readTimebase, write->GetTimebase(ts->writeStreamId));
         return 0;
     }
 
+    bool EyerAVTranscoder::MarkRangeEnd(std::vector<EyerAVTranscodeStream *> & transcodeStream, EyerAVTranscodeStream * currentTs)
+    {
+        int usefulTsNum = 0;
+        int rangeEndNum = 0;
+        for(int i=0; i<transcodeStream.size(); i++){
+            EyerAVTranscodeStream * ts = transcodeStream[i];
+            if(ts->encoder != nullptr || ts->isCopy){
+                usefulTsNum++;
+
+                if(ts->isRangeEnd == 1){
+                    rangeEndNum++;
+                }
+                if(ts->isRangeEnd == 0 && ts == currentTs){
+                    ts->isRangeEnd = 1;
+                    rangeEndNum++;
+                }
+            }
+        }
+
+        return usefulTsNum == rangeEndNum;
+    }
+
     int EyerAVTranscoder::ClearFrame(Eyer::EyerAVWriter * write, EyerAVTranscodeStream * ts)
     {
         EyerAVEncoder * encoder = ts->encoder;
@@ -743,25 +1299,179 @@ namespace Eyer
 
         EyerAVRational encodeTimebase = encoder->GetTimebase();
 
+        EyerAVTranscodeStageTimer encodeTimer;
+        int encodePacketNum = 0;
+        EyerAVPacket packet;
+
+        // 取出重采样器中剩余的采样, 编码器支持短的最后一帧时直接送入, 否则补静音
+        if(resample != nullptr && encoder->GetMediaType() == EyerAVMediaType::MEDIA_TYPE_AUDIO){
+            EyerAVTranscodeStageTimer resampleTimer;
+            int resampleFrameNum = 0;
+            resampleTimer.Start();
+            resample->PutAVFrameNULL();
+            resampleTimer.Stop();
+            int framesize = GetAudioFrameSize(encoder);
+            while(1){
+                EyerAVFrame encodeFrame;
+                resampleTimer.Start();
+                int ret = resample->GetFrame(encodeFrame, framesize);
+                if(ret){
+                    ret = resample->GetLastFrame(encodeFrame, framesize, !encoder->IsSmallLastFrameSupported());
+                }
+                resampleTimer.Stop();
+                if(ret){
+                    break;
+                }
+                resampleFrameNum++;
+                encodeFrame.SetPTS(ts->audioPts);
+                ts->audioPts += encodeFrame.GetSampleNB();
+
+                encodeTimer.Start();
+                encoder->SendFrame(encodeFrame);
+                encodeTimer.Stop();
+                while(1){
+                    encodeTimer.Start();
+                    ret = encoder->RecvPacket(packet);
+                    encodeTimer.Stop();
+                    if(ret){
+                        break;
+                    }
+                    encodePacketNum++;
+                    packet.SetStreamIndex(ts->writeStreamId);
+                    packet.RescaleTs(encodeTimebase, write->GetTimebase(ts->writeStreamId));
+
+                    if(WritePacket(write, ts->readStreamId, packet)){
+                        return -1;
+                    }
+                }
+            }
+            AddProfile(ts->readStreamId, STAGE_RESAMPLE, resampleTimer, resampleFrameNum);
+        }
+
+        encodeTimer.Start();
         encoder->SendFrameNull();
+        encodeTimer.Stop();
         while(1){
-            EyerAVPacket packet;
+            encodeTimer.Start();
             int ret = encoder->RecvPacket(packet);
+            encodeTimer.Stop();
             if(ret){
                 break;
             }
+            encodePacketNum++;
             packet.SetStreamIndex(ts->writeStreamId);
             packet.RescaleTs(encodeTimebase, write->GetTimebase(ts->writeStreamId));
 
-            long long startTime = Eyer::EyerTime::GetTimeNano();
-            write->WritePacket(packet);
-            long long endTime = Eyer::EyerTime::GetTimeNano();
-            ioWriteTime += (endTime - startTime);
+            if(WritePacket(write, ts->readStreamId, packet)){
+                return -1;
+            }
+        }
+        AddProfile(ts->readStreamId, STAGE_ENCODE, encodeTimer, encodePacketNum);
+
+        return 0;
+    }
+
+    int EyerAVTranscoder::FreeTranscodeStream(std::vector<EyerAVTranscodeStream *> & transcodeStream)
+    {
+        for(int i = 0; i < transcodeStream.size(); i++){
+            EyerAVTranscodeStream * ts = transcodeStream[i];
+            if(ts->decoder != nullptr){
+                delete ts->decoder;
+                ts->decoder = nullptr;
+            }
+            if(ts->encoder != nullptr){
+                delete ts->encoder;
+                ts->encoder = nullptr;
+            }
+            if(ts->resample != nullptr){
+                delete ts->resample;
+                ts->resample = nullptr;
+            }
+            delete ts;
         }
+        transcodeStream.clear();
+        return 0;
+    }
+
+    int EyerAVTranscoder::AddProfile(int streamId, EyerAVTranscodeStage stage, const EyerAVTranscodeStageTimer & timer, int64_t count, int64_t bytes)
+    {
+        std::lock_guard<std::mutex> lg(profileMut);
+        return profile.AddStage(streamId, stage, timer, count, bytes);
+    }
+
+    int EyerAVTranscoder::WritePacket(Eyer::EyerAVWriter * write, int streamId, EyerAVPacket & packet)
+    {
+        // 写入后 packet 的数据会被 muxer 接管, 先记录大小
+        int64_t bytes = packet.GetSize();
 
+        EyerAVTranscodeStageTimer muxTimer;
+        muxTimer.Start();
+        int ret = write->WritePacket(packet);
+        muxTimer.Stop();
+
+        AddProfile(streamId, STAGE_MUX, muxTimer, 1, bytes);
+        if(ret){
+            EyerLog("Write packet fail: %d\n", ret);
+            isWriteFail = true;
+        }
+        return ret;
+    }
+
+    int EyerAVTranscoder::InitWriter(Eyer::EyerAVWriter * write, int64_t estimateSize)
+    {
+        write->SetIOBufferSize(params.GetWriteBufferSize());
+        if(params.GetWritePreallocate() && estimateSize > 0){
+            write->SetPreallocateSize(estimateSize);
+        }
+        write->SetAsync(params.GetAsyncWrite(), params.GetWriteQueueSize());
+        if(params.GetMovMode() == EyerAVTranscoderMovMode::FASTSTART){
+            if(write->SetFastStart(true)){
+                errorDesc = "自定义输出不支持 faststart";
+                return -1;
+            }
+        }
+        else if(params.GetMovMode() == EyerAVTranscoderMovMode::FRAGMENT){
+            write->SetFragment(true, params.GetFragmentDuration());
+        }
         return 0;
     }
 
+    int64_t EyerAVTranscoder::EstimateOutputSize(double rangeDuration)
+    {
+        if(rangeDuration <= 0.0){
+            return 0;
+        }
+        // 单位 kbps
+        int bitrate = 0;
+        if(params.GetRateControl() == EyerAVRateControl::ABR || params.GetRateControl() == EyerAVRateControl::CBR){
+            bitrate = params.GetBitrate();
+        }
+        if(params.GetMaxrate() > bitrate){
+            bitrate = params.GetMaxrate();
+        }
+        if(bitrate <= 0 || !params.GetCareVideo() || params.GetAudioExtract()){
+            return 0;
+        }
+        // 音频和封装开销按 320kbps 估计, 再留 5% 余量, 多出的部分在关闭时截断
+        double bits = (bitrate + 320) * 1000.0 * rangeDuration * 1.05;
+        return (int64_t)(bits / 8);
+    }
+
+    int64_t EyerAVTranscoder::GetFileSize(const EyerString & path)
+    {
+        return EyerAVFileUtil::GetFileSize(path);
+    }
+
+    EyerAVTranscodeProfile EyerAVTranscoder::GetProfile()
+    {
+        std::lock_guard<std::mutex> lg(profileMut);
+        EyerAVTranscodeProfile tempProfile = profile;
+        if(isProfileRunning){
+            tempProfile.totalTime = Eyer::EyerTime::GetTimeNano() - profileStartTime;
+        }
+        return tempProfile;
+    }
+
     int EyerAVTranscoder::SetListener(EyerAVTranscoderListener * _listener)
     {
         listener = _listener;
@@ -1,11 +1,16 @@
 #ifndef EYERLIB_EYERAVTRANSCODER_HPP
 #define EYERLIB_EYERAVTRANSCODER_HPP
 
+#include <vector>
+#include <mutex>
+
 #include "EyerCore/EyerCore.hpp"
 #include "EyerAVTranscoderParams.hpp"
 #include "EyerAVTranscodeStream.hpp"
 #include "EyerAVTranscoderStatus.hpp"
 #include "EyerAVTranscoderError.hpp"
+#include "EyerAVTranscodeProfile.hpp"
+#include "EyerAVTranscodeProgress.hpp"
 #include "EyerAV/EyerAVReaderCustomIO.hpp"
 
 #define SAMPLE_RATE_KEEP_SAME -2
@@ -18,6 +23,12 @@ namespace Eyer
         virtual int OnProgress(float progress) = 0;
         virtual int OnFail(EyerAVTranscoderError & error) = 0;
         virtual int OnSuccess() = 0;
+
+        // 紧跟在 OnProgress 之后调用, 带有帧率, 速度, 输出字节数和预计剩余时间
+        virtual int OnProgressInfo(const EyerAVTranscodeProgress & progress)
+        {
+            return 0;
+        }
     };
 
     class EyerAVTranscoderInterrupt
@@ -26,6 +37,11 @@ namespace Eyer
         virtual bool interrupt() = 0;
     };
 
+    class EyerAVTranscoderPipeline;
+    class EyerAVTranscoderSegment;
+    class EyerAVTranscoderSmartCut;
+    class EyerAVTranscoderLadder;
+
     class EyerAVTranscoder
     {
     public:
@@ -37,13 +53,30 @@ namespace Eyer
         int SetListener(EyerAVTranscoderListener * _listener);
 
         int Transcode_(EyerAVTranscoderInterrupt * interrupt);
-        int Transcode(EyerAVTranscoderInterrupt * interrupt, EyerAVReaderCustomIO * customIO = nullptr);
+        // outputCustomIO 不为空时输出写到 outputCustomIO, outputPath 只用来确定封装格式
+        // 自定义 IO 的输入或输出都不支持分段, 断点续转和智能裁剪, 会走普通流程
+        int Transcode(EyerAVTranscoderInterrupt * interrupt, EyerAVReaderCustomIO * customIO = nullptr, EyerAVWriterCustomIO * outputCustomIO = nullptr);
+
+        // 多码率输出: 输入只解复用和解码一次, 按每一路的参数编码到各自的输出文件
+        // 每一路使用自己的编码, 尺寸, 码率, 复制模式和封装参数; 起止时间, 是否处理音视频, 解码线程数和队列大小使用 SetParams 的参数
+        // 添加之后 Transcode 不再写 SetOutputPath 的输出, 也不支持自定义 IO 输出
+        int AddRendition(const EyerString & outputPath, const EyerAVTranscoderParams & renditionParams);
+        int ClearRendition();
+        int GetRenditionNum();
 
         EyerAVTranscoderStatus GetStatus();
         int SetStatus(const EyerAVTranscoderStatus & _status);
 
         EyerString GetErrorDesc();
         int SetErrorDesc(const EyerString & _errorDesc);
+
+        // 分阶段耗时统计, 转码过程中可以从其他线程调用, 返回当前统计的副本
+        EyerAVTranscodeProfile GetProfile();
+
+        friend class EyerAVTranscoderPipeline;
+        friend class EyerAVTranscoderSegment;
+        friend class EyerAVTranscoderSmartCut;
+        friend class EyerAVTranscoderLadder;
     private:
         EyerAVTranscoderStatus status = EyerAVTranscoderStatus::PREPARE;
         EyerString errorDesc = "";
@@ -53,18 +86,56 @@ namespace Eyer
 
         EyerAVTranscoderParams params;
 
+        std::vector<EyerString> renditionPathList;
+        std::vector<EyerAVTranscoderParams> renditionParamsList;
+
+        int TranscodeInternal(EyerAVTranscoderInterrupt * interrupt, EyerAVReaderCustomIO * customIO, EyerAVWriterCustomIO * outputCustomIO);
         int InitEncoder(EyerAVEncoder * encoder, const EyerAVStream & stream);
-        int EncodeFrame(Eyer::EyerAVWriter * write, EyerAVTranscodeStream * ts, EyerAVFrame & frame);
+        // 把 preset/tune/码率控制/GOP/B 帧参数复制到 H264/H265 编码参数
+        int SetEncoderRateParams(EyerAVEncoderParam & encoderParam);
+        // scaledFrame 不为空时带出缩放后的视频帧 (共享数据), 多码率输出级联缩放时使用
+        int EncodeFrame(Eyer::EyerAVWriter * write, EyerAVTranscodeStream * ts, EyerAVFrame & frame, EyerAVFrame * scaledFrame = nullptr);
         int ClearFrame(Eyer::EyerAVWriter * write, EyerAVTranscodeStream * ts);
+        int UpdateProgress(double currentSecPTS);
+        // 距离上次回调是否已经超过 progressInterval
+        bool IsProgressDue();
+        int NotifyProgress(float progress, double mediaTime, int64_t frameNum, int64_t bytesWritten);
+
+        // write 不为空时, 提取音频模式下按输出格式判断音频能否复制
+        bool IsStreamCopy(EyerAVStream & stream, Eyer::EyerAVWriter * write = nullptr);
+        // 每次送入音频编码器的采样数, 编码器不限制帧大小时提取音频模式下使用大块
+        int GetAudioFrameSize(EyerAVEncoder * encoder);
+        // 音频流按 ts->encoder 的参数创建重采样, 其他流设置为空
+        int InitResample(EyerAVTranscodeStream * ts, EyerAVStream & stream);
+        int PrepareCopyPacket(Eyer::EyerAVWriter * write, EyerAVTranscodeStream * ts, EyerAVPacket & packet);
+        bool MarkRangeEnd(std::vector<EyerAVTranscodeStream *> & transcodeStream, EyerAVTranscodeStream * ts);
+        // 释放每一路的解码器, 编码器和重采样, 并清空列表
+        int FreeTranscodeStream(std::vector<EyerAVTranscodeStream *> & transcodeStream);
+
+        int AddProfile(int streamId, EyerAVTranscodeStage stage, const EyerAVTranscodeStageTimer & timer, int64_t count, int64_t bytes = 0);
+        // 写入数据包并记录 mux 阶段的统计, streamId 为输入文件中的流序号, 失败时置 isWriteFail
+        int WritePacket(Eyer::EyerAVWriter * write, int streamId, EyerAVPacket & packet);
+        // 按参数设置输出的缓冲区, 预分配和异步写入, 在 Open 之前调用, estimateSize 为 0 时不预分配
+        int InitWriter(Eyer::EyerAVWriter * write, int64_t estimateSize);
+        // 按码率预估 rangeDuration 秒输出的大小, CRF 等码率未知时返回 0
+        int64_t EstimateOutputSize(double rangeDuration);
+        static int64_t GetFileSize(const EyerString & path);
 
         double duration = 0.0;
-        double lastUpdateTime = 0.0;
+        // 墙钟时间, 单位毫秒
+        long long progressStartTime = 0;
+        long long lastProgressTime = 0;
+        int64_t lastProgressFrameNum = 0;
 
         EyerAVTranscoderListener * listener = nullptr;
 
-        long long totleTime = 0;
-        long long ioReadTime = 0;
-        long long ioWriteTime = 0;
+        // 写入数据包或者文件尾失败, 转码结束时报告 WRITE_FAIL
+        bool isWriteFail = false;
+
+        std::mutex profileMut;
+        EyerAVTranscodeProfile profile;
+        long long profileStartTime = 0;
+        bool isProfileRunning = false;
     };
 }
 
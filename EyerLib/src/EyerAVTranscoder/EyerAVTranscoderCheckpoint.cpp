@@ -0,0 +1,162 @@
+#include "EyerAVTranscoderCheckpoint.hpp"
+
+#include <stdio.h>
+#include <string.h>
+#include <string>
+
+namespace Eyer
+{
+    static const char * CHECKPOINT_VERSION = "1";
+
+    // FNV-1a, 不依赖 std::hash 的实现, 不同版本的程序算出的指纹一致
+    static uint64_t EyerAVTranscoderCheckpoint_Hash(const EyerString & str)
+    {
+        uint64_t hash = 14695981039346656037ULL;
+        const char * data = str.c_str();
+        int len = strlen(data);
+        for(int i = 0; i < len; i++){
+            hash ^= (uint8_t)data[i];
+            hash *= 1099511628211ULL;
+        }
+        return hash;
+    }
+
+    EyerAVTranscoderCheckpoint::EyerAVTranscoderCheckpoint(const EyerString & _path)
+    {
+        path = _path;
+    }
+
+    EyerAVTranscoderCheckpoint::~EyerAVTranscoderCheckpoint()
+    {
+
+    }
+
+    int EyerAVTranscoderCheckpoint::Load()
+    {
+        FILE * f = fopen(path.c_str(), "rb");
+        if(f == nullptr){
+            return -1;
+        }
+
+        inputFingerprint = "";
+        paramsFingerprint = "";
+        plan = "";
+        doneList.clear();
+
+        bool isVersionMatch = false;
+        char line[4096];
+        while(fgets(line, sizeof(line), f) != nullptr){
+            std::string str = line;
+            while(str.size() > 0 && (str[str.size() - 1] == '\n' || str[str.size() - 1] == '\r')){
+                str.erase(str.size() - 1);
+            }
+            size_t pos = str.find('=');
+            if(pos == std::string::npos){
+                continue;
+            }
+            std::string key = str.substr(0, pos);
+            std::string value = str.substr(pos + 1);
+
+            if(key == "version"){
+                isVersionMatch = value == CHECKPOINT_VERSION;
+            }
+            else if(key == "input"){
+                inputFingerprint = value.c_str();
+            }
+            else if(key == "params"){
+                paramsFingerprint = value.c_str();
+            }
+            else if(key == "plan"){
+                plan = value.c_str();
+            }
+            else if(key == "done"){
+                doneList.push_back(atoi(value.c_str()));
+            }
+        }
+        fclose(f);
+
+        if(!isVersionMatch){
+            return -1;
+        }
+        return 0;
+    }
+
+    int EyerAVTranscoderCheckpoint::Save()
+    {
+        EyerString tempPath = path + ".tmp";
+        FILE * f = fopen(tempPath.c_str(), "wb");
+        if(f == nullptr){
+            return -1;
+        }
+
+        fprintf(f, "version=%s\n", CHECKPOINT_VERSION);
+        fprintf(f, "input=%s\n", inputFingerprint.c_str());
+        fprintf(f, "params=%s\n", paramsFingerprint.c_str());
+        fprintf(f, "plan=%s\n", plan.c_str());
+        for(int i = 0; i < doneList.size(); i++){
+            fprintf(f, "done=%d\n", doneList[i]);
+        }
+
+        fflush(f);
+        fclose(f);
+
+        if(rename(tempPath.c_str(), path.c_str())){
+            // Windows 上目标存在时 rename 失败
+            remove(path.c_str());
+            if(rename(tempPath.c_str(), path.c_str())){
+                return -1;
+            }
+        }
+        return 0;
+    }
+
+    int EyerAVTranscoderCheckpoint::Remove()
+    {
+        remove(path.c_str());
+        EyerString tempPath = path + ".tmp";
+        remove(tempPath.c_str());
+        return 0;
+    }
+
+    bool EyerAVTranscoderCheckpoint::IsDone(int chunkIndex)
+    {
+        for(int i = 0; i < doneList.size(); i++){
+            if(doneList[i] == chunkIndex){
+                return true;
+            }
+        }
+        return false;
+    }
+
+    int EyerAVTranscoderCheckpoint::SetDone(int chunkIndex)
+    {
+        if(IsDone(chunkIndex)){
+            return 0;
+        }
+        doneList.push_back(chunkIndex);
+        return 0;
+    }
+
+    EyerString EyerAVTranscoderCheckpoint::GetInputFingerprint(const EyerString & inputPath)
+    {
+        int64_t size = 0;
+        int64_t mtime = 0;
+        if(EyerAVFileUtil::GetFileInfo(inputPath, size, mtime)){
+            return "";
+        }
+        char buf[64];
+        snprintf(buf, sizeof(buf), "|%lld|%lld", (long long)size, (long long)mtime);
+        return inputPath + buf;
+    }
+
+    EyerString EyerAVTranscoderCheckpoint::GetParamsFingerprint(const EyerAVTranscoderParams & _params)
+    {
+        // 只改变速度不改变输出的参数统一成默认值
+        EyerAVTranscoderParams params = _params;
+        params.ResetSpeedParams();
+
+        char buf[32];
+        snprintf(buf, sizeof(buf), "%016llx", (unsigned long long)EyerAVTranscoderCheckpoint_Hash(params.ToString()));
+        return buf;
+    }
+}
@@ -0,0 +1,44 @@
+#ifndef EYERLIB_EYERAVTRANSCODERCHECKPOINT_HPP
+#define EYERLIB_EYERAVTRANSCODERCHECKPOINT_HPP
+
+#include <vector>
+
+#include "EyerCore/EyerCore.hpp"
+#include "EyerAVTranscoderParams.hpp"
+
+namespace Eyer
+{
+    // 断点续转的检查点文件, 记录输入文件指纹, 编码参数指纹, 分段计划和已经完成的分段
+    // 文本格式, 每行一个 key=value
+    class EyerAVTranscoderCheckpoint
+    {
+    public:
+        EyerAVTranscoderCheckpoint(const EyerString & _path);
+        ~EyerAVTranscoderCheckpoint();
+
+        // 文件不存在或者格式不对返回 -1
+        int Load();
+        // 先写临时文件再重命名, 写入过程中进程退出也不会留下损坏的检查点
+        int Save();
+        int Remove();
+
+        bool IsDone(int chunkIndex);
+        int SetDone(int chunkIndex);
+
+        // 输入路径, 文件大小和修改时间
+        static EyerString GetInputFingerprint(const EyerString & inputPath);
+        // 影响输出内容的转码参数, 线程数, 进度间隔等不计入
+        static EyerString GetParamsFingerprint(const EyerAVTranscoderParams & params);
+
+        EyerString inputFingerprint;
+        EyerString paramsFingerprint;
+        // 分段计划, 输入和参数都相同时计划也相同, 用来校验已完成的分段是否还能使用
+        EyerString plan;
+        std::vector<int> doneList;
+
+    private:
+        EyerString path;
+    };
+}
+
+#endif //EYERLIB_EYERAVTRANSCODERCHECKPOINT_HPP
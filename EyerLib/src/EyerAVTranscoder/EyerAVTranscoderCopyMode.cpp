@@ -0,0 +1,56 @@
+#include "EyerAVTranscoderCopyMode.hpp"
+
+namespace Eyer
+{
+    EyerAVTranscoderCopyMode EyerAVTranscoderCopyMode::AUTO     (1, "AUTO");
+    EyerAVTranscoderCopyMode EyerAVTranscoderCopyMode::COPY     (2, "COPY");
+    EyerAVTranscoderCopyMode EyerAVTranscoderCopyMode::ENCODE   (3, "ENCODE");
+
+    EyerAVTranscoderCopyMode::EyerAVTranscoderCopyMode()
+    {
+
+    }
+
+    EyerAVTranscoderCopyMode::EyerAVTranscoderCopyMode(int _id, const EyerString & _name)
+        : id(_id)
+        , name(_name)
+    {
+    }
+
+    EyerAVTranscoderCopyMode::~EyerAVTranscoderCopyMode()
+    {
+
+    }
+
+    EyerAVTranscoderCopyMode::EyerAVTranscoderCopyMode(const EyerAVTranscoderCopyMode & mode)
+    {
+        *this = mode;
+    }
+
+    EyerAVTranscoderCopyMode & EyerAVTranscoderCopyMode::operator = (const EyerAVTranscoderCopyMode & mode)
+    {
+        id = mode.id;
+        name = mode.name;
+        return *this;
+    }
+
+    bool EyerAVTranscoderCopyMode::operator == (const EyerAVTranscoderCopyMode & mode) const
+    {
+        return id == mode.id;
+    }
+
+    bool EyerAVTranscoderCopyMode::operator != (const EyerAVTranscoderCopyMode & mode) const
+    {
+        return id != mode.id;
+    }
+
+    const EyerString & EyerAVTranscoderCopyMode::GetName() const
+    {
+        return name;
+    }
+
+    int EyerAVTranscoderCopyMode::GetId() const
+    {
+        return id;
+    }
+}
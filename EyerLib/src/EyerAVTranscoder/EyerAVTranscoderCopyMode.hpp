@@ -0,0 +1,37 @@
+#ifndef EYERLIB_EYERAVTRANSCODERCOPYMODE_HPP
+#define EYERLIB_EYERAVTRANSCODERCOPYMODE_HPP
+
+#include "EyerCore/EyerCore.hpp"
+
+namespace Eyer
+{
+    class EyerAVTranscoderCopyMode
+    {
+    public:
+        // 源编码与目标一致且不需要缩放/重采样时直接复制数据包
+        static EyerAVTranscoderCopyMode AUTO;
+        // 总是复制数据包, 忽略目标编码参数
+        static EyerAVTranscoderCopyMode COPY;
+        // 总是解码再编码
+        static EyerAVTranscoderCopyMode ENCODE;
+
+        EyerAVTranscoderCopyMode();
+        EyerAVTranscoderCopyMode(int _id, const EyerString & _name);
+        ~EyerAVTranscoderCopyMode();
+
+        EyerAVTranscoderCopyMode(const EyerAVTranscoderCopyMode & mode);
+        EyerAVTranscoderCopyMode & operator = (const EyerAVTranscoderCopyMode & mode);
+
+        bool operator == (const EyerAVTranscoderCopyMode & mode) const;
+        bool operator != (const EyerAVTranscoderCopyMode & mode) const;
+
+        const EyerString & GetName() const;
+        int GetId() const;
+
+    private:
+        int id;
+        EyerString name;
+    };
+}
+
+#endif //EYERLIB_EYERAVTRANSCODERCOPYMODE_HPP
@@ -7,6 +7,11 @@ namespace Eyer
     EyerAVTranscoderError EyerAVTranscoderError::OPEN_WRITE_HEAD_FAIL       (-3, "OPEN_WRITE_HEAD_FAIL");
     EyerAVTranscoderError EyerAVTranscoderError::INTERRUPT_FAIL             (-4, "INTERRUPT_FAIL");
     EyerAVTranscoderError EyerAVTranscoderError::INIT_ENCODER_FAIL          (-5, "INIT_ENCODER_FAIL");
+    EyerAVTranscoderError EyerAVTranscoderError::SEGMENT_FAIL               (-6, "SEGMENT_FAIL");
+    EyerAVTranscoderError EyerAVTranscoderError::SMART_CUT_FAIL             (-7, "SMART_CUT_FAIL");
+    EyerAVTranscoderError EyerAVTranscoderError::LADDER_FAIL                (-8, "LADDER_FAIL");
+    EyerAVTranscoderError EyerAVTranscoderError::TRANSCODE_FAIL             (-9, "TRANSCODE_FAIL");
+    EyerAVTranscoderError EyerAVTranscoderError::WRITE_FAIL                 (-10, "WRITE_FAIL");
 
     EyerAVTranscoderError::EyerAVTranscoderError()
     {
@@ -13,6 +13,11 @@ namespace Eyer
         static EyerAVTranscoderError OPEN_WRITE_HEAD_FAIL;
         static EyerAVTranscoderError INTERRUPT_FAIL;
         static EyerAVTranscoderError INIT_ENCODER_FAIL;
+        static EyerAVTranscoderError SEGMENT_FAIL;
+        static EyerAVTranscoderError SMART_CUT_FAIL;
+        static EyerAVTranscoderError LADDER_FAIL;
+        static EyerAVTranscoderError TRANSCODE_FAIL;
+        static EyerAVTranscoderError WRITE_FAIL;
 
         EyerAVTranscoderError();
         EyerAVTranscoderError(const EyerAVTranscoderError & error);
@@ -7,5 +7,11 @@
 #include "EyerAVTranscoderSupport.hpp"
 #include "EyerAVTranscoderStatus.hpp"
 #include "EyerAVTranscoderError.hpp"
+#include "EyerAVTranscoderCopyMode.hpp"
+#include "EyerAVTranscoderMovMode.hpp"
+#include "EyerAVTranscodeQueue.hpp"
+#include "EyerAVTranscodeProfile.hpp"
+#include "EyerAVTranscodeProgress.hpp"
+#include "EyerAVTranscoderCheckpoint.hpp"
 
 #endif //EYERLIB_EYERAVTRANSCODERHEADER_HPP
@@ -0,0 +1,701 @@
+#include "EyerAVTranscoderLadder.hpp"
+
+#include <algorithm>
+
+#include "EyerAVTranscoder.hpp"
+
+namespace Eyer
+{
+    class EyerAVTranscoderLadderEncodeThread : public EyerThread
+    {
+    public:
+        EyerAVTranscoderLadderEncodeThread(EyerAVTranscoderLadder * _ladder, EyerAVTranscoderLadderRendition * _rendition)
+        {
+            ladder = _ladder;
+            rendition = _rendition;
+        }
+
+        virtual void Run() override
+        {
+            ladder->EncodeLoop(rendition);
+        }
+
+    private:
+        EyerAVTranscoderLadder * ladder = nullptr;
+        EyerAVTranscoderLadderRendition * rendition = nullptr;
+    };
+
+
+
+    EyerAVTranscoderLadderRendition::EyerAVTranscoderLadderRendition(int queueSize)
+        : queue(queueSize)
+    {
+
+    }
+
+    EyerAVTranscoderLadderRendition::~EyerAVTranscoderLadderRendition()
+    {
+        for(int i = 0; i < transcodeStream.size(); i++){
+            EyerAVTranscodeStream * ts = transcodeStream[i];
+            if(ts->encoder != nullptr){
+                delete ts->encoder;
+                ts->encoder = nullptr;
+            }
+            if(ts->resample != nullptr){
+                delete ts->resample;
+                ts->resample = nullptr;
+            }
+            delete ts;
+        }
+        transcodeStream.clear();
+
+        if(writer != nullptr){
+            delete writer;
+            writer = nullptr;
+        }
+        if(transcoder != nullptr){
+            delete transcoder;
+            transcoder = nullptr;
+        }
+    }
+
+
+
+    EyerAVTranscoderLadder::EyerAVTranscoderLadder(EyerAVTranscoder * _transcoder, EyerAVTranscoderInterrupt * _interrupt, EyerAVReaderCustomIO * _customIO)
+    {
+        transcoder = _transcoder;
+        interrupt = _interrupt;
+        customIO = _customIO;
+    }
+
+    EyerAVTranscoderLadder::~EyerAVTranscoderLadder()
+    {
+        Release();
+    }
+
+    int EyerAVTranscoderLadder::Run()
+    {
+        EyerAVTranscoderParams & params = transcoder->params;
+
+        EyerAVReader reader(transcoder->inputPath, customIO);
+        int ret = reader.Open();
+        if(ret){
+            transcoder->errorDesc = "打开视频文件失败";
+            return -1;
+        }
+        transcoder->duration = reader.GetDuration();
+
+        int streamCount = reader.GetStreamCount();
+        decoderList.resize(streamCount, nullptr);
+        usefulList.resize(streamCount, 0);
+        rangeEndList.resize(streamCount, 0);
+        {
+            std::lock_guard<std::mutex> lg(transcoder->profileMut);
+            transcoder->profile.Reset(streamCount);
+            for(int i = 0; i < streamCount; i++){
+                transcoder->profile.streamList[i].mediaType = reader.GetStream(i).GetType().GetName();
+            }
+        }
+
+        for(int i = 0; i < transcoder->renditionPathList.size(); i++){
+            ret = InitRendition(reader, i);
+            if(ret){
+                reader.Close();
+                Release();
+                return -1;
+            }
+        }
+
+        // 所有输出都不用的流在解封装时丢弃
+        for(int i = 0; i < streamCount; i++){
+            if(!usefulList[i]){
+                reader.SetStreamDiscard(i, true);
+            }
+        }
+
+        PlanCascade();
+
+        std::vector<EyerThread *> encodeThreads;
+        for(int i = 0; i < renditionList.size(); i++){
+            EyerThread * thread = new EyerAVTranscoderLadderEncodeThread(this, renditionList[i]);
+            thread->Start();
+            encodeThreads.push_back(thread);
+        }
+
+        // demux 和解码在当前线程执行
+        DemuxLoop(reader);
+
+        // 编码线程在输入队列结束后退出, 级联的下一级在上一级退出后结束
+        for(int i = 0; i < encodeThreads.size(); i++){
+            encodeThreads[i]->Stop();
+            delete encodeThreads[i];
+        }
+        encodeThreads.clear();
+
+        reader.Close();
+
+        for(int i = 0; i < renditionList.size(); i++){
+            EyerAVTranscoderLadderRendition * rendition = renditionList[i];
+
+            long long startTime = Eyer::EyerTime::GetTimeNano();
+            // 异步写入时封装线程中的错误也由 WriteTrailer 返回
+            ret = rendition->writer->WriteTrailer();
+            rendition->writer->Close();
+            long long endTime = Eyer::EyerTime::GetTimeNano();
+            if(ret){
+                SetError(rendition, "写入文件尾失败");
+            }
+
+            EyerAVTranscodeProfile renditionProfile;
+            {
+                std::lock_guard<std::mutex> lg(rendition->transcoder->profileMut);
+                rendition->transcoder->profile.trailerTime += (endTime - startTime);
+                rendition->transcoder->profile.asyncWriteTime += rendition->writer->GetAsyncWriteTime();
+                renditionProfile = rendition->transcoder->profile;
+            }
+            // 解码只统计一次, 各路的缩放, 编码和写入累加到一起
+            std::lock_guard<std::mutex> lg(transcoder->profileMut);
+            transcoder->profile.Merge(renditionProfile);
+        }
+
+        if(isError){
+            transcoder->errorDesc = errorDesc;
+            Release();
+            return -1;
+        }
+
+        if(!isInterrupt){
+            double rangeDuration = transcoder->duration - params.GetStartTime();
+            if(params.GetEndTime() != 0.0 && params.GetEndTime() < transcoder->duration){
+                rangeDuration = params.GetEndTime() - params.GetStartTime();
+            }
+            int64_t bytesWritten = 0;
+            {
+                std::lock_guard<std::mutex> lg(transcoder->profileMut);
+                for(int i = 0; i < transcoder->profile.streamList.size(); i++){
+                    bytesWritten += transcoder->profile.streamList[i].bytesOut;
+                }
+            }
+            transcoder->NotifyProgress(1.0, rangeDuration, decodeVideoFrameNum, bytesWritten);
+        }
+
+        Release();
+        return 0;
+    }
+
+    bool EyerAVTranscoderLadder::IsInterrupt()
+    {
+        return isInterrupt;
+    }
+
+    int EyerAVTranscoderLadder::InitRendition(EyerAVReader & reader, int index)
+    {
+        const EyerAVTranscoderParams & mainParams = transcoder->params;
+        const EyerString & outputPath = transcoder->renditionPathList[index];
+
+        // 范围和处理哪些流由主参数决定, 各路保持一致
+        EyerAVTranscoderParams params = transcoder->renditionParamsList[index];
+        params.SetStartTime(mainParams.GetStartTime());
+        params.SetEndTime(mainParams.GetEndTime());
+        params.SetCareAudio(mainParams.GetCareAudio());
+        params.SetCareVideo(mainParams.GetCareVideo());
+        params.SetSegmentNum(1);
+        params.SetResumable(false);
+        params.SetSmartCut(false);
+        params.SetPipeline(false);
+
+        EyerAVTranscoderLadderRendition * rendition = new EyerAVTranscoderLadderRendition(mainParams.GetPipelineQueueSize());
+        renditionList.push_back(rendition);
+        rendition->index = index;
+
+        int streamCount = reader.GetStreamCount();
+        double duration = transcoder->duration;
+
+        rendition->transcoder = new EyerAVTranscoder(transcoder->inputPath);
+        rendition->transcoder->SetOutputPath(outputPath);
+        rendition->transcoder->SetParams(params);
+        rendition->transcoder->duration = duration;
+        {
+            std::lock_guard<std::mutex> lg(rendition->transcoder->profileMut);
+            rendition->transcoder->profile.Reset(streamCount);
+        }
+
+        double rangeEnd = duration;
+        if(params.GetEndTime() != 0.0 && params.GetEndTime() < duration){
+            rangeEnd = params.GetEndTime();
+        }
+
+        rendition->writer = new EyerAVWriter(outputPath);
+        int ret = rendition->transcoder->InitWriter(rendition->writer, rendition->transcoder->EstimateOutputSize(rangeEnd - params.GetStartTime()));
+        if(ret){
+            transcoder->errorDesc = rendition->transcoder->errorDesc;
+            return -1;
+        }
+        ret = rendition->writer->Open();
+        if(ret){
+            EyerLog("Ladder open output fail: %s\n", outputPath.c_str());
+            transcoder->errorDesc = "输出路径不存在或不可写";
+            return -1;
+        }
+
+        for(int i = 0; i < streamCount; i++){
+            EyerAVStream stream = reader.GetStream(i);
+
+            EyerAVTranscodeStream * ts = new EyerAVTranscodeStream();
+            rendition->transcodeStream.push_back(ts);
+
+            if((stream.GetType() == EyerAVMediaType::MEDIA_TYPE_AUDIO && !params.GetCareAudio()) ||
+               (stream.GetType() == EyerAVMediaType::MEDIA_TYPE_VIDEO && !params.GetCareVideo())){
+                continue;
+            }
+
+            ts->readStreamId = stream.GetStreamId();
+            ts->mediaType = stream.GetType();
+
+            if(rendition->transcoder->IsStreamCopy(stream)){
+                ts->writeStreamId = rendition->writer->AddStream(stream);
+                if(ts->writeStreamId < 0){
+                    EyerLog("Ladder add copy stream error, stream id: %d\n", stream.GetStreamId());
+                    continue;
+                }
+                ts->isCopy = 1;
+                ts->readTimebase = stream.GetTimebase();
+                usefulList[i] = 1;
+                continue;
+            }
+
+            // 解码器所有输出共用, 第一次用到这路流时创建
+            if(decoderList[i] == nullptr){
+                EyerAVDecoder * decoder = new EyerAVDecoder();
+                ret = decoder->Init(stream, mainParams.GetDecodeThreadNum());
+                if(ret){
+                    EyerLog("Ladder init decoder error, stream id: %d\n", stream.GetStreamId());
+                    delete decoder;
+                    continue;
+                }
+                decoderList[i] = decoder;
+            }
+            ts->scaler.SetQuality(params.GetScaleQuality());
+
+            EyerAVEncoder * encoder = new EyerAVEncoder();
+            ret = rendition->transcoder->InitEncoder(encoder, stream);
+            if(ret){
+                EyerLog("Ladder init encoder error, output: %s, stream id: %d\n", outputPath.c_str(), stream.GetStreamId());
+                delete encoder;
+                transcoder->errorDesc = rendition->transcoder->errorDesc;
+                if(transcoder->errorDesc == ""){
+                    transcoder->errorDesc = "初始化编码器失败";
+                }
+                return -1;
+            }
+            ts->encoder = encoder;
+            ts->writeStreamId = rendition->writer->AddStream(*encoder);
+            ret = rendition->transcoder->InitResample(ts, stream);
+            if(ret){
+                EyerLog("Ladder init resample error, output: %s, stream id: %d\n", outputPath.c_str(), stream.GetStreamId());
+                transcoder->errorDesc = rendition->transcoder->errorDesc;
+                return -1;
+            }
+
+            if(stream.GetType() == EyerAVMediaType::MEDIA_TYPE_VIDEO){
+                rendition->videoStreamIndex = i;
+            }
+            usefulList[i] = 1;
+        }
+
+        {
+            std::lock_guard<std::mutex> lg(rendition->transcoder->profileMut);
+            for(int i = 0; i < streamCount; i++){
+                EyerAVTranscodeStream * ts = rendition->transcodeStream[i];
+                rendition->transcoder->profile.streamList[i].mediaType = reader.GetStream(i).GetType().GetName();
+                rendition->transcoder->profile.streamList[i].writeStreamId = ts->writeStreamId;
+                rendition->transcoder->profile.streamList[i].isCopy = ts->isCopy;
+            }
+        }
+
+        ret = rendition->writer->WriteHand();
+        if(ret){
+            EyerLog("Ladder write head fail: %s\n", outputPath.c_str());
+            transcoder->errorDesc = "写入视频头失败";
+            return -1;
+        }
+
+        return 0;
+    }
+
+    int EyerAVTranscoderLadder::PlanCascade()
+    {
+        // 只有指定了宽高并且编码视频的输出参与级联, 按面积从大到小排列
+        std::vector<EyerAVTranscoderLadderRendition *> scaleList;
+        for(int i = 0; i < renditionList.size(); i++){
+            EyerAVTranscoderLadderRendition * rendition = renditionList[i];
+            if(rendition->videoStreamIndex < 0){
+                continue;
+            }
+            const EyerAVTranscoderParams & params = rendition->transcoder->params;
+            if(params.GetWidth() <= 0 || params.GetHeight() <= 0){
+                continue;
+            }
+            scaleList.push_back(rendition);
+        }
+        std::stable_sort(scaleList.begin(), scaleList.end(), [](EyerAVTranscoderLadderRendition * a, EyerAVTranscoderLadderRendition * b){
+            const EyerAVTranscoderParams & pa = a->transcoder->params;
+            const EyerAVTranscoderParams & pb = b->transcoder->params;
+            return (int64_t)pa.GetWidth() * pa.GetHeight() > (int64_t)pb.GetWidth() * pb.GetHeight();
+        });
+
+        for(int i = 0; i < scaleList.size(); i++){
+            EyerAVTranscoderLadderRendition * target = scaleList[i];
+            const EyerAVTranscoderParams & targetParams = target->transcoder->params;
+
+            // 从后往前找, 第一个宽高都不小于目标的就是最小的可用上一级
+            for(int j = i - 1; j >= 0; j--){
+                EyerAVTranscoderLadderRendition * source = scaleList[j];
+                const EyerAVTranscoderParams & sourceParams = source->transcoder->params;
+                if(sourceParams.GetWidth() < targetParams.GetWidth() || sourceParams.GetHeight() < targetParams.GetHeight()){
+                    continue;
+                }
+                // 上一级转换过像素格式时, 只有目标格式相同才级联, 避免位深或色度采样损失
+                if(sourceParams.GetVideoPixelFormat() != EyerAVPixelFormat::EYER_KEEP_SAME && sourceParams.GetVideoPixelFormat() != targetParams.GetVideoPixelFormat()){
+                    continue;
+                }
+                target->source = source;
+                target->producerNum++;
+                source->targetList.push_back(target);
+                EyerLog("Ladder cascade scale: %dx%d -> %dx%d\n", sourceParams.GetWidth(), sourceParams.GetHeight(), targetParams.GetWidth(), targetParams.GetHeight());
+                break;
+            }
+        }
+        return 0;
+    }
+
+    int EyerAVTranscoderLadder::DemuxLoop(EyerAVReader & reader)
+    {
+        const EyerAVTranscoderParams & params = transcoder->params;
+
+        if(params.GetStartTime() != 0.0){
+            reader.Seek(params.GetStartTime());
+        }
+
+        bool isRangeEnd = false;
+        EyerAVFrame frame;
+        EyerAVPacket packet;
+        while(!isRangeEnd && !isError){
+            EyerAVTranscodeStageTimer demuxTimer;
+            demuxTimer.Start();
+            int ret = reader.Read(packet);
+            demuxTimer.Stop();
+            if(ret){
+                break;
+            }
+
+            int streamIndex = packet.GetStreamIndex();
+            if(streamIndex < 0 || streamIndex >= decoderList.size()){
+                continue;
+            }
+            transcoder->AddProfile(streamIndex, STAGE_DEMUX, demuxTimer, 1, packet.GetSize());
+
+            // 流复制的输出各自拿一份引用, 在编码线程中处理起止时间和时间戳
+            for(int i = 0; i < renditionList.size(); i++){
+                EyerAVTranscoderLadderRendition * rendition = renditionList[i];
+                if(!rendition->transcodeStream[streamIndex]->isCopy){
+                    continue;
+                }
+                EyerAVPacket * copyPacket = packetPool.NewPacket();
+                *copyPacket = packet;
+                PushItem(rendition, streamIndex, nullptr, copyPacket);
+            }
+
+            EyerAVDecoder * decoder = decoderList[streamIndex];
+            if(decoder == nullptr){
+                if((params.GetEndTime() != 0.0) && (packet.GetSecPTS() > params.GetEndTime()) && usefulList[streamIndex]){
+                    isRangeEnd = MarkRangeEnd(streamIndex);
+                }
+            }
+            else {
+                EyerAVTranscodeStageTimer decodeTimer;
+                int decodeFrameNum = 0;
+                decodeTimer.Start();
+                decoder->SendPacket(packet);
+                decodeTimer.Stop();
+                while(1){
+                    decodeTimer.Start();
+                    ret = decoder->RecvFrame(frame);
+                    decodeTimer.Stop();
+                    if(ret){
+                        break;
+                    }
+                    decodeFrameNum++;
+
+                    //range处理
+                    if((params.GetStartTime() != 0.0) && (frame.GetSecPTS() < params.GetStartTime())){
+                        continue;
+                    }
+                    if((params.GetEndTime() != 0.0) && (frame.GetSecPTS() > params.GetEndTime())){
+                        if(MarkRangeEnd(streamIndex)){
+                            isRangeEnd = true;
+                            break;
+                        }
+                        continue;
+                    }
+
+                    DispatchFrame(streamIndex, frame);
+                    UpdateProgress(frame.GetSecPTS());
+                }
+                transcoder->AddProfile(streamIndex, STAGE_DECODE, decodeTimer, decodeFrameNum);
+            }
+
+            if(interrupt != nullptr){
+                if(interrupt->interrupt()){
+                    isInterrupt = true;
+                    break;
+                }
+            }
+        }
+
+        // Clear Decoder
+        if(!isInterrupt && !isError){
+            for(int i = 0; i < decoderList.size(); i++){
+                EyerAVDecoder * decoder = decoderList[i];
+                if(decoder == nullptr){
+                    continue;
+                }
+                EyerAVTranscodeStageTimer decodeTimer;
+                int decodeFrameNum = 0;
+                decodeTimer.Start();
+                decoder->SendPacketNull();
+                decodeTimer.Stop();
+                while(1){
+                    decodeTimer.Start();
+                    int ret = decoder->RecvFrame(frame);
+                    decodeTimer.Stop();
+                    if(ret){
+                        break;
+                    }
+                    decodeFrameNum++;
+                    if((params.GetEndTime() != 0.0) && (frame.GetSecPTS() > params.GetEndTime())){
+                        break;
+                    }
+                    DispatchFrame(i, frame);
+                }
+                transcoder->AddProfile(i, STAGE_DECODE, decodeTimer, decodeFrameNum);
+            }
+        }
+
+        for(int i = 0; i < renditionList.size(); i++){
+            FinishQueue(renditionList[i]);
+        }
+        return 0;
+    }
+
+    int EyerAVTranscoderLadder::DispatchFrame(int streamIndex, EyerAVFrame & frame)
+    {
+        bool isVideo = false;
+        for(int i = 0; i < renditionList.size(); i++){
+            EyerAVTranscoderLadderRendition * rendition = renditionList[i];
+            EyerAVTranscodeStream * ts = rendition->transcodeStream[streamIndex];
+            if(ts->encoder == nullptr){
+                continue;
+            }
+            if(ts->mediaType == EyerAVMediaType::MEDIA_TYPE_VIDEO){
+                isVideo = true;
+                // 级联的输出从上一级取缩放后的帧
+                if(rendition->source != nullptr){
+                    continue;
+                }
+            }
+            // 各路共享解码帧的数据, 编码线程只修改自己这份的时间戳
+            EyerAVFrame * dispatchFrame = framePool.NewFrame();
+            *dispatchFrame = frame;
+            PushItem(rendition, streamIndex, dispatchFrame, nullptr);
+        }
+        if(isVideo){
+            decodeVideoFrameNum++;
+        }
+        return 0;
+    }
+
+    int EyerAVTranscoderLadder::PushItem(EyerAVTranscoderLadderRendition * rendition, int streamIndex, EyerAVFrame * frame, EyerAVPacket * packet)
+    {
+        EyerAVTranscoderLadderItem * item = new EyerAVTranscoderLadderItem();
+        item->streamIndex = streamIndex;
+        item->frame = frame;
+        item->packet = packet;
+        int ret = rendition->queue.Push(item);
+        if(ret){
+            DeleteItem(item);
+        }
+        return ret;
+    }
+
+    int EyerAVTranscoderLadder::DeleteItem(EyerAVTranscoderLadderItem * item)
+    {
+        if(item->frame != nullptr){
+            framePool.DeleteFrame(item->frame);
+            item->frame = nullptr;
+        }
+        if(item->packet != nullptr){
+            packetPool.DeletePacket(item->packet);
+            item->packet = nullptr;
+        }
+        delete item;
+        return 0;
+    }
+
+    int EyerAVTranscoderLadder::FinishQueue(EyerAVTranscoderLadderRendition * rendition)
+    {
+        if(--rendition->producerNum <= 0){
+            rendition->queue.SetFinish();
+        }
+        return 0;
+    }
+
+    int EyerAVTranscoderLadder::EncodeLoop(EyerAVTranscoderLadderRendition * rendition)
+    {
+        EyerAVTranscoder * renditionTranscoder = rendition->transcoder;
+        EyerAVWriter * writer = rendition->writer;
+
+        EyerAVFrame scaledFrame;
+        while(1){
+            EyerAVTranscoderLadderItem * item = nullptr;
+            int ret = rendition->queue.Pop(&item);
+            if(ret){
+                break;
+            }
+
+            // 取消或者出错后只取出并丢弃, 让上游尽快结束
+            if(isInterrupt || isError){
+                DeleteItem(item);
+                continue;
+            }
+
+            EyerAVTranscodeStream * ts = rendition->transcodeStream[item->streamIndex];
+            if(item->packet != nullptr){
+                ret = renditionTranscoder->PrepareCopyPacket(writer, ts, *item->packet);
+                if(ret == 0){
+                    if(renditionTranscoder->WritePacket(writer, item->streamIndex, *item->packet)){
+                        SetError(rendition, "写入数据包失败");
+                    }
+                }
+            }
+            else if(item->frame != nullptr){
+                bool isForward = rendition->targetList.size() > 0 && item->streamIndex == rendition->videoStreamIndex;
+                ret = renditionTranscoder->EncodeFrame(writer, ts, *item->frame, isForward ? &scaledFrame : nullptr);
+                if(ret){
+                    SetError(rendition, renditionTranscoder->isWriteFail ? "写入数据包失败" : "编码失败");
+                }
+                else if(isForward){
+                    for(int i = 0; i < rendition->targetList.size(); i++){
+                        EyerAVFrame * forwardFrame = framePool.NewFrame();
+                        *forwardFrame = scaledFrame;
+                        PushItem(rendition->targetList[i], item->streamIndex, forwardFrame, nullptr);
+                    }
+                }
+            }
+            DeleteItem(item);
+        }
+
+        // Clear Encode, 与普通流程一致, 取消或者出错时不再刷新编码器
+        if(!isInterrupt && !isError){
+            for(int i = 0; i < rendition->transcodeStream.size(); i++){
+                EyerAVTranscodeStream * ts = rendition->transcodeStream[i];
+                if(ts->encoder != nullptr){
+                    if(renditionTranscoder->ClearFrame(writer, ts)){
+                        SetError(rendition, "写入数据包失败");
+                        break;
+                    }
+                }
+            }
+        }
+
+        for(int i = 0; i < rendition->targetList.size(); i++){
+            FinishQueue(rendition->targetList[i]);
+        }
+        return 0;
+    }
+
+    bool EyerAVTranscoderLadder::MarkRangeEnd(int streamIndex)
+    {
+        rangeEndList[streamIndex] = 1;
+        for(int i = 0; i < usefulList.size(); i++){
+            if(usefulList[i] && !rangeEndList[i]){
+                return false;
+            }
+        }
+        return true;
+    }
+
+    int EyerAVTranscoderLadder::UpdateProgress(double currentSecPTS)
+    {
+        if(transcoder->listener == nullptr){
+            return 0;
+        }
+        if(!transcoder->IsProgressDue()){
+            return 0;
+        }
+
+        const EyerAVTranscoderParams & params = transcoder->params;
+        double rangeDuration = transcoder->duration - params.GetStartTime();
+        if(params.GetEndTime() != 0.0){
+            rangeDuration = params.GetEndTime() - params.GetStartTime();
+        }
+
+        double mediaTime = currentSecPTS - params.GetStartTime();
+        if(mediaTime < 0.0){
+            mediaTime = 0.0;
+        }
+
+        float progress = 0.0;
+        if(rangeDuration > 0){
+            progress = mediaTime / rangeDuration;
+        }
+        if(progress >= 1.0){
+            progress = 1.0;
+        }
+
+        // 帧数按解码的视频帧计, 字节数是各路输出之和
+        int64_t bytesWritten = 0;
+        for(int i = 0; i < renditionList.size(); i++){
+            EyerAVTranscodeProfile renditionProfile = renditionList[i]->transcoder->GetProfile();
+            for(int j = 0; j < renditionProfile.streamList.size(); j++){
+                bytesWritten += renditionProfile.streamList[j].bytesOut;
+            }
+        }
+
+        return transcoder->NotifyProgress(progress, mediaTime, decodeVideoFrameNum, bytesWritten);
+    }
+
+    int EyerAVTranscoderLadder::SetError(EyerAVTranscoderLadderRendition * rendition, const EyerString & desc)
+    {
+        std::lock_guard<std::mutex> lg(errorMut);
+        if(isError){
+            return 0;
+        }
+        EyerLog("Ladder output fail: %s, %s\n", rendition->transcoder->outputPath.c_str(), desc.c_str());
+        errorDesc = desc + ": " + rendition->transcoder->outputPath;
+        isError = true;
+        return 0;
+    }
+
+    int EyerAVTranscoderLadder::Release()
+    {
+        for(int i = 0; i < renditionList.size(); i++){
+            EyerAVTranscoderLadderRendition * rendition = renditionList[i];
+            EyerAVTranscoderLadderItem * item = nullptr;
+            while(rendition->queue.TryPop(&item) == 0){
+                DeleteItem(item);
+            }
+            delete rendition;
+        }
+        renditionList.clear();
+
+        for(int i = 0; i < decoderList.size(); i++){
+            if(decoderList[i] != nullptr){
+                delete decoderList[i];
+                decoderList[i] = nullptr;
+            }
+        }
+        decoderList.clear();
+        return 0;
+    }
+}
@@ -0,0 +1,105 @@
+#ifndef EYERLIB_EYERAVTRANSCODERLADDER_HPP
+#define EYERLIB_EYERAVTRANSCODERLADDER_HPP
+
+#include <vector>
+#include <atomic>
+#include <mutex>
+
+#include "EyerCore/EyerCore.hpp"
+#include "EyerThread/EyerThreadHeader.hpp"
+#include "EyerAV/EyerAVHeader.hpp"
+#include "EyerAVTranscodeStream.hpp"
+
+namespace Eyer
+{
+    class EyerAVTranscoder;
+    class EyerAVTranscoderInterrupt;
+
+    // 分发给各路输出的数据, 需要编码的流是解码帧, 流复制的是数据包
+    class EyerAVTranscoderLadderItem
+    {
+    public:
+        int streamIndex = -1;
+        EyerAVFrame * frame = nullptr;
+        EyerAVPacket * packet = nullptr;
+    };
+
+    class EyerAVTranscoderLadderRendition
+    {
+    public:
+        EyerAVTranscoderLadderRendition(int queueSize);
+        ~EyerAVTranscoderLadderRendition();
+
+        int index = 0;
+
+        // 只用来保存这一路的参数, 复用它的编码和写入逻辑, 不会调用它的 Transcode
+        EyerAVTranscoder * transcoder = nullptr;
+        EyerAVWriter * writer = nullptr;
+        // 按输入流序号, decoder 由所有输出共用, 不放在这里
+        std::vector<EyerAVTranscodeStream *> transcodeStream;
+        int videoStreamIndex = -1;
+
+        // 级联缩放: 视频帧来自 source 缩放后的结果, 为空时来自解码器
+        EyerAVTranscoderLadderRendition * source = nullptr;
+        std::vector<EyerAVTranscoderLadderRendition *> targetList;
+
+        EyerBoundedQueue<EyerAVTranscoderLadderItem> queue;
+        // 向 queue 写入的生产者数: demux 线程, 加上级联时的 source, 全部结束后才结束 queue
+        std::atomic_int producerNum {1};
+    };
+
+    // 多码率输出:
+    // 1. 一个 EyerAVReader, 每路流一个解码器, demux 和解码在调用线程, 解码帧共享数据分发给各路输出
+    // 2. 每路输出一个编码线程, 有自己的缩放, 重采样, 编码器和 EyerAVWriter, 各路并行编码
+    // 3. 按输出分辨率从大到小排列, 指定了宽高的输出从不小于它的最小一级的缩放结果再缩放, 比从原始分辨率缩放代价小
+    class EyerAVTranscoderLadder
+    {
+    public:
+        EyerAVTranscoderLadder(EyerAVTranscoder * transcoder, EyerAVTranscoderInterrupt * interrupt, EyerAVReaderCustomIO * customIO);
+        ~EyerAVTranscoderLadder();
+
+        // 返回 0 成功 (包括被取消), -1 失败, 任意一路编码或写入失败都算失败, errorDesc 中带出失败的输出路径
+        int Run();
+
+        bool IsInterrupt();
+
+        int EncodeLoop(EyerAVTranscoderLadderRendition * rendition);
+
+    private:
+        int InitRendition(EyerAVReader & reader, int index);
+        int PlanCascade();
+        int DemuxLoop(EyerAVReader & reader);
+        int DispatchFrame(int streamIndex, EyerAVFrame & frame);
+        int PushItem(EyerAVTranscoderLadderRendition * rendition, int streamIndex, EyerAVFrame * frame, EyerAVPacket * packet);
+        int DeleteItem(EyerAVTranscoderLadderItem * item);
+        int FinishQueue(EyerAVTranscoderLadderRendition * rendition);
+        // 所有用到的流都超出结束时间时返回 true
+        bool MarkRangeEnd(int streamIndex);
+        int UpdateProgress(double currentSecPTS);
+        // 记录第一个出错的输出, 之后各路只取出并丢弃数据, demux 尽快结束
+        int SetError(EyerAVTranscoderLadderRendition * rendition, const EyerString & desc);
+        int Release();
+
+        EyerAVTranscoder * transcoder = nullptr;
+        EyerAVTranscoderInterrupt * interrupt = nullptr;
+        EyerAVReaderCustomIO * customIO = nullptr;
+
+        std::vector<EyerAVTranscoderLadderRendition *> renditionList;
+
+        // 以下按输入流序号
+        std::vector<EyerAVDecoder *> decoderList;
+        std::vector<int> usefulList;
+        std::vector<int> rangeEndList;
+
+        std::atomic_bool isInterrupt {false};
+        std::atomic_bool isError {false};
+        std::mutex errorMut;
+        EyerString errorDesc;
+        int64_t decodeVideoFrameNum = 0;
+
+        EyerAVFramePool framePool;
+        EyerAVPacketPool packetPool;
+    };
+}
+
+#endif //EYERLIB_EYERAVTRANSCODERLADDER_HPP
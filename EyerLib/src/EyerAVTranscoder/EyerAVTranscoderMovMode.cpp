@@ -0,0 +1,56 @@
+#include "EyerAVTranscoderMovMode.hpp"
+
+namespace Eyer
+{
+    EyerAVTranscoderMovMode EyerAVTranscoderMovMode::NORMAL       (1, "NORMAL");
+    EyerAVTranscoderMovMode EyerAVTranscoderMovMode::FASTSTART    (2, "FASTSTART");
+    EyerAVTranscoderMovMode EyerAVTranscoderMovMode::FRAGMENT     (3, "FRAGMENT");
+
+    EyerAVTranscoderMovMode::EyerAVTranscoderMovMode()
+    {
+
+    }
+
+    EyerAVTranscoderMovMode::EyerAVTranscoderMovMode(int _id, const EyerString & _name)
+        : id(_id)
+        , name(_name)
+    {
+    }
+
+    EyerAVTranscoderMovMode::~EyerAVTranscoderMovMode()
+    {
+
+    }
+
+    EyerAVTranscoderMovMode::EyerAVTranscoderMovMode(const EyerAVTranscoderMovMode & mode)
+    {
+        *this = mode;
+    }
+
+    EyerAVTranscoderMovMode & EyerAVTranscoderMovMode::operator = (const EyerAVTranscoderMovMode & mode)
+    {
+        id = mode.id;
+        name = mode.name;
+        return *this;
+    }
+
+    bool EyerAVTranscoderMovMode::operator == (const EyerAVTranscoderMovMode & mode) const
+    {
+        return id == mode.id;
+    }
+
+    bool EyerAVTranscoderMovMode::operator != (const EyerAVTranscoderMovMode & mode) const
+    {
+        return id != mode.id;
+    }
+
+    const EyerString & EyerAVTranscoderMovMode::GetName() const
+    {
+        return name;
+    }
+
+    int EyerAVTranscoderMovMode::GetId() const
+    {
+        return id;
+    }
+}
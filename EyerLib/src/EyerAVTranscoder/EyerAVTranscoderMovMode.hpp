@@ -0,0 +1,38 @@
+#ifndef EYERLIB_EYERAVTRANSCODERMOVMODE_HPP
+#define EYERLIB_EYERAVTRANSCODERMOVMODE_HPP
+
+#include "EyerCore/EyerCore.hpp"
+
+namespace Eyer
+{
+    // MP4/MOV 输出的封装方式, 其他封装格式忽略
+    class EyerAVTranscoderMovMode
+    {
+    public:
+        // moov 写在文件末尾, 读取方需要拿到完整文件才能播放
+        static EyerAVTranscoderMovMode NORMAL;
+        // 写文件尾时把 moov 移到文件开头, 需要把整个文件后移一遍, 输出必须是可以重新打开读取的本地文件
+        static EyerAVTranscoderMovMode FASTSTART;
+        // 分片 MP4: 文件头只有空的 moov, 之后每个分片 (moof + mdat) 写完就可以读取, 转码中断时已写入的分片仍然可用
+        static EyerAVTranscoderMovMode FRAGMENT;
+
+        EyerAVTranscoderMovMode();
+        EyerAVTranscoderMovMode(int _id, const EyerString & _name);
+        ~EyerAVTranscoderMovMode();
+
+        EyerAVTranscoderMovMode(const EyerAVTranscoderMovMode & mode);
+        EyerAVTranscoderMovMode & operator = (const EyerAVTranscoderMovMode & mode);
+
+        bool operator == (const EyerAVTranscoderMovMode & mode) const;
+        bool operator != (const EyerAVTranscoderMovMode & mode) const;
+
+        const EyerString & GetName() const;
+        int GetId() const;
+
+    private:
+        int id;
+        EyerString name;
+    };
+}
+
+#endif //EYERLIB_EYERAVTRANSCODERMOVMODE_HPP
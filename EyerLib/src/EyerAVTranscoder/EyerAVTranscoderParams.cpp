@@ -34,15 +34,52 @@ namespace Eyer
 
         crf = _params.crf;
 
+        preset = _params.preset;
+        tune = _params.tune;
+        rateControl = _params.rateControl;
+        bitrate = _params.bitrate;
+        maxrate = _params.maxrate;
+        bufsize = _params.bufsize;
+        gop = _params.gop;
+        bframes = _params.bframes;
+        proresProfile = _params.proresProfile;
+
         decodeThreadNum = _params.decodeThreadNum;
         encodeThreadNum = _params.encodeThreadNum;
 
         careAudio = _params.careAudio;
         careVideo = _params.careVideo;
+        audioExtract = _params.audioExtract;
 
         startTime = _params.startTime;
         endTime = _params.endTime;
 
+        videoCopyMode = _params.videoCopyMode;
+        audioCopyMode = _params.audioCopyMode;
+
+        pipeline = _params.pipeline;
+        pipelineQueueSize = _params.pipelineQueueSize;
+
+        scaleQuality = _params.scaleQuality;
+
+        segmentNum = _params.segmentNum;
+        segmentWorkerNum = _params.segmentWorkerNum;
+
+        smartCut = _params.smartCut;
+
+        resumable = _params.resumable;
+        resumeSegmentDuration = _params.resumeSegmentDuration;
+
+        asyncWrite = _params.asyncWrite;
+        writeQueueSize = _params.writeQueueSize;
+        writeBufferSize = _params.writeBufferSize;
+        writePreallocate = _params.writePreallocate;
+
+        movMode = _params.movMode;
+        fragmentDuration = _params.fragmentDuration;
+
+        progressInterval = _params.progressInterval;
+
         return *this;
     }
 
@@ -89,6 +126,121 @@ namespace Eyer
         return crf;
     }
 
+    int EyerAVTranscoderParams::SetPreset(const EyerString & _preset)
+    {
+        if(!EyerAVEncoderParam::IsPresetSupport(outputVideoCodec, _preset)){
+            return -1;
+        }
+        preset = _preset;
+        return 0;
+    }
+
+    const EyerString EyerAVTranscoderParams::GetPreset() const
+    {
+        return preset;
+    }
+
+    int EyerAVTranscoderParams::SetTune(const EyerString & _tune)
+    {
+        if(!EyerAVEncoderParam::IsTuneSupport(outputVideoCodec, _tune)){
+            return -1;
+        }
+        tune = _tune;
+        return 0;
+    }
+
+    const EyerString EyerAVTranscoderParams::GetTune() const
+    {
+        return tune;
+    }
+
+    int EyerAVTranscoderParams::SetRateControl(const EyerAVRateControl & _rateControl)
+    {
+        rateControl = _rateControl;
+        return 0;
+    }
+
+    const EyerAVRateControl EyerAVTranscoderParams::GetRateControl() const
+    {
+        return rateControl;
+    }
+
+    int EyerAVTranscoderParams::SetBitrate(int _bitrate)
+    {
+        if(_bitrate <= 0){
+            return -1;
+        }
+        bitrate = _bitrate;
+        return 0;
+    }
+
+    const int EyerAVTranscoderParams::GetBitrate() const
+    {
+        return bitrate;
+    }
+
+    int EyerAVTranscoderParams::SetMaxrateBufsize(int _maxrate, int _bufsize)
+    {
+        if(_maxrate < 0 || _bufsize < 0){
+            return -1;
+        }
+        maxrate = _maxrate;
+        bufsize = _bufsize;
+        return 0;
+    }
+
+    const int EyerAVTranscoderParams::GetMaxrate() const
+    {
+        return maxrate;
+    }
+
+    const int EyerAVTranscoderParams::GetBufsize() const
+    {
+        return bufsize;
+    }
+
+    int EyerAVTranscoderParams::SetGOP(int _gop)
+    {
+        if(_gop < 0){
+            return -1;
+        }
+        gop = _gop;
+        return 0;
+    }
+
+    const int EyerAVTranscoderParams::GetGOP() const
+    {
+        return gop;
+    }
+
+    int EyerAVTranscoderParams::SetBFrames(int _bframes)
+    {
+        if(_bframes < -1 || _bframes > 16){
+            return -1;
+        }
+        bframes = _bframes;
+        return 0;
+    }
+
+    const int EyerAVTranscoderParams::GetBFrames() const
+    {
+        return bframes;
+    }
+
+    int EyerAVTranscoderParams::SetProresProfile(int _profile)
+    {
+        if(_profile < -1 || _profile > 3){
+            return -1;
+        }
+        proresProfile = _profile;
+        return 0;
+    }
+
+    const int EyerAVTranscoderParams::GetProresProfile() const
+    {
+        return proresProfile;
+    }
+
     const EyerAVCodecID EyerAVTranscoderParams::GetAudioCodecId() const
     {
         return outputAudioCodec;
@@ -185,6 +337,17 @@ namespace Eyer
         return careAudio;
     }
 
+    int EyerAVTranscoderParams::SetAudioExtract(bool _audioExtract)
+    {
+        audioExtract = _audioExtract;
+        return 0;
+    }
+
+    const bool EyerAVTranscoderParams::GetAudioExtract() const
+    {
+        return audioExtract;
+    }
+
     int EyerAVTranscoderParams::SetStartTime(double _startTime)
     {
         startTime = _startTime;
@@ -207,6 +370,217 @@ namespace Eyer
         return endTime;
     }
 
+    int EyerAVTranscoderParams::SetVideoCopyMode(const EyerAVTranscoderCopyMode & _copyMode)
+    {
+        videoCopyMode = _copyMode;
+        return 0;
+    }
+
+    const EyerAVTranscoderCopyMode EyerAVTranscoderParams::GetVideoCopyMode() const
+    {
+        return videoCopyMode;
+    }
+
+    int EyerAVTranscoderParams::SetAudioCopyMode(const EyerAVTranscoderCopyMode & _copyMode)
+    {
+        audioCopyMode = _copyMode;
+        return 0;
+    }
+
+    const EyerAVTranscoderCopyMode EyerAVTranscoderParams::GetAudioCopyMode() const
+    {
+        return audioCopyMode;
+    }
+
+    int EyerAVTranscoderParams::SetPipeline(bool _pipeline)
+    {
+        pipeline = _pipeline;
+        return 0;
+    }
+
+    const bool EyerAVTranscoderParams::GetPipeline() const
+    {
+        return pipeline;
+    }
+
+    int EyerAVTranscoderParams::SetPipelineQueueSize(int _queueSize)
+    {
+        if(_queueSize <= 0){
+            return -1;
+        }
+        pipelineQueueSize = _queueSize;
+        return 0;
+    }
+
+    const int EyerAVTranscoderParams::GetPipelineQueueSize() const
+    {
+        return pipelineQueueSize;
+    }
+
+    int EyerAVTranscoderParams::SetScaleQuality(const EyerAVScaleQuality & _scaleQuality)
+    {
+        scaleQuality = _scaleQuality;
+        return 0;
+    }
+
+    const EyerAVScaleQuality EyerAVTranscoderParams::GetScaleQuality() const
+    {
+        return scaleQuality;
+    }
+
+    int EyerAVTranscoderParams::SetSegmentNum(int _segmentNum)
+    {
+        if(_segmentNum <= 0){
+            return -1;
+        }
+        segmentNum = _segmentNum;
+        return 0;
+    }
+
+    const int EyerAVTranscoderParams::GetSegmentNum() const
+    {
+        return segmentNum;
+    }
+
+    int EyerAVTranscoderParams::SetSegmentWorkerNum(int _workerNum)
+    {
+        if(_workerNum <= 0){
+            return -1;
+        }
+        segmentWorkerNum = _workerNum;
+        return 0;
+    }
+
+    const int EyerAVTranscoderParams::GetSegmentWorkerNum() const
+    {
+        return segmentWorkerNum;
+    }
+
+    int EyerAVTranscoderParams::SetSmartCut(bool _smartCut)
+    {
+        smartCut = _smartCut;
+        return 0;
+    }
+
+    const bool EyerAVTranscoderParams::GetSmartCut() const
+    {
+        return smartCut;
+    }
+
+    int EyerAVTranscoderParams::SetResumable(bool _resumable)
+    {
+        resumable = _resumable;
+        return 0;
+    }
+
+    const bool EyerAVTranscoderParams::GetResumable() const
+    {
+        return resumable;
+    }
+
+    int EyerAVTranscoderParams::SetResumeSegmentDuration(double _duration)
+    {
+        if(_duration <= 0.0){
+            return -1;
+        }
+        resumeSegmentDuration = _duration;
+        return 0;
+    }
+
+    const double EyerAVTranscoderParams::GetResumeSegmentDuration() const
+    {
+        return resumeSegmentDuration;
+    }
+
+    int EyerAVTranscoderParams::SetAsyncWrite(bool _asyncWrite)
+    {
+        asyncWrite = _asyncWrite;
+        return 0;
+    }
+
+    const bool EyerAVTranscoderParams::GetAsyncWrite() const
+    {
+        return asyncWrite;
+    }
+
+    int EyerAVTranscoderParams::SetWriteQueueSize(int _queueSize)
+    {
+        if(_queueSize <= 0){
+            return -1;
+        }
+        writeQueueSize = _queueSize;
+        return 0;
+    }
+
+    const int EyerAVTranscoderParams::GetWriteQueueSize() const
+    {
+        return writeQueueSize;
+    }
+
+    int EyerAVTranscoderParams::SetWriteBufferSize(int _bufferSize)
+    {
+        if(_bufferSize < 0){
+            return -1;
+        }
+        writeBufferSize = _bufferSize;
+        return 0;
+    }
+
+    const int EyerAVTranscoderParams::GetWriteBufferSize() const
+    {
+        return writeBufferSize;
+    }
+
+    int EyerAVTranscoderParams::SetWritePreallocate(bool _preallocate)
+    {
+        writePreallocate = _preallocate;
+        return 0;
+    }
+
+    const bool EyerAVTranscoderParams::GetWritePreallocate() const
+    {
+        return writePreallocate;
+    }
+
+    int EyerAVTranscoderParams::SetMovMode(const EyerAVTranscoderMovMode & _movMode)
+    {
+        movMode = _movMode;
+        return 0;
+    }
+
+    const EyerAVTranscoderMovMode EyerAVTranscoderParams::GetMovMode() const
+    {
+        return movMode;
+    }
+
+    int EyerAVTranscoderParams::SetFragmentDuration(int _duration)
+    {
+        if(_duration <= 0){
+            return -1;
+        }
+        fragmentDuration = _duration;
+        return 0;
+    }
+
+    const int EyerAVTranscoderParams::GetFragmentDuration() const
+    {
+        return fragmentDuration;
+    }
+
+    int EyerAVTranscoderParams::SetProgressInterval(int _interval)
+    {
+        if(_interval < 0){
+            return -1;
+        }
+        progressInterval = _interval;
+        return 0;
+    }
+
+    const int EyerAVTranscoderParams::GetProgressInterval() const
+    {
+        return progressInterval;
+    }
+
     EyerString EyerAVTranscoderParams::ToString()
     {
         EyerString str = "";
@@ -217,6 +591,15 @@ namespace Eyer
         str += EyerString("width: ") + EyerString::Number(width) + "\n";
         str += EyerString("height: ") + EyerString::Number(height) + "\n";
         str += EyerString("crf: ") + EyerString::Number(crf) + "\n";
+        str += EyerString("preset: ") + preset + "\n";
+        str += EyerString("tune: ") + tune + "\n";
+        str += EyerString("rateControl: ") + rateControl.GetName() + "\n";
+        str += EyerString("bitrate: ") + EyerString::Number(bitrate) + "\n";
+        str += EyerString("maxrate: ") + EyerString::Number(maxrate) + "\n";
+        str += EyerString("bufsize: ") + EyerString::Number(bufsize) + "\n";
+        str += EyerString("gop: ") + EyerString::Number(gop) + "\n";
+        str += EyerString("bframes: ") + EyerString::Number(bframes) + "\n";
+        str += EyerString("proresProfile: ") + EyerString::Number(proresProfile) + "\n";
 
         str += EyerString("outputAudioCodec: ") + outputAudioCodec.GetDescName() + "\n";
         str += EyerString("outputChannelLayout: ") + outputChannelLayout.GetDescName() + "\n";
@@ -226,10 +609,59 @@ namespace Eyer
 
         str += EyerString("careAudio: ") + EyerString::Number(careAudio) + "\n";
         str += EyerString("careVideo: ") + EyerString::Number(careVideo) + "\n";
+        str += EyerString("audioExtract: ") + EyerString::Number(audioExtract) + "\n";
 
         str += EyerString("startTime: ") + EyerString::Number(startTime) + "\n";
         str += EyerString("endTime: ") + EyerString::Number(endTime) + "\n";
 
+        str += EyerString("videoCopyMode: ") + videoCopyMode.GetName() + "\n";
+        str += EyerString("audioCopyMode: ") + audioCopyMode.GetName() + "\n";
+
+        str += EyerString("pipeline: ") + EyerString::Number(pipeline) + "\n";
+        str += EyerString("pipelineQueueSize: ") + EyerString::Number(pipelineQueueSize) + "\n";
+
+        str += EyerString("scaleQuality: ") + scaleQuality.GetName() + "\n";
+
+        str += EyerString("segmentNum: ") + EyerString::Number(segmentNum) + "\n";
+        str += EyerString("segmentWorkerNum: ") + EyerString::Number(segmentWorkerNum) + "\n";
+
+        str += EyerString("smartCut: ") + EyerString::Number(smartCut) + "\n";
+
+        str += EyerString("resumable: ") + EyerString::Number(resumable) + "\n";
+        str += EyerString("resumeSegmentDuration: ") + EyerString::Number(resumeSegmentDuration) + "\n";
+
+        str += EyerString("asyncWrite: ") + EyerString::Number(asyncWrite) + "\n";
+        str += EyerString("writeQueueSize: ") + EyerString::Number(writeQueueSize) + "\n";
+        str += EyerString("writeBufferSize: ") + EyerString::Number(writeBufferSize) + "\n";
+        str += EyerString("writePreallocate: ") + EyerString::Number(writePreallocate) + "\n";
+
+        str += EyerString("movMode: ") + movMode.GetName() + "\n";
+        str += EyerString("fragmentDuration: ") + EyerString::Number(fragmentDuration) + "\n";
+
+        str += EyerString("progressInterval: ") + EyerString::Number(progressInterval) + "\n";
+
         return str;
     }
+
+    int EyerAVTranscoderParams::ResetSpeedParams()
+    {
+        EyerAVTranscoderParams defaultParams;
+
+        decodeThreadNum = defaultParams.decodeThreadNum;
+        encodeThreadNum = defaultParams.encodeThreadNum;
+
+        pipeline = defaultParams.pipeline;
+        pipelineQueueSize = defaultParams.pipelineQueueSize;
+
+        segmentWorkerNum = defaultParams.segmentWorkerNum;
+
+        asyncWrite = defaultParams.asyncWrite;
+        writeQueueSize = defaultParams.writeQueueSize;
+        writeBufferSize = defaultParams.writeBufferSize;
+        writePreallocate = defaultParams.writePreallocate;
+
+        progressInterval = defaultParams.progressInterval;
+
+        return 0;
+    }
 }
\ No newline at end of file
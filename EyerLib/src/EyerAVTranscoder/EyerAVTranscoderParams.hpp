@@ -2,6 +2,8 @@
 #define EYERLIB_EYERAVTRANSCODERPARAMS_HPP
 
 #include "EyerAV/EyerAVHeader.hpp"
+#include "EyerAVTranscoderCopyMode.hpp"
+#include "EyerAVTranscoderMovMode.hpp"
 
 namespace Eyer
 {
@@ -33,6 +35,37 @@ namespace Eyer
         int SetCRF(int _crf);
         const int GetCRF() const;
 
+        // preset/tune 按当前视频编码器校验, 先调用 SetVideoCodecId
+        int SetPreset(const EyerString & _preset);
+        const EyerString GetPreset() const;
+
+        int SetTune(const EyerString & _tune);
+        const EyerString GetTune() const;
+
+        int SetRateControl(const EyerAVRateControl & _rateControl);
+        const EyerAVRateControl GetRateControl() const;
+
+        // 单位 kbps, ABR/CBR 时使用
+        int SetBitrate(int _bitrate);
+        const int GetBitrate() const;
+
+        // 单位 kbps, 0 表示不限制
+        int SetMaxrateBufsize(int _maxrate, int _bufsize);
+        const int GetMaxrate() const;
+        const int GetBufsize() const;
+
+        // 0 表示编码器默认
+        int SetGOP(int _gop);
+        const int GetGOP() const;
+
+        // -1 表示编码器默认
+        int SetBFrames(int _bframes);
+        const int GetBFrames() const;
+
+        // 0 proxy, 1 lt, 2 standard, 3 hq, -1 编码器默认
+        int SetProresProfile(int _profile);
+        const int GetProresProfile() const;
+
         int SetAudioCodecId(const EyerAVCodecID & _codecId);
         int SetChannelLayout(const EyerAVChannelLayout & _channelLayout);
 
@@ -52,14 +85,87 @@ namespace Eyer
         int SetCareAudio(bool _careAudio);
         const bool GetCareAudio() const;
 
+        // 提取音频: 只处理音频流, 其他流在解封装时直接丢弃, 不读取数据
+        // 音频复制模式为 AUTO 时, 只要输出格式能封装输入的音频编码就直接复制, 否则按音频参数编码
+        // 编码器不限制帧大小时 (PCM 等) 按大块送入编码器
+        int SetAudioExtract(bool _audioExtract);
+        const bool GetAudioExtract() const;
+
         int SetStartTime(double _startTime);
         const double GetStartTime() const;
 
         int SetEndTime(double _endTime);
         const double GetEndTime() const;
 
+        int SetVideoCopyMode(const EyerAVTranscoderCopyMode & _copyMode);
+        const EyerAVTranscoderCopyMode GetVideoCopyMode() const;
+
+        int SetAudioCopyMode(const EyerAVTranscoderCopyMode & _copyMode);
+        const EyerAVTranscoderCopyMode GetAudioCopyMode() const;
+
+        int SetPipeline(bool _pipeline);
+        const bool GetPipeline() const;
+
+        int SetPipelineQueueSize(int _queueSize);
+        const int GetPipelineQueueSize() const;
+
+        int SetScaleQuality(const EyerAVScaleQuality & _scaleQuality);
+        const EyerAVScaleQuality GetScaleQuality() const;
+
+        int SetSegmentNum(int _segmentNum);
+        const int GetSegmentNum() const;
+
+        int SetSegmentWorkerNum(int _workerNum);
+        const int GetSegmentWorkerNum() const;
+
+        // 裁剪时只重编码起止两端不完整的 GOP, 中间完整的 GOP 直接复制数据包
+        // 需要设置 startTime/endTime, 且输出视频编码, 宽高, 像素格式与输入一致, 否则走普通流程
+        int SetSmartCut(bool _smartCut);
+        const bool GetSmartCut() const;
+
+        // 断点续转: 按 GOP 边界分段写临时文件, 在 outputPath + ".checkpoint" 记录完成的分段
+        // 中断或者进程退出后用相同的输入, 输出和参数重新转码, 跳过已经完成的分段
+        int SetResumable(bool _resumable);
+        const bool GetResumable() const;
+
+        // 断点续转时每段的目标时长, 单位秒, 实际分段在关键帧处
+        int SetResumeSegmentDuration(double _duration);
+        const double GetResumeSegmentDuration() const;
+
+        // 异步写入: 封装和写文件放在单独的线程, 写入卡顿 (网络存储, fsync) 时不阻塞编码
+        int SetAsyncWrite(bool _asyncWrite);
+        const bool GetAsyncWrite() const;
+
+        // 异步写入时队列中最多缓存的 packet 数
+        int SetWriteQueueSize(int _queueSize);
+        const int GetWriteQueueSize() const;
+
+        // 输出缓冲区大小, 单位字节, 0 表示使用默认的 64K
+        int SetWriteBufferSize(int _bufferSize);
+        const int GetWriteBufferSize() const;
+
+        // 按码率和时长预估输出大小并预先分配文件空间, 只在 ABR/CBR 或者设置了 maxrate 时生效
+        int SetWritePreallocate(bool _preallocate);
+        const bool GetWritePreallocate() const;
+
+        // MP4/MOV 输出的封装方式, 默认 moov 在文件末尾
+        int SetMovMode(const EyerAVTranscoderMovMode & _movMode);
+        const EyerAVTranscoderMovMode GetMovMode() const;
+
+        // FRAGMENT 模式下每个分片的最短时长, 单位毫秒, 到时长后在下一个关键帧处开始新的分片
+        int SetFragmentDuration(int _duration);
+        const int GetFragmentDuration() const;
+
+        // 进度回调的墙钟间隔, 单位毫秒, 0 表示每次更新都回调
+        int SetProgressInterval(int _interval);
+        const int GetProgressInterval() const;
+
         EyerString ToString();
 
+        // 只影响速度不影响输出内容的参数 (线程数, 流水线, 写入方式, 进度间隔) 恢复成默认值, 断点续转的参数指纹使用
+        // 新增参数时在这里归类, 没有在这里重置的参数都当作会改变输出
+        int ResetSpeedParams();
+
     private:
         EyerAVFileFmt outputFileFmt = EyerAVFileFmt::MOV;
 
@@ -69,6 +175,16 @@ namespace Eyer
         int height = -1;
         int crf = 18;
 
+        EyerString preset = "";
+        EyerString tune = "";
+        EyerAVRateControl rateControl = EyerAVRateControl::CRF;
+        int bitrate = 0;
+        int maxrate = 0;
+        int bufsize = 0;
+        int gop = 0;
+        int bframes = -1;
+        int proresProfile = -1;
+
         EyerAVCodecID outputAudioCodec = EyerAVCodecID::CODEC_ID_AAC;
         EyerAVChannelLayout outputChannelLayout = EyerAVChannelLayout::EYER_KEEP_SAME;
         int sampleRate = -2;
@@ -78,9 +194,37 @@ namespace Eyer
 
         bool careAudio = true;
         bool careVideo = true;
+        bool audioExtract = false;
 
         double startTime = 0.0;
         double endTime = 0.0;
+
+        EyerAVTranscoderCopyMode videoCopyMode = EyerAVTranscoderCopyMode::ENCODE;
+        EyerAVTranscoderCopyMode audioCopyMode = EyerAVTranscoderCopyMode::AUTO;
+
+        bool pipeline = false;
+        int pipelineQueueSize = 8;
+
+        EyerAVScaleQuality scaleQuality = EyerAVScaleQuality::SINC;
+
+        // 分段并行转码, segmentNum <= 1 时不分段
+        int segmentNum = 1;
+        int segmentWorkerNum = 2;
+
+        bool smartCut = false;
+
+        bool resumable = false;
+        double resumeSegmentDuration = 60.0;
+
+        bool asyncWrite = false;
+        int writeQueueSize = 64;
+        int writeBufferSize = 0;
+        bool writePreallocate = false;
+
+        EyerAVTranscoderMovMode movMode = EyerAVTranscoderMovMode::NORMAL;
+        int fragmentDuration = 1000;
+
+        int progressInterval = 500;
     };
 }
 
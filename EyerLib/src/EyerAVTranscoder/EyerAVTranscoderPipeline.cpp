@@ -0,0 +1,656 @@
+#include "EyerAVTranscoderPipeline.hpp"
+
+#include "EyerAVTranscoder.hpp"
+
+namespace Eyer
+{
+    class EyerAVTranscoderPipelineDecodeThread : public EyerThread
+    {
+    public:
+        EyerAVTranscoderPipelineDecodeThread(EyerAVTranscoderPipeline * _pipeline, EyerAVTranscoderPipelineStream * _ps)
+        {
+            pipeline = _pipeline;
+            ps = _ps;
+        }
+
+        virtual void Run() override
+        {
+            pipeline->DecodeLoop(ps);
+        }
+
+    private:
+        EyerAVTranscoderPipeline * pipeline = nullptr;
+        EyerAVTranscoderPipelineStream * ps = nullptr;
+    };
+
+    class EyerAVTranscoderPipelineConvertThread : public EyerThread
+    {
+    public:
+        EyerAVTranscoderPipelineConvertThread(EyerAVTranscoderPipeline * _pipeline, EyerAVTranscoderPipelineStream * _ps)
+        {
+            pipeline = _pipeline;
+            ps = _ps;
+        }
+
+        virtual void Run() override
+        {
+            pipeline->ConvertLoop(ps);
+        }
+
+    private:
+        EyerAVTranscoderPipeline * pipeline = nullptr;
+        EyerAVTranscoderPipelineStream * ps = nullptr;
+    };
+
+    class EyerAVTranscoderPipelineEncodeThread : public EyerThread
+    {
+    public:
+        EyerAVTranscoderPipelineEncodeThread(EyerAVTranscoderPipeline * _pipeline, EyerAVTranscoderPipelineStream * _ps)
+        {
+            pipeline = _pipeline;
+            ps = _ps;
+        }
+
+        virtual void Run() override
+        {
+            pipeline->EncodeLoop(ps);
+        }
+
+    private:
+        EyerAVTranscoderPipeline * pipeline = nullptr;
+        EyerAVTranscoderPipelineStream * ps = nullptr;
+    };
+
+    class EyerAVTranscoderPipelineMuxThread : public EyerThread
+    {
+    public:
+        EyerAVTranscoderPipelineMuxThread(EyerAVTranscoderPipeline * _pipeline)
+        {
+            pipeline = _pipeline;
+        }
+
+        virtual void Run() override
+        {
+            pipeline->MuxLoop();
+        }
+
+    private:
+        EyerAVTranscoderPipeline * pipeline = nullptr;
+    };
+
+
+
+    EyerAVTranscoderPipelineStream::EyerAVTranscoderPipelineStream(EyerAVTranscodeStream * _ts, int queueSize)
+        : packetQueue(queueSize), decodeFrameQueue(queueSize), encodeFrameQueue(queueSize)
+    {
+        ts = _ts;
+    }
+
+    EyerAVTranscoderPipelineStream::~EyerAVTranscoderPipelineStream()
+    {
+        EyerAVPacket * packet = nullptr;
+        while(packetQueue.TryPop(&packet) == 0){
+            delete packet;
+        }
+        EyerAVFrame * frame = nullptr;
+        while(decodeFrameQueue.TryPop(&frame) == 0){
+            delete frame;
+        }
+        while(encodeFrameQueue.TryPop(&frame) == 0){
+            delete frame;
+        }
+    }
+
+
+
+    EyerAVTranscoderPipeline::EyerAVTranscoderPipeline(
+            EyerAVTranscoder * _transcoder,
+            EyerAVReader * _reader,
+            EyerAVWriter * _writer,
+            std::vector<EyerAVTranscodeStream *> & _transcodeStream,
+            EyerAVTranscoderInterrupt * _interrupt)
+    {
+        transcoder = _transcoder;
+        transcodeStream = _transcodeStream;
+        reader = _reader;
+        writer = _writer;
+        interrupt = _interrupt;
+
+        int queueSize = transcoder->params.GetPipelineQueueSize();
+        for(int i = 0; i < transcodeStream.size(); i++){
+            pipelineStreams.push_back(new EyerAVTranscoderPipelineStream(transcodeStream[i], queueSize));
+
+            int writeStreamId = transcodeStream[i]->writeStreamId;
+            if(writeStreamId >= 0){
+                if(writeStreamMap.size() <= writeStreamId){
+                    writeStreamMap.resize(writeStreamId + 1, -1);
+                }
+                writeStreamMap[writeStreamId] = i;
+            }
+        }
+        muxQueue = new EyerBoundedQueue<EyerAVPacket>(queueSize * (int)transcodeStream.size() + 1);
+    }
+
+    EyerAVTranscoderPipeline::~EyerAVTranscoderPipeline()
+    {
+        for(int i = 0; i < pipelineStreams.size(); i++){
+            delete pipelineStreams[i];
+        }
+        pipelineStreams.clear();
+
+        if(muxQueue != nullptr){
+            EyerAVPacket * packet = nullptr;
+            while(muxQueue->TryPop(&packet) == 0){
+                delete packet;
+            }
+            delete muxQueue;
+            muxQueue = nullptr;
+        }
+    }
+
+    int EyerAVTranscoderPipeline::Run()
+    {
+        std::vector<EyerThread *> decodeThreads;
+        std::vector<EyerThread *> convertThreads;
+        std::vector<EyerThread *> encodeThreads;
+
+        for(int i = 0; i < pipelineStreams.size(); i++){
+            EyerAVTranscoderPipelineStream * ps = pipelineStreams[i];
+            if(ps->ts->decoder == nullptr || ps->ts->encoder == nullptr){
+                continue;
+            }
+            decodeThreads.push_back(new EyerAVTranscoderPipelineDecodeThread(this, ps));
+            convertThreads.push_back(new EyerAVTranscoderPipelineConvertThread(this, ps));
+            encodeThreads.push_back(new EyerAVTranscoderPipelineEncodeThread(this, ps));
+        }
+
+        EyerAVTranscoderPipelineMuxThread muxThread(this);
+        muxThread.Start();
+        for(int i = 0; i < encodeThreads.size(); i++){
+            encodeThreads[i]->Start();
+        }
+        for(int i = 0; i < convertThreads.size(); i++){
+            convertThreads[i]->Start();
+        }
+        for(int i = 0; i < decodeThreads.size(); i++){
+            decodeThreads[i]->Start();
+        }
+
+        // demux 在当前线程执行
+        DemuxLoop();
+
+        // 每个阶段在输入队列结束后结束自己的输出队列, 这里按顺序等待各阶段退出
+        for(int i = 0; i < decodeThreads.size(); i++){
+            decodeThreads[i]->Stop();
+            delete decodeThreads[i];
+        }
+        decodeThreads.clear();
+
+        for(int i = 0; i < convertThreads.size(); i++){
+            convertThreads[i]->Stop();
+            delete convertThreads[i];
+        }
+        convertThreads.clear();
+
+        for(int i = 0; i < encodeThreads.size(); i++){
+            encodeThreads[i]->Stop();
+            delete encodeThreads[i];
+        }
+        encodeThreads.clear();
+
+        muxQueue->SetFinish();
+        muxThread.Stop();
+
+        if(isError){
+            return -1;
+        }
+        return 0;
+    }
+
+    bool EyerAVTranscoderPipeline::IsInterrupt()
+    {
+        return isInterrupt;
+    }
+
+    bool EyerAVTranscoderPipeline::IsAbort()
+    {
+        return isInterrupt || isError;
+    }
+
+    int EyerAVTranscoderPipeline::SetError(const EyerString & desc)
+    {
+        {
+            std::lock_guard<std::mutex> lock(errorMut);
+            if(isError){
+                return 0;
+            }
+            EyerLog("Pipeline error: %s\n", desc.c_str());
+            transcoder->errorDesc = desc;
+            isError = true;
+        }
+        AbortQueue();
+        return 0;
+    }
+
+    int EyerAVTranscoderPipeline::AbortQueue()
+    {
+        for(int i = 0; i < pipelineStreams.size(); i++){
+            pipelineStreams[i]->packetQueue.Abort();
+            pipelineStreams[i]->decodeFrameQueue.Abort();
+            pipelineStreams[i]->encodeFrameQueue.Abort();
+        }
+        muxQueue->Abort();
+        return 0;
+    }
+
+    int EyerAVTranscoderPipeline::DemuxLoop()
+    {
+        while(!isRangeEnd && !isError){
+            EyerAVPacket * packet = packetPool.NewPacket();
+
+            EyerAVTranscodeStageTimer demuxTimer;
+            demuxTimer.Start();
+            int ret = reader->Read(*packet);
+            demuxTimer.Stop();
+
+            if(ret){
+                packetPool.DeletePacket(packet);
+                break;
+            }
+
+            int streamIndex = packet->GetStreamIndex();
+            if(streamIndex < 0 || streamIndex >= pipelineStreams.size()){
+                packetPool.DeletePacket(packet);
+                continue;
+            }
+            transcoder->AddProfile(streamIndex, STAGE_DEMUX, demuxTimer, 1, packet->GetSize());
+
+            EyerAVTranscoderPipelineStream * ps = pipelineStreams[streamIndex];
+            if(ps->ts->isCopy){
+                // 流复制的包不经过解码和编码, 直接交给 mux 线程
+                ret = transcoder->PrepareCopyPacket(writer, ps->ts, *packet);
+                if(ret == 0){
+                    double secPTS = packet->GetSecPTS();
+                    if(muxQueue->Push(packet)){
+                        packetPool.DeletePacket(packet);
+                    }
+
+                    std::lock_guard<std::mutex> lock(progressMut);
+                    transcoder->UpdateProgress(secPTS);
+                }
+                else {
+                    packetPool.DeletePacket(packet);
+                    if(ret > 0){
+                        CheckRangeEnd(ps->ts);
+                    }
+                }
+            }
+            else if(ps->ts->decoder == nullptr || ps->ts->encoder == nullptr){
+                packetPool.DeletePacket(packet);
+            }
+            else {
+                ret = ps->packetQueue.Push(packet);
+                if(ret){
+                    packetPool.DeletePacket(packet);
+                }
+            }
+
+            if(interrupt != nullptr){
+                if(interrupt->interrupt()){
+                    isInterrupt = true;
+                    break;
+                }
+            }
+        }
+
+        // 取消时队列中剩余的数据直接丢弃
+        if(isInterrupt){
+            AbortQueue();
+        }
+        for(int i = 0; i < pipelineStreams.size(); i++){
+            pipelineStreams[i]->packetQueue.SetFinish();
+        }
+
+        return 0;
+    }
+
+    bool EyerAVTranscoderPipeline::CheckRangeEnd(EyerAVTranscodeStream * ts)
+    {
+        std::lock_guard<std::mutex> lock(rangeMut);
+        if(transcoder->MarkRangeEnd(transcodeStream, ts)){
+            isRangeEnd = true;
+        }
+        return isRangeEnd;
+    }
+
+    int EyerAVTranscoderPipeline::DecodeLoop(EyerAVTranscoderPipelineStream * ps)
+    {
+        EyerAVTranscodeStream * ts = ps->ts;
+        EyerAVDecoder * decoder = ts->decoder;
+        const EyerAVTranscoderParams & params = transcoder->params;
+
+        while(1){
+            EyerAVPacket * packet = nullptr;
+            int ret = ps->packetQueue.Pop(&packet);
+            if(ret){
+                break;
+            }
+
+            // 所有流都已经超出范围, 剩余的包直接丢弃
+            if(isRangeEnd){
+                packetPool.DeletePacket(packet);
+                continue;
+            }
+
+            EyerAVTranscodeStageTimer decodeTimer;
+            int decodeFrameNum = 0;
+            decodeTimer.Start();
+            decoder->SendPacket(*packet);
+            decodeTimer.Stop();
+            packetPool.DeletePacket(packet);
+
+            while(1){
+                EyerAVFrame * frame = framePool.NewFrame();
+                decodeTimer.Start();
+                ret = decoder->RecvFrame(*frame);
+                decodeTimer.Stop();
+                if(ret){
+                    framePool.DeleteFrame(frame);
+                    break;
+                }
+                decodeFrameNum++;
+
+                //range处理
+                if((params.GetStartTime() != 0.0) && (frame->GetSecPTS() < params.GetStartTime())){
+                    framePool.DeleteFrame(frame);
+                    continue;
+                }
+                if((params.GetEndTime() != 0.0) && (frame->GetSecPTS() > params.GetEndTime())){
+                    framePool.DeleteFrame(frame);
+                    if(CheckRangeEnd(ts)){
+                        break;
+                    }
+                    continue;
+                }
+
+                if(ps->decodeFrameQueue.Push(frame)){
+                    framePool.DeleteFrame(frame);
+                    break;
+                }
+            }
+            transcoder->AddProfile(ts->readStreamId, STAGE_DECODE, decodeTimer, decodeFrameNum);
+        }
+
+        // 与串行模式一致, 取消或出错时不再刷新解码器
+        if(IsAbort()){
+            ps->decodeFrameQueue.SetFinish();
+            return 0;
+        }
+
+        // Clear Decoder
+        EyerAVTranscodeStageTimer decodeTimer;
+        int decodeFrameNum = 0;
+        decodeTimer.Start();
+        decoder->SendPacketNull();
+        decodeTimer.Stop();
+        while(1){
+            EyerAVFrame * frame = framePool.NewFrame();
+            decodeTimer.Start();
+            int ret = decoder->RecvFrame(*frame);
+            decodeTimer.Stop();
+            if(ret){
+                framePool.DeleteFrame(frame);
+                break;
+            }
+            decodeFrameNum++;
+            if((params.GetEndTime() != 0.0) && (frame->GetSecPTS() > params.GetEndTime())){
+                framePool.DeleteFrame(frame);
+                break;
+            }
+            if(ps->decodeFrameQueue.Push(frame)){
+                framePool.DeleteFrame(frame);
+                break;
+            }
+        }
+        transcoder->AddProfile(ts->readStreamId, STAGE_DECODE, decodeTimer, decodeFrameNum);
+
+        ps->decodeFrameQueue.SetFinish();
+        return 0;
+    }
+
+    int EyerAVTranscoderPipeline::ConvertLoop(EyerAVTranscoderPipelineStream * ps)
+    {
+        EyerAVTranscodeStream * ts = ps->ts;
+        EyerAVEncoder * encoder = ts->encoder;
+        EyerAVResample * resample = ts->resample;
+        const EyerAVTranscoderParams & params = transcoder->params;
+
+        EyerAVMediaType mediaType = encoder->GetMediaType();
+
+        while(1){
+            EyerAVFrame * frame = nullptr;
+            int ret = ps->decodeFrameQueue.Pop(&frame);
+            if(ret){
+                break;
+            }
+
+            double currentSecPTS = frame->GetSecPTS();
+
+            if(mediaType == EyerAVMediaType::MEDIA_TYPE_AUDIO && params.GetCareAudio()){
+                if(resample == nullptr){
+                    EyerLog("Resample is null\n");
+                    framePool.DeleteFrame(frame);
+                    continue;
+                }
+
+                EyerAVTranscodeStageTimer resampleTimer;
+                int resampleFrameNum = 0;
+                resampleTimer.Start();
+                resample->PutAVFrame(*frame);
+                resampleTimer.Stop();
+                while(1){
+                    EyerAVFrame * encodeFrame = framePool.NewFrame();
+                    int framesize = transcoder->GetAudioFrameSize(encoder);
+                    resampleTimer.Start();
+                    ret = resample->GetFrame(*encodeFrame, framesize);
+                    resampleTimer.Stop();
+                    if(ret){
+                        framePool.DeleteFrame(encodeFrame);
+                        break;
+                    }
+                    resampleFrameNum++;
+                    encodeFrame->SetPTS(ts->audioPts);
+                    ts->audioPts += encodeFrame->GetSampleNB();
+
+                    if(ps->encodeFrameQueue.Push(encodeFrame)){
+                        framePool.DeleteFrame(encodeFrame);
+                        break;
+                    }
+                }
+                transcoder->AddProfile(ts->readStreamId, STAGE_RESAMPLE, resampleTimer, resampleFrameNum);
+            }
+            else if(mediaType == EyerAVMediaType::MEDIA_TYPE_VIDEO && params.GetCareVideo()){
+                frame->SetPTS(frame->GetSecPTS() * 1000);
+                if(params.GetStartTime() != 0.0){
+                    if(ts->encoderVideoFrameIndex == 0){
+                        frame->SetPTS(0);
+                    }else{
+                        frame->SetPTS(frame->GetPTS() - (int64_t)(params.GetStartTime() * 1000));
+                    }
+                }
+                ts->encoderVideoFrameIndex++;
+
+                EyerAVTranscodeStageTimer scaleTimer;
+                EyerAVFrame * distFrame = framePool.NewFrame();
+                scaleTimer.Start();
+                ret = ts->scaler.Scale(*frame, *distFrame, params.GetVideoPixelFormat(), params.GetWidth(), params.GetHeight());
+                scaleTimer.Stop();
+                transcoder->AddProfile(ts->readStreamId, STAGE_SCALE, scaleTimer, 1);
+
+                if(ret){
+                    framePool.DeleteFrame(distFrame);
+                    SetError("图像缩放失败");
+                }
+                else if(ps->encodeFrameQueue.Push(distFrame)){
+                    framePool.DeleteFrame(distFrame);
+                }
+            }
+
+            framePool.DeleteFrame(frame);
+
+            {
+                std::lock_guard<std::mutex> lock(progressMut);
+                transcoder->UpdateProgress(currentSecPTS);
+            }
+        }
+
+        // 取出重采样器中剩余的采样, 编码器支持短的最后一帧时直接送入, 否则补静音
+        if(mediaType == EyerAVMediaType::MEDIA_TYPE_AUDIO && params.GetCareAudio() && resample != nullptr && !IsAbort()){
+            EyerAVTranscodeStageTimer resampleTimer;
+            int resampleFrameNum = 0;
+            resampleTimer.Start();
+            resample->PutAVFrameNULL();
+            resampleTimer.Stop();
+            int framesize = transcoder->GetAudioFrameSize(encoder);
+            while(1){
+                EyerAVFrame * encodeFrame = framePool.NewFrame();
+                resampleTimer.Start();
+                int ret = resample->GetFrame(*encodeFrame, framesize);
+                if(ret){
+                    ret = resample->GetLastFrame(*encodeFrame, framesize, !encoder->IsSmallLastFrameSupported());
+                }
+                resampleTimer.Stop();
+                if(ret){
+                    framePool.DeleteFrame(encodeFrame);
+                    break;
+                }
+                resampleFrameNum++;
+                encodeFrame->SetPTS(ts->audioPts);
+                ts->audioPts += encodeFrame->GetSampleNB();
+
+                if(ps->encodeFrameQueue.Push(encodeFrame)){
+                    framePool.DeleteFrame(encodeFrame);
+                    break;
+                }
+            }
+            transcoder->AddProfile(ts->readStreamId, STAGE_RESAMPLE, resampleTimer, resampleFrameNum);
+        }
+
+        ps->encodeFrameQueue.SetFinish();
+        return 0;
+    }
+
+    int EyerAVTranscoderPipeline::EncodeLoop(EyerAVTranscoderPipelineStream * ps)
+    {
+        EyerAVTranscodeStream * ts = ps->ts;
+        EyerAVEncoder * encoder = ts->encoder;
+
+        while(1){
+            EyerAVFrame * frame = nullptr;
+            int ret = ps->encodeFrameQueue.Pop(&frame);
+            if(ret){
+                break;
+            }
+
+            EyerAVTranscodeStageTimer encodeTimer;
+            int encodePacketNum = 0;
+            encodeTimer.Start();
+            ret = encoder->SendFrame(*frame);
+            encodeTimer.Stop();
+            framePool.DeleteFrame(frame);
+            if(ret){
+                SetError("编码失败");
+                break;
+            }
+
+            while(1){
+                EyerAVPacket * packet = packetPool.NewPacket();
+                encodeTimer.Start();
+                ret = encoder->RecvPacket(*packet);
+                encodeTimer.Stop();
+                if(ret){
+                    packetPool.DeletePacket(packet);
+                    break;
+                }
+                encodePacketNum++;
+                if(PushEncodedPacket(ts, packet)){
+                    break;
+                }
+            }
+            transcoder->AddProfile(ts->readStreamId, STAGE_ENCODE, encodeTimer, encodePacketNum);
+        }
+
+        // Clear Encode, 与串行模式一致, 取消或出错时不再刷新编码器
+        if(!IsAbort()){
+            EyerAVTranscodeStageTimer encodeTimer;
+            int encodePacketNum = 0;
+            encodeTimer.Start();
+            encoder->SendFrameNull();
+            encodeTimer.Stop();
+            while(1){
+                EyerAVPacket * packet = packetPool.NewPacket();
+                encodeTimer.Start();
+                int ret = encoder->RecvPacket(*packet);
+                encodeTimer.Stop();
+                if(ret){
+                    packetPool.DeletePacket(packet);
+                    break;
+                }
+                encodePacketNum++;
+                packet->SetStreamIndex(ts->writeStreamId);
+                packet->RescaleTs(encoder->GetTimebase(), writer->GetTimebase(ts->writeStreamId));
+                if(muxQueue->Push(packet)){
+                    packetPool.DeletePacket(packet);
+                    break;
+                }
+            }
+            transcoder->AddProfile(ts->readStreamId, STAGE_ENCODE, encodeTimer, encodePacketNum);
+        }
+
+        return 0;
+    }
+
+    int EyerAVTranscoderPipeline::PushEncodedPacket(EyerAVTranscodeStream * ts, EyerAVPacket * packet)
+    {
+        EyerAVEncoder * encoder = ts->encoder;
+
+        packet->SetStreamIndex(ts->writeStreamId);
+        packet->RescaleTs(encoder->GetTimebase(), writer->GetTimebase(ts->writeStreamId));
+
+        if(encoder->GetMediaType() == EyerAVMediaType::MEDIA_TYPE_VIDEO){
+            if(packet->GetDTS() > packet->GetPTS()){
+                packet->SetPTS(packet->GetDTS());
+            }
+        }
+
+        int ret = muxQueue->Push(packet);
+        if(ret){
+            packetPool.DeletePacket(packet);
+        }
+        return ret;
+    }
+
+    int EyerAVTranscoderPipeline::MuxLoop()
+    {
+        while(1){
+            EyerAVPacket * packet = nullptr;
+            int ret = muxQueue->Pop(&packet);
+            if(ret){
+                break;
+            }
+
+            int streamId = -1;
+            int writeStreamId = packet->GetStreamIndex();
+            if(writeStreamId >= 0 && writeStreamId < writeStreamMap.size()){
+                streamId = writeStreamMap[writeStreamId];
+            }
+            ret = transcoder->WritePacket(writer, streamId, *packet);
+            packetPool.DeletePacket(packet);
+            if(ret){
+                SetError("写入数据包失败");
+                break;
+            }
+        }
+        return 0;
+    }
+}
@@ -0,0 +1,93 @@
+#ifndef EYERLIB_EYERAVTRANSCODERPIPELINE_HPP
+#define EYERLIB_EYERAVTRANSCODERPIPELINE_HPP
+
+#include <vector>
+#include <mutex>
+#include <atomic>
+
+#include "EyerCore/EyerCore.hpp"
+#include "EyerThread/EyerThreadHeader.hpp"
+#include "EyerAV/EyerAVHeader.hpp"
+#include "EyerAVTranscodeStream.hpp"
+
+namespace Eyer
+{
+    class EyerAVTranscoder;
+    class EyerAVTranscoderInterrupt;
+
+    class EyerAVTranscoderPipelineStream
+    {
+    public:
+        EyerAVTranscoderPipelineStream(EyerAVTranscodeStream * _ts, int queueSize);
+        ~EyerAVTranscoderPipelineStream();
+
+        EyerAVTranscodeStream * ts = nullptr;
+
+        // demux -> decode
+        EyerBoundedQueue<EyerAVPacket> packetQueue;
+        // decode -> scale/resample
+        EyerBoundedQueue<EyerAVFrame> decodeFrameQueue;
+        // scale/resample -> encode
+        EyerBoundedQueue<EyerAVFrame> encodeFrameQueue;
+    };
+
+    // 流水线转码: demux 线程 -> 每路流一个解码线程 -> 每路流一个 scale/resample 线程 -> 每路流一个编码线程 -> mux 线程
+    // 各阶段之间通过有界队列连接, 队列满时上游阻塞
+    // 取消或者任一阶段出错时中止所有队列, 不再刷新解码器和编码器
+    class EyerAVTranscoderPipeline
+    {
+    public:
+        EyerAVTranscoderPipeline(
+                EyerAVTranscoder * transcoder,
+                EyerAVReader * reader,
+                EyerAVWriter * writer,
+                std::vector<EyerAVTranscodeStream *> & transcodeStream,
+                EyerAVTranscoderInterrupt * interrupt);
+        ~EyerAVTranscoderPipeline();
+
+        // 有阶段出错时返回 -1, 错误描述写入 transcoder 的 errorDesc
+        int Run();
+
+        bool IsInterrupt();
+
+        int DecodeLoop(EyerAVTranscoderPipelineStream * ps);
+        int ConvertLoop(EyerAVTranscoderPipelineStream * ps);
+        int EncodeLoop(EyerAVTranscoderPipelineStream * ps);
+        int MuxLoop();
+
+    private:
+        int DemuxLoop();
+        bool CheckRangeEnd(EyerAVTranscodeStream * ts);
+        int PushEncodedPacket(EyerAVTranscodeStream * ts, EyerAVPacket * packet);
+        // 只记录第一个错误
+        int SetError(const EyerString & desc);
+        int AbortQueue();
+        bool IsAbort();
+
+        EyerAVTranscoder * transcoder = nullptr;
+        EyerAVReader * reader = nullptr;
+        EyerAVWriter * writer = nullptr;
+        EyerAVTranscoderInterrupt * interrupt = nullptr;
+
+        std::vector<EyerAVTranscodeStream *> transcodeStream;
+        std::vector<EyerAVTranscoderPipelineStream *> pipelineStreams;
+        EyerBoundedQueue<EyerAVPacket> * muxQueue = nullptr;
+
+        std::atomic_bool isInterrupt {false};
+        std::atomic_bool isRangeEnd {false};
+        std::atomic_bool isError {false};
+
+        std::mutex rangeMut;
+        std::mutex errorMut;
+        std::mutex progressMut;
+
+        // 输出流序号 -> 输入流序号, mux 线程用来归属统计
+        std::vector<int> writeStreamMap;
+
+        // 各线程之间传递的帧和包都从这里取, 用完归还
+        EyerAVFramePool framePool;
+        EyerAVPacketPool packetPool;
+    };
+}
+
+#endif //EYERLIB_EYERAVTRANSCODERPIPELINE_HPP
@@ -0,0 +1,675 @@
+#include "EyerAVTranscoderSegment.hpp"
+
+#include <stdio.h>
+#include <string>
+#include <algorithm>
+#include <math.h>
+
+#include "EyerAVTranscoder.hpp"
+
+namespace Eyer
+{
+    // 分段的结束时间取下一段起始关键帧之前一点, Transcoder 的 range 处理会包含 endTime 这一帧
+    static const double SEGMENT_END_EPSILON = 0.001;
+
+    class EyerAVTranscoderSegmentWorker : public EyerThread
+    {
+    public:
+        EyerAVTranscoderSegmentWorker(EyerAVTranscoderSegment * _segment)
+        {
+            segment = _segment;
+        }
+
+        virtual void Run() override
+        {
+            segment->WorkLoop();
+        }
+
+    private:
+        EyerAVTranscoderSegment * segment = nullptr;
+    };
+
+    class EyerAVTranscoderSegmentListener : public EyerAVTranscoderListener
+    {
+    public:
+        EyerAVTranscoderSegmentListener(EyerAVTranscoderSegment * _segment, EyerAVTranscoderSegmentChunk * _chunk)
+        {
+            segment = _segment;
+            chunk = _chunk;
+        }
+
+        virtual int OnProgress(float progress) override
+        {
+            return 0;
+        }
+
+        virtual int OnProgressInfo(const EyerAVTranscodeProgress & progress) override
+        {
+            return segment->OnChunkProgress(chunk, progress);
+        }
+
+        virtual int OnFail(EyerAVTranscoderError & error) override
+        {
+            EyerLog("Segment chunk %d fail: %s\n", chunk->index, error.GetDesc().c_str());
+            return 0;
+        }
+
+        virtual int OnSuccess() override
+        {
+            return 0;
+        }
+
+    private:
+        EyerAVTranscoderSegment * segment = nullptr;
+        EyerAVTranscoderSegmentChunk * chunk = nullptr;
+    };
+
+    static int EyerAVTranscoderSegment_ReadStreamPacket(EyerAVReader * reader, int streamIndex, EyerAVPacket & packet)
+    {
+        while(1){
+            int ret = reader->Read(packet);
+            if(ret){
+                return ret;
+            }
+            if(packet.GetStreamIndex() == streamIndex){
+                return 0;
+            }
+        }
+        return -1;
+    }
+
+    static double EyerAVTranscoderSegment_SecDTS(EyerAVPacket & packet, const EyerAVRational & timebase)
+    {
+        return packet.GetDTS() * 1.0 * timebase.num / timebase.den;
+    }
+
+    EyerAVTranscoderSegment::EyerAVTranscoderSegment(EyerAVTranscoder * _transcoder, EyerAVTranscoderInterrupt * _interrupt)
+        : checkpoint(_transcoder->outputPath + ".checkpoint")
+    {
+        transcoder = _transcoder;
+        interrupt = _interrupt;
+    }
+
+    EyerAVTranscoderSegment::~EyerAVTranscoderSegment()
+    {
+        if(videoReader != nullptr){
+            videoReader->Close();
+            delete videoReader;
+            videoReader = nullptr;
+        }
+        for(int i = 0; i < chunkList.size(); i++){
+            delete chunkList[i];
+        }
+        chunkList.clear();
+        videoChunkList.clear();
+        audioChunk = nullptr;
+    }
+
+    int EyerAVTranscoderSegment::Run()
+    {
+        std::vector<double> keyFrameList;
+        double duration = 0.0;
+        int ret = ScanKeyFrame(keyFrameList, duration);
+        if(ret){
+            return ret;
+        }
+
+        ret = SplitChunk(keyFrameList, duration);
+        if(ret){
+            return ret;
+        }
+
+        bool resumable = transcoder->params.GetResumable();
+        if(resumable){
+            LoadCheckpoint();
+        }
+
+        int workerNum = transcoder->params.GetSegmentWorkerNum();
+        if(workerNum > chunkList.size()){
+            workerNum = chunkList.size();
+        }
+        EyerLog("Segment transcode, chunk num: %d, worker num: %d\n", (int)videoChunkList.size(), workerNum);
+
+        std::vector<EyerAVTranscoderSegmentWorker *> workerList;
+        for(int i = 0; i < workerNum; i++){
+            EyerAVTranscoderSegmentWorker * worker = new EyerAVTranscoderSegmentWorker(this);
+            worker->Start();
+            workerList.push_back(worker);
+        }
+        for(int i = 0; i < workerList.size(); i++){
+            workerList[i]->Stop();
+            delete workerList[i];
+        }
+        workerList.clear();
+
+        if(isInterrupt){
+            RemoveTempFile(resumable);
+            return 0;
+        }
+        if(isFail){
+            RemoveTempFile(resumable);
+            return -1;
+        }
+
+        ret = Concat();
+        if(ret && resumable){
+            // 分段都已完成, 下次只需要重新拼接
+            RemoveTempFile(true);
+            return ret;
+        }
+        RemoveTempFile();
+        if(resumable){
+            checkpoint.Remove();
+        }
+        return ret;
+    }
+
+    bool EyerAVTranscoderSegment::IsInterrupt()
+    {
+        return isInterrupt;
+    }
+
+    int EyerAVTranscoderSegment::ScanKeyFrame(std::vector<double> & keyFrameList, double & duration)
+    {
+        EyerAVReader reader(transcoder->inputPath);
+        int ret = reader.Open();
+        if(ret){
+            // 交给普通流程报告打开失败
+            return 1;
+        }
+
+        duration = reader.GetDuration();
+
+        int videoIndex = reader.GetVideoStreamIndex();
+        if(videoIndex < 0 || !transcoder->params.GetCareVideo()){
+            reader.Close();
+            return 1;
+        }
+
+        EyerAVStream videoStream = reader.GetStream(videoIndex);
+        if(transcoder->IsStreamCopy(videoStream)){
+            reader.Close();
+            return 1;
+        }
+
+        hasAudio = reader.GetAudioStreamIndex() >= 0 && transcoder->params.GetCareAudio();
+
+        // 只读包不解码, 记录视频关键帧的时间
+        EyerAVPacket packet;
+        while(1){
+            ret = EyerAVTranscoderSegment_ReadStreamPacket(&reader, videoIndex, packet);
+            if(ret){
+                break;
+            }
+            if(packet.IsKeyFrame()){
+                keyFrameList.push_back(packet.GetSecPTS());
+            }
+        }
+        reader.Close();
+
+        std::sort(keyFrameList.begin(), keyFrameList.end());
+
+        return 0;
+    }
+
+    int EyerAVTranscoderSegment::SplitChunk(std::vector<double> & keyFrameList, double duration)
+    {
+        EyerAVTranscoderParams & params = transcoder->params;
+
+        double rangeStart = params.GetStartTime();
+        double rangeEnd = duration;
+        if(params.GetEndTime() != 0.0 && params.GetEndTime() < duration){
+            rangeEnd = params.GetEndTime();
+        }
+        if(rangeEnd - rangeStart <= 0.0){
+            return 1;
+        }
+
+        // 每段的目标起点均分整个区间, 实际起点取不早于目标的第一个关键帧
+        std::vector<double> boundaryList;
+        boundaryList.push_back(rangeStart);
+        int segmentNum = params.GetSegmentNum();
+        // 断点续转时分段不能太长, 否则中断后要重做的部分太多
+        if(params.GetResumable()){
+            int resumeSegmentNum = (int)ceil((rangeEnd - rangeStart) / params.GetResumeSegmentDuration());
+            if(resumeSegmentNum > segmentNum){
+                segmentNum = resumeSegmentNum;
+            }
+        }
+        for(int i = 1; i < segmentNum; i++){
+            double target = rangeStart + (rangeEnd - rangeStart) * i / segmentNum;
+            for(int j = 0; j < keyFrameList.size(); j++){
+                double keyFrame = keyFrameList[j];
+                if(keyFrame < target){
+                    continue;
+                }
+                if(keyFrame > boundaryList[boundaryList.size() - 1] && keyFrame < rangeEnd){
+                    boundaryList.push_back(keyFrame);
+                }
+                break;
+            }
+        }
+
+        // 断点续转允许只有一段, 输出仍然经过临时文件和检查点
+        if(boundaryList.size() < 2 && !params.GetResumable()){
+            EyerLog("Segment transcode, not enough key frame\n");
+            return 1;
+        }
+
+        // 临时文件和输出使用相同的封装格式
+        std::string outputPath = transcoder->outputPath.c_str();
+        std::string suffix = "";
+        size_t dotPos = outputPath.find_last_of('.');
+        if(dotPos != std::string::npos){
+            suffix = outputPath.substr(dotPos);
+        }
+
+        if(hasAudio){
+            audioChunk = new EyerAVTranscoderSegmentChunk();
+            audioChunk->index = -1;
+            audioChunk->isAudio = true;
+            audioChunk->startTime = rangeStart;
+            audioChunk->endTime = params.GetEndTime();
+            audioChunk->duration = rangeEnd - rangeStart;
+            audioChunk->path = transcoder->outputPath + ".segment_audio" + suffix.c_str();
+            // 音频放在最前面, 和视频段并行转码
+            chunkList.push_back(audioChunk);
+        }
+
+        for(int i = 0; i < boundaryList.size(); i++){
+            EyerAVTranscoderSegmentChunk * chunk = new EyerAVTranscoderSegmentChunk();
+            chunk->index = i;
+            chunk->startTime = boundaryList[i];
+            chunk->offsetTime = boundaryList[i] - rangeStart;
+            if(i + 1 < boundaryList.size()){
+                chunk->endTime = boundaryList[i + 1] - SEGMENT_END_EPSILON;
+                chunk->duration = boundaryList[i + 1] - boundaryList[i];
+            }
+            else{
+                chunk->endTime = params.GetEndTime();
+                chunk->duration = rangeEnd - boundaryList[i];
+            }
+            chunk->path = transcoder->outputPath + ".segment" + EyerString::Number(i) + suffix.c_str();
+
+            EyerLog("Segment chunk %d, start: %f, end: %f\n", i, chunk->startTime, chunk->endTime);
+
+            chunkList.push_back(chunk);
+            videoChunkList.push_back(chunk);
+        }
+
+        return 0;
+    }
+
+    int EyerAVTranscoderSegment::WorkLoop()
+    {
+        while(1){
+            if(isInterrupt || isFail){
+                break;
+            }
+            int index = nextChunk++;
+            if(index >= chunkList.size()){
+                break;
+            }
+            // 上次已经完成的分段
+            if(chunkList[index]->isSucc){
+                continue;
+            }
+            TranscodeChunk(chunkList[index]);
+        }
+        return 0;
+    }
+
+    int EyerAVTranscoderSegment::TranscodeChunk(EyerAVTranscoderSegmentChunk * chunk)
+    {
+        EyerAVTranscoderParams params = transcoder->params;
+        // 每段都是普通转码, 不能再次进入分段流程
+        params.SetSegmentNum(1);
+        params.SetResumable(false);
+        // 临时文件只给拼接读取, 封装方式只作用于最终输出
+        params.SetMovMode(EyerAVTranscoderMovMode::NORMAL);
+        params.SetPipeline(false);
+        params.SetStartTime(chunk->startTime);
+        params.SetEndTime(chunk->endTime);
+        if(chunk->isAudio){
+            params.SetCareVideo(false);
+        }
+        else{
+            params.SetCareAudio(false);
+        }
+
+        EyerAVTranscoderSegmentListener listener(this, chunk);
+
+        EyerAVTranscoder chunkTranscoder(transcoder->inputPath);
+        chunkTranscoder.SetOutputPath(chunk->path);
+        chunkTranscoder.SetParams(params);
+        chunkTranscoder.SetListener(&listener);
+        chunkTranscoder.Transcode(interrupt);
+
+        EyerAVTranscodeProfile chunkProfile = chunkTranscoder.GetProfile();
+        {
+            std::lock_guard<std::mutex> lg(transcoder->profileMut);
+            transcoder->profile.Merge(chunkProfile);
+        }
+
+        if(chunkTranscoder.GetStatus() == EyerAVTranscoderStatus::SUCC){
+            chunk->isSucc = true;
+            if(transcoder->params.GetResumable()){
+                SetChunkDone(chunk);
+            }
+
+            EyerAVTranscodeProgress progress;
+            progress.progress = 1.0;
+            progress.frameNum = chunkProfile.GetStageTotal(STAGE_SCALE).count;
+            for(int i = 0; i < chunkProfile.streamList.size(); i++){
+                progress.bytesWritten += chunkProfile.streamList[i].bytesOut;
+            }
+            OnChunkProgress(chunk, progress);
+            return 0;
+        }
+
+        if(interrupt != nullptr && interrupt->interrupt()){
+            isInterrupt = true;
+        }
+        else{
+            std::lock_guard<std::mutex> lg(progressMut);
+            isFail = true;
+            transcoder->errorDesc = chunkTranscoder.GetErrorDesc();
+        }
+        return -1;
+    }
+
+    int EyerAVTranscoderSegment::OnChunkProgress(EyerAVTranscoderSegmentChunk * chunk, const EyerAVTranscodeProgress & progress)
+    {
+        std::lock_guard<std::mutex> lg(progressMut);
+        chunk->progress = progress.progress;
+        chunk->frameNum = progress.frameNum;
+        chunk->bytesWritten = progress.bytesWritten;
+
+        if(transcoder->listener == nullptr){
+            return 0;
+        }
+        // 多个 worker 同时上报, 按总的回调间隔节流, 某一段完成时总是回调
+        if(progress.progress < 1.0 && !transcoder->IsProgressDue()){
+            return 0;
+        }
+
+        int64_t frameNum = 0;
+        int64_t bytesWritten = 0;
+        for(int i = 0; i < chunkList.size(); i++){
+            frameNum += chunkList[i]->frameNum;
+            bytesWritten += chunkList[i]->bytesWritten;
+        }
+
+        // 按每段的时长加权, 音频段不计入
+        double totalDuration = 0.0;
+        double finishDuration = 0.0;
+        for(int i = 0; i < videoChunkList.size(); i++){
+            totalDuration += videoChunkList[i]->duration;
+            finishDuration += videoChunkList[i]->duration * videoChunkList[i]->progress;
+        }
+
+        float totalProgress = 0.0;
+        if(totalDuration > 0.0){
+            totalProgress = finishDuration / totalDuration;
+        }
+        if(totalProgress >= 1.0){
+            totalProgress = 1.0;
+        }
+        transcoder->NotifyProgress(totalProgress, finishDuration, frameNum, bytesWritten);
+
+        return 0;
+    }
+
+    int EyerAVTranscoderSegment::Concat()
+    {
+        // 拼接只复制数据包, 输出大小约等于各段临时文件大小之和
+        int64_t estimateSize = 0;
+        for(int i = 0; i < chunkList.size(); i++){
+            estimateSize += EyerAVTranscoder::GetFileSize(chunkList[i]->path);
+        }
+
+        EyerAVWriter writer(transcoder->outputPath);
+        int ret = transcoder->InitWriter(&writer, estimateSize);
+        if(ret){
+            return -1;
+        }
+        ret = writer.Open();
+        if(ret){
+            transcoder->errorDesc = "输出路径不存在或不可写";
+            return -1;
+        }
+
+        // 各段使用相同的编码参数, 视频流的参数 (extradata) 取第一段
+        int videoWriteStreamId = -1;
+        {
+            EyerAVReader firstReader(videoChunkList[0]->path);
+            ret = firstReader.Open();
+            if(ret){
+                transcoder->errorDesc = "分段文件打开失败";
+                return -1;
+            }
+            int firstVideoIndex = firstReader.GetVideoStreamIndex();
+            if(firstVideoIndex < 0){
+                firstReader.Close();
+                transcoder->errorDesc = "分段文件打开失败";
+                return -1;
+            }
+            videoWriteStreamId = writer.AddStream(firstReader.GetStream(firstVideoIndex));
+            firstReader.Close();
+        }
+
+        EyerAVReader * audioReader = nullptr;
+        int audioStreamIndex = -1;
+        int audioWriteStreamId = -1;
+        EyerAVRational audioReadTimebase;
+        if(audioChunk != nullptr){
+            audioReader = new EyerAVReader(audioChunk->path);
+            ret = audioReader->Open();
+            if(ret == 0){
+                audioStreamIndex = audioReader->GetAudioStreamIndex();
+            }
+            if(audioStreamIndex >= 0){
+                EyerAVStream audioStream = audioReader->GetStream(audioStreamIndex);
+                audioReadTimebase = audioStream.GetTimebase();
+                audioWriteStreamId = writer.AddStream(audioStream);
+            }
+        }
+
+        ret = writer.WriteHand();
+        if(ret){
+            transcoder->errorDesc = "写入视频头失败";
+            if(audioReader != nullptr){
+                audioReader->Close();
+                delete audioReader;
+            }
+            return -1;
+        }
+
+        EyerAVRational videoWriteTimebase = writer.GetTimebase(videoWriteStreamId);
+        EyerAVRational audioWriteTimebase;
+        if(audioWriteStreamId >= 0){
+            audioWriteTimebase = writer.GetTimebase(audioWriteStreamId);
+        }
+
+        EyerAVPacket videoPacket;
+        ret = ReadVideoPacket(videoPacket, &writer, videoWriteStreamId);
+        bool videoEnd = ret != 0;
+        if(ret < -1){
+            transcoder->errorDesc = "分段文件打开失败";
+        }
+
+        EyerAVPacket audioPacket;
+        bool audioEnd = true;
+        if(audioWriteStreamId >= 0){
+            audioEnd = EyerAVTranscoderSegment_ReadStreamPacket(audioReader, audioStreamIndex, audioPacket) != 0;
+            audioPacket.SetStreamIndex(audioWriteStreamId);
+            audioPacket.RescaleTs(audioReadTimebase, audioWriteTimebase);
+        }
+
+        // 按 DTS 交错写入
+        while(!videoEnd || !audioEnd){
+            bool writeVideo = audioEnd;
+            if(!videoEnd && !audioEnd){
+                writeVideo = EyerAVTranscoderSegment_SecDTS(videoPacket, videoWriteTimebase) <= EyerAVTranscoderSegment_SecDTS(audioPacket, audioWriteTimebase);
+            }
+
+            if(writeVideo){
+                if(writer.WritePacket(videoPacket)){
+                    transcoder->isWriteFail = true;
+                    break;
+                }
+                ret = ReadVideoPacket(videoPacket, &writer, videoWriteStreamId);
+                if(ret){
+                    videoEnd = true;
+                    if(ret < -1){
+                        transcoder->errorDesc = "分段文件打开失败";
+                        break;
+                    }
+                }
+            }
+            else{
+                if(writer.WritePacket(audioPacket)){
+                    transcoder->isWriteFail = true;
+                    break;
+                }
+                audioEnd = EyerAVTranscoderSegment_ReadStreamPacket(audioReader, audioStreamIndex, audioPacket) != 0;
+                audioPacket.SetStreamIndex(audioWriteStreamId);
+                audioPacket.RescaleTs(audioReadTimebase, audioWriteTimebase);
+            }
+        }
+
+        // 异步写入时封装线程中的错误也由 WriteTrailer 返回
+        if(writer.WriteTrailer()){
+            transcoder->isWriteFail = true;
+        }
+        writer.Close();
+
+        if(audioReader != nullptr){
+            audioReader->Close();
+            delete audioReader;
+            audioReader = nullptr;
+        }
+
+        if(transcoder->isWriteFail){
+            transcoder->errorDesc = "写入文件失败";
+            return -1;
+        }
+        if(ret < -1){
+            return -1;
+        }
+        return 0;
+    }
+
+    int EyerAVTranscoderSegment::ReadVideoPacket(EyerAVPacket & packet, EyerAVWriter * writer, int writeStreamId)
+    {
+        while(1){
+            if(videoReader == nullptr){
+                videoChunkIndex++;
+                if(videoChunkIndex >= videoChunkList.size()){
+                    return -1;
+                }
+                videoReader = new EyerAVReader(videoChunkList[videoChunkIndex]->path);
+                int ret = videoReader->Open();
+                if(ret){
+                    delete videoReader;
+                    videoReader = nullptr;
+                    return -2;
+                }
+                videoStreamIndex = videoReader->GetVideoStreamIndex();
+                if(videoStreamIndex < 0){
+                    videoReader->Close();
+                    delete videoReader;
+                    videoReader = nullptr;
+                    return -2;
+                }
+                videoReadTimebase = videoReader->GetStream(videoStreamIndex).GetTimebase();
+            }
+
+            int ret = EyerAVTranscoderSegment_ReadStreamPacket(videoReader, videoStreamIndex, packet);
+            if(ret){
+                videoReader->Close();
+                delete videoReader;
+                videoReader = nullptr;
+                continue;
+            }
+
+            // 每段都从 0 开始, 加上该段在最终文件中的起始时间
+            EyerAVTranscoderSegmentChunk * chunk = videoChunkList[videoChunkIndex];
+            int64_t offset = EyerAVRational::RescaleQ((int64_t)(chunk->offsetTime * 1000000), EyerAVRational(1, 1000000), videoReadTimebase);
+            packet.OffsetTs(-offset);
+
+            packet.SetStreamIndex(writeStreamId);
+            packet.RescaleTs(videoReadTimebase, writer->GetTimebase(writeStreamId));
+            return 0;
+        }
+        return -1;
+    }
+
+    int EyerAVTranscoderSegment::RemoveTempFile(bool keepFinished)
+    {
+        for(int i = 0; i < chunkList.size(); i++){
+            if(keepFinished && chunkList[i]->isSucc){
+                continue;
+            }
+            remove(chunkList[i]->path.c_str());
+        }
+        return 0;
+    }
+
+    EyerString EyerAVTranscoderSegment::GetPlan()
+    {
+        EyerString plan = "";
+        for(int i = 0; i < chunkList.size(); i++){
+            EyerAVTranscoderSegmentChunk * chunk = chunkList[i];
+            char buf[128];
+            snprintf(buf, sizeof(buf), "%d:%.3f-%.3f;", chunk->index, chunk->startTime, chunk->endTime);
+            plan += buf;
+        }
+        return plan;
+    }
+
+    int EyerAVTranscoderSegment::LoadCheckpoint()
+    {
+        EyerString inputFingerprint = EyerAVTranscoderCheckpoint::GetInputFingerprint(transcoder->inputPath);
+        EyerString paramsFingerprint = EyerAVTranscoderCheckpoint::GetParamsFingerprint(transcoder->params);
+        EyerString plan = GetPlan();
+
+        std::vector<int> doneList;
+        int ret = checkpoint.Load();
+        if(ret == 0 && checkpoint.inputFingerprint == inputFingerprint && checkpoint.paramsFingerprint == paramsFingerprint && checkpoint.plan == plan){
+            for(int i = 0; i < chunkList.size(); i++){
+                EyerAVTranscoderSegmentChunk * chunk = chunkList[i];
+                if(!checkpoint.IsDone(chunk->index)){
+                    continue;
+                }
+                // 检查点里记录完成, 但是分段文件已经被删掉
+                FILE * f = fopen(chunk->path.c_str(), "rb");
+                if(f == nullptr){
+                    continue;
+                }
+                fclose(f);
+
+                chunk->isSucc = true;
+                chunk->progress = 1.0;
+                doneList.push_back(chunk->index);
+            }
+            EyerLog("Segment resume from checkpoint, finished chunk: %d / %d\n", (int)doneList.size(), (int)chunkList.size());
+        }
+        else if(ret == 0){
+            EyerLog("Segment checkpoint not match, start over\n");
+        }
+
+        checkpoint.inputFingerprint = inputFingerprint;
+        checkpoint.paramsFingerprint = paramsFingerprint;
+        checkpoint.plan = plan;
+        checkpoint.doneList = doneList;
+        return checkpoint.Save();
+    }
+
+    int EyerAVTranscoderSegment::SetChunkDone(EyerAVTranscoderSegmentChunk * chunk)
+    {
+        std::lock_guard<std::mutex> lg(checkpointMut);
+        checkpoint.SetDone(chunk->index);
+        return checkpoint.Save();
+    }
+}
@@ -0,0 +1,99 @@
+#ifndef EYERLIB_EYERAVTRANSCODERSEGMENT_HPP
+#define EYERLIB_EYERAVTRANSCODERSEGMENT_HPP
+
+#include <vector>
+#include <mutex>
+#include <atomic>
+
+#include "EyerCore/EyerCore.hpp"
+#include "EyerThread/EyerThreadHeader.hpp"
+#include "EyerAV/EyerAVHeader.hpp"
+#include "EyerAVTranscodeProgress.hpp"
+#include "EyerAVTranscoderCheckpoint.hpp"
+
+namespace Eyer
+{
+    class EyerAVTranscoder;
+    class EyerAVTranscoderInterrupt;
+
+    class EyerAVTranscoderSegmentChunk
+    {
+    public:
+        int index = 0;
+        // 音频单独作为一个任务整段转码, 避免 AAC 等编码器在分段边界处产生的静音/跳变
+        bool isAudio = false;
+
+        double startTime = 0.0;
+        // 0.0 表示到文件结尾
+        double endTime = 0.0;
+        // 在最终文件中的起始时间, 相对于第一段的起点
+        double offsetTime = 0.0;
+        double duration = 0.0;
+
+        EyerString path;
+
+        bool isSucc = false;
+        float progress = 0.0;
+        int64_t frameNum = 0;
+        int64_t bytesWritten = 0;
+    };
+
+    // 分段并行转码:
+    // 1. 扫描视频流的关键帧位置, 按 GOP 边界把输入切成 N 段
+    // 2. 每段由一个 worker 用独立的 EyerAVReader/EyerAVDecoder/EyerAVEncoder 转码到临时文件, 音频整段单独转码
+    // 3. 把各段视频和音频按时间戳交错, 无损拼接到最终的输出文件
+    // 断点续转时每完成一段就更新检查点, 中断后保留已完成的分段, 下次转码跳过这些分段
+    class EyerAVTranscoderSegment
+    {
+    public:
+        EyerAVTranscoderSegment(EyerAVTranscoder * transcoder, EyerAVTranscoderInterrupt * interrupt);
+        ~EyerAVTranscoderSegment();
+
+        // 各段 worker 会并发调用 interrupt->interrupt(), 实现需要线程安全
+        // 返回 0 成功, -1 失败, 1 表示该输入不适合分段 (没有视频流, 视频流复制, 关键帧不足), 调用者走普通流程
+        int Run();
+
+        bool IsInterrupt();
+
+        int WorkLoop();
+        int OnChunkProgress(EyerAVTranscoderSegmentChunk * chunk, const EyerAVTranscodeProgress & progress);
+
+    private:
+        int ScanKeyFrame(std::vector<double> & keyFrameList, double & duration);
+        int SplitChunk(std::vector<double> & keyFrameList, double duration);
+        int TranscodeChunk(EyerAVTranscoderSegmentChunk * chunk);
+        int Concat();
+        int ReadVideoPacket(EyerAVPacket & packet, EyerAVWriter * writer, int writeStreamId);
+        // keepFinished 为 true 时保留已经完成的分段, 给下次续转使用
+        int RemoveTempFile(bool keepFinished = false);
+
+        EyerString GetPlan();
+        int LoadCheckpoint();
+        int SetChunkDone(EyerAVTranscoderSegmentChunk * chunk);
+
+        EyerAVTranscoder * transcoder = nullptr;
+        EyerAVTranscoderInterrupt * interrupt = nullptr;
+
+        std::vector<EyerAVTranscoderSegmentChunk *> chunkList;
+        std::vector<EyerAVTranscoderSegmentChunk *> videoChunkList;
+        EyerAVTranscoderSegmentChunk * audioChunk = nullptr;
+        bool hasAudio = false;
+
+        std::atomic_int nextChunk {0};
+        std::atomic_bool isInterrupt {false};
+        std::atomic_bool isFail {false};
+
+        std::mutex progressMut;
+
+        std::mutex checkpointMut;
+        EyerAVTranscoderCheckpoint checkpoint;
+
+        // 拼接时当前读取的视频段
+        int videoChunkIndex = -1;
+        EyerAVReader * videoReader = nullptr;
+        int videoStreamIndex = -1;
+        EyerAVRational videoReadTimebase;
+    };
+}
+
+#endif //EYERLIB_EYERAVTRANSCODERSEGMENT_HPP
@@ -0,0 +1,733 @@
+#include "EyerAVTranscoderSmartCut.hpp"
+
+#include <stdio.h>
+#include <string>
+
+#include "EyerAVTranscoder.hpp"
+
+namespace Eyer
+{
+    // 头部的结束时间取 K1 之前一点, Transcoder 的 range 处理会包含 endTime 这一帧
+    static const double SMART_CUT_EPSILON = 0.001;
+
+    class EyerAVTranscoderSmartCutListener : public EyerAVTranscoderListener
+    {
+    public:
+        EyerAVTranscoderSmartCutListener(EyerAVTranscoderSmartCut * _smartCut, EyerAVTranscoderSmartCutPart * _part)
+        {
+            smartCut = _smartCut;
+            part = _part;
+        }
+
+        virtual int OnProgress(float progress) override
+        {
+            return 0;
+        }
+
+        virtual int OnProgressInfo(const EyerAVTranscodeProgress & progress) override
+        {
+            return smartCut->OnPartProgress(part, progress);
+        }
+
+        virtual int OnFail(EyerAVTranscoderError & error) override
+        {
+            EyerLog("Smart cut part %s fail: %s\n", part->path.c_str(), error.GetDesc().c_str());
+            return 0;
+        }
+
+        virtual int OnSuccess() override
+        {
+            return 0;
+        }
+
+    private:
+        EyerAVTranscoderSmartCut * smartCut = nullptr;
+        EyerAVTranscoderSmartCutPart * part = nullptr;
+    };
+
+    static int EyerAVTranscoderSmartCut_ReadStreamPacket(EyerAVReader * reader, int streamIndex, EyerAVPacket & packet)
+    {
+        while(1){
+            int ret = reader->Read(packet);
+            if(ret){
+                return ret;
+            }
+            if(packet.GetStreamIndex() == streamIndex){
+                return 0;
+            }
+        }
+        return -1;
+    }
+
+    static double EyerAVTranscoderSmartCut_SecDTS(EyerAVPacket & packet, const EyerAVRational & timebase)
+    {
+        return packet.GetDTS() * 1.0 * timebase.num / timebase.den;
+    }
+
+    static EyerAVBitstreamFilterType EyerAVTranscoderSmartCut_AnnexBFilter(EyerAVStream & stream)
+    {
+        if(stream.GetCodecID() == EyerAVCodecID::CODEC_ID_H265){
+            return EyerAVBitstreamFilterType::HEVC_MP4TOANNEXB;
+        }
+        return EyerAVBitstreamFilterType::H264_MP4TOANNEXB;
+    }
+
+    EyerAVTranscoderSmartCut::EyerAVTranscoderSmartCut(EyerAVTranscoder * _transcoder, EyerAVTranscoderInterrupt * _interrupt)
+    {
+        transcoder = _transcoder;
+        interrupt = _interrupt;
+    }
+
+    EyerAVTranscoderSmartCut::~EyerAVTranscoderSmartCut()
+    {
+        CloseVideoPart();
+        for(int i = 0; i < partList.size(); i++){
+            delete partList[i];
+        }
+        partList.clear();
+        videoPartList.clear();
+        copyPart = nullptr;
+        audioPart = nullptr;
+    }
+
+    int EyerAVTranscoderSmartCut::Run()
+    {
+        int ret = Plan();
+        if(ret){
+            return ret;
+        }
+
+        EyerLog("Smart cut, video part num: %d, copy: %f - %f\n", (int)videoPartList.size(), copyPart->startTime, copyPart->startTime + copyPart->duration);
+
+        for(int i = 0; i < partList.size(); i++){
+            EyerAVTranscoderSmartCutPart * part = partList[i];
+            if(part->isCopy){
+                continue;
+            }
+            ret = TranscodePart(part);
+            if(ret){
+                RemoveTempFile();
+                if(isInterrupt){
+                    return 0;
+                }
+                return -1;
+            }
+        }
+
+        ret = Concat();
+        RemoveTempFile();
+        return ret;
+    }
+
+    bool EyerAVTranscoderSmartCut::IsInterrupt()
+    {
+        return isInterrupt;
+    }
+
+    int EyerAVTranscoderSmartCut::Plan()
+    {
+        EyerAVTranscoderParams & params = transcoder->params;
+
+        if(params.GetStartTime() == 0.0 && params.GetEndTime() == 0.0){
+            return 1;
+        }
+        // 视频整段复制本来就不需要重编码
+        if(!params.GetCareVideo() || params.GetVideoCopyMode() == EyerAVTranscoderCopyMode::COPY){
+            return 1;
+        }
+
+        EyerAVReader reader(transcoder->inputPath);
+        int ret = reader.Open();
+        if(ret){
+            // 交给普通流程报告打开失败
+            return 1;
+        }
+
+        double duration = reader.GetDuration();
+
+        int videoIndex = reader.GetVideoStreamIndex();
+        if(videoIndex < 0){
+            reader.Close();
+            return 1;
+        }
+
+        // 两端重编码的结果要和复制的 GOP 拼在同一条流里, 编码和画面参数必须和输入一致
+        inputVideoStream = reader.GetStream(videoIndex);
+        EyerAVCodecID codecId = inputVideoStream.GetCodecID();
+        if(codecId != EyerAVCodecID::CODEC_ID_H264 && codecId != EyerAVCodecID::CODEC_ID_H265){
+            reader.Close();
+            return 1;
+        }
+        if(codecId != params.GetVideoCodecId()){
+            reader.Close();
+            return 1;
+        }
+        if((params.GetWidth() > 0 && params.GetWidth() != inputVideoStream.GetWidth()) ||
+           (params.GetHeight() > 0 && params.GetHeight() != inputVideoStream.GetHeight())){
+            reader.Close();
+            return 1;
+        }
+        if(params.GetVideoPixelFormat() != EyerAVPixelFormat::EYER_KEEP_SAME && params.GetVideoPixelFormat() != inputVideoStream.GetPixelFormat()){
+            reader.Close();
+            return 1;
+        }
+
+        bool hasAudio = reader.GetAudioStreamIndex() >= 0 && params.GetCareAudio();
+
+        double rangeStart = params.GetStartTime();
+        double rangeEnd = duration;
+        hasTail = false;
+        if(params.GetEndTime() != 0.0 && params.GetEndTime() < duration){
+            rangeEnd = params.GetEndTime();
+            hasTail = true;
+        }
+        if(rangeEnd - rangeStart <= 0.0){
+            reader.Close();
+            return 1;
+        }
+
+        // 只读区间内的包, 从长文件中裁剪一小段时不需要扫描整个文件
+        if(rangeStart != 0.0){
+            reader.Seek(rangeStart);
+        }
+
+        double keyFrameStart = -1.0;
+        double keyFrameEnd = -1.0;
+        int64_t rangeBytes = 0;
+        double firstPTS = -1.0;
+        double lastPTS = -1.0;
+        EyerAVPacket packet;
+        while(1){
+            ret = EyerAVTranscoderSmartCut_ReadStreamPacket(&reader, videoIndex, packet);
+            if(ret){
+                break;
+            }
+            double secPTS = packet.GetSecPTS();
+            if(packet.IsKeyFrame()){
+                if(secPTS > rangeEnd){
+                    break;
+                }
+                if(secPTS >= rangeStart){
+                    if(keyFrameStart < 0.0){
+                        keyFrameStart = secPTS;
+                    }
+                    keyFrameEnd = secPTS;
+                }
+            }
+            if(secPTS < rangeStart || secPTS > rangeEnd){
+                continue;
+            }
+            rangeBytes += packet.GetSize();
+            if(firstPTS < 0.0 || secPTS < firstPTS){
+                firstPTS = secPTS;
+            }
+            if(secPTS > lastPTS){
+                lastPTS = secPTS;
+            }
+        }
+        reader.Close();
+
+        // 区间内至少要有一个完整的 GOP, 否则复制不了任何东西
+        if(keyFrameStart < 0.0){
+            EyerLog("Smart cut, no key frame in range\n");
+            return 1;
+        }
+        if(hasTail && keyFrameEnd <= keyFrameStart){
+            EyerLog("Smart cut, no complete GOP in range\n");
+            return 1;
+        }
+
+        if(lastPTS > firstPTS){
+            inputBitrate = (int)(rangeBytes * 8 / (lastPTS - firstPTS) / 1000);
+        }
+
+        // 临时文件和输出使用相同的封装格式
+        std::string outputPath = transcoder->outputPath.c_str();
+        std::string suffix = "";
+        size_t dotPos = outputPath.find_last_of('.');
+        if(dotPos != std::string::npos){
+            suffix = outputPath.substr(dotPos);
+        }
+
+        if(keyFrameStart - rangeStart > SMART_CUT_EPSILON){
+            EyerAVTranscoderSmartCutPart * head = new EyerAVTranscoderSmartCutPart();
+            head->startTime = rangeStart;
+            head->endTime = keyFrameStart - SMART_CUT_EPSILON;
+            head->offsetTime = 0.0;
+            head->duration = keyFrameStart - rangeStart;
+            head->path = transcoder->outputPath + ".smartcut_head" + suffix.c_str();
+            partList.push_back(head);
+            videoPartList.push_back(head);
+        }
+
+        copyPart = new EyerAVTranscoderSmartCutPart();
+        copyPart->isCopy = true;
+        copyPart->startTime = keyFrameStart;
+        // 输入的时间戳没有重新从 0 开始, 减去区间起点
+        copyPart->offsetTime = -rangeStart;
+        if(hasTail){
+            copyPart->endTime = keyFrameEnd;
+            copyPart->duration = keyFrameEnd - keyFrameStart;
+        }
+        else{
+            copyPart->endTime = 0.0;
+            copyPart->duration = rangeEnd - keyFrameStart;
+        }
+        partList.push_back(copyPart);
+        videoPartList.push_back(copyPart);
+
+        if(hasTail){
+            EyerAVTranscoderSmartCutPart * tail = new EyerAVTranscoderSmartCutPart();
+            tail->startTime = keyFrameEnd;
+            tail->endTime = rangeEnd;
+            tail->offsetTime = keyFrameEnd - rangeStart;
+            tail->duration = rangeEnd - keyFrameEnd;
+            tail->path = transcoder->outputPath + ".smartcut_tail" + suffix.c_str();
+            partList.push_back(tail);
+            videoPartList.push_back(tail);
+        }
+
+        if(hasAudio){
+            audioPart = new EyerAVTranscoderSmartCutPart();
+            audioPart->isAudio = true;
+            audioPart->startTime = rangeStart;
+            audioPart->endTime = params.GetEndTime();
+            audioPart->duration = rangeEnd - rangeStart;
+            audioPart->path = transcoder->outputPath + ".smartcut_audio" + suffix.c_str();
+            partList.push_back(audioPart);
+        }
+
+        return 0;
+    }
+
+    int EyerAVTranscoderSmartCut::TranscodePart(EyerAVTranscoderSmartCutPart * part)
+    {
+        EyerAVTranscoderParams params = transcoder->params;
+        params.SetSmartCut(false);
+        params.SetSegmentNum(1);
+        params.SetResumable(false);
+        // 临时文件只给拼接读取, 封装方式只作用于最终输出
+        params.SetMovMode(EyerAVTranscoderMovMode::NORMAL);
+        params.SetPipeline(false);
+        params.SetStartTime(part->startTime);
+        params.SetEndTime(part->endTime);
+        if(part->isAudio){
+            params.SetCareVideo(false);
+        }
+        else{
+            params.SetCareAudio(false);
+            // 和复制的 GOP 使用一样的像素格式和平均码率, 边界处画质不跳变
+            params.SetVideoCopyMode(EyerAVTranscoderCopyMode::ENCODE);
+            params.SetVideoPixelFormat(inputVideoStream.GetPixelFormat());
+            if(inputBitrate > 0){
+                params.SetRateControl(EyerAVRateControl::ABR);
+                params.SetBitrate(inputBitrate);
+            }
+        }
+
+        EyerAVTranscoderSmartCutListener listener(this, part);
+
+        EyerAVTranscoder partTranscoder(transcoder->inputPath);
+        partTranscoder.SetOutputPath(part->path);
+        partTranscoder.SetParams(params);
+        partTranscoder.SetListener(&listener);
+        partTranscoder.Transcode(interrupt);
+
+        EyerAVTranscodeProfile partProfile = partTranscoder.GetProfile();
+        {
+            std::lock_guard<std::mutex> lg(transcoder->profileMut);
+            transcoder->profile.Merge(partProfile);
+        }
+
+        if(partTranscoder.GetStatus() == EyerAVTranscoderStatus::SUCC){
+            EyerAVTranscodeProgress progress;
+            progress.progress = 1.0;
+            progress.frameNum = partProfile.GetStageTotal(STAGE_SCALE).count;
+            for(int i = 0; i < partProfile.streamList.size(); i++){
+                progress.bytesWritten += partProfile.streamList[i].bytesOut;
+            }
+            OnPartProgress(part, progress);
+            return 0;
+        }
+
+        if(interrupt != nullptr && interrupt->interrupt()){
+            isInterrupt = true;
+        }
+        else{
+            transcoder->errorDesc = partTranscoder.GetErrorDesc();
+        }
+        return -1;
+    }
+
+    int EyerAVTranscoderSmartCut::OnPartProgress(EyerAVTranscoderSmartCutPart * part, const EyerAVTranscodeProgress & progress)
+    {
+        part->progress = progress.progress;
+        part->frameNum = progress.frameNum;
+        part->bytesWritten = progress.bytesWritten;
+
+        if(transcoder->listener == nullptr){
+            return 0;
+        }
+        if(progress.progress < 1.0 && !transcoder->IsProgressDue()){
+            return 0;
+        }
+
+        int64_t frameNum = 0;
+        int64_t bytesWritten = 0;
+        for(int i = 0; i < partList.size(); i++){
+            frameNum += partList[i]->frameNum;
+            bytesWritten += partList[i]->bytesWritten;
+        }
+
+        // 按每部分的时长加权, 音频不计入
+        double totalDuration = 0.0;
+        double finishDuration = 0.0;
+        for(int i = 0; i < videoPartList.size(); i++){
+            totalDuration += videoPartList[i]->duration;
+            finishDuration += videoPartList[i]->duration * videoPartList[i]->progress;
+        }
+
+        float totalProgress = 0.0;
+        if(totalDuration > 0.0){
+            totalProgress = finishDuration / totalDuration;
+        }
+        if(totalProgress >= 1.0){
+            totalProgress = 1.0;
+        }
+        transcoder->NotifyProgress(totalProgress, finishDuration, frameNum, bytesWritten);
+
+        return 0;
+    }
+
+    int EyerAVTranscoderSmartCut::Concat()
+    {
+        // 重编码部分取临时文件大小, 复制部分按输入码率估计
+        int64_t estimateSize = 0;
+        for(int i = 0; i < partList.size(); i++){
+            if(partList[i]->isCopy){
+                estimateSize += (int64_t)(inputBitrate * 1000.0 * partList[i]->duration / 8);
+            }
+            else{
+                estimateSize += EyerAVTranscoder::GetFileSize(partList[i]->path);
+            }
+        }
+
+        EyerAVWriter writer(transcoder->outputPath);
+        int ret = transcoder->InitWriter(&writer, estimateSize);
+        if(ret){
+            return -1;
+        }
+        ret = writer.Open();
+        if(ret){
+            transcoder->errorDesc = "输出路径不存在或不可写";
+            return -1;
+        }
+
+        // 输出流使用输入视频流转成 Annex B 之后的参数, 封装器写文件头时会转回 avcC/hvcC
+        // 重编码部分的 SPS/PPS 和 avcC/hvcC 不同, 写成 avc3/hev1 让码流内的参数集生效
+        int videoWriteStreamId = -1;
+        {
+            EyerAVBitstreamFilter bsf(EyerAVTranscoderSmartCut_AnnexBFilter(inputVideoStream), inputVideoStream);
+            EyerAVStream outputStream = inputVideoStream;
+            bsf.GetOutputStream(outputStream);
+            videoWriteStreamId = writer.AddStream(outputStream);
+            writer.SetInBandParameterSets(videoWriteStreamId);
+        }
+
+        maxDecodeDelay = 0.0;
+        for(int i = 0; i < videoPartList.size(); i++){
+            ProbeDecodeDelay(videoPartList[i]);
+            if(videoPartList[i]->decodeDelay > maxDecodeDelay){
+                maxDecodeDelay = videoPartList[i]->decodeDelay;
+            }
+        }
+
+        EyerAVReader * audioReader = nullptr;
+        int audioStreamIndex = -1;
+        int audioWriteStreamId = -1;
+        EyerAVRational audioReadTimebase;
+        if(audioPart != nullptr){
+            audioReader = new EyerAVReader(audioPart->path);
+            ret = audioReader->Open();
+            if(ret == 0){
+                audioStreamIndex = audioReader->GetAudioStreamIndex();
+            }
+            if(audioStreamIndex >= 0){
+                EyerAVStream audioStream = audioReader->GetStream(audioStreamIndex);
+                audioReadTimebase = audioStream.GetTimebase();
+                audioWriteStreamId = writer.AddStream(audioStream);
+            }
+        }
+
+        ret = writer.WriteHand();
+        if(ret){
+            transcoder->errorDesc = "写入视频头失败";
+            if(audioReader != nullptr){
+                audioReader->Close();
+                delete audioReader;
+            }
+            return -1;
+        }
+
+        EyerAVRational videoWriteTimebase = writer.GetTimebase(videoWriteStreamId);
+        EyerAVRational audioWriteTimebase;
+        if(audioWriteStreamId >= 0){
+            audioWriteTimebase = writer.GetTimebase(audioWriteStreamId);
+        }
+
+        EyerAVPacket videoPacket;
+        ret = ReadVideoPacket(videoPacket, &writer, videoWriteStreamId);
+        bool videoEnd = ret != 0;
+        // 某一部分无法拼接, 输出作废, 回退到普通流程
+        bool isPartFail = ret < -1;
+
+        EyerAVPacket audioPacket;
+        bool audioEnd = true;
+        if(audioWriteStreamId >= 0){
+            audioEnd = EyerAVTranscoderSmartCut_ReadStreamPacket(audioReader, audioStreamIndex, audioPacket) != 0;
+            audioPacket.SetStreamIndex(audioWriteStreamId);
+            audioPacket.RescaleTs(audioReadTimebase, audioWriteTimebase);
+        }
+
+        // 按 DTS 交错写入
+        while(!isPartFail && (!videoEnd || !audioEnd)){
+            bool writeVideo = audioEnd;
+            if(!videoEnd && !audioEnd){
+                writeVideo = EyerAVTranscoderSmartCut_SecDTS(videoPacket, videoWriteTimebase) <= EyerAVTranscoderSmartCut_SecDTS(audioPacket, audioWriteTimebase);
+            }
+
+            if(writeVideo){
+                if(writer.WritePacket(videoPacket)){
+                    transcoder->isWriteFail = true;
+                    break;
+                }
+                ret = ReadVideoPacket(videoPacket, &writer, videoWriteStreamId);
+                if(ret){
+                    videoEnd = true;
+                    if(ret < -1){
+                        isPartFail = true;
+                        break;
+                    }
+                }
+            }
+            else{
+                if(writer.WritePacket(audioPacket)){
+                    transcoder->isWriteFail = true;
+                    break;
+                }
+                audioEnd = EyerAVTranscoderSmartCut_ReadStreamPacket(audioReader, audioStreamIndex, audioPacket) != 0;
+                audioPacket.SetStreamIndex(audioWriteStreamId);
+                audioPacket.RescaleTs(audioReadTimebase, audioWriteTimebase);
+            }
+
+            // 复制部分可能很长, 拼接过程中也要响应取消
+            if(interrupt != nullptr && interrupt->interrupt()){
+                isInterrupt = true;
+                break;
+            }
+        }
+
+        // 异步写入时封装线程中的错误也由 WriteTrailer 返回
+        if(writer.WriteTrailer()){
+            transcoder->isWriteFail = true;
+        }
+        writer.Close();
+
+        if(audioReader != nullptr){
+            audioReader->Close();
+            delete audioReader;
+            audioReader = nullptr;
+        }
+
+        if(transcoder->isWriteFail){
+            transcoder->errorDesc = "写入文件失败";
+            return -1;
+        }
+        if(isInterrupt){
+            return 0;
+        }
+        if(isPartFail){
+            remove(transcoder->outputPath.c_str());
+            EyerLog("Smart cut concat fail, use normal transcode\n");
+            return 1;
+        }
+
+        EyerAVTranscodeProgress progress;
+        progress.progress = 1.0;
+        progress.frameNum = copyPart->frameNum;
+        progress.bytesWritten = copyPart->bytesWritten;
+        OnPartProgress(copyPart, progress);
+        return 0;
+    }
+
+    int EyerAVTranscoderSmartCut::ReadVideoPacket(EyerAVPacket & packet, EyerAVWriter * writer, int writeStreamId)
+    {
+        while(1){
+            if(videoReader == nullptr){
+                videoPartIndex++;
+                if(videoPartIndex >= videoPartList.size()){
+                    return -1;
+                }
+                EyerAVTranscoderSmartCutPart * part = videoPartList[videoPartIndex];
+                if(part->isCopy){
+                    videoReader = new EyerAVReader(transcoder->inputPath);
+                }
+                else{
+                    videoReader = new EyerAVReader(part->path);
+                }
+                int ret = videoReader->Open();
+                if(ret){
+                    delete videoReader;
+                    videoReader = nullptr;
+                    EyerLog("Smart cut open part fail\n");
+                    return -2;
+                }
+                videoStreamIndex = videoReader->GetVideoStreamIndex();
+                if(videoStreamIndex < 0){
+                    CloseVideoPart();
+                    EyerLog("Smart cut open part fail\n");
+                    return -2;
+                }
+                EyerAVStream stream = videoReader->GetStream(videoStreamIndex);
+                videoReadTimebase = stream.GetTimebase();
+                // 每部分的 extradata 不同, 各自转成 Annex B, 关键帧前插入自己的 SPS/PPS
+                videoBsf = new EyerAVBitstreamFilter(EyerAVTranscoderSmartCut_AnnexBFilter(stream), stream);
+
+                isCopyStarted = false;
+                if(part->isCopy && part->startTime != 0.0){
+                    videoReader->Seek(part->startTime);
+                }
+            }
+
+            EyerAVTranscoderSmartCutPart * part = videoPartList[videoPartIndex];
+
+            int ret = EyerAVTranscoderSmartCut_ReadStreamPacket(videoReader, videoStreamIndex, packet);
+            if(ret){
+                CloseVideoPart();
+                continue;
+            }
+
+            if(part->isCopy){
+                double secPTS = packet.GetSecPTS();
+                // Seek 可能落在 K1 之前的关键帧, 从 K1 开始复制
+                if(!isCopyStarted){
+                    if(!packet.IsKeyFrame() || secPTS < part->startTime - SMART_CUT_EPSILON){
+                        continue;
+                    }
+                    isCopyStarted = true;
+                }
+                // 到 K2 为止, 之后接尾部重编码的部分
+                if(hasTail && packet.IsKeyFrame() && secPTS >= part->endTime - SMART_CUT_EPSILON){
+                    CloseVideoPart();
+                    continue;
+                }
+                // 开放 GOP 中显示在 K1 之前的帧已经包含在头部里
+                if(secPTS < part->startTime - SMART_CUT_EPSILON){
+                    continue;
+                }
+
+                EyerAVTranscodeProgress progress;
+                progress.progress = (secPTS - part->startTime) / part->duration;
+                if(progress.progress > 1.0){
+                    progress.progress = 1.0;
+                }
+                progress.frameNum = part->frameNum + 1;
+                progress.bytesWritten = part->bytesWritten + packet.GetSize();
+                OnPartProgress(part, progress);
+            }
+
+            ret = videoBsf->SendPacket(packet);
+            if(ret < 0){
+                continue;
+            }
+            ret = videoBsf->RecvPacket(packet);
+            if(ret < 0){
+                continue;
+            }
+
+            int64_t offset = EyerAVRational::RescaleQ((int64_t)(part->offsetTime * 1000000), EyerAVRational(1, 1000000), videoReadTimebase);
+            packet.OffsetTs(-offset);
+
+            EyerAVRational writeTimebase = writer->GetTimebase(writeStreamId);
+            packet.SetStreamIndex(writeStreamId);
+            packet.RescaleTs(videoReadTimebase, writeTimebase);
+
+            // 重编码部分和复制部分的解码延迟不同, 延迟小的部分 DTS 往前移, 边界处 DTS 不会重叠
+            int64_t delay = EyerAVRational::RescaleQ((int64_t)((maxDecodeDelay - part->decodeDelay) * 1000000), EyerAVRational(1, 1000000), writeTimebase);
+            packet.SetDTS(packet.GetDTS() - delay);
+
+            // 剩下的只有时间基换算的舍入误差, 同样只调整 DTS, PTS 不变
+            if(lastVideoDTS != INT64_MIN && packet.GetDTS() <= lastVideoDTS){
+                packet.SetDTS(lastVideoDTS + 1);
+                if(packet.GetPTS() < packet.GetDTS()){
+                    CloseVideoPart();
+                    EyerLog("Smart cut dts not monotonic at part boundary\n");
+                    return -2;
+                }
+            }
+            lastVideoDTS = packet.GetDTS();
+            return 0;
+        }
+        return -1;
+    }
+
+    int EyerAVTranscoderSmartCut::ProbeDecodeDelay(EyerAVTranscoderSmartCutPart * part)
+    {
+        part->decodeDelay = 0.0;
+
+        EyerAVReader reader(part->isCopy ? transcoder->inputPath : part->path);
+        if(reader.Open()){
+            return -1;
+        }
+        int streamIndex = reader.GetVideoStreamIndex();
+        if(streamIndex < 0){
+            reader.Close();
+            return -1;
+        }
+        EyerAVStream stream = reader.GetStream(streamIndex);
+        EyerAVRational timebase = stream.GetTimebase();
+        if(part->isCopy && part->startTime != 0.0){
+            reader.Seek(part->startTime);
+        }
+
+        // 和 ReadVideoPacket 一样, 复制部分从 K1 开始
+        EyerAVPacket packet;
+        while(EyerAVTranscoderSmartCut_ReadStreamPacket(&reader, streamIndex, packet) == 0){
+            if(!packet.IsKeyFrame()){
+                continue;
+            }
+            if(part->isCopy && packet.GetSecPTS() < part->startTime - SMART_CUT_EPSILON){
+                continue;
+            }
+            part->decodeDelay = (packet.GetPTS() - packet.GetDTS()) * 1.0 * timebase.num / timebase.den;
+            break;
+        }
+        reader.Close();
+        return 0;
+    }
+
+    int EyerAVTranscoderSmartCut::CloseVideoPart()
+    {
+        if(videoBsf != nullptr){
+            delete videoBsf;
+            videoBsf = nullptr;
+        }
+        if(videoReader != nullptr){
+            videoReader->Close();
+            delete videoReader;
+            videoReader = nullptr;
+        }
+        return 0;
+    }
+
+    int EyerAVTranscoderSmartCut::RemoveTempFile()
+    {
+        for(int i = 0; i < partList.size(); i++){
+            if(partList[i]->isCopy){
+                continue;
+            }
+            remove(partList[i]->path.c_str());
+        }
+        return 0;
+    }
+}
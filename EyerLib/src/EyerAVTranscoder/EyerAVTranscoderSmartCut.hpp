@@ -0,0 +1,97 @@
+#ifndef EYERLIB_EYERAVTRANSCODERSMARTCUT_HPP
+#define EYERLIB_EYERAVTRANSCODERSMARTCUT_HPP
+
+#include <vector>
+#include <stdint.h>
+
+#include "EyerCore/EyerCore.hpp"
+#include "EyerAV/EyerAVHeader.hpp"
+#include "EyerAVTranscodeProgress.hpp"
+
+namespace Eyer
+{
+    class EyerAVTranscoder;
+    class EyerAVTranscoderInterrupt;
+
+    class EyerAVTranscoderSmartCutPart
+    {
+    public:
+        // 中间完整的 GOP 直接从输入文件复制, 不产生临时文件
+        bool isCopy = false;
+        bool isAudio = false;
+
+        double startTime = 0.0;
+        // 0.0 表示到文件结尾
+        double endTime = 0.0;
+        // 写入最终文件时加到时间戳上的偏移, 单位秒
+        double offsetTime = 0.0;
+        double duration = 0.0;
+        // 第一个关键帧 PTS 和 DTS 的差, 单位秒, 不同编码器的 B 帧重排延迟不同
+        double decodeDelay = 0.0;
+
+        EyerString path;
+
+        float progress = 0.0;
+        int64_t frameNum = 0;
+        int64_t bytesWritten = 0;
+    };
+
+    // 智能裁剪:
+    // 1. 从起始时间 Seek, 只扫描区间内视频包, 找到区间内第一个关键帧 K1 和最后一个关键帧 K2
+    // 2. [start, K1) 和 [K2, end] 两段不完整的 GOP 用和输入一致的编码, 尺寸, 码率重编码到临时文件
+    // 3. [K1, K2) 之间完整的 GOP 直接复制数据包, 音频整段单独转码
+    // 4. 视频包统一转成 Annex B, 每个关键帧前都带有 SPS/PPS, 重编码部分和复制部分的参数集可以不同
+    //    输出写成 avc3/hev1, 码流内的参数集变化是合法的
+    // 5. 各部分的解码延迟对齐到最大的一个, 只把 DTS 往前移, 显示时间不变
+    class EyerAVTranscoderSmartCut
+    {
+    public:
+        EyerAVTranscoderSmartCut(EyerAVTranscoder * transcoder, EyerAVTranscoderInterrupt * interrupt);
+        ~EyerAVTranscoderSmartCut();
+
+        // 返回 0 成功, -1 失败, 1 表示该输入不适合智能裁剪 (没有设置区间, 编码参数和输入不一致, 区间内没有完整的 GOP, 拼接处无法衔接), 调用者走普通流程
+        int Run();
+
+        bool IsInterrupt();
+
+        int OnPartProgress(EyerAVTranscoderSmartCutPart * part, const EyerAVTranscodeProgress & progress);
+
+    private:
+        int Plan();
+        int TranscodePart(EyerAVTranscoderSmartCutPart * part);
+        int Concat();
+        int ProbeDecodeDelay(EyerAVTranscoderSmartCutPart * part);
+        // 返回 -1 所有部分都读完, -2 无法拼接, 调用者回退到普通流程
+        int ReadVideoPacket(EyerAVPacket & packet, EyerAVWriter * writer, int writeStreamId);
+        int CloseVideoPart();
+        int RemoveTempFile();
+
+        EyerAVTranscoder * transcoder = nullptr;
+        EyerAVTranscoderInterrupt * interrupt = nullptr;
+
+        EyerAVStream inputVideoStream;
+        // 输入视频的平均码率, 单位 kbps, 重编码两端时使用
+        int inputBitrate = 0;
+
+        std::vector<EyerAVTranscoderSmartCutPart *> partList;
+        std::vector<EyerAVTranscoderSmartCutPart *> videoPartList;
+        EyerAVTranscoderSmartCutPart * copyPart = nullptr;
+        EyerAVTranscoderSmartCutPart * audioPart = nullptr;
+        // 复制部分结束于 K2, 没有尾部时复制到文件结尾
+        bool hasTail = false;
+
+        bool isInterrupt = false;
+
+        // 拼接时当前读取的视频部分
+        int videoPartIndex = -1;
+        EyerAVReader * videoReader = nullptr;
+        EyerAVBitstreamFilter * videoBsf = nullptr;
+        int videoStreamIndex = -1;
+        EyerAVRational videoReadTimebase;
+        bool isCopyStarted = false;
+        int64_t lastVideoDTS = INT64_MIN;
+        double maxDecodeDelay = 0.0;
+    };
+}
+
+#endif //EYERLIB_EYERAVTRANSCODERSMARTCUT_HPP
@@ -0,0 +1,122 @@
+#ifndef EYERLIB_ASYNCWRITETEST_HPP
+#define EYERLIB_ASYNCWRITETEST_HPP
+
+#include <stdio.h>
+#include <gtest/gtest.h>
+
+#include "EyerAVTranscoder/EyerAVTranscoderHeader.hpp"
+
+#include "TranscoderTestUtil.hpp"
+
+static int64_t AsyncWriteTest_FileSize(const Eyer::EyerString & path)
+{
+    FILE * f = fopen(path.c_str(), "rb");
+    if(f == nullptr){
+        return -1;
+    }
+    fseek(f, 0, SEEK_END);
+    int64_t size = ftell(f);
+    fclose(f);
+    return size;
+}
+
+TEST(EyerAVTranscoder, EyerAVTranscoderTest_AsyncWrite)
+{
+    Eyer::EyerString inputPath = "./panasonic_S5_h264_1920x1080_yuv420p_30fps_wedding2.MOV";
+
+    Eyer::EyerAVTranscoderParams params;
+    params.SetVideoCodecId(Eyer::EyerAVCodecID::CODEC_ID_H264);
+    params.SetAudioCodecId(Eyer::EyerAVCodecID::CODEC_ID_AAC);
+    params.SetRateControl(Eyer::EyerAVRateControl::ABR);
+    params.SetBitrate(4000);
+    params.SetEndTime(3.0);
+
+    Eyer::EyerAVTranscoder syncTranscoder(inputPath);
+    syncTranscoder.SetOutputPath("./S5_AVC_sync_write_out.MP4");
+    syncTranscoder.SetParams(params);
+    ASSERT_EQ(syncTranscoder.Transcode(nullptr), 0);
+    ASSERT_EQ(syncTranscoder.GetStatus(), Eyer::EyerAVTranscoderStatus::SUCC);
+
+    params.SetAsyncWrite(true);
+    params.SetWriteQueueSize(4);
+    params.SetWriteBufferSize(4 * 1024 * 1024);
+    params.SetWritePreallocate(true);
+
+    Eyer::EyerAVTranscoder asyncTranscoder(inputPath);
+    asyncTranscoder.SetOutputPath("./S5_AVC_async_write_out.MP4");
+    asyncTranscoder.SetParams(params);
+    ASSERT_EQ(asyncTranscoder.Transcode(nullptr), 0);
+    ASSERT_EQ(asyncTranscoder.GetStatus(), Eyer::EyerAVTranscoderStatus::SUCC);
+    ASSERT_GT(asyncTranscoder.GetProfile().asyncWriteTime, 0);
+
+    // 写入的内容和同步写入一致, 预分配的空间在关闭时截断
+    int syncCount = TranscoderTestUtil_CountPacket("./S5_AVC_sync_write_out.MP4");
+    ASSERT_GT(syncCount, 0);
+    ASSERT_EQ(TranscoderTestUtil_CountPacket("./S5_AVC_async_write_out.MP4"), syncCount);
+
+    int64_t syncSize = AsyncWriteTest_FileSize("./S5_AVC_sync_write_out.MP4");
+    int64_t asyncSize = AsyncWriteTest_FileSize("./S5_AVC_async_write_out.MP4");
+    ASSERT_GT(syncSize, 0);
+    ASSERT_LT(asyncSize, syncSize * 11 / 10);
+}
+
+// 写入超过 1MB 之后失败, 模拟磁盘写满
+class AsyncWriteTestFailWriter : public Eyer::EyerAVMemoryWriterCustomIO
+{
+public:
+    virtual int Write(const uint8_t * buf, int buf_size) override
+    {
+        if(GetSize() > 1024 * 1024){
+            return -1;
+        }
+        return Eyer::EyerAVMemoryWriterCustomIO::Write(buf, buf_size);
+    }
+};
+
+class AsyncWriteTestListener : public Eyer::EyerAVTranscoderListener
+{
+public:
+    virtual int OnProgress(float progress) override
+    {
+        return 0;
+    }
+
+    virtual int OnFail(Eyer::EyerAVTranscoderError & error) override
+    {
+        errorCode = error.GetCode();
+        return 0;
+    }
+
+    virtual int OnSuccess() override
+    {
+        return 0;
+    }
+
+    int errorCode = 0;
+};
+
+TEST(EyerAVTranscoder, EyerAVTranscoderTest_AsyncWrite_WriteFail)
+{
+    for(int i = 0; i < 2; i++){
+        bool isAsync = i == 1;
+        Eyer::EyerAVTranscoderParams params;
+        params.SetVideoCodecId(Eyer::EyerAVCodecID::CODEC_ID_H264);
+        params.SetVideoPixelFormat(Eyer::EyerAVPixelFormat::EYER_YUV420P);
+        params.SetAsyncWrite(isAsync);
+
+        AsyncWriteTestFailWriter outputIO;
+        AsyncWriteTestListener listener;
+        Eyer::EyerAVTranscoder transcoder("./panasonic_S5_h264_1920x1080_yuv420p_30fps_wedding2.MOV");
+        // 只用来确定封装格式, 不会创建文件
+        transcoder.SetOutputPath("./S5_AVC_write_fail_out.MP4");
+        transcoder.SetParams(params);
+        transcoder.SetListener(&listener);
+
+        // 同步写入由 WritePacket 返回错误, 异步写入的错误在之后的 WritePacket 或者 WriteTrailer 返回
+        ASSERT_NE(transcoder.Transcode(nullptr, nullptr, &outputIO), 0);
+        ASSERT_EQ(transcoder.GetStatus(), Eyer::EyerAVTranscoderStatus::FAIL);
+        ASSERT_EQ(listener.errorCode, Eyer::EyerAVTranscoderError::WRITE_FAIL.GetCode());
+    }
+}
+
+#endif //EYERLIB_ASYNCWRITETEST_HPP
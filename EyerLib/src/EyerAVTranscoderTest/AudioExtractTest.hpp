@@ -0,0 +1,72 @@
+#ifndef EYERLIB_AUDIOEXTRACTTEST_HPP
+#define EYERLIB_AUDIOEXTRACTTEST_HPP
+
+#include <stdio.h>
+#include <gtest/gtest.h>
+
+#include "EyerAVTranscoder/EyerAVTranscoderHeader.hpp"
+
+static void AudioExtractTest_Run(const Eyer::EyerString & outputPath, const Eyer::EyerAVTranscoderCopyMode & copyMode)
+{
+    Eyer::EyerString inputPath = "./panasonic_S5_h264_1920x1080_yuv420p_30fps_wedding2.MOV";
+
+    Eyer::EyerAVTranscoderParams params;
+    params.SetAudioCodecId(Eyer::EyerAVCodecID::CODEC_ID_AAC);
+    params.SetAudioCopyMode(copyMode);
+    params.SetAudioExtract(true);
+    params.SetEndTime(5.0);
+
+    Eyer::EyerAVTranscoder transcoder(inputPath);
+    transcoder.SetOutputPath(outputPath);
+    transcoder.SetParams(params);
+    int ret = transcoder.Transcode(nullptr);
+    ASSERT_EQ(ret, 0);
+    ASSERT_EQ(transcoder.GetStatus(), Eyer::EyerAVTranscoderStatus::SUCC);
+
+    Eyer::EyerAVReader inputReader(inputPath);
+    ASSERT_EQ(inputReader.Open(), 0);
+    int inputAudioIndex = inputReader.GetAudioStreamIndex();
+    ASSERT_GE(inputAudioIndex, 0);
+    Eyer::EyerAVStream inputStream = inputReader.GetStream(inputAudioIndex);
+    inputReader.Close();
+
+    // 输出只有音频
+    Eyer::EyerAVReader outputReader(outputPath);
+    ASSERT_EQ(outputReader.Open(), 0);
+    ASSERT_EQ(outputReader.GetStreamCount(), 1);
+    ASSERT_LT(outputReader.GetVideoStreamIndex(), 0);
+    int outputAudioIndex = outputReader.GetAudioStreamIndex();
+    ASSERT_GE(outputAudioIndex, 0);
+    Eyer::EyerAVStream outputStream = outputReader.GetStream(outputAudioIndex);
+    outputReader.Close();
+    if(copyMode == Eyer::EyerAVTranscoderCopyMode::ENCODE){
+        ASSERT_EQ(outputStream.GetCodecID(), Eyer::EyerAVCodecID::CODEC_ID_AAC);
+    }
+    else{
+        ASSERT_EQ(outputStream.GetCodecID(), inputStream.GetCodecID());
+    }
+
+    // 视频流在解封装时丢弃, 一个数据包都不会读到
+    Eyer::EyerAVTranscodeProfile profile = transcoder.GetProfile();
+    for(int i = 0; i < profile.streamList.size(); i++){
+        if(profile.streamList[i].mediaType == Eyer::EyerAVMediaType::MEDIA_TYPE_VIDEO.GetName()){
+            ASSERT_EQ(profile.streamList[i].stageTime[Eyer::STAGE_DEMUX].count, 0);
+        }
+        if(i == inputAudioIndex){
+            ASSERT_GT(profile.streamList[i].stageTime[Eyer::STAGE_DEMUX].count, 0);
+        }
+    }
+}
+
+TEST(EyerAVTranscoder, EyerAVTranscoderTest_AudioExtract_Copy)
+{
+    // MOV 能封装输入的音频编码, 直接复制
+    AudioExtractTest_Run("./S5_audio_extract_copy_out.MOV", Eyer::EyerAVTranscoderCopyMode::AUTO);
+}
+
+TEST(EyerAVTranscoder, EyerAVTranscoderTest_AudioExtract_Encode)
+{
+    AudioExtractTest_Run("./S5_audio_extract_encode_out.m4a", Eyer::EyerAVTranscoderCopyMode::ENCODE);
+}
+
+#endif //EYERLIB_AUDIOEXTRACTTEST_HPP
@@ -0,0 +1,111 @@
+#ifndef EYERLIB_CUSTOMIOTEST_HPP
+#define EYERLIB_CUSTOMIOTEST_HPP
+
+#include <stdio.h>
+#include <string.h>
+#include <gtest/gtest.h>
+
+#include "EyerAVTranscoder/EyerAVTranscoderHeader.hpp"
+
+// 从内存中读回转码结果
+class CustomIOTestMemoryReader : public Eyer::EyerAVReaderCustomIO
+{
+public:
+    CustomIOTestMemoryReader(const uint8_t * _data, int64_t _size)
+    {
+        data = _data;
+        size = _size;
+    }
+
+    virtual int Read(uint8_t * buf, int buf_size) override
+    {
+        int64_t len = size - pos;
+        if(len <= 0){
+            return AVERROR_EOF_TAG;
+        }
+        if(len > buf_size){
+            len = buf_size;
+        }
+        memcpy(buf, data + pos, len);
+        pos += len;
+        return len;
+    }
+
+    virtual int64_t Seek(int64_t offset, int whence) override
+    {
+        whence &= ~Eyer::EyerAVWriterCustomIO::SEEK_FORCE;
+        if(whence == Eyer::EyerAVWriterCustomIO::SEEK_SIZE){
+            return size;
+        }
+        if(whence == SEEK_SET){
+            pos = offset;
+        }
+        else if(whence == SEEK_CUR){
+            pos += offset;
+        }
+        else if(whence == SEEK_END){
+            pos = size + offset;
+        }
+        else{
+            return -1;
+        }
+        return pos;
+    }
+
+    // FFmpeg 的 AVERROR_EOF
+    static const int AVERROR_EOF_TAG = -(int)(('E') | ('O' << 8) | ('F' << 16) | ((unsigned)(' ') << 24));
+
+private:
+    const uint8_t * data = nullptr;
+    int64_t size = 0;
+    int64_t pos = 0;
+};
+
+TEST(EyerAVTranscoder, EyerAVTranscoderTest_CustomIO_Memory)
+{
+    Eyer::EyerString inputPath = "./panasonic_S5_h264_1920x1080_yuv420p_30fps_wedding2.MOV";
+
+    Eyer::EyerAVTranscoderParams params;
+    params.SetVideoCodecId(Eyer::EyerAVCodecID::CODEC_ID_H264);
+    params.SetAudioCodecId(Eyer::EyerAVCodecID::CODEC_ID_AAC);
+    params.SetEndTime(2.0);
+    // 自定义输出不支持分段, 走普通流程
+    params.SetSegmentNum(2);
+
+    Eyer::EyerAVMemoryWriterCustomIO outputIO;
+
+    Eyer::EyerAVTranscoder transcoder(inputPath);
+    // 只用来确定封装格式, 不会创建文件
+    transcoder.SetOutputPath("./S5_AVC_custom_io_out.MP4");
+    transcoder.SetParams(params);
+    ASSERT_EQ(transcoder.Transcode(nullptr, nullptr, &outputIO), 0);
+    ASSERT_EQ(transcoder.GetStatus(), Eyer::EyerAVTranscoderStatus::SUCC);
+
+    FILE * f = fopen("./S5_AVC_custom_io_out.MP4", "rb");
+    ASSERT_EQ(f, nullptr);
+
+    ASSERT_GT(outputIO.GetSize(), 8);
+    ASSERT_EQ(memcmp(outputIO.GetData() + 4, "ftyp", 4), 0);
+
+    CustomIOTestMemoryReader inputIO(outputIO.GetData(), outputIO.GetSize());
+    Eyer::EyerAVReader reader("", &inputIO);
+    ASSERT_EQ(reader.Open(), 0);
+    int videoIndex = reader.GetVideoStreamIndex();
+    ASSERT_GE(videoIndex, 0);
+    ASSERT_GE(reader.GetAudioStreamIndex(), 0);
+
+    int videoCount = 0;
+    while(1){
+        Eyer::EyerAVPacket packet;
+        if(reader.Read(packet)){
+            break;
+        }
+        if(packet.GetStreamIndex() == videoIndex){
+            videoCount++;
+        }
+    }
+    reader.Close();
+    ASSERT_GT(videoCount, 0);
+}
+
+#endif //EYERLIB_CUSTOMIOTEST_HPP
@@ -0,0 +1,116 @@
+#ifndef EYERLIB_ENCODERPRESETTEST_HPP
+#define EYERLIB_ENCODERPRESETTEST_HPP
+
+#include <stdio.h>
+#include <gtest/gtest.h>
+
+#include "EyerAVTranscoder/EyerAVTranscoderHeader.hpp"
+
+TEST(EyerAVTranscoder, EyerAVTranscoderTest_EncoderPreset_Params)
+{
+    Eyer::EyerAVTranscoderParams params;
+    params.SetVideoCodecId(Eyer::EyerAVCodecID::CODEC_ID_H264);
+    ASSERT_EQ(params.SetPreset("ultrafast"), 0);
+    ASSERT_EQ(params.SetPreset("not_a_preset"), -1);
+    ASSERT_EQ(params.GetPreset(), Eyer::EyerString("ultrafast"));
+    ASSERT_EQ(params.SetTune("film"), 0);
+    // film 只有 x264 支持, grain 两者都支持
+    params.SetVideoCodecId(Eyer::EyerAVCodecID::CODEC_ID_H265);
+    ASSERT_EQ(params.SetTune("animation"), 0);
+    ASSERT_EQ(params.SetTune("film"), -1);
+    ASSERT_EQ(params.SetTune("grain"), 0);
+
+    ASSERT_EQ(params.SetBitrate(0), -1);
+    ASSERT_EQ(params.SetBitrate(4000), 0);
+    ASSERT_EQ(params.SetMaxrateBufsize(-1, 0), -1);
+    ASSERT_EQ(params.SetMaxrateBufsize(6000, 8000), 0);
+    ASSERT_EQ(params.SetGOP(-1), -1);
+    ASSERT_EQ(params.SetGOP(60), 0);
+    ASSERT_EQ(params.SetBFrames(-2), -1);
+    ASSERT_EQ(params.SetBFrames(0), 0);
+    ASSERT_EQ(params.SetProresProfile(4), -1);
+    ASSERT_EQ(params.SetProresProfile(3), 0);
+
+    params.SetRateControl(Eyer::EyerAVRateControl::CBR);
+    Eyer::EyerAVTranscoderParams copyParams = params;
+    ASSERT_EQ(copyParams.GetRateControl(), Eyer::EyerAVRateControl::CBR);
+    ASSERT_EQ(copyParams.GetBitrate(), 4000);
+    ASSERT_EQ(copyParams.GetMaxrate(), 6000);
+    ASSERT_EQ(copyParams.GetBufsize(), 8000);
+    ASSERT_EQ(copyParams.GetGOP(), 60);
+    ASSERT_EQ(copyParams.GetBFrames(), 0);
+    ASSERT_EQ(copyParams.GetProresProfile(), 3);
+}
+
+TEST(EyerAVTranscoder, EyerAVTranscoderTest_EncoderPreset_ABR)
+{
+    Eyer::EyerString inputPath = "./panasonic_S5_h264_1920x1080_yuv420p_30fps_wedding2.MOV";
+    Eyer::EyerString outputPath = "./S5_AVC_preset_abr_out.MOV";
+
+    Eyer::EyerAVTranscoderParams params;
+    params.SetVideoCodecId(Eyer::EyerAVCodecID::CODEC_ID_H264);
+    params.SetCareAudio(false);
+    params.SetStartTime(0.0);
+    params.SetEndTime(2.0);
+    ASSERT_EQ(params.SetPreset("ultrafast"), 0);
+    ASSERT_EQ(params.SetTune("zerolatency"), 0);
+    params.SetRateControl(Eyer::EyerAVRateControl::ABR);
+    ASSERT_EQ(params.SetBitrate(2000), 0);
+    ASSERT_EQ(params.SetMaxrateBufsize(3000, 4000), 0);
+    ASSERT_EQ(params.SetGOP(30), 0);
+    ASSERT_EQ(params.SetBFrames(0), 0);
+
+    Eyer::EyerAVTranscoder transcoder(inputPath);
+    transcoder.SetOutputPath(outputPath);
+    transcoder.SetParams(params);
+    int ret = transcoder.Transcode(nullptr);
+    ASSERT_EQ(ret, 0);
+
+    // 没有 B 帧时, 解码顺序和显示顺序一致, pts 单调递增
+    Eyer::EyerAVReader reader(outputPath);
+    ASSERT_EQ(reader.Open(), 0);
+    int videoIndex = reader.GetVideoStreamIndex();
+    int64_t lastPts = -1;
+    int keyFrameCount = 0;
+    while(1){
+        Eyer::EyerAVPacket packet;
+        ret = reader.Read(packet);
+        if(ret){
+            break;
+        }
+        if(packet.GetStreamIndex() != videoIndex){
+            continue;
+        }
+        ASSERT_GT(packet.GetPTS(), lastPts);
+        lastPts = packet.GetPTS();
+        if(packet.IsKeyFrame()){
+            keyFrameCount++;
+        }
+    }
+    reader.Close();
+    // 2 秒 30fps, GOP 30, 至少两个关键帧
+    ASSERT_GE(keyFrameCount, 2);
+}
+
+TEST(EyerAVTranscoder, EyerAVTranscoderTest_EncoderPreset_Mismatch)
+{
+    Eyer::EyerString inputPath = "./panasonic_S5_h264_1920x1080_yuv420p_30fps_wedding2.MOV";
+    Eyer::EyerString outputPath = "./S5_AVC_preset_mismatch_out.MOV";
+
+    Eyer::EyerAVTranscoderParams params;
+    params.SetVideoCodecId(Eyer::EyerAVCodecID::CODEC_ID_H264);
+    ASSERT_EQ(params.SetTune("film"), 0);
+    // 设置 tune 之后切换到不支持 film 的 H265
+    params.SetVideoCodecId(Eyer::EyerAVCodecID::CODEC_ID_H265);
+    params.SetCareAudio(false);
+    params.SetEndTime(1.0);
+
+    Eyer::EyerAVTranscoder transcoder(inputPath);
+    transcoder.SetOutputPath(outputPath);
+    transcoder.SetParams(params);
+    int ret = transcoder.Transcode(nullptr);
+    ASSERT_NE(ret, 0);
+    ASSERT_EQ(transcoder.GetStatus(), Eyer::EyerAVTranscoderStatus::FAIL);
+}
+
+#endif //EYERLIB_ENCODERPRESETTEST_HPP
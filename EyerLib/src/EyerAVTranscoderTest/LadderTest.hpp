@@ -0,0 +1,138 @@
+#ifndef EYERLIB_LADDERTEST_HPP
+#define EYERLIB_LADDERTEST_HPP
+
+#include <stdio.h>
+#include <string.h>
+#ifdef __linux__
+#include <unistd.h>
+#endif
+#include <gtest/gtest.h>
+
+#include "EyerAVTranscoder/EyerAVTranscoderHeader.hpp"
+
+// 检查输出的视频尺寸, 返回视频包数量
+static int LadderTest_CheckOutput(const Eyer::EyerString & path, int width, int height)
+{
+    Eyer::EyerAVReader reader(path);
+    int ret = reader.Open();
+    if(ret){
+        return -1;
+    }
+    int videoStreamIndex = reader.GetVideoStreamIndex();
+    if(videoStreamIndex < 0){
+        return -1;
+    }
+    Eyer::EyerAVStream stream = reader.GetStream(videoStreamIndex);
+    if(stream.GetWidth() != width || stream.GetHeight() != height){
+        EyerLog("Ladder output size: %dx%d, expect: %dx%d\n", stream.GetWidth(), stream.GetHeight(), width, height);
+        return -1;
+    }
+
+    int packetNum = 0;
+    Eyer::EyerAVPacket packet;
+    while(reader.Read(packet) == 0){
+        if(packet.GetStreamIndex() == videoStreamIndex){
+            packetNum++;
+        }
+    }
+    reader.Close();
+    return packetNum;
+}
+
+TEST(EyerAVTranscoder, EyerAVTranscoderTest_Ladder)
+{
+    Eyer::EyerAVTranscoderParams params;
+    params.SetEndTime(2.0);
+
+    Eyer::EyerAVTranscoderParams params720;
+    params720.SetVideoCodecId(Eyer::EyerAVCodecID::CODEC_ID_H264);
+    params720.SetAudioCodecId(Eyer::EyerAVCodecID::CODEC_ID_AAC);
+    params720.SetWidthHeight(1280, 720);
+
+    // 640x360 从 720p 的缩放结果级联缩放
+    Eyer::EyerAVTranscoderParams params360;
+    params360.SetVideoCodecId(Eyer::EyerAVCodecID::CODEC_ID_H264);
+    params360.SetAudioCodecId(Eyer::EyerAVCodecID::CODEC_ID_AAC);
+    params360.SetWidthHeight(640, 360);
+
+    // 音频直接复制
+    Eyer::EyerAVTranscoderParams params540;
+    params540.SetVideoCodecId(Eyer::EyerAVCodecID::CODEC_ID_H264);
+    params540.SetWidthHeight(960, 540);
+    params540.SetAudioCopyMode(Eyer::EyerAVTranscoderCopyMode::COPY);
+
+    Eyer::EyerAVTranscoder transcoder("./panasonic_S5_h264_1920x1080_yuv420p_30fps_wedding2.MOV");
+    transcoder.SetParams(params);
+    transcoder.AddRendition("./S5_AVC_ladder_720_out.MP4", params720);
+    transcoder.AddRendition("./S5_AVC_ladder_360_out.MP4", params360);
+    transcoder.AddRendition("./S5_AVC_ladder_540_out.MP4", params540);
+    ASSERT_EQ(transcoder.GetRenditionNum(), 3);
+
+    int ret = transcoder.Transcode(nullptr);
+    ASSERT_EQ(ret, 0);
+    ASSERT_EQ(transcoder.GetStatus(), Eyer::EyerAVTranscoderStatus::SUCC);
+
+    int packetNum720 = LadderTest_CheckOutput("./S5_AVC_ladder_720_out.MP4", 1280, 720);
+    int packetNum360 = LadderTest_CheckOutput("./S5_AVC_ladder_360_out.MP4", 640, 360);
+    int packetNum540 = LadderTest_CheckOutput("./S5_AVC_ladder_540_out.MP4", 960, 540);
+    ASSERT_GT(packetNum720, 0);
+    ASSERT_GT(packetNum360, 0);
+    ASSERT_GT(packetNum540, 0);
+    // 各路编码同样的解码帧
+    ASSERT_EQ(packetNum720, packetNum360);
+    ASSERT_EQ(packetNum720, packetNum540);
+
+    // 只解码一次: 编码帧数是三路之和, 解码帧数只多出结束时间之后的几帧
+    Eyer::EyerAVTranscodeProfile profile = transcoder.GetProfile();
+    int64_t decodeVideoNum = 0;
+    int64_t encodeVideoNum = 0;
+    for(int i = 0; i < profile.streamList.size(); i++){
+        if(profile.streamList[i].mediaType == Eyer::EyerAVMediaType::MEDIA_TYPE_VIDEO.GetName()){
+            decodeVideoNum += profile.streamList[i].stageTime[Eyer::STAGE_DECODE].count;
+            encodeVideoNum += profile.streamList[i].stageTime[Eyer::STAGE_ENCODE].count;
+        }
+    }
+    ASSERT_GT(decodeVideoNum, 0);
+    ASSERT_GT(encodeVideoNum, decodeVideoNum * 2);
+}
+
+TEST(EyerAVTranscoder, EyerAVTranscoderTest_Ladder_OutputCustomIO)
+{
+    Eyer::EyerAVTranscoderParams params;
+    params.SetVideoCodecId(Eyer::EyerAVCodecID::CODEC_ID_H264);
+    params.SetWidthHeight(640, 360);
+
+    Eyer::EyerAVMemoryWriterCustomIO outputIO;
+    Eyer::EyerAVTranscoder transcoder("./panasonic_S5_h264_1920x1080_yuv420p_30fps_wedding2.MOV");
+    transcoder.AddRendition("./S5_AVC_ladder_customio_out.MP4", params);
+    int ret = transcoder.Transcode(nullptr, nullptr, &outputIO);
+    ASSERT_EQ(ret, -1);
+    ASSERT_EQ(transcoder.GetStatus(), Eyer::EyerAVTranscoderStatus::FAIL);
+}
+
+#ifdef __linux__
+TEST(EyerAVTranscoder, EyerAVTranscoderTest_Ladder_WriteFail)
+{
+    // 写入 /dev/full 返回 ENOSPC, 模拟其中一路磁盘写满
+    Eyer::EyerString fullPath = "./S5_AVC_ladder_full_out.MP4";
+    remove(fullPath.c_str());
+    ASSERT_EQ(symlink("/dev/full", fullPath.c_str()), 0);
+
+    Eyer::EyerAVTranscoderParams params;
+    params.SetVideoCodecId(Eyer::EyerAVCodecID::CODEC_ID_H264);
+    params.SetWidthHeight(640, 360);
+
+    Eyer::EyerAVTranscoder transcoder("./panasonic_S5_h264_1920x1080_yuv420p_30fps_wedding2.MOV");
+    transcoder.AddRendition("./S5_AVC_ladder_ok_out.MP4", params);
+    transcoder.AddRendition(fullPath, params);
+    int ret = transcoder.Transcode(nullptr);
+    remove(fullPath.c_str());
+
+    ASSERT_EQ(ret, -1);
+    ASSERT_EQ(transcoder.GetStatus(), Eyer::EyerAVTranscoderStatus::FAIL);
+    // 错误信息中带出失败的那一路
+    ASSERT_NE(strstr(transcoder.GetErrorDesc().c_str(), fullPath.c_str()), nullptr);
+}
+#endif
+
+#endif //EYERLIB_LADDERTEST_HPP
@@ -47,6 +47,20 @@ TEST(EyerAVTranscoder, EyerAVTranscoderQuerySupport)
 }
 
 #include "PixelFmtTest.hpp"
+#include "PipelineTest.hpp"
+#include "StreamCopyTest.hpp"
+#include "SegmentTest.hpp"
+#include "QueueTest.hpp"
+#include "EncoderPresetTest.hpp"
+#include "ProfileTest.hpp"
+#include "ProgressTest.hpp"
+#include "SmartCutTest.hpp"
+#include "ResumeTest.hpp"
+#include "CustomIOTest.hpp"
+#include "AsyncWriteTest.hpp"
+#include "MovModeTest.hpp"
+#include "LadderTest.hpp"
+#include "AudioExtractTest.hpp"
 
 int main(int argc,char **argv)
 {
@@ -0,0 +1,125 @@
+#ifndef EYERLIB_MOVMODETEST_HPP
+#define EYERLIB_MOVMODETEST_HPP
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "EyerAVTranscoder/EyerAVTranscoderHeader.hpp"
+
+// 按顺序列出文件顶层 box 的类型
+static std::vector<std::string> MovModeTest_TopLevelBox(const Eyer::EyerString & path)
+{
+    std::vector<std::string> boxList;
+    FILE * f = fopen(path.c_str(), "rb");
+    if(f == nullptr){
+        return boxList;
+    }
+    int64_t pos = 0;
+    while(1){
+        uint8_t head[16];
+        if(fseek(f, pos, SEEK_SET) || fread(head, 1, 8, f) != 8){
+            break;
+        }
+        int64_t size = ((int64_t)head[0] << 24) | (head[1] << 16) | (head[2] << 8) | head[3];
+        if(size == 1){
+            if(fread(head + 8, 1, 8, f) != 8){
+                break;
+            }
+            size = 0;
+            for(int i = 8; i < 16; i++){
+                size = (size << 8) | head[i];
+            }
+        }
+        if(size < 8){
+            break;
+        }
+        boxList.push_back(std::string((const char *)head + 4, 4));
+        pos += size;
+    }
+    fclose(f);
+    return boxList;
+}
+
+static int MovModeTest_IndexOf(const std::vector<std::string> & boxList, const std::string & type)
+{
+    for(int i = 0; i < boxList.size(); i++){
+        if(boxList[i] == type){
+            return i;
+        }
+    }
+    return -1;
+}
+
+static int MovModeTest_Transcode(const Eyer::EyerString & outputPath, const Eyer::EyerAVTranscoderMovMode & movMode)
+{
+    Eyer::EyerAVTranscoderParams params;
+    params.SetVideoCodecId(Eyer::EyerAVCodecID::CODEC_ID_H264);
+    params.SetAudioCodecId(Eyer::EyerAVCodecID::CODEC_ID_AAC);
+    params.SetEndTime(3.0);
+    params.SetGOP(30);
+    params.SetMovMode(movMode);
+    params.SetFragmentDuration(500);
+
+    Eyer::EyerAVTranscoder transcoder("./panasonic_S5_h264_1920x1080_yuv420p_30fps_wedding2.MOV");
+    transcoder.SetOutputPath(outputPath);
+    transcoder.SetParams(params);
+    transcoder.Transcode(nullptr);
+    if(transcoder.GetStatus() != Eyer::EyerAVTranscoderStatus::SUCC){
+        return -1;
+    }
+    return 0;
+}
+
+TEST(EyerAVTranscoder, EyerAVTranscoderTest_MovMode_FastStart)
+{
+    ASSERT_EQ(MovModeTest_Transcode("./S5_AVC_faststart_out.MP4", Eyer::EyerAVTranscoderMovMode::FASTSTART), 0);
+
+    std::vector<std::string> boxList = MovModeTest_TopLevelBox("./S5_AVC_faststart_out.MP4");
+    int moovIndex = MovModeTest_IndexOf(boxList, "moov");
+    int mdatIndex = MovModeTest_IndexOf(boxList, "mdat");
+    ASSERT_GE(moovIndex, 0);
+    ASSERT_GE(mdatIndex, 0);
+    ASSERT_LT(moovIndex, mdatIndex);
+}
+
+TEST(EyerAVTranscoder, EyerAVTranscoderTest_MovMode_Fragment)
+{
+    ASSERT_EQ(MovModeTest_Transcode("./S5_AVC_fragment_out.MP4", Eyer::EyerAVTranscoderMovMode::FRAGMENT), 0);
+
+    // 3 秒, 每个关键帧间隔 1 秒, 至少 2 个分片
+    std::vector<std::string> boxList = MovModeTest_TopLevelBox("./S5_AVC_fragment_out.MP4");
+    ASSERT_EQ(MovModeTest_IndexOf(boxList, "moov"), 1);
+    int moofCount = 0;
+    for(int i = 0; i < boxList.size(); i++){
+        if(boxList[i] == "moof"){
+            moofCount++;
+        }
+    }
+    ASSERT_GE(moofCount, 2);
+
+    Eyer::EyerAVReader reader("./S5_AVC_fragment_out.MP4");
+    ASSERT_EQ(reader.Open(), 0);
+    ASSERT_GE(reader.GetVideoStreamIndex(), 0);
+    Eyer::EyerAVPacket packet;
+    ASSERT_EQ(reader.Read(packet), 0);
+    reader.Close();
+}
+
+TEST(EyerAVTranscoder, EyerAVTranscoderTest_MovMode_FastStartCustomIO)
+{
+    Eyer::EyerAVTranscoderParams params;
+    params.SetEndTime(1.0);
+    params.SetMovMode(Eyer::EyerAVTranscoderMovMode::FASTSTART);
+
+    // 内存输出不能按路径重新打开, 不支持 faststart
+    Eyer::EyerAVMemoryWriterCustomIO outputIO;
+    Eyer::EyerAVTranscoder transcoder("./panasonic_S5_h264_1920x1080_yuv420p_30fps_wedding2.MOV");
+    transcoder.SetOutputPath("./S5_faststart_custom_io_out.MP4");
+    transcoder.SetParams(params);
+    ASSERT_EQ(transcoder.Transcode(nullptr, nullptr, &outputIO), -1);
+    ASSERT_EQ(transcoder.GetStatus(), Eyer::EyerAVTranscoderStatus::FAIL);
+}
+
+#endif //EYERLIB_MOVMODETEST_HPP
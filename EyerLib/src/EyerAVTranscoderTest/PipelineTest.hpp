@@ -0,0 +1,115 @@
+#ifndef EYERLIB_PIPELINETEST_HPP
+#define EYERLIB_PIPELINETEST_HPP
+
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "EyerAVTranscoder/EyerAVTranscoderHeader.hpp"
+
+static int PipelineTest_Transcode(const Eyer::EyerString & inputPath, const Eyer::EyerString & outputPath, bool pipeline)
+{
+    Eyer::EyerAVTranscoderParams params;
+    params.SetVideoCodecId(Eyer::EyerAVCodecID::CODEC_ID_H264);
+    params.SetVideoPixelFormat(Eyer::EyerAVPixelFormat::EYER_YUV420P);
+    params.SetAudioCodecId(Eyer::EyerAVCodecID::CODEC_ID_AAC);
+    params.SetChannelLayout(Eyer::EyerAVChannelLayout::EYER_AV_CH_LAYOUT_STEREO);
+    params.SetSampleRate(48000);
+    params.SetPipeline(pipeline);
+
+    Eyer::EyerAVTranscoder transcoder(inputPath);
+    transcoder.SetOutputPath(outputPath);
+    transcoder.SetParams(params);
+    return transcoder.Transcode(nullptr);
+}
+
+TEST(EyerAVTranscoder, EyerAVTranscoderTest_Pipeline_MatchSequential)
+{
+    Eyer::EyerString inputPath = "./panasonic_S5_h264_1920x1080_yuv420p_30fps_wedding2.MOV";
+    Eyer::EyerString sequentialPath = "./S5_AVC_sequential_out.MP4";
+    Eyer::EyerString pipelinePath = "./S5_AVC_pipeline_out.MP4";
+
+    ASSERT_EQ(PipelineTest_Transcode(inputPath, sequentialPath, false), 0);
+    ASSERT_EQ(PipelineTest_Transcode(inputPath, pipelinePath, true), 0);
+
+    Eyer::EyerAVReader sequentialReader(sequentialPath);
+    ASSERT_EQ(sequentialReader.Open(), 0);
+    Eyer::EyerAVReader pipelineReader(pipelinePath);
+    ASSERT_EQ(pipelineReader.Open(), 0);
+
+    ASSERT_EQ(sequentialReader.GetStreamCount(), pipelineReader.GetStreamCount());
+
+    int videoStreamIndex = sequentialReader.GetVideoStreamIndex();
+    ASSERT_EQ(videoStreamIndex, pipelineReader.GetVideoStreamIndex());
+
+    // 逐帧比较视频流的压缩数据和时间戳
+    int frameCount = 0;
+    while(1){
+        Eyer::EyerAVPacket sequentialPacket;
+        int sequentialRet = 0;
+        while((sequentialRet = sequentialReader.Read(sequentialPacket)) == 0){
+            if(sequentialPacket.GetStreamIndex() == videoStreamIndex){
+                break;
+            }
+        }
+
+        Eyer::EyerAVPacket pipelinePacket;
+        int pipelineRet = 0;
+        while((pipelineRet = pipelineReader.Read(pipelinePacket)) == 0){
+            if(pipelinePacket.GetStreamIndex() == videoStreamIndex){
+                break;
+            }
+        }
+
+        ASSERT_EQ(sequentialRet == 0, pipelineRet == 0);
+        if(sequentialRet){
+            break;
+        }
+
+        ASSERT_EQ(sequentialPacket.GetPTS(), pipelinePacket.GetPTS());
+        ASSERT_EQ(sequentialPacket.GetDTS(), pipelinePacket.GetDTS());
+        ASSERT_EQ(sequentialPacket.GetSize(), pipelinePacket.GetSize());
+        ASSERT_EQ(memcmp(sequentialPacket.GetDatePtr(), pipelinePacket.GetDatePtr(), sequentialPacket.GetSize()), 0);
+        frameCount++;
+    }
+
+    EyerLog("Pipeline compare frame count: %d\n", frameCount);
+    ASSERT_GT(frameCount, 0);
+
+    sequentialReader.Close();
+    pipelineReader.Close();
+}
+
+// 写入超过 1MB 之后失败, 模拟磁盘写满
+class PipelineTestFailWriter : public Eyer::EyerAVMemoryWriterCustomIO
+{
+public:
+    virtual int Write(const uint8_t * buf, int buf_size) override
+    {
+        if(GetSize() > 1024 * 1024){
+            return -1;
+        }
+        return Eyer::EyerAVMemoryWriterCustomIO::Write(buf, buf_size);
+    }
+};
+
+TEST(EyerAVTranscoder, EyerAVTranscoderTest_Pipeline_WriteFail)
+{
+    Eyer::EyerAVTranscoderParams params;
+    params.SetVideoCodecId(Eyer::EyerAVCodecID::CODEC_ID_H264);
+    params.SetVideoPixelFormat(Eyer::EyerAVPixelFormat::EYER_YUV420P);
+    params.SetPipeline(true);
+
+    PipelineTestFailWriter outputIO;
+    Eyer::EyerAVTranscoder transcoder("./panasonic_S5_h264_1920x1080_yuv420p_30fps_wedding2.MOV");
+    // 只用来确定封装格式, 不会创建文件
+    transcoder.SetOutputPath("./S5_AVC_pipeline_fail_out.MP4");
+    transcoder.SetParams(params);
+
+    // mux 线程出错后各阶段退出, 不能报告成功
+    ASSERT_NE(transcoder.Transcode(nullptr, nullptr, &outputIO), 0);
+    ASSERT_EQ(transcoder.GetStatus(), Eyer::EyerAVTranscoderStatus::FAIL);
+}
+
+#endif //EYERLIB_PIPELINETEST_HPP
@@ -0,0 +1,101 @@
+#ifndef EYERLIB_PROFILETEST_HPP
+#define EYERLIB_PROFILETEST_HPP
+
+#include <stdio.h>
+#include <gtest/gtest.h>
+
+#include "EyerAVTranscoder/EyerAVTranscoderHeader.hpp"
+
+class ProfileTestListener : public Eyer::EyerAVTranscoderListener
+{
+public:
+    virtual int OnProgress(float progress) override
+    {
+        // 转码过程中读取统计
+        Eyer::EyerAVTranscodeProfile profile = transcoder->GetProfile();
+        if(profile.totalTime > 0){
+            runningProfileNum++;
+        }
+        return 0;
+    }
+
+    virtual int OnFail(Eyer::EyerAVTranscoderError & error) override
+    {
+        return 0;
+    }
+
+    virtual int OnSuccess() override
+    {
+        return 0;
+    }
+
+    Eyer::EyerAVTranscoder * transcoder = nullptr;
+    int runningProfileNum = 0;
+};
+
+static void ProfileTest_Run(bool pipeline)
+{
+    Eyer::EyerString inputPath = "./panasonic_S5_h264_1920x1080_yuv420p_30fps_wedding2.MOV";
+    Eyer::EyerString outputPath = pipeline ? "./S5_AVC_profile_pipeline_out.MOV" : "./S5_AVC_profile_out.MOV";
+
+    Eyer::EyerAVTranscoderParams params;
+    params.SetVideoCodecId(Eyer::EyerAVCodecID::CODEC_ID_H264);
+    params.SetAudioCodecId(Eyer::EyerAVCodecID::CODEC_ID_AAC);
+    params.SetWidthHeight(1280, 720);
+    params.SetEndTime(3.0);
+    params.SetPipeline(pipeline);
+
+    Eyer::EyerAVTranscoder transcoder(inputPath);
+    ProfileTestListener listener;
+    listener.transcoder = &transcoder;
+    transcoder.SetOutputPath(outputPath);
+    transcoder.SetParams(params);
+    transcoder.SetListener(&listener);
+    int ret = transcoder.Transcode(nullptr);
+    ASSERT_EQ(ret, 0);
+    ASSERT_GT(listener.runningProfileNum, 0);
+
+    Eyer::EyerAVTranscodeProfile profile = transcoder.GetProfile();
+    ASSERT_GT(profile.totalTime, 0);
+    ASSERT_GT(profile.streamList.size(), 0);
+
+    Eyer::EyerAVTranscodeStageTime demux = profile.GetStageTotal(Eyer::STAGE_DEMUX);
+    Eyer::EyerAVTranscodeStageTime decode = profile.GetStageTotal(Eyer::STAGE_DECODE);
+    Eyer::EyerAVTranscodeStageTime scale = profile.GetStageTotal(Eyer::STAGE_SCALE);
+    Eyer::EyerAVTranscodeStageTime resample = profile.GetStageTotal(Eyer::STAGE_RESAMPLE);
+    Eyer::EyerAVTranscodeStageTime encode = profile.GetStageTotal(Eyer::STAGE_ENCODE);
+    Eyer::EyerAVTranscodeStageTime mux = profile.GetStageTotal(Eyer::STAGE_MUX);
+    ASSERT_GT(demux.count, 0);
+    ASSERT_GT(decode.count, 0);
+    ASSERT_GT(scale.count, 0);
+    ASSERT_GT(resample.count, 0);
+    ASSERT_GT(encode.count, 0);
+    ASSERT_GT(mux.count, 0);
+    ASSERT_GT(encode.wallTime, 0);
+    ASSERT_GT(encode.cpuTime, 0);
+
+    int64_t bytesIn = 0;
+    int64_t bytesOut = 0;
+    for(int i = 0; i < profile.streamList.size(); i++){
+        bytesIn += profile.streamList[i].bytesIn;
+        bytesOut += profile.streamList[i].bytesOut;
+    }
+    ASSERT_GT(bytesIn, 0);
+    ASSERT_GT(bytesOut, 0);
+
+    Eyer::EyerString json = profile.ToJson();
+    EyerLog("Profile: %s\n", json.c_str());
+    ASSERT_FALSE(json.IsEmpty());
+}
+
+TEST(EyerAVTranscoder, EyerAVTranscoderTest_Profile)
+{
+    ProfileTest_Run(false);
+}
+
+TEST(EyerAVTranscoder, EyerAVTranscoderTest_Profile_Pipeline)
+{
+    ProfileTest_Run(true);
+}
+
+#endif //EYERLIB_PROFILETEST_HPP
@@ -0,0 +1,107 @@
+#ifndef EYERLIB_PROGRESSTEST_HPP
+#define EYERLIB_PROGRESSTEST_HPP
+
+#include <stdio.h>
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "EyerAVTranscoder/EyerAVTranscoderHeader.hpp"
+
+class ProgressTestListener : public Eyer::EyerAVTranscoderListener
+{
+public:
+    virtual int OnProgress(float progress) override
+    {
+        progressNum++;
+        return 0;
+    }
+
+    virtual int OnProgressInfo(const Eyer::EyerAVTranscodeProgress & progress) override
+    {
+        EyerLog("%s", progress.ToString().c_str());
+        infoList.push_back(progress);
+        timeList.push_back(Eyer::EyerTime::GetTime());
+        return 0;
+    }
+
+    virtual int OnFail(Eyer::EyerAVTranscoderError & error) override
+    {
+        return 0;
+    }
+
+    virtual int OnSuccess() override
+    {
+        return 0;
+    }
+
+    int progressNum = 0;
+    std::vector<Eyer::EyerAVTranscodeProgress> infoList;
+    std::vector<long long> timeList;
+};
+
+static void ProgressTest_Run(bool pipeline, int segmentNum)
+{
+    Eyer::EyerString inputPath = "./panasonic_S5_h264_1920x1080_yuv420p_30fps_wedding2.MOV";
+    Eyer::EyerString outputPath = "./S5_AVC_progress_out.MOV";
+
+    int interval = 200;
+
+    Eyer::EyerAVTranscoderParams params;
+    params.SetVideoCodecId(Eyer::EyerAVCodecID::CODEC_ID_H264);
+    params.SetAudioCodecId(Eyer::EyerAVCodecID::CODEC_ID_AAC);
+    params.SetEndTime(5.0);
+    params.SetPipeline(pipeline);
+    params.SetSegmentNum(segmentNum);
+    ASSERT_EQ(params.SetProgressInterval(-1), -1);
+    ASSERT_EQ(params.SetProgressInterval(interval), 0);
+
+    ProgressTestListener listener;
+    Eyer::EyerAVTranscoder transcoder(inputPath);
+    transcoder.SetOutputPath(outputPath);
+    transcoder.SetParams(params);
+    transcoder.SetListener(&listener);
+    int ret = transcoder.Transcode(nullptr);
+    ASSERT_EQ(ret, 0);
+
+    ASSERT_GT(listener.infoList.size(), 0);
+    ASSERT_EQ(listener.infoList.size(), listener.progressNum);
+
+    for(int i = 0; i < listener.infoList.size(); i++){
+        const Eyer::EyerAVTranscodeProgress & info = listener.infoList[i];
+        ASSERT_GE(info.progress, 0.0);
+        ASSERT_LE(info.progress, 1.0);
+        ASSERT_GE(info.elapsedTime, 0.0);
+        if(i > 0){
+            const Eyer::EyerAVTranscodeProgress & lastInfo = listener.infoList[i - 1];
+            ASSERT_GE(info.frameNum, lastInfo.frameNum);
+            ASSERT_GE(info.bytesWritten, lastInfo.bytesWritten);
+            // 分段转码时, 某一段完成会立即回调, 不受间隔限制
+            if(segmentNum <= 1){
+                ASSERT_GE(listener.timeList[i] - listener.timeList[i - 1], interval - 20);
+            }
+        }
+    }
+
+    const Eyer::EyerAVTranscodeProgress & lastInfo = listener.infoList[listener.infoList.size() - 1];
+    ASSERT_GT(lastInfo.frameNum, 0);
+    ASSERT_GT(lastInfo.bytesWritten, 0);
+    ASSERT_GT(lastInfo.speed, 0.0);
+}
+
+TEST(EyerAVTranscoder, EyerAVTranscoderTest_Progress)
+{
+    ProgressTest_Run(false, 1);
+}
+
+TEST(EyerAVTranscoder, EyerAVTranscoderTest_Progress_Pipeline)
+{
+    ProgressTest_Run(true, 1);
+}
+
+TEST(EyerAVTranscoder, EyerAVTranscoderTest_Progress_Segment)
+{
+    ProgressTest_Run(false, 3);
+}
+
+#endif //EYERLIB_PROGRESSTEST_HPP
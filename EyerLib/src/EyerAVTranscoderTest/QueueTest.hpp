@@ -0,0 +1,98 @@
+#ifndef EYERLIB_QUEUETEST_HPP
+#define EYERLIB_QUEUETEST_HPP
+
+#include <stdio.h>
+#include <mutex>
+#include <gtest/gtest.h>
+
+#include "EyerAVTranscoder/EyerAVTranscoderHeader.hpp"
+
+class QueueTestListener : public Eyer::EyerAVTranscodeQueueListener
+{
+public:
+    virtual int OnJobProgress(int jobId, float progress) override
+    {
+        return 0;
+    }
+
+    virtual int OnJobFail(int jobId, Eyer::EyerAVTranscoderError & error) override
+    {
+        std::lock_guard<std::mutex> lg(mut);
+        failCount++;
+        return 0;
+    }
+
+    virtual int OnJobSuccess(int jobId) override
+    {
+        std::lock_guard<std::mutex> lg(mut);
+        successCount++;
+        return 0;
+    }
+
+    virtual int OnProgress(float progress) override
+    {
+        std::lock_guard<std::mutex> lg(mut);
+        lastProgress = progress;
+        return 0;
+    }
+
+    std::mutex mut;
+    int successCount = 0;
+    int failCount = 0;
+    float lastProgress = 0.0;
+};
+
+TEST(EyerAVTranscoder, EyerAVTranscoderTest_Queue_SplitThreadBudget)
+{
+    Eyer::EyerAVTranscoderParams params;
+
+    Eyer::EyerAVTranscodeQueue::SplitThreadBudget(params, 16, 2);
+    ASSERT_EQ(params.GetDecodeThreadNum(), 2);
+    ASSERT_EQ(params.GetEncodeThreadNum(), 6);
+
+    Eyer::EyerAVTranscodeQueue::SplitThreadBudget(params, 4, 4);
+    ASSERT_EQ(params.GetDecodeThreadNum(), 1);
+    ASSERT_EQ(params.GetEncodeThreadNum(), 1);
+}
+
+TEST(EyerAVTranscoder, EyerAVTranscoderTest_Queue_Run)
+{
+    Eyer::EyerString inputPath = "./panasonic_S5_h264_1920x1080_yuv420p_30fps_wedding2.MOV";
+
+    Eyer::EyerAVTranscoderParams params;
+    params.SetVideoCodecId(Eyer::EyerAVCodecID::CODEC_ID_H264);
+    params.SetVideoPixelFormat(Eyer::EyerAVPixelFormat::EYER_YUV420P);
+    params.SetWidthHeight(1280, 720);
+    params.SetAudioCodecId(Eyer::EyerAVCodecID::CODEC_ID_AAC);
+    params.SetStartTime(0.0);
+    params.SetEndTime(2.0);
+
+    QueueTestListener listener;
+
+    Eyer::EyerAVTranscodeQueue queue(2, 8);
+    queue.SetListener(&listener);
+
+    std::vector<int> jobIdList;
+    for(int i = 0; i < 3; i++){
+        Eyer::EyerString outputPath = Eyer::EyerString("./S5_AVC_queue_out_") + Eyer::EyerString::Number(i) + ".MP4";
+        jobIdList.push_back(queue.AddJob(inputPath, outputPath, params));
+    }
+    int badJobId = queue.AddJob("./not_exist_input.MOV", "./S5_AVC_queue_out_bad.MP4", params);
+
+    ASSERT_EQ(queue.GetJobCount(), 4);
+
+    queue.Start();
+    queue.Wait();
+
+    for(int i = 0; i < jobIdList.size(); i++){
+        ASSERT_EQ(queue.GetJobStatus(jobIdList[i]), Eyer::EyerAVTranscoderStatus::SUCC);
+        ASSERT_FLOAT_EQ(queue.GetJobProgress(jobIdList[i]), 1.0);
+    }
+    ASSERT_EQ(queue.GetJobStatus(badJobId), Eyer::EyerAVTranscoderStatus::FAIL);
+
+    ASSERT_EQ(listener.successCount, 3);
+    ASSERT_EQ(listener.failCount, 1);
+    ASSERT_FLOAT_EQ(queue.GetProgress(), 1.0);
+}
+
+#endif //EYERLIB_QUEUETEST_HPP
@@ -0,0 +1,138 @@
+#ifndef EYERLIB_RESUMETEST_HPP
+#define EYERLIB_RESUMETEST_HPP
+
+#include <stdio.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+
+#include "EyerAVTranscoder/EyerAVTranscoderHeader.hpp"
+
+#include "TranscoderTestUtil.hpp"
+
+// 进度过半时取消, 模拟转码到一半被停止
+class ResumeTestInterrupt : public Eyer::EyerAVTranscoderInterrupt, public Eyer::EyerAVTranscoderListener
+{
+public:
+    virtual bool interrupt() override
+    {
+        return isInterrupt;
+    }
+
+    virtual int OnProgress(float progress) override
+    {
+        return 0;
+    }
+
+    virtual int OnProgressInfo(const Eyer::EyerAVTranscodeProgress & progress) override
+    {
+        if(progress.progress >= 0.5){
+            isInterrupt = true;
+        }
+        return 0;
+    }
+
+    virtual int OnFail(Eyer::EyerAVTranscoderError & error) override
+    {
+        return 0;
+    }
+
+    virtual int OnSuccess() override
+    {
+        return 0;
+    }
+
+    std::atomic_bool isInterrupt {false};
+};
+
+static Eyer::EyerAVTranscoderParams ResumeTest_Params(bool resumable)
+{
+    Eyer::EyerAVTranscoderParams params;
+    params.SetVideoCodecId(Eyer::EyerAVCodecID::CODEC_ID_H264);
+    params.SetAudioCodecId(Eyer::EyerAVCodecID::CODEC_ID_AAC);
+    params.SetEndTime(6.0);
+    params.SetResumable(resumable);
+    params.SetResumeSegmentDuration(1.0);
+    params.SetSegmentWorkerNum(1);
+    params.SetProgressInterval(0);
+    return params;
+}
+
+TEST(EyerAVTranscoder, EyerAVTranscoderTest_Resume)
+{
+    Eyer::EyerString inputPath = "./panasonic_S5_h264_1920x1080_yuv420p_30fps_wedding2.MOV";
+    Eyer::EyerString referencePath = "./S5_AVC_resume_reference_out.MP4";
+    Eyer::EyerString outputPath = "./S5_AVC_resume_out.MP4";
+    Eyer::EyerString checkpointPath = outputPath + ".checkpoint";
+    remove(checkpointPath.c_str());
+
+    int64_t fullFrameNum = 0;
+    {
+        Eyer::EyerAVTranscoder transcoder(inputPath);
+        transcoder.SetOutputPath(referencePath);
+        transcoder.SetParams(ResumeTest_Params(false));
+        ASSERT_EQ(transcoder.Transcode(nullptr), 0);
+        ASSERT_EQ(transcoder.GetStatus(), Eyer::EyerAVTranscoderStatus::SUCC);
+        fullFrameNum = transcoder.GetProfile().GetStageTotal(Eyer::STAGE_SCALE).count;
+    }
+
+    // 第一次转码到一半被取消, 保留检查点和已经完成的分段
+    {
+        ResumeTestInterrupt interrupt;
+        Eyer::EyerAVTranscoder transcoder(inputPath);
+        transcoder.SetOutputPath(outputPath);
+        transcoder.SetParams(ResumeTest_Params(true));
+        transcoder.SetListener(&interrupt);
+        transcoder.Transcode(&interrupt);
+        ASSERT_EQ(transcoder.GetStatus(), Eyer::EyerAVTranscoderStatus::FAIL);
+
+        Eyer::EyerAVTranscoderCheckpoint checkpoint(checkpointPath);
+        ASSERT_EQ(checkpoint.Load(), 0);
+        ASSERT_GT(checkpoint.doneList.size(), 0);
+    }
+
+    // 第二次跳过已经完成的分段
+    {
+        Eyer::EyerAVTranscoder transcoder(inputPath);
+        transcoder.SetOutputPath(outputPath);
+        transcoder.SetParams(ResumeTest_Params(true));
+        ASSERT_EQ(transcoder.Transcode(nullptr), 0);
+        ASSERT_EQ(transcoder.GetStatus(), Eyer::EyerAVTranscoderStatus::SUCC);
+
+        int64_t resumeFrameNum = transcoder.GetProfile().GetStageTotal(Eyer::STAGE_SCALE).count;
+        EyerLog("Resume frame num: %lld, full frame num: %lld\n", (long long)resumeFrameNum, (long long)fullFrameNum);
+        ASSERT_LT(resumeFrameNum, fullFrameNum);
+    }
+
+    ASSERT_EQ(TranscoderTestUtil_CountPacket(outputPath), TranscoderTestUtil_CountPacket(referencePath));
+
+    // 完成后检查点和分段文件都已经删除
+    FILE * f = fopen(checkpointPath.c_str(), "rb");
+    ASSERT_EQ(f, nullptr);
+    f = fopen("./S5_AVC_resume_out.MP4.segment0.MP4", "rb");
+    ASSERT_EQ(f, nullptr);
+}
+
+TEST(EyerAVTranscoder, EyerAVTranscoderTest_Resume_ParamsFingerprint)
+{
+    Eyer::EyerAVTranscoderParams params;
+    Eyer::EyerString fingerprint = Eyer::EyerAVTranscoderCheckpoint::GetParamsFingerprint(params);
+
+    // 只影响速度的参数不改变指纹
+    Eyer::EyerAVTranscoderParams speedParams;
+    speedParams.SetDecodeThreadNum(8);
+    speedParams.SetEncodeThreadNum(8);
+    speedParams.SetPipeline(true);
+    speedParams.SetAsyncWrite(true);
+    speedParams.SetWriteQueueSize(16);
+    speedParams.SetWriteBufferSize(1024 * 1024);
+    speedParams.SetWritePreallocate(true);
+    speedParams.SetProgressInterval(0);
+    ASSERT_TRUE(Eyer::EyerAVTranscoderCheckpoint::GetParamsFingerprint(speedParams) == fingerprint);
+
+    Eyer::EyerAVTranscoderParams crfParams;
+    crfParams.SetCRF(23);
+    ASSERT_FALSE(Eyer::EyerAVTranscoderCheckpoint::GetParamsFingerprint(crfParams) == fingerprint);
+}
+
+#endif //EYERLIB_RESUMETEST_HPP
@@ -0,0 +1,97 @@
+#ifndef EYERLIB_SEGMENTTEST_HPP
+#define EYERLIB_SEGMENTTEST_HPP
+
+#include <stdio.h>
+#include <gtest/gtest.h>
+
+#include "EyerAVTranscoder/EyerAVTranscoderHeader.hpp"
+
+static int SegmentTest_Transcode(const Eyer::EyerString & inputPath, const Eyer::EyerString & outputPath, int segmentNum)
+{
+    Eyer::EyerAVTranscoderParams params;
+    params.SetVideoCodecId(Eyer::EyerAVCodecID::CODEC_ID_H264);
+    params.SetVideoPixelFormat(Eyer::EyerAVPixelFormat::EYER_YUV420P);
+    params.SetAudioCodecId(Eyer::EyerAVCodecID::CODEC_ID_AAC);
+    params.SetChannelLayout(Eyer::EyerAVChannelLayout::EYER_AV_CH_LAYOUT_STEREO);
+    params.SetSampleRate(48000);
+    params.SetSegmentNum(segmentNum);
+    params.SetSegmentWorkerNum(4);
+
+    Eyer::EyerAVTranscoder transcoder(inputPath);
+    transcoder.SetOutputPath(outputPath);
+    transcoder.SetParams(params);
+    int ret = transcoder.Transcode(nullptr);
+    if(ret){
+        return ret;
+    }
+    if(transcoder.GetStatus() != Eyer::EyerAVTranscoderStatus::SUCC){
+        return -1;
+    }
+    return 0;
+}
+
+TEST(EyerAVTranscoder, EyerAVTranscoderTest_Segment_MatchSequential)
+{
+    Eyer::EyerString inputPath = "./panasonic_S5_h264_1920x1080_yuv420p_30fps_wedding2.MOV";
+    Eyer::EyerString sequentialPath = "./S5_AVC_segment_sequential_out.MP4";
+    Eyer::EyerString segmentPath = "./S5_AVC_segment_out.MP4";
+
+    ASSERT_EQ(SegmentTest_Transcode(inputPath, sequentialPath, 1), 0);
+    ASSERT_EQ(SegmentTest_Transcode(inputPath, segmentPath, 4), 0);
+
+    Eyer::EyerAVReader sequentialReader(sequentialPath);
+    ASSERT_EQ(sequentialReader.Open(), 0);
+    Eyer::EyerAVReader segmentReader(segmentPath);
+    ASSERT_EQ(segmentReader.Open(), 0);
+
+    ASSERT_EQ(sequentialReader.GetStreamCount(), segmentReader.GetStreamCount());
+    ASSERT_GE(segmentReader.GetAudioStreamIndex(), 0);
+
+    int sequentialVideoIndex = sequentialReader.GetVideoStreamIndex();
+    int segmentVideoIndex = segmentReader.GetVideoStreamIndex();
+    ASSERT_GE(segmentVideoIndex, 0);
+
+    int sequentialCount = 0;
+    while(1){
+        Eyer::EyerAVPacket packet;
+        if(sequentialReader.Read(packet)){
+            break;
+        }
+        if(packet.GetStreamIndex() == sequentialVideoIndex){
+            sequentialCount++;
+        }
+    }
+
+    // 拼接后帧数不变, 分段边界处 DTS 单调递增
+    int segmentCount = 0;
+    int keyFrameCount = 0;
+    int64_t lastDTS = INT64_MIN;
+    while(1){
+        Eyer::EyerAVPacket packet;
+        if(segmentReader.Read(packet)){
+            break;
+        }
+        if(packet.GetStreamIndex() != segmentVideoIndex){
+            continue;
+        }
+        ASSERT_GT(packet.GetDTS(), lastDTS);
+        lastDTS = packet.GetDTS();
+        if(packet.IsKeyFrame()){
+            keyFrameCount++;
+        }
+        segmentCount++;
+    }
+
+    EyerLog("Segment frame count: %d, sequential frame count: %d\n", segmentCount, sequentialCount);
+    ASSERT_EQ(segmentCount, sequentialCount);
+    ASSERT_GE(keyFrameCount, 2);
+
+    sequentialReader.Close();
+    segmentReader.Close();
+
+    // 临时分段文件已经删除
+    FILE * f = fopen("./S5_AVC_segment_out.MP4.segment0.MP4", "rb");
+    ASSERT_EQ(f, nullptr);
+}
+
+#endif //EYERLIB_SEGMENTTEST_HPP
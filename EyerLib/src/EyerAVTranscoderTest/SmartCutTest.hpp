@@ -0,0 +1,153 @@
+#ifndef EYERLIB_SMARTCUTTEST_HPP
+#define EYERLIB_SMARTCUTTEST_HPP
+
+#include <stdio.h>
+#include <gtest/gtest.h>
+
+#include "EyerAVTranscoder/EyerAVTranscoderHeader.hpp"
+
+#include "TranscoderTestUtil.hpp"
+
+static int SmartCutTest_Transcode(const Eyer::EyerString & inputPath, const Eyer::EyerString & outputPath, double startTime, double endTime, bool smartCut, Eyer::EyerAVTranscodeProfile * profile = nullptr)
+{
+    Eyer::EyerAVTranscoderParams params;
+    params.SetVideoCodecId(Eyer::EyerAVCodecID::CODEC_ID_H264);
+    params.SetAudioCodecId(Eyer::EyerAVCodecID::CODEC_ID_AAC);
+    params.SetStartTime(startTime);
+    params.SetEndTime(endTime);
+    params.SetSmartCut(smartCut);
+
+    Eyer::EyerAVTranscoder transcoder(inputPath);
+    transcoder.SetOutputPath(outputPath);
+    transcoder.SetParams(params);
+    int ret = transcoder.Transcode(nullptr);
+    if(profile != nullptr){
+        *profile = transcoder.GetProfile();
+    }
+    if(ret){
+        return ret;
+    }
+    if(transcoder.GetStatus() != Eyer::EyerAVTranscoderStatus::SUCC){
+        return -1;
+    }
+    return 0;
+}
+
+// 解码视频流, 返回解出的帧数, failNum 输出送包失败的次数
+static int SmartCutTest_DecodeVideo(const Eyer::EyerString & path, int * failNum)
+{
+    *failNum = 0;
+    Eyer::EyerAVReader reader(path);
+    if(reader.Open()){
+        return -1;
+    }
+    int streamIndex = reader.GetVideoStreamIndex();
+    if(streamIndex < 0){
+        reader.Close();
+        return -1;
+    }
+    Eyer::EyerAVStream stream = reader.GetStream(streamIndex);
+    Eyer::EyerAVDecoder decoder;
+    if(decoder.Init(stream)){
+        reader.Close();
+        return -1;
+    }
+
+    int frameNum = 0;
+    while(1){
+        Eyer::EyerAVPacket packet;
+        if(reader.Read(packet)){
+            break;
+        }
+        if(packet.GetStreamIndex() != streamIndex){
+            continue;
+        }
+        if(decoder.SendPacket(packet)){
+            (*failNum)++;
+            continue;
+        }
+        while(1){
+            Eyer::EyerAVFrame frame;
+            if(decoder.RecvFrame(frame)){
+                break;
+            }
+            frameNum++;
+        }
+    }
+    decoder.SendPacketNull();
+    while(1){
+        Eyer::EyerAVFrame frame;
+        if(decoder.RecvFrame(frame)){
+            break;
+        }
+        frameNum++;
+    }
+    reader.Close();
+    return frameNum;
+}
+
+TEST(EyerAVTranscoder, EyerAVTranscoderTest_SmartCut_MatchReencode)
+{
+    Eyer::EyerString inputPath = "./panasonic_S5_h264_1920x1080_yuv420p_30fps_wedding2.MOV";
+    Eyer::EyerString reencodePath = "./S5_AVC_smartcut_reencode_out.MP4";
+    Eyer::EyerString smartCutPath = "./S5_AVC_smartcut_out.MP4";
+
+    double duration = 0.0;
+    {
+        Eyer::EyerAVReader reader(inputPath);
+        ASSERT_EQ(reader.Open(), 0);
+        duration = reader.GetDuration();
+        reader.Close();
+    }
+    ASSERT_GT(duration, 4.0);
+
+    // 起止时间都不在关键帧上
+    double startTime = 1.3;
+    double endTime = duration - 1.3;
+
+    ASSERT_EQ(SmartCutTest_Transcode(inputPath, reencodePath, startTime, endTime, false), 0);
+    Eyer::EyerAVTranscodeProfile smartCutProfile;
+    ASSERT_EQ(SmartCutTest_Transcode(inputPath, smartCutPath, startTime, endTime, true, &smartCutProfile), 0);
+
+    double reencodeLastPTS = 0.0;
+    double smartCutLastPTS = 0.0;
+    // 重编码部分和复制部分的边界处 DTS 也要单调递增, 否则返回 -1
+    int reencodeCount = TranscoderTestUtil_CountPacket(reencodePath, -1, &reencodeLastPTS);
+    int smartCutCount = TranscoderTestUtil_CountPacket(smartCutPath, -1, &smartCutLastPTS);
+    EyerLog("Smart cut frame count: %d, reencode frame count: %d\n", smartCutCount, reencodeCount);
+    ASSERT_GT(reencodeCount, 0);
+    ASSERT_EQ(smartCutCount, reencodeCount);
+    ASSERT_NEAR(smartCutLastPTS, reencodeLastPTS, 0.05);
+
+    // 确实走了智能裁剪: 只有头尾两段解码, 没有回退到整段重编码
+    int64_t decodeVideoNum = 0;
+    for(int i = 0; i < smartCutProfile.streamList.size(); i++){
+        if(smartCutProfile.streamList[i].mediaType == Eyer::EyerAVMediaType::MEDIA_TYPE_VIDEO.GetName()){
+            decodeVideoNum += smartCutProfile.streamList[i].stageTime[Eyer::STAGE_DECODE].count;
+        }
+    }
+    EyerLog("Smart cut decode video frame: %lld\n", (long long)decodeVideoNum);
+    ASSERT_GT(decodeVideoNum, 0);
+    ASSERT_LT(decodeVideoNum * 2, smartCutCount);
+
+    // 头部和复制部分, 复制部分和尾部的边界处每一帧都能解出来
+    int decodeFailNum = 0;
+    int decodeFrameNum = SmartCutTest_DecodeVideo(smartCutPath, &decodeFailNum);
+    ASSERT_EQ(decodeFailNum, 0);
+    ASSERT_EQ(decodeFrameNum, smartCutCount);
+
+    {
+        Eyer::EyerAVReader reader(smartCutPath);
+        ASSERT_EQ(reader.Open(), 0);
+        ASSERT_GE(reader.GetAudioStreamIndex(), 0);
+        reader.Close();
+    }
+
+    // 临时文件已经删除
+    FILE * f = fopen("./S5_AVC_smartcut_out.MP4.smartcut_head.MP4", "rb");
+    ASSERT_EQ(f, nullptr);
+    f = fopen("./S5_AVC_smartcut_out.MP4.smartcut_tail.MP4", "rb");
+    ASSERT_EQ(f, nullptr);
+}
+
+#endif //EYERLIB_SMARTCUTTEST_HPP
@@ -0,0 +1,77 @@
+#ifndef EYERLIB_STREAMCOPYTEST_HPP
+#define EYERLIB_STREAMCOPYTEST_HPP
+
+#include <stdio.h>
+#include <gtest/gtest.h>
+
+#include "EyerAVTranscoder/EyerAVTranscoderHeader.hpp"
+
+#include "TranscoderTestUtil.hpp"
+
+TEST(EyerAVTranscoder, EyerAVTranscoderTest_StreamCopy_Video)
+{
+    Eyer::EyerString inputPath = "./panasonic_S5_h264_1920x1080_yuv420p_30fps_wedding2.MOV";
+    Eyer::EyerString outputPath = "./S5_AVC_video_copy_out.MOV";
+
+    Eyer::EyerAVTranscoderParams params;
+    params.SetVideoCodecId(Eyer::EyerAVCodecID::CODEC_ID_H264);
+    params.SetVideoCopyMode(Eyer::EyerAVTranscoderCopyMode::COPY);
+    params.SetAudioCodecId(Eyer::EyerAVCodecID::CODEC_ID_AAC);
+    params.SetAudioCopyMode(Eyer::EyerAVTranscoderCopyMode::ENCODE);
+
+    Eyer::EyerAVTranscoder transcoder(inputPath);
+    transcoder.SetOutputPath(outputPath);
+    transcoder.SetParams(params);
+    int ret = transcoder.Transcode(nullptr);
+    ASSERT_EQ(ret, 0);
+
+    Eyer::EyerAVReader inputReader(inputPath);
+    ASSERT_EQ(inputReader.Open(), 0);
+    int inputVideoIndex = inputReader.GetVideoStreamIndex();
+    Eyer::EyerAVStream inputStream = inputReader.GetStream(inputVideoIndex);
+    inputReader.Close();
+
+    Eyer::EyerAVReader outputReader(outputPath);
+    ASSERT_EQ(outputReader.Open(), 0);
+    int outputVideoIndex = outputReader.GetVideoStreamIndex();
+    Eyer::EyerAVStream outputStream = outputReader.GetStream(outputVideoIndex);
+    outputReader.Close();
+
+    ASSERT_EQ(outputStream.GetCodecID(), inputStream.GetCodecID());
+    ASSERT_EQ(outputStream.GetWidth(), inputStream.GetWidth());
+    ASSERT_EQ(outputStream.GetHeight(), inputStream.GetHeight());
+
+    // 复制模式下视频包数量与源文件一致
+    ASSERT_EQ(TranscoderTestUtil_CountPacket(outputPath, outputVideoIndex), TranscoderTestUtil_CountPacket(inputPath, inputVideoIndex));
+}
+
+TEST(EyerAVTranscoder, EyerAVTranscoderTest_StreamCopy_Range)
+{
+    Eyer::EyerString inputPath = "./panasonic_S5_h264_1920x1080_yuv420p_30fps_wedding2.MOV";
+    Eyer::EyerString outputPath = "./S5_AVC_copy_range_out.MOV";
+
+    Eyer::EyerAVTranscoderParams params;
+    params.SetVideoCodecId(Eyer::EyerAVCodecID::CODEC_ID_H264);
+    params.SetVideoCopyMode(Eyer::EyerAVTranscoderCopyMode::COPY);
+    params.SetAudioCopyMode(Eyer::EyerAVTranscoderCopyMode::COPY);
+    params.SetStartTime(1.0);
+    params.SetEndTime(3.0);
+
+    Eyer::EyerAVTranscoder transcoder(inputPath);
+    transcoder.SetOutputPath(outputPath);
+    transcoder.SetParams(params);
+    int ret = transcoder.Transcode(nullptr);
+    ASSERT_EQ(ret, 0);
+
+    Eyer::EyerAVReader reader(outputPath);
+    ASSERT_EQ(reader.Open(), 0);
+    double duration = reader.GetDuration();
+    reader.Close();
+
+    EyerLog("Copy range duration: %f\n", duration);
+    // 视频从起始时间之前的关键帧开始复制, 所以时长会略大于裁剪区间
+    ASSERT_GT(duration, 1.5);
+    ASSERT_LT(duration, 5.0);
+}
+
+#endif //EYERLIB_STREAMCOPYTEST_HPP
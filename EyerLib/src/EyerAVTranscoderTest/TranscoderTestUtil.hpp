@@ -0,0 +1,52 @@
+#ifndef EYERLIB_TRANSCODERTESTUTIL_HPP
+#define EYERLIB_TRANSCODERTESTUTIL_HPP
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include "EyerAVTranscoder/EyerAVTranscoderHeader.hpp"
+
+// 统计一个流的数据包数量, streamIndex 小于 0 时统计视频流
+// lastSecPTS 不为空时输出最大的 PTS; 打不开或者 DTS 不是单调递增时返回 -1
+static int TranscoderTestUtil_CountPacket(const Eyer::EyerString & path, int streamIndex = -1, double * lastSecPTS = nullptr)
+{
+    Eyer::EyerAVReader reader(path);
+    if(reader.Open()){
+        return -1;
+    }
+    if(streamIndex < 0){
+        streamIndex = reader.GetVideoStreamIndex();
+    }
+    if(streamIndex < 0){
+        reader.Close();
+        return -1;
+    }
+
+    int count = 0;
+    int64_t lastDTS = INT64_MIN;
+    if(lastSecPTS != nullptr){
+        *lastSecPTS = 0.0;
+    }
+    while(1){
+        Eyer::EyerAVPacket packet;
+        if(reader.Read(packet)){
+            break;
+        }
+        if(packet.GetStreamIndex() != streamIndex){
+            continue;
+        }
+        if(packet.GetDTS() <= lastDTS){
+            reader.Close();
+            return -1;
+        }
+        lastDTS = packet.GetDTS();
+        if(lastSecPTS != nullptr && packet.GetSecPTS() > *lastSecPTS){
+            *lastSecPTS = packet.GetSecPTS();
+        }
+        count++;
+    }
+    reader.Close();
+    return count;
+}
+
+#endif //EYERLIB_TRANSCODERTESTUTIL_HPP
@@ -7,6 +7,10 @@
 #include <iomanip>
 #include <sstream>
 
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
 
 namespace Eyer
 {
@@ -56,6 +60,32 @@ namespace Eyer
         return (long long)tmp.count();
     }
 
+    /**
+     * @brief 获取当前线程消耗的 CPU 时间（纳秒）
+     * @return 当前线程在用户态和内核态消耗的 CPU 时间，获取失败返回 0
+     *
+     * 与 GetTimeNano 的差值配合使用，可以区分一段代码是在计算还是在等待（IO、锁、队列）
+     */
+    long long EyerTime::GetThreadCPUTimeNano()
+    {
+#ifdef _WIN32
+        FILETIME creationTime, exitTime, kernelTime, userTime;
+        if(!GetThreadTimes(GetCurrentThread(), &creationTime, &exitTime, &kernelTime, &userTime)){
+            return 0;
+        }
+        // FILETIME 单位为 100 纳秒
+        unsigned long long kernel = ((unsigned long long)kernelTime.dwHighDateTime << 32) | kernelTime.dwLowDateTime;
+        unsigned long long user = ((unsigned long long)userTime.dwHighDateTime << 32) | userTime.dwLowDateTime;
+        return (long long)(kernel + user) * 100;
+#else
+        struct timespec ts;
+        if(clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts)){
+            return 0;
+        }
+        return (long long)ts.tv_sec * 1000000000 + ts.tv_nsec;
+#endif
+    }
+
     /**
      * @brief 将毫秒转换为时间字符串格式
      * @param milliseconds 毫秒数
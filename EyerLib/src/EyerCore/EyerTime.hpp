@@ -9,6 +9,7 @@ namespace Eyer
     {
     public:
         static long long GetTimeNano();
+        static long long GetThreadCPUTimeNano();
         static long long GetTime();
         static int EyerSleepMilliseconds(int time);
         static EyerString Milliseconds_to_time(int milliseconds);
@@ -0,0 +1,107 @@
+#ifndef EYERLIB_EYERBOUNDEDQUEUE_HPP
+#define EYERLIB_EYERBOUNDEDQUEUE_HPP
+
+#include <queue>
+#include <mutex>
+#include <condition_variable>
+
+namespace Eyer
+{
+    // 有界阻塞队列, 用于流水线各阶段之间传递数据
+    // 队列满时 Push 阻塞 (背压), 队列空时 Pop 阻塞
+    // SetFinish: 生产者结束, 消费者取完剩余数据后 Pop 返回 -1
+    // Abort: 立即唤醒所有等待者, Push/Pop 均返回 -1
+    template<typename T>
+    class EyerBoundedQueue
+    {
+    public:
+        EyerBoundedQueue(int _maxSize = 8)
+        {
+            maxSize = _maxSize;
+            if(maxSize <= 0){
+                maxSize = 1;
+            }
+        }
+
+        ~EyerBoundedQueue()
+        {
+
+        }
+
+        int Push(T * t)
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            notFullCV.wait(lock, [this]{ return (int)queue.size() < maxSize || abortFlag; });
+            if(abortFlag){
+                return -1;
+            }
+            queue.push(t);
+            notEmptyCV.notify_one();
+            return 0;
+        }
+
+        int Pop(T ** t)
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            notEmptyCV.wait(lock, [this]{ return queue.size() > 0 || finishFlag || abortFlag; });
+            if(abortFlag){
+                return -1;
+            }
+            if(queue.size() <= 0){
+                return -1;
+            }
+            *t = queue.front();
+            queue.pop();
+            notFullCV.notify_one();
+            return 0;
+        }
+
+        // Abort 之后用于取出残留数据, 以便调用者释放
+        int TryPop(T ** t)
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            if(queue.size() <= 0){
+                return -1;
+            }
+            *t = queue.front();
+            queue.pop();
+            notFullCV.notify_one();
+            return 0;
+        }
+
+        int SetFinish()
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            finishFlag = true;
+            notEmptyCV.notify_all();
+            return 0;
+        }
+
+        int Abort()
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            abortFlag = true;
+            notEmptyCV.notify_all();
+            notFullCV.notify_all();
+            return 0;
+        }
+
+        int Size()
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            return queue.size();
+        }
+
+    private:
+        std::mutex mtx;
+        std::condition_variable notEmptyCV;
+        std::condition_variable notFullCV;
+        std::queue<T *> queue;
+
+        int maxSize = 8;
+        bool finishFlag = false;
+        bool abortFlag = false;
+    };
+}
+
+#endif //EYERLIB_EYERBOUNDEDQUEUE_HPP
@@ -3,5 +3,6 @@
 
 #include "EyerThread.hpp"
 #include "EyerConditionVariableBox.hpp"
+#include "EyerBoundedQueue.hpp"
 
 #endif //EYERLIB_EYERTHREADHEADER_HPP